@@ -0,0 +1,13 @@
+set (TE_CONTAINERBENCHMARK_INC_NOFILTER
+)
+
+set (TE_CONTAINERBENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_CONTAINERBENCHMARK_SRC_NOFILTER} ${TE_CONTAINERBENCHMARK_INC_NOFILTER})
+
+set (TE_CONTAINERBENCHMARK_SRC
+    ${TE_CONTAINERBENCHMARK_INC_NOFILTER}
+    ${TE_CONTAINERBENCHMARK_SRC_NOFILTER}
+)
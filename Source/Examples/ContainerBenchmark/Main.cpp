@@ -0,0 +1,407 @@
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeFlatHashMap.h"
+#include "Utility/TeSlotMap.h"
+#include "Utility/TeTimer.h"
+
+#include <cstdio>
+#include <random>
+
+/**
+ * Compares FlatHashMap against Map and UnorderedMap. Each container is filled with the same keys, then looked up with
+ * keys that are present and keys that aren't, iterated and emptied again. Sizes go from a handful of elements, like
+ * the per device button states of VirtualInput, up to large resource tables.
+ *
+ * Also checks that FlatHashMap handles hashers returning only a few distinct values and that SlotMap rejects handles
+ * to free slots, and compares SlotMap against the usual ways of referencing objects that are created and destroyed at
+ * runtime: a shared pointer per object indexed by an id, and a FlatHashMap from ids to values.
+ */
+
+namespace te
+{
+    /** Value of roughly the size of VirtualInput's cached button state. */
+    struct BenchmarkValue
+    {
+        UINT64 Data[4] = { 0, 0, 0, 0 };
+    };
+
+    /** Number of operations each measurement runs for, over multiple containers when they are small. */
+    constexpr UINT32 OPERATIONS_PER_TEST = 1024 * 1024;
+
+    /** Sum of looked up values, printed so the compiler can't skip the work. */
+    UINT64 gChecksum = 0;
+
+    UINT64 GetKey(const UINT64& key) { return key; }
+    UINT64 GetKey(const String& key) { return key.size(); }
+
+    template <typename K>
+    Vector<K> CreateKeys(UINT32 count, std::mt19937_64& random);
+
+    template <>
+    Vector<UINT32> CreateKeys<UINT32>(UINT32 count, std::mt19937_64& random)
+    {
+        Vector<UINT32> keys(count);
+        for (UINT32 i = 0; i < count; i++)
+            keys[i] = (UINT32)random();
+
+        return keys;
+    }
+
+    template <>
+    Vector<UINT64> CreateKeys<UINT64>(UINT32 count, std::mt19937_64& random)
+    {
+        Vector<UINT64> keys(count);
+        for (UINT32 i = 0; i < count; i++)
+            keys[i] = random();
+
+        return keys;
+    }
+
+    template <>
+    Vector<String> CreateKeys<String>(UINT32 count, std::mt19937_64& random)
+    {
+        Vector<String> keys(count);
+        for (UINT32 i = 0; i < count; i++)
+            keys[i] = "Resources/Textures/Texture_" + ToString((UINT32)random()) + ".png";
+
+        return keys;
+    }
+
+    void PrintResult(const char* container, const char* operation, UINT64 microseconds, UINT64 operations)
+    {
+        printf("    %-14s %-14s %8.2f ns/op\n", container, operation, microseconds * 1000.0 / operations);
+    }
+
+    /** Runs all the measurements for one container type. */
+    template <typename M, typename K>
+    void RunBenchmark(const char* name, const Vector<K>& keys, const Vector<K>& missingKeys)
+    {
+        const UINT32 count = (UINT32)keys.size();
+        const UINT32 repeats = std::max(OPERATIONS_PER_TEST / count, 1U);
+
+        Vector<M> containers(repeats);
+        Timer timer;
+
+        timer.Reset();
+        for (auto& container : containers)
+        {
+            for (auto& key : keys)
+                container[key].Data[0] = 1;
+        }
+
+        PrintResult(name, "insert", timer.GetMicroseconds(), (UINT64)count * repeats);
+
+        timer.Reset();
+        for (UINT32 i = 0; i < repeats; i++)
+        {
+            const M& container = containers[i];
+            for (auto& key : keys)
+                gChecksum += container.find(key)->second.Data[0];
+        }
+
+        PrintResult(name, "lookup", timer.GetMicroseconds(), (UINT64)count * repeats);
+
+        timer.Reset();
+        for (UINT32 i = 0; i < repeats; i++)
+        {
+            const M& container = containers[i];
+            for (auto& key : missingKeys)
+                gChecksum += container.find(key) == container.end() ? 1 : 0;
+        }
+
+        PrintResult(name, "lookup missing", timer.GetMicroseconds(), (UINT64)count * repeats);
+
+        timer.Reset();
+        for (UINT32 i = 0; i < repeats; i++)
+        {
+            for (auto& entry : containers[i])
+                gChecksum += entry.second.Data[0] + GetKey(entry.first);
+        }
+
+        PrintResult(name, "iterate", timer.GetMicroseconds(), (UINT64)count * repeats);
+
+        timer.Reset();
+        for (auto& container : containers)
+        {
+            for (auto& key : keys)
+                container.erase(key);
+        }
+
+        PrintResult(name, "erase", timer.GetMicroseconds(), (UINT64)count * repeats);
+    }
+
+    /** Inserts objects, looks them up in random order, iterates over them and erases them, by id or by handle. */
+    void RunHandleBenchmarks(UINT32 count)
+    {
+        const UINT32 repeats = std::max(OPERATIONS_PER_TEST / count, 1U);
+        const UINT64 operations = (UINT64)count * repeats;
+
+        Vector<UINT32> order(count);
+        for (UINT32 i = 0; i < count; i++)
+            order[i] = i;
+
+        std::mt19937_64 random(count);
+        std::shuffle(order.begin(), order.end(), random);
+
+        printf("Handles, %u elements\n", count);
+
+        {
+            Vector<UnorderedMap<UINT32, SPtr<BenchmarkValue>>> containers(repeats);
+            Timer timer;
+
+            for (auto& container : containers)
+            {
+                for (UINT32 i = 0; i < count; i++)
+                    container[i] = te_shared_ptr_new<BenchmarkValue>();
+            }
+
+            PrintResult("SPtr by id", "insert", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& id : order)
+                    gChecksum += container.find(id)->second->Data[0];
+            }
+
+            PrintResult("SPtr by id", "lookup", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& entry : container)
+                    gChecksum += entry.second->Data[0];
+            }
+
+            PrintResult("SPtr by id", "iterate", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& id : order)
+                    container.erase(id);
+            }
+
+            PrintResult("SPtr by id", "erase", timer.GetMicroseconds(), operations);
+        }
+
+        {
+            Vector<FlatHashMap<UINT32, BenchmarkValue>> containers(repeats);
+            Timer timer;
+
+            for (auto& container : containers)
+            {
+                for (UINT32 i = 0; i < count; i++)
+                    container[i].Data[0] = 1;
+            }
+
+            PrintResult("FlatHashMap", "insert", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& id : order)
+                    gChecksum += container.find(id)->second.Data[0];
+            }
+
+            PrintResult("FlatHashMap", "lookup", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& entry : container)
+                    gChecksum += entry.second.Data[0];
+            }
+
+            PrintResult("FlatHashMap", "iterate", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& id : order)
+                    container.erase(id);
+            }
+
+            PrintResult("FlatHashMap", "erase", timer.GetMicroseconds(), operations);
+        }
+
+        {
+            Vector<SlotMap<BenchmarkValue>> containers(repeats);
+            Vector<SlotMap<BenchmarkValue>::Handle> handles(count);
+            Timer timer;
+
+            for (auto& container : containers)
+            {
+                for (UINT32 i = 0; i < count; i++)
+                    handles[i] = container.Emplace();
+            }
+
+            PrintResult("SlotMap", "insert", timer.GetMicroseconds(), operations);
+
+            // Containers are filled the same way, so handles of the last one are valid in all of them
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& id : order)
+                    gChecksum += container[handles[id]].Data[0];
+            }
+
+            PrintResult("SlotMap", "lookup", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& value : container)
+                    gChecksum += value.Data[0];
+            }
+
+            PrintResult("SlotMap", "iterate", timer.GetMicroseconds(), operations);
+
+            timer.Reset();
+            for (auto& container : containers)
+            {
+                for (auto& id : order)
+                    container.Erase(handles[id]);
+            }
+
+            PrintResult("SlotMap", "erase", timer.GetMicroseconds(), operations);
+        }
+    }
+
+    /** Hasher giving only four distinct values, so that thousands of keys share each home slot. */
+    struct DegenerateHash
+    {
+        size_t operator()(UINT64 key) const { return (size_t)(key % 4); }
+    };
+
+    /**
+     * Checks that FlatHashMap keeps working with a degenerate hasher, which UnorderedMap handles with long bucket
+     * chains. Inserts, erases and erases while iterating random keys, comparing the contents with an UnorderedMap.
+     * Returns false if they differ.
+     */
+    bool CheckDegenerateHash()
+    {
+        constexpr UINT32 NUM_OPERATIONS = 20000;
+        constexpr UINT64 NUM_KEYS = 2000;
+
+        FlatHashMap<UINT64, UINT64, DegenerateHash> map;
+        UnorderedMap<UINT64, UINT64> reference;
+        std::mt19937_64 random(NUM_OPERATIONS);
+
+        Timer timer;
+        for (UINT32 i = 0; i < NUM_OPERATIONS; i++)
+        {
+            const UINT64 key = random() % NUM_KEYS;
+            const UINT32 operation = (UINT32)(random() % 16);
+
+            if (operation < 10)
+            {
+                if (map.insert({ key, i }).second != reference.insert({ key, i }).second)
+                    return false;
+            }
+            else if (operation < 15)
+            {
+                if (map.erase(key) != reference.erase(key))
+                    return false;
+            }
+            else
+            {
+                for (auto iter = map.begin(); iter != map.end();)
+                {
+                    if (iter->first % 5 == 0)
+                    {
+                        reference.erase(iter->first);
+                        iter = map.erase(iter);
+                    }
+                    else
+                        ++iter;
+                }
+            }
+        }
+
+        if (map.size() != reference.size())
+            return false;
+
+        for (auto& entry : reference)
+        {
+            auto iterFind = map.find(entry.first);
+            if (iterFind == map.end() || iterFind->second != entry.second)
+                return false;
+        }
+
+        PrintResult("FlatHashMap", "degenerate hash", timer.GetMicroseconds(), NUM_OPERATIONS);
+        return true;
+    }
+
+    /**
+     * Checks that SlotMap rejects handles to free slots: erased handles, handles forged with the generation the next
+     * object of a slot will get, and handles from another map. Returns false if one of them is accepted.
+     */
+    bool CheckSlotMapHandles()
+    {
+        SlotMap<UINT64> map;
+        SlotMap<UINT64> other;
+
+        const SlotMap<UINT64>::Handle erased = map.Insert(1);
+        const SlotMap<UINT64>::Handle live = map.Insert(2);
+        map.Erase(erased);
+
+        const SlotMap<UINT64>::Handle forged = { erased.Index, erased.Generation + 1 };
+        if (map.Contains(erased) || map.Contains(forged) || map.Get(forged) != nullptr)
+            return false;
+
+        other.Erase(other.Insert(3));
+        const SlotMap<UINT64>::Handle foreign = other.Insert(4);
+        if (map.Contains(foreign) || !map.Contains(live))
+            return false;
+
+        const SlotMap<UINT64>::Handle reused = map.Insert(5);
+        if (reused.Index != erased.Index || !map.Contains(reused) || map.Contains(erased) || map[reused] != 5)
+            return false;
+
+        map.Clear();
+        return !map.Contains(live) && !map.Contains(reused) && !map.Contains({ reused.Index, reused.Generation + 1 });
+    }
+
+    template <typename K>
+    void RunBenchmarks(const char* keyName, UINT32 count)
+    {
+        std::mt19937_64 random(count);
+        const Vector<K> keys = CreateKeys<K>(count, random);
+        const Vector<K> missingKeys = CreateKeys<K>(count, random);
+
+        printf("%s keys, %u elements\n", keyName, count);
+
+        RunBenchmark<Map<K, BenchmarkValue>>("Map", keys, missingKeys);
+        RunBenchmark<UnorderedMap<K, BenchmarkValue>>("UnorderedMap", keys, missingKeys);
+        RunBenchmark<FlatHashMap<K, BenchmarkValue>>("FlatHashMap", keys, missingKeys);
+    }
+}
+
+int main()
+{
+    using namespace te;
+
+    if (!CheckDegenerateHash())
+    {
+        printf("FlatHashMap contents differ from UnorderedMap with a degenerate hasher\n");
+        return 1;
+    }
+
+    if (!CheckSlotMapHandles())
+    {
+        printf("SlotMap accepted a handle to a free slot\n");
+        return 1;
+    }
+
+    const UINT32 sizes[] = { 16, 1024, 65536, 1024 * 1024 };
+    for (auto size : sizes)
+    {
+        RunBenchmarks<UINT32>("UINT32", size);
+        RunBenchmarks<UINT64>("UINT64", size);
+        RunBenchmarks<String>("String", size);
+        RunHandleBenchmarks(size);
+    }
+
+    printf("Checksum: %llu\n", (unsigned long long)gChecksum);
+    return 0;
+}
\ No newline at end of file
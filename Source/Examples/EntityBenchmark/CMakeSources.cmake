@@ -0,0 +1,13 @@
+set (TE_ENTITYBENCHMARK_INC_NOFILTER
+)
+
+set (TE_ENTITYBENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_ENTITYBENCHMARK_SRC_NOFILTER} ${TE_ENTITYBENCHMARK_INC_NOFILTER})
+
+set (TE_ENTITYBENCHMARK_SRC
+    ${TE_ENTITYBENCHMARK_INC_NOFILTER}
+    ${TE_ENTITYBENCHMARK_SRC_NOFILTER}
+)
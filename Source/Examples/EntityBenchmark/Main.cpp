@@ -0,0 +1,264 @@
+#include "TeCorePrerequisites.h"
+#include "Scene/TeWorld.h"
+#include "Scene/TeTransformHierarchy.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Threading/TeThreadPool.h"
+#include "Scheduler/TeUpdateScheduler.h"
+#include "Utility/TeTimer.h"
+
+#include <cstdio>
+
+/**
+ * Measures the cost of updating many simulated entities, stored as individually allocated objects (one allocation per
+ * entity, updated through a virtual call) and stored in World chunks (iterated sequentially, in parallel, and through
+ * systems scheduled by the UpdateScheduler). Also measures entity creation, structural changes through command
+ * buffers, and the update of a transform hierarchy of the same size when all or only a few nodes move.
+ */
+
+namespace te
+{
+    struct Position
+    {
+        float X = 0.0f, Y = 0.0f, Z = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float X = 0.0f, Y = 0.0f, Z = 0.0f;
+    };
+
+    struct Health
+    {
+        float Value = 100.0f;
+        float Regeneration = 0.5f;
+    };
+
+    /** Marks entities that ran out of health. */
+    struct Dead
+    { };
+
+    /** Entity of a classic object oriented scene, for comparison. */
+    class SceneObject
+    {
+    public:
+        virtual ~SceneObject() = default;
+        virtual void Update(float delta) = 0;
+
+        Position Pos;
+    };
+
+    class MovingObject : public SceneObject
+    {
+    public:
+        void Update(float delta) override
+        {
+            Pos.X += Vel.X * delta;
+            Pos.Y += Vel.Y * delta;
+            Pos.Z += Vel.Z * delta;
+        }
+
+        Velocity Vel;
+        Health Life;
+    };
+
+    constexpr UINT32 NUM_FRAMES = 20;
+    constexpr float FRAME_DELTA = 1.0f / 60.0f;
+
+    /** Sum of positions, printed so the compiler can't skip the work. */
+    double gChecksum = 0.0;
+
+    void PrintResult(const char* test, UINT64 microseconds, UINT64 operations)
+    {
+        printf("    %-32s %8.2f ns/entity\n", test, microseconds * 1000.0 / operations);
+    }
+
+    /** Integration step heavy enough for the memory layout not to be the only factor. */
+    void Integrate(Position& position, Velocity& velocity, float delta)
+    {
+        velocity.Y -= 9.81f * delta;
+        velocity.X *= 0.999f;
+        velocity.Z *= 0.999f;
+
+        position.X += velocity.X * delta;
+        position.Y += velocity.Y * delta;
+        position.Z += velocity.Z * delta;
+
+        if (position.Y < 0.0f)
+        {
+            position.Y = -position.Y;
+            velocity.Y = std::sqrt(velocity.Y * velocity.Y) * 0.8f;
+        }
+    }
+
+    void RunObjectBenchmark(UINT32 count)
+    {
+        Timer timer;
+        Vector<SceneObject*> objects;
+        objects.reserve(count);
+
+        for (UINT32 i = 0; i < count; i++)
+        {
+            MovingObject* object = te_new<MovingObject>();
+            object->Pos.Y = (float)(i % 100);
+            object->Vel.X = 1.0f;
+            objects.push_back(object);
+        }
+
+        PrintResult("Objects: create", timer.GetMicroseconds(), count);
+
+        timer.Reset();
+        for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+        {
+            for (auto& object : objects)
+                object->Update(FRAME_DELTA);
+        }
+
+        PrintResult("Objects: update", timer.GetMicroseconds(), (UINT64)count * NUM_FRAMES);
+
+        for (auto& object : objects)
+        {
+            gChecksum += object->Pos.X;
+            te_delete(object);
+        }
+    }
+
+    void RunWorldBenchmark(UINT32 count)
+    {
+        World world;
+        Timer timer;
+
+        for (UINT32 i = 0; i < count; i++)
+        {
+            Position position;
+            position.Y = (float)(i % 100);
+
+            Velocity velocity;
+            velocity.X = 1.0f;
+
+            world.CreateEntity(position, velocity, Health());
+        }
+
+        PrintResult("World: create", timer.GetMicroseconds(), count);
+
+        Query<Position, Velocity> query(world);
+        auto integrate = [](Position& position, Velocity& velocity) { Integrate(position, velocity, FRAME_DELTA); };
+
+        timer.Reset();
+        for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+            query.ForEach(integrate);
+
+        PrintResult("World: ForEach", timer.GetMicroseconds(), (UINT64)count * NUM_FRAMES);
+
+        timer.Reset();
+        for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+            query.ForEachParallel(integrate);
+
+        PrintResult("World: ForEachParallel", timer.GetMicroseconds(), (UINT64)count * NUM_FRAMES);
+
+        // Two systems writing different components, which the UpdateScheduler runs in parallel
+        SYSTEM_DESC moveDesc;
+        moveDesc.Name = "Move";
+        moveDesc.Parallel = true;
+        world.AddSystem<Position, Velocity>(moveDesc, integrate);
+
+        SYSTEM_DESC healthDesc;
+        healthDesc.Name = "Health";
+        healthDesc.Parallel = true;
+        world.AddSystem<Health>(healthDesc, [&world](Entity entity, Health& health)
+        {
+            health.Value += health.Regeneration * FRAME_DELTA - (entity.Index % 97 == 0 ? 10.0f : 0.0f);
+            if (health.Value <= 0.0f)
+                world.GetCommands().AddComponent<Dead>(entity);
+        });
+
+        SYSTEM_DESC cleanupDesc;
+        cleanupDesc.Name = "Cleanup";
+        cleanupDesc.Phase = UpdatePhase::PostUpdate;
+        world.AddSystem<const Dead>(cleanupDesc, [&world](Entity entity, const Dead&)
+        {
+            world.GetCommands().DestroyEntity(entity);
+        });
+
+        timer.Reset();
+        for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+        {
+            for (UINT32 phase = 0; phase < (UINT32)UpdatePhase::Count; phase++)
+            {
+                gUpdateScheduler().Run((UpdatePhase)phase);
+                world.Flush();
+            }
+        }
+
+        PrintResult("World: systems", timer.GetMicroseconds(), (UINT64)count * NUM_FRAMES);
+        printf("    %u entities left\n", world.GetNumEntities());
+
+        query.ForEach([](const Position& position, const Velocity&) { gChecksum += position.X; });
+    }
+
+    void RunTransformBenchmark(UINT32 count)
+    {
+        // Chains of five nodes, like characters with a few attached objects
+        constexpr UINT32 CHAIN_LENGTH = 5;
+
+        TransformHierarchy transforms;
+        Vector<TransformId> nodes;
+        nodes.reserve(count);
+
+        for (UINT32 i = 0; i < count; i += CHAIN_LENGTH)
+        {
+            TransformId node;
+            for (UINT32 j = 0; j < CHAIN_LENGTH; j++)
+            {
+                node = transforms.Create(node);
+                transforms.SetLocalBounds(node, AABox::UNIT_BOX);
+                nodes.push_back(node);
+            }
+        }
+
+        transforms.Update();
+
+        const UINT32 steps[] = { 1, 100 };
+        for (auto step : steps)
+        {
+            Timer timer;
+            for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+            {
+                for (UINT32 i = frame % step; i < (UINT32)nodes.size(); i += step)
+                    transforms.SetPosition(nodes[i], Vector3((float)frame, 0.0f, 0.0f));
+
+                transforms.Update();
+            }
+
+            PrintResult(step == 1 ? "Transforms: all moved" : "Transforms: 1% moved", timer.GetMicroseconds(),
+                (UINT64)nodes.size() * NUM_FRAMES);
+        }
+
+        gChecksum += transforms.GetWorldMatrix(nodes.back()).GetTranslation().x;
+    }
+}
+
+int main()
+{
+    using namespace te;
+
+    ThreadPool::StartUp(TE_THREAD_HARDWARE_CONCURRENCY, TE_THREAD_HARDWARE_CONCURRENCY * 2 + 8);
+    TaskScheduler::StartUp();
+    UpdateScheduler::StartUp();
+
+    const UINT32 counts[] = { 10000, 100000, 500000 };
+    for (auto count : counts)
+    {
+        printf("%u entities\n", count);
+
+        RunObjectBenchmark(count);
+        RunWorldBenchmark(count);
+        RunTransformBenchmark(count);
+    }
+
+    UpdateScheduler::ShutDown();
+    TaskScheduler::ShutDown();
+    ThreadPool::ShutDown();
+
+    printf("Checksum: %f\n", gChecksum);
+    return 0;
+}
\ No newline at end of file
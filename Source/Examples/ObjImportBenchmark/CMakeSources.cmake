@@ -0,0 +1,13 @@
+set (TE_OBJIMPORTBENCHMARK_INC_NOFILTER
+)
+
+set (TE_OBJIMPORTBENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_OBJIMPORTBENCHMARK_SRC_NOFILTER} ${TE_OBJIMPORTBENCHMARK_INC_NOFILTER})
+
+set (TE_OBJIMPORTBENCHMARK_SRC
+    ${TE_OBJIMPORTBENCHMARK_INC_NOFILTER}
+    ${TE_OBJIMPORTBENCHMARK_SRC_NOFILTER}
+)
\ No newline at end of file
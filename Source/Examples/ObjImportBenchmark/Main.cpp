@@ -0,0 +1,297 @@
+#include "TeCorePrerequisites.h"
+#include "FileSystem/TeFileSystem.h"
+#include "Importer/TeImporter.h"
+#include "Importer/TeMeshImportOptions.h"
+#include "Mesh/TeMeshData.h"
+#include "Mesh/TeMeshOptimizer.h"
+#include "Mesh/TeMeshSimplifier.h"
+#include "Serialization/TeBinarySerializer.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Utility/TeDynLib.h"
+#include "Utility/TeDynLibManager.h"
+#include "Utility/TeTime.h"
+#include "Utility/TeTimer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#if defined(TE_BENCHMARK_ASSIMP)
+#   include <assimp/Importer.hpp>
+#   include <assimp/postprocess.h>
+#   include <assimp/scene.h>
+#endif
+
+/**
+ * Measures the throughput of the OBJ importer plugin, with and without the mesh optimization stage. Imports the file
+ * provided on the command line, or a generated grid if none is provided. If assimp is available the same file is also
+ * imported with it as a point of comparison.
+ *
+ * Also checks that the LODs of a closed mesh split into sub-meshes stay closed.
+ */
+
+namespace te
+{
+    static constexpr UINT32 NUM_RUNS = 3;
+
+    /** Writes a grid of quads with normals and texture coordinates, split into a few materials. */
+    void CreateGridFile(const String& path, UINT32 size)
+    {
+        std::ofstream stream(path.c_str(), std::ios::binary);
+
+        for (UINT32 y = 0; y <= size; y++)
+        {
+            for (UINT32 x = 0; x <= size; x++)
+            {
+                stream << "v " << x * 0.25f << " " << (x * y % 7) * 0.125f << " " << y * 0.25f << "\n";
+                stream << "vt " << (float)x / size << " " << (float)y / size << "\n";
+            }
+        }
+
+        stream << "vn 0.0 1.0 0.0\n";
+
+        const UINT32 rowSize = size + 1;
+        const UINT32 rowsPerMaterial = std::max(size / 4, 1U);
+
+        for (UINT32 y = 0; y < size; y++)
+        {
+            if (y % rowsPerMaterial == 0)
+                stream << "usemtl Material" << y / rowsPerMaterial << "\n";
+
+            for (UINT32 x = 0; x < size; x++)
+            {
+                const UINT32 a = y * rowSize + x + 1;
+                const UINT32 b = a + 1;
+                const UINT32 c = b + rowSize;
+                const UINT32 d = a + rowSize;
+
+                stream << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << c << "/" << c << "/1 "
+                    << d << "/" << d << "/1\n";
+            }
+        }
+    }
+
+    /** Returns the number of edges used by a single triangle of a list. */
+    UINT32 CountOpenEdges(const Vector<UINT32>& indices)
+    {
+        Vector<UINT64> edges;
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            const UINT64 from = indices[i];
+            const UINT64 to = indices[i % 3 == 2 ? i - 2 : i + 1];
+
+            edges.push_back((from << 32) | to);
+        }
+
+        std::sort(edges.begin(), edges.end());
+
+        UINT32 numOpenEdges = 0;
+        for (UINT64 edge : edges)
+        {
+            if (!std::binary_search(edges.begin(), edges.end(), (edge << 32) | (edge >> 32)))
+                numOpenEdges++;
+        }
+
+        return numOpenEdges;
+    }
+
+    /**
+     * Generates LODs of a torus split into three sub-meshes, which are simplified independently. Returns false if the
+     * LODs have open edges, meaning the sub-meshes moved apart.
+     */
+    bool CheckSubMeshBoundaries()
+    {
+        constexpr UINT32 NUM_RINGS = 48;
+        constexpr UINT32 NUM_SIDES = 24;
+        constexpr UINT32 NUM_SUB_MESHES = 3;
+
+        MeshData mesh;
+        for (UINT32 i = 0; i < NUM_RINGS; i++)
+        {
+            const float ringAngle = i * Math::TWO_PI / NUM_RINGS;
+
+            for (UINT32 j = 0; j < NUM_SIDES; j++)
+            {
+                const float sideAngle = j * Math::TWO_PI / NUM_SIDES;
+                const float radius = 1.0f + 0.3f * std::cos(sideAngle);
+
+                mesh.Positions.push_back(Vector3(radius * std::cos(ringAngle), radius * std::sin(ringAngle),
+                    0.3f * std::sin(sideAngle)));
+            }
+        }
+
+        for (UINT32 i = 0; i < NUM_SUB_MESHES; i++)
+        {
+            SubMesh subMesh;
+            subMesh.IndexOffset = (UINT32)mesh.Indices.size();
+
+            for (UINT32 ring = i * NUM_RINGS / NUM_SUB_MESHES; ring < (i + 1) * NUM_RINGS / NUM_SUB_MESHES; ring++)
+            {
+                for (UINT32 side = 0; side < NUM_SIDES; side++)
+                {
+                    const UINT32 nextRing = (ring + 1) % NUM_RINGS;
+                    const UINT32 nextSide = (side + 1) % NUM_SIDES;
+
+                    const UINT32 a = ring * NUM_SIDES + side;
+                    const UINT32 b = nextRing * NUM_SIDES + side;
+                    const UINT32 c = nextRing * NUM_SIDES + nextSide;
+                    const UINT32 d = ring * NUM_SIDES + nextSide;
+
+                    mesh.Indices.insert(mesh.Indices.end(), { a, b, c, a, c, d });
+                }
+            }
+
+            subMesh.IndexCount = (UINT32)mesh.Indices.size() - subMesh.IndexOffset;
+            mesh.SubMeshes.push_back(subMesh);
+        }
+
+        MeshSimplifier::GenerateLods(mesh, { 0.5f, 0.25f });
+
+        bool closed = CountOpenEdges(mesh.Indices) == 0;
+        for (auto& lod : mesh.Lods)
+        {
+            const UINT32 numOpenEdges = CountOpenEdges(lod.Indices);
+            printf("%-28s %10u triangles %8u open edges\n", "Torus LOD", (UINT32)lod.Indices.size() / 3, numOpenEdges);
+
+            closed &= numOpenEdges == 0;
+        }
+
+        return closed;
+    }
+
+    void LoadImporterPlugin(const String& name)
+    {
+        DynLib* library = gDynLibManager().Load(name);
+        if (library == nullptr)
+            return;
+
+        typedef void* (*LoadPluginFunc)();
+
+        LoadPluginFunc loadPluginFunc = (LoadPluginFunc)library->GetSymbol("LoadPlugin");
+        if (loadPluginFunc != nullptr)
+            loadPluginFunc();
+    }
+
+    void PrintResult(const char* name, size_t size, UINT64 microseconds)
+    {
+        const double megabytes = size / (1024.0 * 1024.0);
+        const double seconds = std::max(microseconds, (UINT64)1) / 1000000.0;
+
+        printf("%-28s %10.2f MB %10.2f ms %10.2f MB/s\n", name, megabytes, microseconds / 1000.0, megabytes / seconds);
+    }
+
+    /** Imports the file a few times and prints the best time. No cache folder is set, every run runs the importer. */
+    bool RunImport(const char* name, const String& path, size_t fileSize, const SPtr<const ImportOptions>& options)
+    {
+        SPtr<ImportResult> result;
+        UINT64 bestTime = std::numeric_limits<UINT64>::max();
+        Timer timer;
+
+        for (UINT32 i = 0; i < NUM_RUNS; i++)
+        {
+            timer.Reset();
+            result = gImporter().Import(path, options);
+            bestTime = std::min(bestTime, timer.GetMicroseconds());
+        }
+
+        MeshData mesh;
+        BinaryReader reader(result->Data.data(), result->Data.size());
+        reader.Read(mesh);
+
+        if (!result->Succeeded || reader.HasFailed())
+        {
+            printf("Failed to import %s.\n", path.c_str());
+            return false;
+        }
+
+        PrintResult(name, fileSize, bestTime);
+        printf("%28s %10u vertices %10u triangles %8u meshlets %6.3f ACMR\n", "", mesh.GetNumVertices(),
+            mesh.GetNumTriangles(), (UINT32)mesh.Meshlets.size(), MeshOptimizer::GetCacheMissRatio(mesh));
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace te;
+
+    String path;
+    if (argc > 1)
+        path = argv[1];
+    else
+    {
+        path = "ObjImportBenchmark.obj";
+        CreateGridFile(path, 1024);
+    }
+
+    const size_t fileSize = (size_t)FileSystem::GetFileSize(path);
+
+    Time::StartUp();
+    ThreadPool::StartUp(TE_THREAD_HARDWARE_CONCURRENCY, TE_THREAD_HARDWARE_CONCURRENCY * 2 + 8);
+    DynLibManager::StartUp();
+    TaskScheduler::StartUp();
+    Importer::StartUp();
+
+    LoadImporterPlugin("TeObjectImporter");
+
+    int retVal = 0;
+    if (!CheckSubMeshBoundaries())
+    {
+        printf("Sub-meshes of a LOD moved apart.\n");
+        retVal = 1;
+    }
+
+    if (!gImporter().SupportsFileType("obj"))
+    {
+        printf("No importer is registered for OBJ files.\n");
+        retVal = 1;
+    }
+    else
+    {
+        SPtr<MeshImportOptions> optimizeOptions = te_shared_ptr_new<MeshImportOptions>();
+        optimizeOptions->Optimize = true;
+        optimizeOptions->GenerateMeshlets = true;
+        optimizeOptions->QuantizeAttributes = true;
+
+        if (!RunImport("ObjectImporter", path, fileSize, nullptr) ||
+            !RunImport("ObjectImporter (optimized)", path, fileSize, optimizeOptions))
+        {
+            retVal = 1;
+        }
+
+#if defined(TE_BENCHMARK_ASSIMP)
+        UINT64 bestTime = std::numeric_limits<UINT64>::max();
+        UINT32 numVertices = 0;
+        Timer timer;
+
+        for (UINT32 i = 0; i < NUM_RUNS; i++)
+        {
+            Assimp::Importer importer;
+
+            timer.Reset();
+            const aiScene* scene = importer.ReadFile(path.c_str(),
+                aiProcess_Triangulate | aiProcess_JoinIdenticalVertices);
+            bestTime = std::min(bestTime, timer.GetMicroseconds());
+
+            numVertices = 0;
+            if (scene != nullptr)
+            {
+                for (UINT32 j = 0; j < scene->mNumMeshes; j++)
+                    numVertices += scene->mMeshes[j]->mNumVertices;
+            }
+        }
+
+        PrintResult("assimp", fileSize, bestTime);
+        printf("%28s %10u vertices\n", "", numVertices);
+#endif
+    }
+
+    Importer::ShutDown();
+    TaskScheduler::ShutDown();
+    DynLibManager::ShutDown();
+    ThreadPool::ShutDown();
+    Time::ShutDown();
+
+    return retVal;
+}
\ No newline at end of file
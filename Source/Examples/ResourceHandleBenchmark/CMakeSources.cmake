@@ -0,0 +1,13 @@
+set (TE_RESOURCEHANDLEBENCHMARK_INC_NOFILTER
+)
+
+set (TE_RESOURCEHANDLEBENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_RESOURCEHANDLEBENCHMARK_SRC_NOFILTER} ${TE_RESOURCEHANDLEBENCHMARK_INC_NOFILTER})
+
+set (TE_RESOURCEHANDLEBENCHMARK_SRC
+    ${TE_RESOURCEHANDLEBENCHMARK_INC_NOFILTER}
+    ${TE_RESOURCEHANDLEBENCHMARK_SRC_NOFILTER}
+)
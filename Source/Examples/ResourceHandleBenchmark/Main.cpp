@@ -0,0 +1,237 @@
+#include "TeCorePrerequisites.h"
+#include "Resources/TeResource.h"
+#include "Resources/TeResourceDecoder.h"
+#include "Resources/TeResourceManager.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Threading/TeThreadPool.h"
+#include "Utility/TeTimer.h"
+
+#include <cstdio>
+#include <fstream>
+
+/**
+ * Measures the cost of passing resource handles around by value, as render queues do: every frame a queue of draw
+ * commands is filled with copies of material handles, sorted, read and cleared. Compares owning handles, borrowed
+ * handles, and a copy of the previous handle design (handle data held by a shared pointer, with its own reference
+ * count on top of it). Handles are also copied from multiple threads at once, since contended reference counts are
+ * where atomics cost the most.
+ */
+
+namespace te
+{
+    /** Stands for a material, only holding a value read by the draws. */
+    class BenchmarkResource : public Resource
+    {
+    public:
+        UINT32 Value = 1;
+    };
+
+    class BenchmarkDecoder : public ResourceDecoder
+    {
+    public:
+        SPtr<Resource> Decode(const String& filePath, const Vector<UINT8>& data, ResourceLoadFlag loadFlags) override
+        {
+            SPtr<BenchmarkResource> resource = te_shared_ptr_new<BenchmarkResource>();
+            resource->Value = data.empty() ? 1 : data[0];
+
+            return resource;
+        }
+    };
+
+    /** Handle as implemented before handle data became pooled and intrusively reference counted. */
+    class LegacyHandle
+    {
+    public:
+        struct Data
+        {
+            SPtr<Resource> Ptr;
+            std::atomic<UINT32> RefCount{0};
+        };
+
+        LegacyHandle() = default;
+
+        explicit LegacyHandle(const SPtr<Resource>& resource)
+            : _data(te_shared_ptr_new<Data>())
+        {
+            _data->Ptr = resource;
+            _data->RefCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        LegacyHandle(const LegacyHandle& other)
+            : _data(other._data)
+        {
+            if (_data)
+                _data->RefCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        LegacyHandle(LegacyHandle&& other) = default;
+
+        ~LegacyHandle()
+        {
+            if (_data && _data->RefCount.fetch_sub(1, std::memory_order_release) == 1)
+                std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        LegacyHandle& operator=(LegacyHandle&& other)
+        {
+            if (this == &other)
+                return *this;
+
+            if (_data)
+                _data->RefCount.fetch_sub(1, std::memory_order_release);
+
+            _data = std::exchange(other._data, nullptr);
+            return *this;
+        }
+
+        BenchmarkResource* operator->() const { return static_cast<BenchmarkResource*>(_data->Ptr.get()); }
+
+    private:
+        SPtr<Data> _data;
+    };
+
+    template <typename H>
+    struct DrawCommand
+    {
+        H Material;
+        UINT32 SortKey;
+    };
+
+    constexpr UINT32 NUM_MATERIALS = 64;
+    constexpr UINT32 NUM_DRAWS = 100000;
+    constexpr UINT32 NUM_FRAMES = 20;
+
+    /** Sum of read values, printed so the compiler can't skip the work. */
+    UINT64 gChecksum = 0;
+
+    void PrintResult(const char* handle, const char* test, UINT64 microseconds, UINT64 operations)
+    {
+        printf("    %-10s %-18s %8.2f ns/draw\n", handle, test, microseconds * 1000.0 / operations);
+    }
+
+    /** Fills, sorts and reads a render queue every frame. */
+    template <typename H>
+    void RunQueueBenchmark(const char* name, const Vector<H>& materials)
+    {
+        Vector<DrawCommand<H>> queue;
+        queue.reserve(NUM_DRAWS);
+
+        Timer timer;
+        for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+        {
+            for (UINT32 i = 0; i < NUM_DRAWS; i++)
+            {
+                const UINT32 material = (i * 7 + frame) % NUM_MATERIALS;
+                queue.push_back({ materials[material], (i * 2654435761U) >> 8 });
+            }
+
+            std::sort(queue.begin(), queue.end(),
+                [](const DrawCommand<H>& a, const DrawCommand<H>& b) { return a.SortKey < b.SortKey; });
+
+            for (auto& command : queue)
+                gChecksum += command.Material->Value;
+
+            queue.clear();
+        }
+
+        PrintResult(name, "render queue", timer.GetMicroseconds(), (UINT64)NUM_DRAWS * NUM_FRAMES);
+    }
+
+    /** Copies the same few handles from all worker threads at once. */
+    template <typename H>
+    void RunParallelBenchmark(const char* name, const Vector<H>& materials)
+    {
+        const UINT32 numTasks = std::max(gTaskScheduler().getNumWorkers(), 1U);
+        Vector<UINT64> checksums(numTasks, 0);
+
+        auto copyTask = [&materials, &checksums](UINT32 task)
+        {
+            Vector<H> copies;
+            copies.reserve(NUM_DRAWS);
+
+            for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+            {
+                for (UINT32 i = 0; i < NUM_DRAWS; i++)
+                    copies.push_back(materials[i % 4]);
+
+                for (auto& copy : copies)
+                    checksums[task] += copy->Value;
+
+                copies.clear();
+            }
+        };
+
+        Timer timer;
+
+        Vector<SPtr<Task>> tasks;
+        for (UINT32 i = 1; i < numTasks; i++)
+        {
+            tasks.push_back(Task::Create("HandleCopy", [&copyTask, i]() { copyTask(i); }));
+            gTaskScheduler().AddTask(tasks.back());
+        }
+
+        copyTask(0);
+
+        for (auto& task : tasks)
+            task->Wait();
+
+        PrintResult(name, "parallel copies", timer.GetMicroseconds(), (UINT64)NUM_DRAWS * NUM_FRAMES * numTasks);
+
+        for (auto& checksum : checksums)
+            gChecksum += checksum;
+    }
+}
+
+int main()
+{
+    using namespace te;
+
+    ThreadPool::StartUp(TE_THREAD_HARDWARE_CONCURRENCY, TE_THREAD_HARDWARE_CONCURRENCY * 2 + 8);
+    TaskScheduler::StartUp();
+    ResourceManager::StartUp();
+
+    gResourceManager().RegisterDecoder(".bench", te_shared_ptr_new<BenchmarkDecoder>());
+
+    Vector<String> paths;
+    Vector<ResourceHandle<BenchmarkResource>> materials;
+    for (UINT32 i = 0; i < NUM_MATERIALS; i++)
+    {
+        paths.push_back("ResourceHandleBenchmark_" + ToString(i) + ".bench");
+
+        std::ofstream file(paths.back().c_str(), std::ios::binary);
+        file.put((char)(i + 1));
+        file.close();
+
+        materials.push_back(static_resource_cast<BenchmarkResource>(gResourceManager().Load(paths.back())));
+    }
+
+    Vector<BorrowedResourceHandle<BenchmarkResource>> borrowed(materials.begin(), materials.end());
+
+    Vector<LegacyHandle> legacy;
+    for (auto& material : materials)
+        legacy.push_back(LegacyHandle(material.GetInternalPtr()));
+
+    printf("%u draws, %u materials, %u workers\n", NUM_DRAWS, NUM_MATERIALS, gTaskScheduler().getNumWorkers());
+
+    RunQueueBenchmark("Legacy", legacy);
+    RunQueueBenchmark("Handle", materials);
+    RunQueueBenchmark("Borrowed", borrowed);
+
+    RunParallelBenchmark("Legacy", legacy);
+    RunParallelBenchmark("Handle", materials);
+    RunParallelBenchmark("Borrowed", borrowed);
+
+    legacy.clear();
+    borrowed.clear();
+    materials.clear();
+
+    ResourceManager::ShutDown();
+    TaskScheduler::ShutDown();
+    ThreadPool::ShutDown();
+
+    for (auto& path : paths)
+        std::remove(path.c_str());
+
+    printf("Checksum: %llu\n", (unsigned long long)gChecksum);
+    return 0;
+}
\ No newline at end of file
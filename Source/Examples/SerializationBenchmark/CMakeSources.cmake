@@ -0,0 +1,13 @@
+set (TE_SERIALIZATIONBENCHMARK_INC_NOFILTER
+)
+
+set (TE_SERIALIZATIONBENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_SERIALIZATIONBENCHMARK_SRC_NOFILTER} ${TE_SERIALIZATIONBENCHMARK_INC_NOFILTER})
+
+set (TE_SERIALIZATIONBENCHMARK_SRC
+    ${TE_SERIALIZATIONBENCHMARK_INC_NOFILTER}
+    ${TE_SERIALIZATIONBENCHMARK_SRC_NOFILTER}
+)
@@ -0,0 +1,289 @@
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Serialization/TeBinarySerializer.h"
+#include "Utility/TeTimer.h"
+#include "ThirdParty/Json/json.h"
+
+#include <cstdio>
+
+/**
+ * Compares the binary serializer against JSON on a large scene file. The scene is a flat list of nodes with a
+ * transform, a mesh reference and a list of children, followed by the vertex data of the meshes.
+ */
+
+namespace te
+{
+    struct SceneNode
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+        String Name;
+        Vector3 Position;
+        Quaternion Rotation;
+        Vector3 Scale;
+        UUID Mesh;
+        Vector<UINT32> Children;
+
+        template<class Archive>
+        void Serialize(Archive& archive, UINT32 version)
+        {
+            archive.Field(Name);
+            archive.Field(Position);
+            archive.Field(Rotation);
+            archive.Field(Scale);
+            archive.Field(Mesh);
+            archive.Field(Children);
+        }
+    };
+
+    struct SceneMesh
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+        UUID Id;
+        Vector<Vector3> Positions;
+        Vector<Vector3> Normals;
+        Vector<UINT32> Indices;
+
+        template<class Archive>
+        void Serialize(Archive& archive, UINT32 version)
+        {
+            archive.Field(Id);
+            archive.Field(Positions);
+            archive.Field(Normals);
+            archive.Field(Indices);
+        }
+    };
+
+    struct Scene
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+        Vector<SceneNode> Nodes;
+        Vector<SceneMesh> Meshes;
+
+        template<class Archive>
+        void Serialize(Archive& archive, UINT32 version)
+        {
+            archive.Field(Nodes);
+            archive.Field(Meshes);
+        }
+    };
+
+    /** Same as SceneMesh, but the vertex data is referenced in place from the serialized buffer. */
+    struct SceneMeshView
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+        UUID Id;
+        ArrayView<Vector3> Positions;
+        ArrayView<Vector3> Normals;
+        ArrayView<UINT32> Indices;
+
+        void Serialize(BinaryReader& reader, UINT32 version)
+        {
+            reader.Field(Id);
+            Positions = reader.ReadArrayView<Vector3>();
+            Normals = reader.ReadArrayView<Vector3>();
+            Indices = reader.ReadArrayView<UINT32>();
+        }
+    };
+
+    /** Scene read with SceneMeshView instead of SceneMesh. */
+    struct SceneView
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+        Vector<SceneNode> Nodes;
+        Vector<SceneMeshView> Meshes;
+
+        void Serialize(BinaryReader& reader, UINT32 version)
+        {
+            reader.Field(Nodes);
+            reader.Field(Meshes);
+        }
+    };
+
+    Scene CreateScene(UINT32 numNodes, UINT32 numMeshes, UINT32 numVertices)
+    {
+        Scene scene;
+
+        for (UINT32 i = 0; i < numMeshes; i++)
+        {
+            SceneMesh mesh;
+            mesh.Id = UUIDGenerator::GenerateRandom();
+
+            for (UINT32 j = 0; j < numVertices; j++)
+            {
+                mesh.Positions.push_back(Vector3((float)j, (float)(j * 2), (float)(j * 3)));
+                mesh.Normals.push_back(Vector3(0.0f, 1.0f, 0.0f));
+                mesh.Indices.push_back(j);
+            }
+
+            scene.Meshes.push_back(std::move(mesh));
+        }
+
+        scene.Nodes.resize(numNodes);
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            SceneNode& node = scene.Nodes[i];
+            node.Name = "Node_" + ToString(i);
+            node.Position = Vector3((float)i, 0.5f, -(float)i);
+            node.Rotation = Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+            node.Scale = Vector3(1.0f, 1.0f, 1.0f);
+            node.Mesh = scene.Meshes[i % numMeshes].Id;
+
+            if (i > 0)
+                scene.Nodes[(i - 1) / 4].Children.push_back(i);
+        }
+
+        return scene;
+    }
+
+    nlohmann::json ToJson(const Vector3& value)
+    {
+        return { value.x, value.y, value.z };
+    }
+
+    Vector3 Vector3FromJson(const nlohmann::json& value)
+    {
+        return Vector3(value[0].get<float>(), value[1].get<float>(), value[2].get<float>());
+    }
+
+    nlohmann::json ToJson(const Scene& scene)
+    {
+        nlohmann::json json;
+        nlohmann::json& nodes = json["nodes"];
+        nlohmann::json& meshes = json["meshes"];
+
+        for (auto& node : scene.Nodes)
+        {
+            nlohmann::json entry;
+            entry["name"] = node.Name;
+            entry["position"] = ToJson(node.Position);
+            entry["rotation"] = { node.Rotation.x, node.Rotation.y, node.Rotation.z, node.Rotation.w };
+            entry["scale"] = ToJson(node.Scale);
+            entry["mesh"] = node.Mesh.ToString();
+            entry["children"] = node.Children;
+
+            nodes.push_back(std::move(entry));
+        }
+
+        for (auto& mesh : scene.Meshes)
+        {
+            nlohmann::json entry;
+            entry["id"] = mesh.Id.ToString();
+
+            nlohmann::json& positions = entry["positions"];
+            for (auto& position : mesh.Positions)
+                positions.push_back(ToJson(position));
+
+            nlohmann::json& normals = entry["normals"];
+            for (auto& normal : mesh.Normals)
+                normals.push_back(ToJson(normal));
+
+            entry["indices"] = mesh.Indices;
+            meshes.push_back(std::move(entry));
+        }
+
+        return json;
+    }
+
+    Scene SceneFromJson(const nlohmann::json& json)
+    {
+        Scene scene;
+
+        for (auto& entry : json["nodes"])
+        {
+            SceneNode node;
+            node.Name = entry["name"].get<String>();
+            node.Position = Vector3FromJson(entry["position"]);
+
+            const nlohmann::json& rotation = entry["rotation"];
+            node.Rotation = Quaternion(rotation[0].get<float>(), rotation[1].get<float>(), rotation[2].get<float>(),
+                rotation[3].get<float>());
+
+            node.Scale = Vector3FromJson(entry["scale"]);
+            node.Mesh = UUID(entry["mesh"].get<String>());
+            node.Children = entry["children"].get<Vector<UINT32>>();
+
+            scene.Nodes.push_back(std::move(node));
+        }
+
+        for (auto& entry : json["meshes"])
+        {
+            SceneMesh mesh;
+            mesh.Id = UUID(entry["id"].get<String>());
+
+            for (auto& position : entry["positions"])
+                mesh.Positions.push_back(Vector3FromJson(position));
+
+            for (auto& normal : entry["normals"])
+                mesh.Normals.push_back(Vector3FromJson(normal));
+
+            mesh.Indices = entry["indices"].get<Vector<UINT32>>();
+            scene.Meshes.push_back(std::move(mesh));
+        }
+
+        return scene;
+    }
+
+    void PrintResult(const char* name, size_t size, UINT64 microseconds)
+    {
+        const double megabytes = size / (1024.0 * 1024.0);
+        const double seconds = std::max(microseconds, (UINT64)1) / 1000000.0;
+
+        printf("%-24s %10.2f MB %10.2f ms %10.2f MB/s\n", name, megabytes, microseconds / 1000.0, megabytes / seconds);
+    }
+}
+
+int main()
+{
+    using namespace te;
+
+    const Scene scene = CreateScene(100000, 64, 16384);
+    Timer timer;
+
+    // JSON
+    timer.Reset();
+    std::string jsonText = ToJson(scene).dump();
+    PrintResult("JSON write", jsonText.size(), timer.GetMicroseconds());
+
+    timer.Reset();
+    Scene jsonScene = SceneFromJson(nlohmann::json::parse(jsonText));
+    PrintResult("JSON read", jsonText.size(), timer.GetMicroseconds());
+
+    // Binary
+    timer.Reset();
+    BinaryWriter writer;
+    writer.Write(scene);
+    PrintResult("Binary write", writer.GetSize(), timer.GetMicroseconds());
+
+    const Vector<UINT8>& data = writer.GetData();
+
+    timer.Reset();
+    Scene binaryScene;
+    BinaryReader reader(data.data(), data.size());
+    reader.Read(binaryScene);
+    PrintResult("Binary read", data.size(), timer.GetMicroseconds());
+
+    // Binary, with mesh data referenced in place
+    timer.Reset();
+    SceneView sceneView;
+    BinaryReader viewReader(data.data(), data.size());
+    viewReader.Read(sceneView);
+
+    PrintResult("Binary read (in place)", data.size(), timer.GetMicroseconds());
+
+    const bool valid = !reader.HasFailed() && !viewReader.HasFailed() &&
+        binaryScene.Nodes.size() == scene.Nodes.size() && jsonScene.Nodes.size() == scene.Nodes.size() &&
+        binaryScene.Meshes.back().Positions == scene.Meshes.back().Positions &&
+        sceneView.Meshes.back().Positions.Size == scene.Meshes.back().Positions.size();
+
+    if (!valid)
+    {
+        printf("Deserialized scene doesn't match the source scene.\n");
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -2,6 +2,16 @@
 
  namespace te
  {
+    UPDATE_DESC Audio::GetUpdateDesc() const
+    {
+        UPDATE_DESC desc;
+        desc.Name = "Audio";
+        desc.Phase = UpdatePhase::Update;
+        desc.Writes = { "Audio" };
+
+        return desc;
+    }
+
     TE_CORE_EXPORT Audio& gAudio()
     {
         return Audio::Instance();
@@ -2,6 +2,7 @@
 
 #include "TeCorePrerequisites.h"
 #include "Utility/TeModule.h"
+#include "Scheduler/TeUpdateScheduler.h"
 
 namespace te
 {
@@ -10,6 +11,12 @@ namespace te
     public:
         virtual ~Audio() = default;
         virtual void Update() = 0;
+
+        /**
+         * Returns when the audio update runs and what data it accesses, see UpdateScheduler. Implementations
+         * that read or write data shared with other modules should extend the returned description.
+         */
+        virtual UPDATE_DESC GetUpdateDesc() const;
     };
 
     /** Provides easier access to Audio. */
@@ -18,6 +18,33 @@ set (TE_CORE_SRC_RENDERER
     "Core/Renderer/TeRenderer.cpp"
 )
 
+set (TE_CORE_INC_CORETHREAD
+    "Core/CoreThread/TeCoreThread.h"
+)
+set (TE_CORE_SRC_CORETHREAD
+    "Core/CoreThread/TeCoreThread.cpp"
+)
+
+set (TE_CORE_INC_SCHEDULER
+    "Core/Scheduler/TeUpdateScheduler.h"
+)
+set (TE_CORE_SRC_SCHEDULER
+    "Core/Scheduler/TeUpdateScheduler.cpp"
+)
+
+set (TE_CORE_INC_SCENE
+    "Core/Scene/TeEntity.h"
+    "Core/Scene/TeWorld.h"
+    "Core/Scene/TeTransformHierarchy.h"
+    "Core/Scene/TeSceneManager.h"
+)
+set (TE_CORE_SRC_SCENE
+    "Core/Scene/TeEntity.cpp"
+    "Core/Scene/TeWorld.cpp"
+    "Core/Scene/TeTransformHierarchy.cpp"
+    "Core/Scene/TeSceneManager.cpp"
+)
+
 set(TE_CORE_INC_PLATFORM
     "Core/Platform/TePlatform.h"
 )
@@ -123,6 +150,7 @@ set (TE_CORE_INC_RESOURCES
     "Core/Resources/TeResourceManager.h"
     "Core/Resources/TeResourceHandle.h"
     "Core/Resources/TeResourceMetaData.h"
+    "Core/Resources/TeResourceDecoder.h"
 )
 set (TE_CORE_SRC_RESOURCES
     "Core/Resources/TeResource.cpp"
@@ -144,12 +172,24 @@ set (TE_CORE_INC_IMPORTER
     "Core/Importer/TeImportOptions.h"
     "Core/Importer/TeTextureImportOptions.cpp"
     "Core/Importer/TeBaseImporter.cpp"
+    "Core/Importer/TeMeshImportOptions.h"
 )
 set (TE_CORE_SRC_IMPORTER
     "Core/Importer/TeImporter.cpp"
     "Core/Importer/TeImportOptions.h"
     "Core/Importer/TeTextureImportOptions.h"
     "Core/Importer/TeBaseImporter.h"
+    "Core/Importer/TeMeshImportOptions.cpp"
+)
+
+set (TE_CORE_INC_MESH
+    "Core/Mesh/TeMeshData.h"
+    "Core/Mesh/TeMeshOptimizer.h"
+    "Core/Mesh/TeMeshSimplifier.h"
+)
+set (TE_CORE_SRC_MESH
+    "Core/Mesh/TeMeshOptimizer.cpp"
+    "Core/Mesh/TeMeshSimplifier.cpp"
 )
 
 set (TE_CORE_INC_IMAGE
@@ -175,6 +215,9 @@ list(APPEND TE_CORE_SRC_PLATFORM ${TE_CORE_SRC_PLATFORM})
 
 source_group("Core\\RenderAPI" FILES ${TE_CORE_INC_RENDERAPI} ${TE_CORE_SRC_RENDERAPI})
 source_group("Core\\Renderer" FILES ${TE_CORE_INC_RENDERER} ${TE_CORE_SRC_RENDERER})
+source_group("Core\\CoreThread" FILES ${TE_CORE_INC_CORETHREAD} ${TE_CORE_SRC_CORETHREAD})
+source_group("Core\\Scheduler" FILES ${TE_CORE_INC_SCHEDULER} ${TE_CORE_SRC_SCHEDULER})
+source_group("Core\\Scene" FILES ${TE_CORE_INC_SCENE} ${TE_CORE_SRC_SCENE})
 source_group("Core\\Platform" FILES ${TE_CORE_INC_PLATFORM} ${TE_CORE_SRC_PLATFORM})
 source_group("Core\\Audio" FILES ${TE_CORE_INC_AUDIO} ${TE_CORE_SRC_AUDIO})
 source_group("Core\\Physics" FILES ${TE_CORE_INC_PHYSICS} ${TE_CORE_SRC_PHYSICS})
@@ -183,6 +226,7 @@ source_group("Core\\Manager" FILES ${TE_CORE_INC_MANAGER} ${TE_CORE_SRC_MANAGER}
 source_group("Core\\Resources" FILES ${TE_CORE_INC_RESOURCES} ${TE_CORE_SRC_RESOURCES})
 source_group("Core\\Text" FILES ${TE_CORE_INC_TEXT} ${TE_CORE_SRC_TEXT})
 source_group("Core\\Importer" FILES ${TE_CORE_INC_IMPORTER} ${TE_CORE_SRC_IMPORTER})
+source_group("Core\\Mesh" FILES ${TE_CORE_INC_MESH} ${TE_CORE_SRC_MESH})
 source_group("Core\\Image" FILES ${TE_CORE_INC_IMAGE} ${TE_CORE_SRC_IMAGE})
 source_group("Core" FILES ${TE_CORE_INC_NOFILTER} ${TE_CORE_SRC_NOFILTER})
 
@@ -191,6 +235,12 @@ set(TE_CORE_SRC
     ${TE_CORE_INC_RENDERAPI}
     ${TE_CORE_SRC_RENDERER}
     ${TE_CORE_INC_RENDERER}
+    ${TE_CORE_SRC_CORETHREAD}
+    ${TE_CORE_INC_CORETHREAD}
+    ${TE_CORE_SRC_SCHEDULER}
+    ${TE_CORE_INC_SCHEDULER}
+    ${TE_CORE_SRC_SCENE}
+    ${TE_CORE_INC_SCENE}
     ${TE_CORE_SRC_PLATFORM}
     ${TE_CORE_INC_PLATFORM}
     ${TE_CORE_SRC_NOFILTER}
@@ -205,6 +255,8 @@ set(TE_CORE_SRC
     ${TE_CORE_SRC_MANAGER}
     ${TE_CORE_INC_IMPORTER}
     ${TE_CORE_SRC_IMPORTER}
+    ${TE_CORE_INC_MESH}
+    ${TE_CORE_SRC_MESH}
     ${TE_CORE_INC_RESOURCES}
     ${TE_CORE_SRC_RESOURCES}
 )
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "CoreThread/TeCoreThread.h"
+#include "Utility/TeTime.h"
+
+namespace te
+{
+    CoreThread::CoreThread(UINT32 frameLatency, RenderFunc renderFunc)
+        : _frameLatency(std::min(frameLatency, MAX_FRAME_LATENCY))
+        , _renderFunc(std::move(renderFunc))
+        , _threadId(TE_THREAD_CURRENT_ID)
+    { }
+
+    void CoreThread::OnStartUp()
+    {
+        if (!IsPipelined())
+            return;
+
+        Lock lock(_mutex);
+        _thread = ThreadPool::Instance().Run("Core", std::bind(&CoreThread::RunMain, this));
+
+        // Make sure IsCoreThread() returns the right value as soon as start-up completes
+        while (_threadId == TE_THREAD_CURRENT_ID)
+            _frameRenderedCond.wait(lock);
+    }
+
+    void CoreThread::OnShutDown()
+    {
+        if (!IsPipelined())
+            return;
+
+        Flush();
+
+        {
+            Lock lock(_mutex);
+            _shutdown = true;
+        }
+
+        _frameSubmittedCond.notify_one();
+        _thread.BlockUntilComplete();
+    }
+
+    void CoreThread::QueueCommand(std::function<void()> command)
+    {
+        // Slot of the frame currently being built is never read by the core thread, see SubmitFrame()
+        GetSlot(_submittedFrames).Commands.push_back(std::move(command));
+    }
+
+    void CoreThread::SubmitFrame()
+    {
+        FrameSnapshot& frame = GetSlot(_submittedFrames);
+        frame.FrameIdx = gTime().GetFrameIdx();
+        frame.FrameDelta = gTime().GetFrameDelta();
+        frame.FixedUpdateAlpha = gTime().GetFixedUpdateAlpha();
+
+        if (!IsPipelined())
+        {
+            RenderFrame(frame);
+
+            _submittedFrames++;
+            _renderedFrames++;
+            return;
+        }
+
+        Lock lock(_mutex);
+        _submittedFrames++;
+        _frameSubmittedCond.notify_one();
+
+        // Once this returns the slot of the next frame has been consumed by the core thread and can be reused
+        while (_submittedFrames - _renderedFrames > _frameLatency)
+            _frameRenderedCond.wait(lock);
+    }
+
+    void CoreThread::Flush()
+    {
+        Lock lock(_mutex);
+
+        while (_renderedFrames < _submittedFrames)
+            _frameRenderedCond.wait(lock);
+    }
+
+    bool CoreThread::IsCoreThread() const
+    {
+        return _threadId == TE_THREAD_CURRENT_ID;
+    }
+
+    void CoreThread::RunMain()
+    {
+        {
+            Lock lock(_mutex);
+            _threadId = TE_THREAD_CURRENT_ID;
+        }
+
+        _frameRenderedCond.notify_all();
+
+        while (true)
+        {
+            FrameSnapshot* frame = nullptr;
+
+            {
+                Lock lock(_mutex);
+
+                while (_renderedFrames == _submittedFrames && !_shutdown)
+                    _frameSubmittedCond.wait(lock);
+
+                if (_renderedFrames == _submittedFrames)
+                    break;
+
+                frame = &GetSlot(_renderedFrames);
+            }
+
+            RenderFrame(*frame);
+
+            {
+                Lock lock(_mutex);
+                _renderedFrames++;
+            }
+
+            _frameRenderedCond.notify_all();
+        }
+    }
+
+    void CoreThread::RenderFrame(FrameSnapshot& frame)
+    {
+        for (auto& command : frame.Commands)
+            command();
+
+        frame.Commands.clear();
+
+        if (_renderFunc)
+            _renderFunc(frame);
+    }
+
+    CoreThread& gCoreThread()
+    {
+        return CoreThread::Instance();
+    }
+}
\ No newline at end of file
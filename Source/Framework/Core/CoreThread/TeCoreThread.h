@@ -0,0 +1,111 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
+#include "Threading/TeThreadPool.h"
+
+namespace te
+{
+    /**
+     * Everything the render stage needs to know about a frame produced by the simulation. Once submitted the snapshot
+     * is never touched by the sim thread again until the render stage is done with it, so it can be read without locks.
+     */
+    struct FrameSnapshot
+    {
+        UINT64 FrameIdx = 0;
+        float FrameDelta = 0.0f;
+        float FixedUpdateAlpha = 0.0f; /**< See Time::GetFixedUpdateAlpha. Use to interpolate between physics states. */
+
+        /** Commands queued with CoreThread::QueueCommand() during the frame. Executed in order, before rendering. */
+        Vector<std::function<void()>> Commands;
+    };
+
+    /**
+     * Runs the render stage of the main loop on a dedicated thread, so the simulation of frame N+1 can overlap with the
+     * render submission of frame N. The sim thread records state into a FrameSnapshot and submits it, the core thread
+     * consumes submitted snapshots in order.
+     *
+     * Frame latency controls how many frames the simulation is allowed to run ahead of the render stage. A latency of
+     * zero disables the core thread and the render stage is executed inline on the sim thread.
+     */
+    class TE_CORE_EXPORT CoreThread : public Module<CoreThread>
+    {
+    public:
+        typedef std::function<void(const FrameSnapshot&)> RenderFunc;
+
+        /** Max number of frames the simulation can run ahead of the render stage. */
+        static constexpr UINT32 MAX_FRAME_LATENCY = 3;
+
+        /**
+         * @param[in]	frameLatency	Number of frames the simulation can be ahead of the render stage. Clamped to
+         *								MAX_FRAME_LATENCY.
+         * @param[in]	renderFunc		Executed once for every submitted frame, on the core thread.
+         */
+        CoreThread(UINT32 frameLatency, RenderFunc renderFunc);
+        ~CoreThread() = default;
+
+        /**
+         * Queues a command to be executed on the core thread, before the current frame is rendered. Use this to pass
+         * data to the render stage without sharing it with the simulation.
+         *
+         * @note	Sim thread only.
+         */
+        void QueueCommand(std::function<void()> command);
+
+        /**
+         * Publishes the frame being built by the simulation to the render stage and starts a new one. Blocks if the
+         * simulation is more than the allowed frame latency ahead of the render stage.
+         *
+         * @note	Sim thread only.
+         */
+        void SubmitFrame();
+
+        /** Blocks until every submitted frame has been rendered. */
+        void Flush();
+
+        /** Returns the number of frames the simulation is allowed to run ahead of the render stage. */
+        UINT32 GetFrameLatency() const { return _frameLatency; }
+
+        /** Returns true if the render stage runs on its own thread. */
+        bool IsPipelined() const { return _frameLatency > 0; }
+
+        /** Returns true if called from the thread that executes the render stage. */
+        bool IsCoreThread() const;
+
+    protected:
+        /** @copydoc Module::OnStartUp */
+        void OnStartUp() override;
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /** Main method of the core thread. Renders submitted frames until shut down. */
+        void RunMain();
+
+        /** Executes the render stage for the provided frame. */
+        void RenderFrame(FrameSnapshot& frame);
+
+        /** Returns the snapshot slot used by the frame with the provided index. */
+        FrameSnapshot& GetSlot(UINT64 frameIdx) { return _frames[frameIdx % (MAX_FRAME_LATENCY + 1)]; }
+
+    protected:
+        UINT32 _frameLatency;
+        RenderFunc _renderFunc;
+
+        FrameSnapshot _frames[MAX_FRAME_LATENCY + 1];
+        UINT64 _submittedFrames = 0;
+        UINT64 _renderedFrames = 0;
+
+        HThread _thread;
+        ThreadId _threadId;
+        bool _shutdown = false;
+
+        Mutex _mutex;
+        Signal _frameSubmittedCond;
+        Signal _frameRenderedCond;
+    };
+
+    /** Provides easy access to CoreThread. */
+    TE_CORE_EXPORT CoreThread& gCoreThread();
+}
\ No newline at end of file
@@ -1,8 +1,14 @@
 #include "Importer/TeBaseImporter.h"
+#include "Importer/TeImportOptions.h"
 
 namespace te
 {
     BaseImporter::~BaseImporter()
     {
     }
+
+    SPtr<ImportOptions> BaseImporter::CreateImportOptions() const
+    {
+        return te_shared_ptr_new<ImportOptions>();
+    }
 }
\ No newline at end of file
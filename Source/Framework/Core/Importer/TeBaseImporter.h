@@ -10,11 +10,39 @@ namespace te
 	 * 			
 	 * On initialization this class must register itself with the Importer module, which delegates asset import calls to a 
 	 * specific importer.
+	 *
+	 * @note	Importers can be called from multiple threads at once, Import() must not modify the importer.
 	 */
 	class TE_CORE_EXPORT BaseImporter
 	{
 	public:
 		BaseImporter() = default;
         virtual ~BaseImporter() = 0;
+
+        /** Checks if the importer can import files with the provided extension (lowercase, without the leading dot). */
+        virtual bool IsExtensionSupported(StringView extension) const { return false; }
+
+        /**
+         * Version of the import output. Must be increased whenever the output of the importer changes for the same
+         * source file, which invalidates all cached import results of the importer.
+         */
+        virtual UINT32 GetVersion() const { return 0; }
+
+        /** Creates the import options specific to this importer, initialized with the default values. */
+        virtual SPtr<ImportOptions> CreateImportOptions() const;
+
+        /**
+         * Converts the contents of a source file into the engine format.
+         *
+         * @param[in]	filePath	Path of the source file. Only needed for reporting errors, or for formats that refer
+         *							to other files.
+         * @param[in]	data		Contents of the source file.
+         * @param[in]	size		Size of @p data in bytes.
+         * @param[in]	options		Options created by CreateImportOptions().
+         * @param[out]	output		Imported data, which can be turned into a resource by a ResourceDecoder.
+         * @return					True if the import succeeded.
+         */
+        virtual bool Import(const String& filePath, const UINT8* data, size_t size, const ImportOptions& options,
+            Vector<UINT8>& output) const { return false; }
     };
 }
\ No newline at end of file
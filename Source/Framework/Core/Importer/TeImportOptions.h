@@ -12,6 +12,12 @@ namespace te
 	{
 	public:
 		virtual ~ImportOptions() = default;
+
+        /**
+         * Writes all options that affect the result of the import. Written data is hashed to identify cached import
+         * results, so options that don't change the result (e.g. verbosity) don't need to be written.
+         */
+        virtual void Serialize(BinaryWriter& writer) const { }
 	};
 
 	/** @} */
@@ -1,6 +1,413 @@
 #include "Importer/TeImporter.h"
+#include "Importer/TeBaseImporter.h"
+#include "Importer/TeImportOptions.h"
+#include "FileSystem/TeFileSystem.h"
+#include "FileSystem/TeDataStream.h"
+#include "Serialization/TeBinarySerializer.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Utility/TeUUID.h"
+#include "String/TeInlineString.h"
+
+#include <cstdio>
 
 namespace te
 {
-    // TODO
+    namespace
+    {
+        /** Identifies import cache files ("TEIC"). */
+        constexpr UINT32 CACHE_MAGIC = 0x43494554;
+
+        /** Identifies the import manifest ("TEIM"). */
+        constexpr UINT32 MANIFEST_MAGIC = 0x4D494554;
+
+        /** Version of the cache file and manifest formats. */
+        constexpr UINT32 CACHE_VERSION = 2;
+
+        /** Name of the manifest file in the cache folder. */
+        const char* MANIFEST_FILE_NAME = "ImportManifest.bin";
+
+        /** Header of a cached import result, followed by the data itself. */
+        struct CacheHeader
+        {
+            UINT32 Magic;
+            UINT32 Version;
+            UINT64 Key;
+            UINT64 DataSize;
+            UINT64 DataHash;
+        };
+
+        /** Extensions longer than this aren't supported by any importer. */
+        constexpr UINT32 MAX_EXTENSION_LENGTH = 15;
+
+        using Extension = InlineString<MAX_EXTENSION_LENGTH>;
+
+        /** Converts an extension to lowercase. Returns false if it is too long to be supported. */
+        bool ToLowerExtension(StringView extension, Extension& output)
+        {
+            output.Clear();
+            for (char c : extension)
+                output.Append((char)tolower((UINT8)c));
+
+            return !output.IsTruncated();
+        }
+
+        /** Finds the extension of a file in lowercase, without the leading dot. Returns false if there is none. */
+        bool GetExtension(StringView filePath, Extension& output)
+        {
+            const size_t extensionStart = filePath.find_last_of('.');
+            if (extensionStart == StringView::npos || filePath.find_first_of("/\\", extensionStart) != StringView::npos)
+                return false;
+
+            return ToLowerExtension(filePath.substr(extensionStart + 1), output) && !output.Empty();
+        }
+
+        /** Returns the path of the cached import result with the provided key. */
+        String GetCachePath(const String& cacheFolder, UINT64 key)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+
+            return cacheFolder + "/" + name;
+        }
+    }
+
+    Importer::~Importer()
+    {
+        for (auto& importer : _importers)
+            te_delete(importer);
+    }
+
+    void Importer::OnShutDown()
+    {
+        SaveManifest();
+    }
+
+    void Importer::RegisterAssetImporter(BaseImporter* importer)
+    {
+        if (importer == nullptr)
+            return;
+
+        Lock lock(_mutex);
+        _importers.push_back(importer);
+    }
+
+    bool Importer::SupportsFileType(StringView extension) const
+    {
+        Extension lowerExtension;
+        if (!ToLowerExtension(extension, lowerExtension))
+            return false;
+
+        Lock lock(_mutex);
+        for (auto& importer : _importers)
+        {
+            if (importer->IsExtensionSupported(lowerExtension))
+                return true;
+        }
+
+        return false;
+    }
+
+    SPtr<ImportOptions> Importer::CreateImportOptions(StringView filePath) const
+    {
+        BaseImporter* importer = FindImporter(filePath);
+        if (importer == nullptr)
+            return nullptr;
+
+        return importer->CreateImportOptions();
+    }
+
+    void Importer::SetCacheFolder(const String& folder)
+    {
+        SaveManifest();
+
+        Map<String, ManifestEntry> manifest;
+        if (!folder.empty())
+        {
+            if (!FileSystem::CreateFolder(folder))
+            {
+                TE_DEBUG("Unable to create import cache folder: " + folder);
+            }
+
+            FileDataStream stream(folder + "/" + MANIFEST_FILE_NAME, DataStream::READ, 0);
+            if (stream.IsOpen())
+            {
+                Vector<UINT8> data(stream.Size());
+                data.resize(stream.Read(data.data(), data.size()));
+
+                BinaryReader reader(data.data(), data.size());
+
+                UINT32 magic = 0;
+                UINT32 version = 0;
+                reader.Read(magic);
+                reader.Read(version);
+
+                // Stale or corrupted manifests only mean files have to be hashed again
+                if (magic == MANIFEST_MAGIC && version == CACHE_VERSION)
+                    reader.Read(manifest);
+
+                if (reader.HasFailed())
+                    manifest.clear();
+            }
+        }
+
+        Lock lock(_mutex);
+        _cacheFolder = folder;
+        _manifest = std::move(manifest);
+        _isManifestDirty = false;
+    }
+
+    String Importer::GetCacheFolder() const
+    {
+        Lock lock(_mutex);
+        return _cacheFolder;
+    }
+
+    SPtr<ImportResult> Importer::Import(const String& filePath, const SPtr<const ImportOptions>& options)
+    {
+        SPtr<ImportResult> result = te_shared_ptr_new<ImportResult>();
+        result->FilePath = filePath;
+
+        BaseImporter* importer = FindImporter(filePath);
+        if (importer == nullptr)
+        {
+            TE_DEBUG("No importer registered for file: " + filePath);
+            UpdateStats(*result, false);
+            return result;
+        }
+
+        SPtr<const ImportOptions> importOptions = options != nullptr ? options : importer->CreateImportOptions();
+
+        BinaryWriter optionsWriter;
+        importOptions->Serialize(optionsWriter);
+
+        const UINT64 optionsHash = HashBytes(optionsWriter.GetData().data(), optionsWriter.GetSize(),
+            importer->GetVersion());
+
+        ManifestEntry entry;
+        entry.Size = FileSystem::GetFileSize(filePath);
+        entry.ModifiedTime = FileSystem::GetLastModifiedTime(filePath);
+
+        String cacheFolder;
+        bool isUnchanged = false;
+        {
+            Lock lock(_mutex);
+            cacheFolder = _cacheFolder;
+
+            auto iterFind = _manifest.find(filePath);
+            if (iterFind != _manifest.end() && iterFind->second.Size == entry.Size &&
+                iterFind->second.ModifiedTime == entry.ModifiedTime)
+            {
+                entry.SourceHash = iterFind->second.SourceHash;
+                isUnchanged = true;
+            }
+        }
+
+        // Unchanged file whose result is still cached, nothing needs to be read
+        if (isUnchanged && !cacheFolder.empty())
+        {
+            result->Key = HashBytes((const UINT8*)&entry.SourceHash, sizeof(entry.SourceHash), optionsHash);
+            if (ReadCached(cacheFolder, result->Key, result->Data))
+            {
+                result->Succeeded = true;
+                result->FromCache = true;
+
+                UpdateStats(*result, true);
+                return result;
+            }
+        }
+
+        MappedFileDataStream source(filePath, MappedFileDataStream::AccessHint::Sequential);
+        if (!source.IsOpen())
+        {
+            TE_DEBUG("Unable to open file for import: " + filePath);
+            UpdateStats(*result, false);
+            return result;
+        }
+
+        entry.SourceHash = HashBytes(source.GetPtr(), source.Size(), 0);
+        result->Key = HashBytes((const UINT8*)&entry.SourceHash, sizeof(entry.SourceHash), optionsHash);
+
+        // Contents might be the same even though the file was touched, or imported through another path
+        if (!cacheFolder.empty() && ReadCached(cacheFolder, result->Key, result->Data))
+        {
+            result->Succeeded = true;
+            result->FromCache = true;
+        }
+        else
+        {
+            result->Succeeded = importer->Import(filePath, source.GetPtr(), source.Size(), *importOptions, result->Data);
+            if (!result->Succeeded)
+            {
+                TE_DEBUG("Failed to import file: " + filePath);
+                result->Data.clear();
+
+                UpdateStats(*result, false);
+                return result;
+            }
+
+            if (!cacheFolder.empty())
+                WriteCached(cacheFolder, result->Key, result->Data);
+        }
+
+        UpdateManifest(filePath, entry);
+        UpdateStats(*result, false);
+
+        return result;
+    }
+
+    Vector<SPtr<ImportResult>> Importer::Import(const Vector<String>& filePaths,
+        const Vector<SPtr<const ImportOptions>>& options)
+    {
+        Vector<SPtr<ImportResult>> results(filePaths.size());
+        Vector<SPtr<Task>> tasks;
+        tasks.reserve(filePaths.size());
+
+        for (size_t i = 0; i < filePaths.size(); i++)
+        {
+            auto import = [this, &results, &filePaths, &options, i]()
+            {
+                results[i] = Import(filePaths[i], i < options.size() ? options[i] : nullptr);
+            };
+
+            tasks.push_back(Task::Create("Import", import));
+            gTaskScheduler().AddTask(tasks.back());
+        }
+
+        for (auto& task : tasks)
+            task->Wait();
+
+        return results;
+    }
+
+    void Importer::SaveManifest()
+    {
+        BinaryWriter writer;
+        String path;
+        {
+            Lock lock(_mutex);
+            if (!_isManifestDirty || _cacheFolder.empty())
+                return;
+
+            writer.Write(MANIFEST_MAGIC);
+            writer.Write(CACHE_VERSION);
+            writer.Write(_manifest);
+
+            path = _cacheFolder + "/" + MANIFEST_FILE_NAME;
+            _isManifestDirty = false;
+        }
+
+        FileDataStream stream(path, DataStream::WRITE);
+        if (!stream.IsOpen() || stream.Write(writer.GetData().data(), writer.GetSize()) != writer.GetSize())
+        {
+            TE_DEBUG("Unable to write import manifest: " + path);
+        }
+    }
+
+    ImporterStats Importer::GetStats() const
+    {
+        Lock lock(_mutex);
+        return _stats;
+    }
+
+    BaseImporter* Importer::FindImporter(StringView filePath) const
+    {
+        Extension extension;
+        if (!GetExtension(filePath, extension))
+            return nullptr;
+
+        Lock lock(_mutex);
+        for (auto iter = _importers.rbegin(); iter != _importers.rend(); ++iter)
+        {
+            if ((*iter)->IsExtensionSupported(extension))
+                return *iter;
+        }
+
+        return nullptr;
+    }
+
+    bool Importer::ReadCached(const String& cacheFolder, UINT64 key, Vector<UINT8>& data)
+    {
+        FileDataStream stream(GetCachePath(cacheFolder, key), DataStream::READ, 0);
+        if (!stream.IsOpen())
+            return false;
+
+        CacheHeader header;
+        if (stream.Read(&header, sizeof(header)) != sizeof(header))
+            return false;
+
+        if (header.Magic != CACHE_MAGIC || header.Version != CACHE_VERSION || header.Key != key ||
+            header.DataSize != stream.Size() - sizeof(header))
+        {
+            return false;
+        }
+
+        data.resize((size_t)header.DataSize);
+        if (stream.Read(data.data(), data.size()) != data.size() ||
+            HashBytes(data.data(), data.size(), 0) != header.DataHash)
+        {
+            data.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Importer::WriteCached(const String& cacheFolder, UINT64 key, const Vector<UINT8>& data)
+    {
+        CacheHeader header;
+        header.Magic = CACHE_MAGIC;
+        header.Version = CACHE_VERSION;
+        header.Key = key;
+        header.DataSize = data.size();
+        header.DataHash = HashBytes(data.data(), data.size(), 0);
+
+        // Written under a temporary name first, so other threads or processes never see a partially written result
+        const String path = GetCachePath(cacheFolder, key);
+        const String tempPath = path + "." + UUIDGenerator::GenerateRandom().ToString() + ".tmp";
+
+        {
+            FileDataStream stream(tempPath, DataStream::WRITE);
+            if (!stream.IsOpen() || stream.Write(&header, sizeof(header)) != sizeof(header) ||
+                stream.Write(data.data(), data.size()) != data.size())
+            {
+                TE_DEBUG("Unable to write import cache file: " + tempPath);
+                stream.Close();
+
+                remove(tempPath.c_str());
+                return;
+            }
+        }
+
+        // Result with the same key has the same contents, losing the race to another writer is fine
+        if (rename(tempPath.c_str(), path.c_str()) != 0)
+            remove(tempPath.c_str());
+    }
+
+    void Importer::UpdateManifest(const String& filePath, const ManifestEntry& entry)
+    {
+        Lock lock(_mutex);
+        _manifest[filePath] = entry;
+        _isManifestDirty = true;
+    }
+
+    void Importer::UpdateStats(const ImportResult& result, bool unchanged)
+    {
+        Lock lock(_mutex);
+
+        if (!result.Succeeded)
+            _stats.NumFailed++;
+        else if (result.FromCache)
+        {
+            _stats.NumCacheHits++;
+            if (unchanged)
+                _stats.NumUnchanged++;
+        }
+        else
+            _stats.NumImported++;
+    }
+
+    Importer& gImporter()
+    {
+        return Importer::Instance();
+    }
 }
\ No newline at end of file
@@ -2,14 +2,137 @@
 
 #include "TeCorePrerequisites.h"
 #include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
 
 namespace te
 {
-    /** Module responsible for importing various asset types and converting them to types usable by the engine. */
+    /** Result of importing a single source file. */
+    struct ImportResult
+    {
+        String FilePath;
+        Vector<UINT8> Data; /**< Imported data, in the format produced by the importer. */
+        UINT64 Key = 0; /**< Hash of the source contents, import options and importer version. */
+        bool Succeeded = false;
+        bool FromCache = false; /**< True if the data was found in the import cache and no importer ran. */
+    };
+
+    /** Statistics of the imports performed by the Importer. */
+    struct ImporterStats
+    {
+        UINT64 NumImported = 0; /**< Imports that ran an importer. */
+        UINT64 NumCacheHits = 0;
+        UINT64 NumUnchanged = 0; /**< Cache hits that didn't need to read the source file, included in NumCacheHits. */
+        UINT64 NumFailed = 0;
+    };
+
+    /**
+     * Module responsible for importing various asset types and converting them to types usable by the engine.
+     *
+     * Import results are cached by a hash of the source file contents, the import options and the importer version, so
+     * reimporting an unchanged asset returns the previous result without running the importer. The size and modification
+     * time of every imported file are kept in a manifest, unchanged files don't even need to be read to find their hash.
+     * Both the results and the manifest are persisted in the cache folder, if one is set.
+     */
 	class TE_CORE_EXPORT Importer : public Module<Importer>
 	{
 	public:
 		Importer() = default; 
-		~Importer() = default; 
+		~Importer();
+
+        /** Registers a new importer and takes ownership of it. Importers registered later take precedence. */
+        void RegisterAssetImporter(BaseImporter* importer);
+
+        /** Checks if files with the provided extension (without the leading dot, in any case) can be imported. */
+        bool SupportsFileType(StringView extension) const;
+
+        /** Creates import options for the importer of the provided file. Returns null if no importer supports it. */
+        SPtr<ImportOptions> CreateImportOptions(StringView filePath) const;
+
+        /**
+         * Sets the folder import results and the manifest are stored in, and loads the manifest stored in it. Folder is
+         * created if it doesn't exist. An empty path disables the persistent cache.
+         */
+        void SetCacheFolder(const String& folder);
+
+        /** Returns the folder set through SetCacheFolder(). */
+        String GetCacheFolder() const;
+
+        /**
+         * Imports a file, or returns its cached import result.
+         *
+         * @param[in]	filePath	Path of the file to import.
+         * @param[in]	options		Options created through CreateImportOptions() for the same file type, or null to use
+         *							the default options.
+         *
+         * @note	Thread safe.
+         */
+        SPtr<ImportResult> Import(const String& filePath, const SPtr<const ImportOptions>& options = nullptr);
+
+        /**
+         * Imports multiple files in parallel, one TaskScheduler task per file, and waits for all of them to complete.
+         *
+         * @param[in]	filePaths	Paths of the files to import.
+         * @param[in]	options		Options for each of the files, in the same order. Files without an entry, or with a
+         *							null entry, use the default options.
+         * @return					Import results, in the same order as @p filePaths.
+         */
+        Vector<SPtr<ImportResult>> Import(const Vector<String>& filePaths,
+            const Vector<SPtr<const ImportOptions>>& options = {});
+
+        /** Writes the manifest into the cache folder, if it changed. Done automatically on shut down. */
+        void SaveManifest();
+
+        /** Returns statistics of the imports performed so far. */
+        ImporterStats GetStats() const;
+
+    protected:
+        /** Last known state of an imported source file. */
+        struct ManifestEntry
+        {
+            static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+            UINT64 Size = 0;
+            UINT64 ModifiedTime = 0;
+            UINT64 SourceHash = 0;
+
+            template<class Archive>
+            void Serialize(Archive& archive, UINT32 version)
+            {
+                archive.Field(Size);
+                archive.Field(ModifiedTime);
+                archive.Field(SourceHash);
+            }
+        };
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /** Returns the importer for the provided file, or null if there is none. */
+        BaseImporter* FindImporter(StringView filePath) const;
+
+        /** Reads the cached import result with the provided key. Returns false if there is none, or it is corrupted. */
+        static bool ReadCached(const String& cacheFolder, UINT64 key, Vector<UINT8>& data);
+
+        /** Stores an import result into the cache. */
+        static void WriteCached(const String& cacheFolder, UINT64 key, const Vector<UINT8>& data);
+
+        /** Updates the manifest entry of a file after it was imported. */
+        void UpdateManifest(const String& filePath, const ManifestEntry& entry);
+
+        /** Records the outcome of an import in the statistics. */
+        void UpdateStats(const ImportResult& result, bool unchanged);
+
+    protected:
+        Vector<BaseImporter*> _importers;
+
+        String _cacheFolder;
+        Map<String, ManifestEntry> _manifest;
+        bool _isManifestDirty = false;
+
+        ImporterStats _stats;
+        mutable Mutex _mutex;
     };
+
+    /** Provides easy access to Importer. */
+    TE_CORE_EXPORT Importer& gImporter();
 }
\ No newline at end of file
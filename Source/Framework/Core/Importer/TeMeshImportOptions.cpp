@@ -0,0 +1,16 @@
+#include "Importer/TeMeshImportOptions.h"
+#include "Serialization/TeBinarySerializer.h"
+
+namespace te
+{
+    void MeshImportOptions::Serialize(BinaryWriter& writer) const
+    {
+        writer.Write(ImportNormals);
+        writer.Write(ImportUVs);
+        writer.Write(Scale);
+        writer.Write(Optimize);
+        writer.Write(GenerateMeshlets);
+        writer.Write(QuantizeAttributes);
+        writer.Write(LodRatios);
+    }
+}
\ No newline at end of file
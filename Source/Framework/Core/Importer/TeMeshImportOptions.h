@@ -0,0 +1,42 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Importer/TeImportOptions.h"
+
+namespace te
+{
+	/** Contains import options you may use to control how is a mesh imported. */
+	class TE_CORE_EXPORT MeshImportOptions : public ImportOptions
+	{
+	public:
+		MeshImportOptions() = default;
+
+        /** @copydoc ImportOptions::Serialize */
+        void Serialize(BinaryWriter& writer) const override;
+
+    public:
+        /** Determines if vertex normals are imported, if the source file has them. */
+        bool ImportNormals = true;
+
+        /** Determines if texture coordinates are imported, if the source file has them. */
+        bool ImportUVs = true;
+
+        /** Uniform scale applied to vertex positions. */
+        float Scale = 1.0f;
+
+        /** Reorders triangles and vertices for vertex cache efficiency, less overdraw and sequential vertex fetches. */
+        bool Optimize = false;
+
+        /** Splits the mesh into meshlets, see MeshData::Meshlets. */
+        bool GenerateMeshlets = false;
+
+        /** Stores normals and UVs with 16-bit components, see MeshData::PackedNormals and MeshData::PackedUVs. */
+        bool QuantizeAttributes = false;
+
+        /**
+         * Fraction of the triangles kept in each of the generated LODs, e.g. { 0.5f, 0.25f }. No LODs are generated if
+         * empty, see MeshData::Lods.
+         */
+        Vector<float> LodRatios;
+    };
+}
\ No newline at end of file
@@ -95,6 +95,8 @@ namespace te
         _pointerDoubleClicked = false;
 
         // Capture raw input
+        UpdateRawInput();
+
         if (_mouse != nullptr)
             _mouse->Capture();
 
@@ -212,6 +212,12 @@ namespace te
         /** Performs platform specific raw input system cleanup. */
         void CleanUpRawInput();
 
+        /**
+         * Performs platform specific work that must happen once per frame before the devices are captured, such as
+         * handling devices that were connected or disconnected.
+         */
+        void UpdateRawInput();
+
         /**	Triggered by input handler when a button is pressed. */
         void ButtonDown(UINT32 deviceIdx, ButtonCode code, UINT64 timestamp);
 
@@ -5,7 +5,7 @@ namespace te
 {
     UINT32 VirtualButton::NextButtonId = 0;
 
-    Map<String, UINT32> VirtualAxis::UniqueAxisIds;
+    UnorderedMap<StringId, UINT32> VirtualAxis::UniqueAxisIds;
     UINT32 VirtualAxis::NextAxisId = 0;
 
     VIRTUAL_BUTTON_DESC::VIRTUAL_BUTTON_DESC(ButtonCode buttonCode, ButtonModifier modifiers, bool repeatable)
@@ -16,9 +16,9 @@ namespace te
         : Type(type)
     { }
 
-    VirtualButton::VirtualButton(const String& name)
+    VirtualButton::VirtualButton(const StringId& name)
     {
-        Map<String, UINT32>& uniqueButtonIds = GetUniqueButtonIds();
+        UnorderedMap<StringId, UINT32>& uniqueButtonIds = GetUniqueButtonIds();
 
         auto findIter = uniqueButtonIds.find(name);
 
@@ -31,13 +31,13 @@ namespace te
         }
     }
 
-    Map<String, UINT32>& VirtualButton::GetUniqueButtonIds()
+    UnorderedMap<StringId, UINT32>& VirtualButton::GetUniqueButtonIds()
     {
-        static Map<String, UINT32> uniqueButtonIds;
+        static UnorderedMap<StringId, UINT32> uniqueButtonIds;
         return uniqueButtonIds;
     }
 
-    VirtualAxis::VirtualAxis(const String& name)
+    VirtualAxis::VirtualAxis(const StringId& name)
     {
         auto findIter = UniqueAxisIds.find(name);
 
@@ -50,7 +50,7 @@ namespace te
         }
     }
 
-    void InputConfiguration::RegisterButton(const String& name, ButtonCode buttonCode, ButtonModifier modifiers, bool repeatable)
+    void InputConfiguration::RegisterButton(const StringId& name, ButtonCode buttonCode, ButtonModifier modifiers, bool repeatable)
     {
         Vector<VirtualButtonData>& btnData = _buttons[buttonCode & 0x0000FFFF];
 
@@ -76,7 +76,7 @@ namespace te
         btn.Button = VirtualButton(name);
     }
 
-    void InputConfiguration::UnregisterButton(const String& name)
+    void InputConfiguration::UnregisterButton(const StringId& name)
     {
         Vector<UINT32> toRemove;
 
@@ -100,7 +100,7 @@ namespace te
         }
     }
 
-    void InputConfiguration::RegisterAxis(const String& name, const VIRTUAL_AXIS_DESC& desc)
+    void InputConfiguration::RegisterAxis(const StringId& name, const VIRTUAL_AXIS_DESC& desc)
     {
         VirtualAxis axis(name);
 
@@ -112,7 +112,7 @@ namespace te
         _axes[axis.AxisIdentifier].Axis = axis;
     }
 
-    void InputConfiguration::UnregisterAxis(const String& name)
+    void InputConfiguration::UnregisterAxis(const StringId& name)
     {
         for (UINT32 i = 0; i < (UINT32)_axes.size(); i++)
         {
@@ -2,6 +2,7 @@
 
 #include "TeCorePrerequisites.h"
 #include "Input/TeInputData.h"
+#include "String/TeStringId.h"
 
 namespace te
 {
@@ -67,7 +68,8 @@ namespace te
      * Identifier for a virtual button.
      *
      * Primary purpose of this class is to avoid expensive string compare, and instead use a unique button identifier for
-     * compare. Generally you want to create one of these using the button name, and then store it for later use.
+     * compare. Generally you want to create one of these using the button name, and then store it for later use. Names
+     * known at compile time can be passed as string literal identifiers ("Name"_sid), which skips hashing the name.
      *
      * @note
      * This class is not thread safe and should only be used on the sim thread.
@@ -76,7 +78,7 @@ namespace te
     {
     public:
         VirtualButton() = default;
-        VirtualButton(const String& name);
+        VirtualButton(const StringId& name);
 
         bool operator== (const VirtualButton& rhs) const
         {
@@ -86,7 +88,7 @@ namespace te
         UINT32 ButtonIdentifier = 0;
     private:
         /** Returns a static map of all virtual button identifiers and their buttons. */
-        static Map<String, UINT32>& GetUniqueButtonIds();
+        static UnorderedMap<StringId, UINT32>& GetUniqueButtonIds();
 
         static UINT32 NextButtonId;
     };
@@ -96,7 +98,8 @@ namespace te
      *
      * Primary purpose of this class is to avoid expensive string compare (axis names), and instead use a unique axis
      * identifier for compare. Generally you want to create one of these using the axis name, and then store it for later
-     * use.
+     * use. Names known at compile time can be passed as string literal identifiers ("Name"_sid), which skips hashing
+     * the name.
      *
      * @note
      * This class is not thread safe and should only be used on the sim thread.
@@ -105,7 +108,7 @@ namespace te
     {
     public:
         VirtualAxis() = default;
-        VirtualAxis(const String& name);
+        VirtualAxis(const StringId& name);
 
         UINT32 AxisIdentifier = 0;
 
@@ -115,7 +118,7 @@ namespace te
         }
 
     private:
-        static Map<String, UINT32> UniqueAxisIds;
+        static UnorderedMap<StringId, UINT32> UniqueAxisIds;
         static UINT32 NextAxisId;
     };
 
@@ -128,7 +131,7 @@ namespace te
         /**	Internal virtual button data container. */
         struct VirtualButtonData
         {
-            String Name;
+            StringId Name;
             VirtualButton Button;
             VIRTUAL_BUTTON_DESC Desc;
         };
@@ -136,7 +139,7 @@ namespace te
         /**	Internal virtual axis data container. */
         struct VirtualAxisData
         {
-            String Name;
+            StringId Name;
             VirtualAxis Axis;
             VIRTUAL_AXIS_DESC Desc;
         };
@@ -159,10 +162,10 @@ namespace te
          * @param[in]	repeatable	If true, the virtual button events will be sent continually while the physical button
          *							is being held.
          */
-        void RegisterButton(const String& name, ButtonCode buttonCode, ButtonModifier modifiers = ButtonModifier::None, bool repeatable = false);
+        void RegisterButton(const StringId& name, ButtonCode buttonCode, ButtonModifier modifiers = ButtonModifier::None, bool repeatable = false);
 
         /**	Unregisters a virtual button with the specified name. Events will no longer be generated for that button. */
-        void UnregisterButton(const String& name);
+        void UnregisterButton(const StringId& name);
 
         /**
          * Registers a new virtual axis.
@@ -170,13 +173,13 @@ namespace te
          * @param[in]	name	Unique name used to access the axis.
          * @param[in]	desc	Descriptor structure containing virtual axis creation parameters.
          */
-        void RegisterAxis(const String& name, const VIRTUAL_AXIS_DESC& desc);
+        void RegisterAxis(const StringId& name, const VIRTUAL_AXIS_DESC& desc);
 
         /**
          * Unregisters a virtual axis with the specified name. You will no longer be able to retrieve valid values for that
          * axis.
          */
-        void UnregisterAxis(const String& name);
+        void UnregisterAxis(const StringId& name);
 
         /**
          * Sets repeat interval for held virtual buttons. Buttons will be continously triggered in interval increments as
@@ -357,7 +357,7 @@ namespace te
             :mIsUsed(false)
         { }
 
-        UINT32 textChar; /**< Character the that was input. */
+        UINT32 textChar; /**< Unicode code point of the character that was input, see UTF8::Encode(). */
 
         /**
          * Check if the event has been marked as used. Internally this means nothing but caller might choose to ignore an
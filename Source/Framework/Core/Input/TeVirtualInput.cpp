@@ -36,7 +36,7 @@ namespace te
         if (deviceIdx >= (UINT32)_devices.size())
             return false;
 
-        const Map<UINT32, ButtonData>& cachedStates = _devices[deviceIdx].CachedStates;
+        const FlatHashMap<UINT32, ButtonData>& cachedStates = _devices[deviceIdx].CachedStates;
         auto iterFind = cachedStates.find(button.ButtonIdentifier);
 
         if (iterFind != cachedStates.end())
@@ -50,7 +50,7 @@ namespace te
         if (deviceIdx >= (UINT32)_devices.size())
             return false;
 
-        const Map<UINT32, ButtonData>& cachedStates = _devices[deviceIdx].CachedStates;
+        const FlatHashMap<UINT32, ButtonData>& cachedStates = _devices[deviceIdx].CachedStates;
         auto iterFind = cachedStates.find(button.ButtonIdentifier);
 
         if (iterFind != cachedStates.end())
@@ -64,7 +64,7 @@ namespace te
         if (deviceIdx >= (UINT32)_devices.size())
             return false;
 
-        const Map<UINT32, ButtonData>& cachedStates = _devices[deviceIdx].CachedStates;
+        const FlatHashMap<UINT32, ButtonData>& cachedStates = _devices[deviceIdx].CachedStates;
         auto iterFind = cachedStates.find(button.ButtonIdentifier);
 
         if (iterFind != cachedStates.end())
@@ -208,7 +208,7 @@ namespace te
             while (event.deviceIdx >= (UINT32)_devices.size())
                 _devices.push_back(DeviceData());
 
-            Map<UINT32, ButtonData>& cachedStates = _devices[event.deviceIdx].CachedStates;
+            FlatHashMap<UINT32, ButtonData>& cachedStates = _devices[event.deviceIdx].CachedStates;
 
             UINT32 numButtons = (UINT32)_tempButtons.size();
             for (UINT32 i = 0; i < numButtons; i++)
@@ -251,7 +251,7 @@ namespace te
             while (event.deviceIdx >= (UINT32)_devices.size())
                 _devices.push_back(DeviceData());
 
-            Map<UINT32, ButtonData>& cachedStates = _devices[event.deviceIdx].CachedStates;
+            FlatHashMap<UINT32, ButtonData>& cachedStates = _devices[event.deviceIdx].CachedStates;
 
             UINT32 numButtons = (UINT32)_tempButtons.size();
             for (UINT32 i = 0; i < numButtons; i++)
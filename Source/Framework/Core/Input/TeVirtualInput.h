@@ -3,6 +3,7 @@
 #include "TeCorePrerequisites.h"
 #include "Input/TeInputConfiguration.h"
 #include "Utility/TeEvent.h"
+#include "Utility/TeFlatHashMap.h"
 #include "Utility/TeModule.h"
 
 namespace te
@@ -35,7 +36,7 @@ namespace te
         /**	Contains button data for a specific input device. */
         struct DeviceData
         {
-            Map<UINT32, ButtonData> CachedStates;
+            FlatHashMap<UINT32, ButtonData> CachedStates;
         };
 
         /**	Data container for a virtual button event. */
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeVector2.h"
+#include "Math/TeVector3.h"
+#include "Serialization/TeBinarySerializer.h"
+
+namespace te
+{
+    /** Range of indices of a mesh that is drawn with a single material. */
+    struct SubMesh
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 2;
+
+        UINT32 IndexOffset = 0;
+        UINT32 IndexCount = 0;
+        String MaterialName;
+
+        /** Range of MeshData::Meshlets covering the triangles of this sub-mesh, if meshlets were generated. */
+        UINT32 MeshletOffset = 0;
+        UINT32 MeshletCount = 0;
+
+        template<class Archive>
+        void Serialize(Archive& archive, UINT32 version)
+        {
+            archive.Field(IndexOffset);
+            archive.Field(IndexCount);
+            archive.Field(MaterialName);
+
+            if (version >= 2)
+            {
+                archive.Field(MeshletOffset);
+                archive.Field(MeshletCount);
+            }
+        }
+    };
+
+    /**
+     * Small cluster of triangles that references a limited number of vertices, so it can be processed by a single GPU
+     * work group and culled as a whole.
+     */
+    struct Meshlet
+    {
+        UINT32 VertexOffset; /**< First entry in MeshData::MeshletVertices. */
+        UINT32 TriangleOffset; /**< First entry in MeshData::MeshletTriangles, each triangle uses three entries. */
+        UINT32 VertexCount;
+        UINT32 TriangleCount;
+
+        Vector3 Center; /**< Center of the bounding sphere of the meshlet. */
+        float Radius;
+    };
+
+    template<> struct SerializableType<Meshlet> : FixedLayoutSerializableType<Meshlet> { };
+
+    /**
+     * Simplified version of a mesh. Uses a subset of the vertices of the mesh, and has the same sub-meshes with fewer
+     * triangles.
+     */
+    struct MeshLod
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 1;
+
+        Vector<UINT32> Indices;
+        Vector<SubMesh> SubMeshes;
+
+        /**
+         * Estimated distance between the simplified surface and the full detail one, in the units of the vertex
+         * positions. Projected at the distance of the mesh, this gives the screen space error of using the LOD.
+         */
+        float Error = 0.0f;
+
+        template<class Archive>
+        void Serialize(Archive& archive, UINT32 version)
+        {
+            archive.Field(Indices);
+            archive.Field(SubMeshes);
+            archive.Field(Error);
+        }
+    };
+
+    /**
+     * Indexed triangle list, as output by mesh importers. Vertex attributes are stored in separate streams. Normals and
+     * UVs are either empty or contain one entry per vertex.
+     *
+     * Normals and UVs can be quantized by MeshOptimizer, in which case they are stored in PackedNormals and PackedUVs
+     * instead of Normals and UVs.
+     */
+    struct MeshData
+    {
+        static constexpr UINT32 SERIALIZATION_VERSION = 3;
+
+        Vector<Vector3> Positions;
+        Vector<Vector3> Normals;
+        Vector<Vector2> UVs;
+        Vector<UINT32> Indices;
+        Vector<SubMesh> SubMeshes;
+
+        /** Octahedral encoded normals, as two 16-bit signed normalized components (x in the low bits). */
+        Vector<UINT32> PackedNormals;
+
+        /**
+         * UVs as two 16-bit unsigned normalized components (u in the low bits), relative to the UV bounds of the mesh.
+         * Decoded as UVOffset + packed * UVScale.
+         */
+        Vector<UINT32> PackedUVs;
+        Vector2 UVOffset = Vector2(0.0f, 0.0f);
+        Vector2 UVScale = Vector2(1.0f, 1.0f);
+
+        /** Meshlets of all sub-meshes, see SubMesh::MeshletOffset. */
+        Vector<Meshlet> Meshlets;
+
+        /** Vertex indices referenced by meshlets. */
+        Vector<UINT32> MeshletVertices;
+
+        /** Triangles of meshlets, as indices into the meshlet's range of MeshletVertices. */
+        Vector<UINT8> MeshletTriangles;
+
+        /** Simplified versions of the mesh, from the most to the least detailed. */
+        Vector<MeshLod> Lods;
+
+        /** Returns the number of unique vertices. */
+        UINT32 GetNumVertices() const { return (UINT32)Positions.size(); }
+
+        /** Returns the number of triangles, across all sub-meshes. */
+        UINT32 GetNumTriangles() const { return (UINT32)Indices.size() / 3; }
+
+        /**
+         * Returns the least detailed LOD whose error is at most @p maxError. 0 is the full detail mesh, and i + 1 is
+         * Lods[i].
+         */
+        UINT32 SelectLod(float maxError) const
+        {
+            UINT32 lod = 0;
+            while (lod < (UINT32)Lods.size() && Lods[lod].Error <= maxError)
+                lod++;
+
+            return lod;
+        }
+
+        template<class Archive>
+        void Serialize(Archive& archive, UINT32 version)
+        {
+            archive.Field(Positions);
+            archive.Field(Normals);
+            archive.Field(UVs);
+            archive.Field(Indices);
+            archive.Field(SubMeshes);
+
+            if (version >= 2)
+            {
+                archive.Field(PackedNormals);
+                archive.Field(PackedUVs);
+                archive.Field(UVOffset);
+                archive.Field(UVScale);
+                archive.Field(Meshlets);
+                archive.Field(MeshletVertices);
+                archive.Field(MeshletTriangles);
+            }
+
+            if (version >= 3)
+                archive.Field(Lods);
+        }
+    };
+}
\ No newline at end of file
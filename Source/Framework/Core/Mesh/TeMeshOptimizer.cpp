@@ -0,0 +1,621 @@
+#include "Mesh/TeMeshOptimizer.h"
+#include "Mesh/TeMeshData.h"
+#include "Mesh/TeMeshSimplifier.h"
+#include "Importer/TeMeshImportOptions.h"
+#include "Error/TeDebug.h"
+
+#include <cmath>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 INVALID_INDEX = ~0U;
+
+        /** Range of triangles [Begin, End) of a single sub-mesh. */
+        struct TriangleRange
+        {
+            UINT32 Begin;
+            UINT32 End;
+        };
+
+        /** Triangles using each of the vertices, in compressed row form. */
+        struct VertexAdjacency
+        {
+            Vector<UINT32> Offsets; /**< Range of Triangles for every vertex, one extra entry at the end. */
+            Vector<UINT32> Triangles; /**< Sorted by triangle index, for each of the vertices. */
+        };
+
+        /**
+         * Simulates a FIFO vertex cache. Every vertex is stamped with the time it was last inserted in the cache, and
+         * the time advances on every insertion, so a vertex is in the cache as long as the difference is at most the
+         * cache size.
+         */
+        class VertexCache
+        {
+        public:
+            VertexCache(UINT32 numVertices, UINT32 size)
+                : _timestamps(numVertices, 0)
+                , _size(size)
+                , _time(size + 1)
+            { }
+
+            /** Returns true if the vertex wasn't in the cache, and inserts it. */
+            bool Access(UINT32 vertex)
+            {
+                if (_time - _timestamps[vertex] <= _size)
+                    return false;
+
+                _timestamps[vertex] = _time++;
+                return true;
+            }
+
+            /** Returns the number of vertices of a triangle that weren't in the cache, and inserts them. */
+            UINT32 AccessTriangle(const UINT32* indices)
+            {
+                return (UINT32)Access(indices[0]) + (UINT32)Access(indices[1]) + (UINT32)Access(indices[2]);
+            }
+
+            /** Returns the number of insertions since the vertex was inserted, it's cached if this is <= cache size. */
+            UINT32 GetAge(UINT32 vertex) const { return _time - _timestamps[vertex]; }
+
+            /** Evicts all vertices from the cache. */
+            void Flush() { _time += _size + 1; }
+
+        private:
+            Vector<UINT32> _timestamps;
+            UINT32 _size;
+            UINT32 _time;
+        };
+
+        /** Returns the triangle ranges of all sub-meshes, or of the whole index buffer if there are no sub-meshes. */
+        Vector<TriangleRange> GetTriangleRanges(const Vector<SubMesh>& subMeshes, const Vector<UINT32>& indices)
+        {
+            Vector<TriangleRange> ranges;
+
+            if (subMeshes.empty())
+                ranges.push_back({ 0, (UINT32)indices.size() / 3 });
+
+            for (auto& subMesh : subMeshes)
+            {
+                TE_ASSERT_ERROR(subMesh.IndexOffset % 3 == 0 && subMesh.IndexCount % 3 == 0,
+                    "Sub-meshes must contain whole triangles.");
+                ranges.push_back({ subMesh.IndexOffset / 3, (subMesh.IndexOffset + subMesh.IndexCount) / 3 });
+            }
+
+            return ranges;
+        }
+
+        void BuildAdjacency(const Vector<UINT32>& indices, UINT32 numVertices, VertexAdjacency& adjacency)
+        {
+            adjacency.Offsets.assign((size_t)numVertices + 1, 0);
+            for (UINT32 index : indices)
+                adjacency.Offsets[index + 1]++;
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                adjacency.Offsets[i + 1] += adjacency.Offsets[i];
+
+            Vector<UINT32> writeOffsets(adjacency.Offsets.begin(), adjacency.Offsets.end() - 1);
+
+            adjacency.Triangles.resize(indices.size());
+            for (size_t i = 0; i < indices.size(); i++)
+                adjacency.Triangles[writeOffsets[indices[i]]++] = (UINT32)(i / 3);
+        }
+
+        /** Reorders a per-vertex attribute stream according to a remap table created by OptimizeVertexFetch(). */
+        template<class T>
+        void RemapVertexStream(Vector<T>& stream, const Vector<UINT32>& remap, UINT32 numVertices)
+        {
+            if (stream.empty())
+                return;
+
+            Vector<T> output(numVertices);
+            for (size_t i = 0; i < stream.size(); i++)
+            {
+                if (remap[i] != INVALID_INDEX)
+                    output[remap[i]] = stream[i];
+            }
+
+            stream = std::move(output);
+        }
+
+        /** Rounds a value in [-1, 1] to a 16-bit signed normalized integer. */
+        UINT32 QuantizeSnorm16(float value)
+        {
+            value = std::max(-1.0f, std::min(1.0f, value));
+            return (UINT32)(UINT16)(INT16)std::floor(value * 32767.0f + 0.5f);
+        }
+
+        /** Rounds a value in [0, 1] to a 16-bit unsigned normalized integer. */
+        UINT32 QuantizeUnorm16(float value)
+        {
+            value = std::max(0.0f, std::min(1.0f, value));
+            return (UINT32)std::floor(value * 65535.0f + 0.5f);
+        }
+
+        /** Encodes a unit vector with octahedral mapping. Zero vectors decode to positive Z. */
+        UINT32 EncodeNormal(const Vector3& normal)
+        {
+            const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+            if (length == 0.0f)
+                return 0;
+
+            float x = normal.x / length;
+            float y = normal.y / length;
+
+            // Fold the lower hemisphere over the diagonals
+            if (normal.z < 0.0f)
+            {
+                const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+                x = foldedX;
+                y = foldedY;
+            }
+
+            return QuantizeSnorm16(x) | (QuantizeSnorm16(y) << 16);
+        }
+
+        /** Implementation of MeshOptimizer::OptimizeVertexCache() for a single index buffer. */
+        void ReorderForVertexCache(Vector<UINT32>& indices, const Vector<SubMesh>& subMeshes, UINT32 numVertices)
+        {
+            VertexAdjacency adjacency;
+            BuildAdjacency(indices, numVertices, adjacency);
+
+            VertexCache cache(numVertices, MeshOptimizer::VERTEX_CACHE_SIZE);
+            Vector<UINT32> liveTriangles(numVertices, 0);
+            Vector<UINT8> emitted(indices.size() / 3, 0);
+            Vector<UINT32> deadEnds;
+            Vector<UINT32> candidates;
+
+            Vector<UINT32> output = indices;
+
+            for (auto& range : GetTriangleRanges(subMeshes, indices))
+            {
+                if (range.Begin == range.End)
+                    continue;
+
+                for (UINT32 i = range.Begin * 3; i < range.End * 3; i++)
+                    liveTriangles[indices[i]]++;
+
+                cache.Flush();
+                deadEnds.clear();
+
+                UINT32 outputIdx = range.Begin * 3;
+                UINT32 cursor = range.Begin * 3;
+                UINT32 fanVertex = indices[cursor];
+
+                while (fanVertex != INVALID_INDEX)
+                {
+                    // Emit all remaining triangles around the fanning vertex
+                    candidates.clear();
+                    for (UINT32 i = adjacency.Offsets[fanVertex]; i < adjacency.Offsets[fanVertex + 1]; i++)
+                    {
+                        const UINT32 triangle = adjacency.Triangles[i];
+                        if (triangle < range.Begin || triangle >= range.End || emitted[triangle])
+                            continue;
+
+                        for (UINT32 j = 0; j < 3; j++)
+                        {
+                            const UINT32 vertex = indices[triangle * 3 + j];
+
+                            output[outputIdx++] = vertex;
+                            deadEnds.push_back(vertex);
+                            candidates.push_back(vertex);
+                            liveTriangles[vertex]--;
+                            cache.Access(vertex);
+                        }
+
+                        emitted[triangle] = 1;
+                    }
+
+                    // Continue from the oldest vertex that will still be cached after fanning around it
+                    fanVertex = INVALID_INDEX;
+                    INT64 bestPriority = -1;
+
+                    for (UINT32 vertex : candidates)
+                    {
+                        if (liveTriangles[vertex] == 0)
+                            continue;
+
+                        const UINT32 age = cache.GetAge(vertex);
+
+                        INT64 priority = 0;
+                        if (age + 2 * liveTriangles[vertex] <= MeshOptimizer::VERTEX_CACHE_SIZE)
+                            priority = age;
+
+                        if (priority > bestPriority)
+                        {
+                            bestPriority = priority;
+                            fanVertex = vertex;
+                        }
+                    }
+
+                    // Dead end, go back to a recently used vertex or to the next unprocessed part of the input
+                    while (fanVertex == INVALID_INDEX && !deadEnds.empty())
+                    {
+                        const UINT32 vertex = deadEnds.back();
+                        deadEnds.pop_back();
+
+                        if (liveTriangles[vertex] > 0)
+                            fanVertex = vertex;
+                    }
+
+                    while (fanVertex == INVALID_INDEX && cursor < range.End * 3)
+                    {
+                        const UINT32 vertex = indices[cursor++];
+                        if (liveTriangles[vertex] > 0)
+                            fanVertex = vertex;
+                    }
+                }
+            }
+
+            indices = std::move(output);
+        }
+
+        /** Implementation of MeshOptimizer::OptimizeOverdraw() for a single index buffer. */
+        void ReorderForOverdraw(Vector<UINT32>& indices, const Vector<SubMesh>& subMeshes,
+            const Vector<Vector3>& positions, float threshold)
+        {
+            const UINT32 numVertices = (UINT32)positions.size();
+
+            struct Cluster
+            {
+                UINT32 Begin;
+                UINT32 End;
+                float SortKey;
+            };
+
+            VertexCache cache(numVertices, MeshOptimizer::VERTEX_CACHE_SIZE);
+            Vector<UINT32> hardBoundaries;
+            Vector<Cluster> clusters;
+
+            Vector<UINT32> output = indices;
+
+            for (auto& range : GetTriangleRanges(subMeshes, indices))
+            {
+                if (range.End - range.Begin < 2)
+                    continue;
+
+                // Triangles that miss the cache with all their vertices are where the vertex cache optimization
+                // restarted from a vertex far away
+                hardBoundaries.clear();
+                cache.Flush();
+
+                for (UINT32 i = range.Begin; i < range.End; i++)
+                {
+                    const UINT32 misses = cache.AccessTriangle(&indices[i * 3]);
+                    if (i == range.Begin || misses == 3)
+                        hardBoundaries.push_back(i);
+                }
+
+                hardBoundaries.push_back(range.End);
+
+                // Split further as soon as the cache miss ratio of the split part is close to the one of the cluster
+                clusters.clear();
+                for (size_t i = 0; i + 1 < hardBoundaries.size(); i++)
+                {
+                    const UINT32 begin = hardBoundaries[i];
+                    const UINT32 end = hardBoundaries[i + 1];
+
+                    cache.Flush();
+
+                    UINT32 clusterMisses = 0;
+                    for (UINT32 j = begin; j < end; j++)
+                        clusterMisses += cache.AccessTriangle(&indices[j * 3]);
+
+                    const float clusterThreshold = threshold * clusterMisses / (float)(end - begin);
+
+                    cache.Flush();
+
+                    UINT32 clusterBegin = begin;
+                    UINT32 misses = 0;
+
+                    for (UINT32 j = begin; j < end; j++)
+                    {
+                        misses += cache.AccessTriangle(&indices[j * 3]);
+
+                        if (j + 1 < end && misses <= clusterThreshold * (j + 1 - clusterBegin))
+                        {
+                            clusters.push_back({ clusterBegin, j + 1, 0.0f });
+                            clusterBegin = j + 1;
+                            misses = 0;
+
+                            cache.Flush();
+                        }
+                    }
+
+                    clusters.push_back({ clusterBegin, end, 0.0f });
+                }
+
+                Vector3 meshCenter(0.0f, 0.0f, 0.0f);
+                for (UINT32 i = range.Begin * 3; i < range.End * 3; i++)
+                    meshCenter += positions[indices[i]];
+
+                meshCenter /= (float)((range.End - range.Begin) * 3);
+
+                // Clusters pointing away from the center of the mesh are likely to occlude the others
+                for (auto& cluster : clusters)
+                {
+                    Vector3 center(0.0f, 0.0f, 0.0f);
+                    Vector3 normal(0.0f, 0.0f, 0.0f);
+                    float area = 0.0f;
+
+                    for (UINT32 i = cluster.Begin; i < cluster.End; i++)
+                    {
+                        const Vector3& a = positions[indices[i * 3 + 0]];
+                        const Vector3& b = positions[indices[i * 3 + 1]];
+                        const Vector3& c = positions[indices[i * 3 + 2]];
+
+                        const Vector3 triangleNormal = (b - a).Cross(c - a);
+                        const float triangleArea = triangleNormal.Length();
+
+                        center += (a + b + c) * (triangleArea / 3.0f);
+                        normal += triangleNormal;
+                        area += triangleArea;
+                    }
+
+                    if (area > 0.0f)
+                        center /= area;
+
+                    normal.Normalize();
+                    cluster.SortKey = (center - meshCenter).Dot(normal);
+                }
+
+                std::stable_sort(clusters.begin(), clusters.end(),
+                    [](const Cluster& a, const Cluster& b) { return a.SortKey > b.SortKey; });
+
+                UINT32 outputIdx = range.Begin * 3;
+                for (auto& cluster : clusters)
+                {
+                    for (UINT32 i = cluster.Begin * 3; i < cluster.End * 3; i++)
+                        output[outputIdx++] = indices[i];
+                }
+            }
+
+            indices = std::move(output);
+        }
+    }
+
+    void MeshOptimizer::Optimize(MeshData& mesh, const MeshImportOptions& options)
+    {
+        if (!options.LodRatios.empty())
+            MeshSimplifier::GenerateLods(mesh, options.LodRatios);
+
+        if (options.Optimize)
+        {
+            OptimizeVertexCache(mesh);
+            OptimizeOverdraw(mesh);
+            OptimizeVertexFetch(mesh);
+        }
+
+        if (options.GenerateMeshlets)
+            BuildMeshlets(mesh);
+
+        if (options.QuantizeAttributes)
+            QuantizeAttributes(mesh);
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(MeshData& mesh)
+    {
+        ReorderForVertexCache(mesh.Indices, mesh.SubMeshes, mesh.GetNumVertices());
+
+        for (auto& lod : mesh.Lods)
+            ReorderForVertexCache(lod.Indices, lod.SubMeshes, mesh.GetNumVertices());
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(MeshData& mesh, float threshold)
+    {
+        ReorderForOverdraw(mesh.Indices, mesh.SubMeshes, mesh.Positions, threshold);
+
+        for (auto& lod : mesh.Lods)
+            ReorderForOverdraw(lod.Indices, lod.SubMeshes, mesh.Positions, threshold);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(MeshData& mesh)
+    {
+        Vector<UINT32> remap(mesh.GetNumVertices(), INVALID_INDEX);
+        UINT32 numVertices = 0;
+
+        for (auto& index : mesh.Indices)
+        {
+            if (remap[index] == INVALID_INDEX)
+                remap[index] = numVertices++;
+
+            index = remap[index];
+        }
+
+        RemapVertexStream(mesh.Positions, remap, numVertices);
+        RemapVertexStream(mesh.Normals, remap, numVertices);
+        RemapVertexStream(mesh.UVs, remap, numVertices);
+        RemapVertexStream(mesh.PackedNormals, remap, numVertices);
+        RemapVertexStream(mesh.PackedUVs, remap, numVertices);
+
+        for (auto& vertex : mesh.MeshletVertices)
+            vertex = remap[vertex];
+
+        // LODs only use vertices of the full detail mesh
+        for (auto& lod : mesh.Lods)
+        {
+            for (auto& index : lod.Indices)
+                index = remap[index];
+        }
+    }
+
+    void MeshOptimizer::BuildMeshlets(MeshData& mesh, UINT32 maxVertices, UINT32 maxTriangles)
+    {
+        TE_ASSERT_ERROR(maxVertices >= 3 && maxVertices < 256 && maxTriangles > 0, "Invalid meshlet size.");
+
+        constexpr UINT8 NOT_IN_MESHLET = 0xFF;
+
+        const Vector<UINT32>& indices = mesh.Indices;
+        const Vector<Vector3>& positions = mesh.Positions;
+
+        mesh.Meshlets.clear();
+        mesh.MeshletVertices.clear();
+        mesh.MeshletTriangles.clear();
+
+        // Index of every vertex within the meshlet being built
+        Vector<UINT8> localIndices(mesh.GetNumVertices(), NOT_IN_MESHLET);
+        Meshlet meshlet;
+
+        auto beginMeshlet = [&]()
+        {
+            meshlet.VertexOffset = (UINT32)mesh.MeshletVertices.size();
+            meshlet.TriangleOffset = (UINT32)mesh.MeshletTriangles.size();
+            meshlet.VertexCount = 0;
+            meshlet.TriangleCount = 0;
+        };
+
+        auto endMeshlet = [&]()
+        {
+            if (meshlet.TriangleCount == 0)
+                return;
+
+            Vector3 min = positions[mesh.MeshletVertices[meshlet.VertexOffset]];
+            Vector3 max = min;
+
+            for (UINT32 i = 0; i < meshlet.VertexCount; i++)
+            {
+                const UINT32 vertex = mesh.MeshletVertices[meshlet.VertexOffset + i];
+
+                min.Min(positions[vertex]);
+                max.Max(positions[vertex]);
+                localIndices[vertex] = NOT_IN_MESHLET;
+            }
+
+            meshlet.Center = (min + max) * 0.5f;
+            meshlet.Radius = 0.0f;
+
+            for (UINT32 i = 0; i < meshlet.VertexCount; i++)
+            {
+                const Vector3& position = positions[mesh.MeshletVertices[meshlet.VertexOffset + i]];
+                meshlet.Radius = std::max(meshlet.Radius, meshlet.Center.Distance(position));
+            }
+
+            mesh.Meshlets.push_back(meshlet);
+        };
+
+        const Vector<TriangleRange> ranges = GetTriangleRanges(mesh.SubMeshes, mesh.Indices);
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            const UINT32 firstMeshlet = (UINT32)mesh.Meshlets.size();
+            beginMeshlet();
+
+            for (UINT32 j = ranges[i].Begin; j < ranges[i].End; j++)
+            {
+                const UINT32 a = indices[j * 3 + 0];
+                const UINT32 b = indices[j * 3 + 1];
+                const UINT32 c = indices[j * 3 + 2];
+
+                const UINT32 newVertices = (localIndices[a] == NOT_IN_MESHLET) +
+                    (localIndices[b] == NOT_IN_MESHLET && b != a) +
+                    (localIndices[c] == NOT_IN_MESHLET && c != a && c != b);
+
+                if (meshlet.VertexCount + newVertices > maxVertices || meshlet.TriangleCount == maxTriangles)
+                {
+                    endMeshlet();
+                    beginMeshlet();
+                }
+
+                for (UINT32 vertex : { a, b, c })
+                {
+                    if (localIndices[vertex] == NOT_IN_MESHLET)
+                    {
+                        localIndices[vertex] = (UINT8)meshlet.VertexCount++;
+                        mesh.MeshletVertices.push_back(vertex);
+                    }
+
+                    mesh.MeshletTriangles.push_back(localIndices[vertex]);
+                }
+
+                meshlet.TriangleCount++;
+            }
+
+            endMeshlet();
+
+            if (i < mesh.SubMeshes.size())
+            {
+                mesh.SubMeshes[i].MeshletOffset = firstMeshlet;
+                mesh.SubMeshes[i].MeshletCount = (UINT32)mesh.Meshlets.size() - firstMeshlet;
+            }
+        }
+    }
+
+    void MeshOptimizer::QuantizeAttributes(MeshData& mesh)
+    {
+        if (!mesh.Normals.empty())
+        {
+            mesh.PackedNormals.resize(mesh.Normals.size());
+            for (size_t i = 0; i < mesh.Normals.size(); i++)
+                mesh.PackedNormals[i] = EncodeNormal(mesh.Normals[i]);
+
+            mesh.Normals = Vector<Vector3>();
+        }
+
+        if (!mesh.UVs.empty())
+        {
+            Vector2 min = mesh.UVs[0];
+            Vector2 max = mesh.UVs[0];
+
+            for (auto& uv : mesh.UVs)
+            {
+                min.x = std::min(min.x, uv.x);
+                min.y = std::min(min.y, uv.y);
+                max.x = std::max(max.x, uv.x);
+                max.y = std::max(max.y, uv.y);
+            }
+
+            mesh.UVOffset = min;
+            mesh.UVScale = Vector2(max.x > min.x ? max.x - min.x : 1.0f, max.y > min.y ? max.y - min.y : 1.0f);
+
+            mesh.PackedUVs.resize(mesh.UVs.size());
+            for (size_t i = 0; i < mesh.UVs.size(); i++)
+            {
+                const Vector2& uv = mesh.UVs[i];
+
+                mesh.PackedUVs[i] = QuantizeUnorm16((uv.x - min.x) / mesh.UVScale.x) |
+                    (QuantizeUnorm16((uv.y - min.y) / mesh.UVScale.y) << 16);
+            }
+
+            mesh.UVs = Vector<Vector2>();
+        }
+    }
+
+    Vector3 MeshOptimizer::DecodeNormal(UINT32 packed)
+    {
+        float x = (INT16)(packed & 0xFFFF) / 32767.0f;
+        float y = (INT16)(packed >> 16) / 32767.0f;
+        const float z = 1.0f - std::abs(x) - std::abs(y);
+
+        // Unfold the lower hemisphere
+        const float offset = std::max(-z, 0.0f);
+        x += x >= 0.0f ? -offset : offset;
+        y += y >= 0.0f ? -offset : offset;
+
+        return Vector3::Normalize(Vector3(x, y, z));
+    }
+
+    Vector2 MeshOptimizer::DecodeUV(UINT32 packed, const Vector2& offset, const Vector2& scale)
+    {
+        const float u = (packed & 0xFFFF) / 65535.0f;
+        const float v = (packed >> 16) / 65535.0f;
+
+        return Vector2(offset.x + u * scale.x, offset.y + v * scale.y);
+    }
+
+    float MeshOptimizer::GetCacheMissRatio(const MeshData& mesh, UINT32 cacheSize)
+    {
+        const UINT32 numTriangles = mesh.GetNumTriangles();
+        if (numTriangles == 0)
+            return 0.0f;
+
+        VertexCache cache(mesh.GetNumVertices(), cacheSize);
+
+        UINT64 misses = 0;
+        for (UINT32 i = 0; i < numTriangles; i++)
+            misses += cache.AccessTriangle(&mesh.Indices[i * 3]);
+
+        return misses / (float)numTriangles;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeVector2.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    /**
+     * Post-import optimizations of MeshData, reducing the GPU cost of rendering it and the memory it uses. All steps
+     * work on every sub-mesh separately and never move triangles between sub-meshes.
+     *
+     * The usual order is MeshSimplifier::GenerateLods(), OptimizeVertexCache(), OptimizeOverdraw(),
+     * OptimizeVertexFetch(), BuildMeshlets() and QuantizeAttributes(), which is what Optimize() runs.
+     */
+    class TE_CORE_EXPORT MeshOptimizer
+    {
+    public:
+        /** Size of the FIFO post-transform vertex cache the index order is optimized for. */
+        static constexpr UINT32 VERTEX_CACHE_SIZE = 16;
+
+        /** Default max number of vertices of a meshlet. */
+        static constexpr UINT32 MAX_MESHLET_VERTICES = 64;
+
+        /** Default max number of triangles of a meshlet. */
+        static constexpr UINT32 MAX_MESHLET_TRIANGLES = 124;
+
+        /** Runs the optimization steps enabled in the import options. */
+        static void Optimize(MeshData& mesh, const MeshImportOptions& options);
+
+        /**
+         * Reorders triangles so vertices are reused while they are still in the post-transform vertex cache, using the
+         * Tipsify algorithm (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"). LODs
+         * are optimized as well.
+         */
+        static void OptimizeVertexCache(MeshData& mesh);
+
+        /**
+         * Reorders clusters of triangles so the ones facing away from the center of the mesh are drawn first, and are
+         * more likely to occlude the rest. Expects the index order to be optimized by OptimizeVertexCache() and keeps
+         * the order within clusters. Clusters are split while their cache miss ratio stays within @p threshold times
+         * the ratio of the unsplit cluster, so higher values trade vertex cache efficiency for less overdraw. LODs are
+         * optimized as well.
+         */
+        static void OptimizeOverdraw(MeshData& mesh, float threshold = 1.05f);
+
+        /**
+         * Reorders vertices in the order they are first referenced by the index buffer, so vertex fetches are mostly
+         * sequential. Vertices that aren't referenced are removed.
+         */
+        static void OptimizeVertexFetch(MeshData& mesh);
+
+        /**
+         * Splits every sub-mesh of the full detail mesh into meshlets, following the current triangle order.
+         * @p maxVertices can be at most 255, as meshlet triangles use 8-bit indices.
+         */
+        static void BuildMeshlets(MeshData& mesh, UINT32 maxVertices = MAX_MESHLET_VERTICES,
+            UINT32 maxTriangles = MAX_MESHLET_TRIANGLES);
+
+        /**
+         * Replaces normals and UVs by their 16-bit encoded versions in MeshData::PackedNormals and MeshData::PackedUVs.
+         * Normals are octahedral encoded, UVs are stored relative to the UV bounds of the mesh.
+         */
+        static void QuantizeAttributes(MeshData& mesh);
+
+        /** Decodes a normal from MeshData::PackedNormals. */
+        static Vector3 DecodeNormal(UINT32 packed);
+
+        /** Decodes a UV from MeshData::PackedUVs. */
+        static Vector2 DecodeUV(UINT32 packed, const Vector2& offset, const Vector2& scale);
+
+        /**
+         * Returns the average number of vertex cache misses per triangle (ACMR) when drawing the mesh, for a FIFO cache
+         * of the provided size. Ranges from 0.5 (ideal, for large regular meshes) to 3.
+         */
+        static float GetCacheMissRatio(const MeshData& mesh, UINT32 cacheSize = VERTEX_CACHE_SIZE);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,610 @@
+#include "Mesh/TeMeshSimplifier.h"
+#include "Mesh/TeMeshData.h"
+#include "Threading/TeTaskScheduler.h"
+
+#include <cmath>
+#include <numeric>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 INVALID_INDEX = ~0U;
+
+        /** Weight of the planes keeping borders and seams in place, relative to the planes of the triangles. */
+        constexpr double BORDER_WEIGHT = 10.0;
+
+        /**
+         * A pass collapses at most one edge per this many triangles. Costs are only updated between passes, so fewer
+         * collapses per pass give better results, at the cost of more passes.
+         */
+        constexpr UINT32 TRIANGLES_PER_COLLAPSE = 6;
+
+        /** Cosine of the max angle a triangle's normal can rotate by in a single collapse, about 75 degrees. */
+        constexpr float MAX_NORMAL_ROTATION_COS = 0.25f;
+
+        /** Symmetric 4x4 matrix giving the weighted sum of squared distances of a point to a set of planes. */
+        struct Quadric
+        {
+            double XX = 0.0, XY = 0.0, XZ = 0.0, XW = 0.0;
+            double YY = 0.0, YZ = 0.0, YW = 0.0;
+            double ZZ = 0.0, ZW = 0.0;
+            double WW = 0.0;
+            double Weight = 0.0;
+
+            /** Adds the plane a * x + b * y + c * z + d = 0, with a unit length normal. */
+            void AddPlane(const Vector3& normal, float d, double weight)
+            {
+                const double a = normal.x;
+                const double b = normal.y;
+                const double c = normal.z;
+
+                XX += a * a * weight; XY += a * b * weight; XZ += a * c * weight; XW += a * d * weight;
+                YY += b * b * weight; YZ += b * c * weight; YW += b * d * weight;
+                ZZ += c * c * weight; ZW += c * d * weight;
+                WW += (double)d * d * weight;
+                Weight += weight;
+            }
+
+            void Add(const Quadric& other)
+            {
+                XX += other.XX; XY += other.XY; XZ += other.XZ; XW += other.XW;
+                YY += other.YY; YZ += other.YZ; YW += other.YW;
+                ZZ += other.ZZ; ZW += other.ZW;
+                WW += other.WW;
+                Weight += other.Weight;
+            }
+
+            /** Returns the weighted average of the squared distances of the point to the planes. */
+            double GetError(const Vector3& point) const
+            {
+                if (Weight <= 0.0)
+                    return 0.0;
+
+                const double x = point.x;
+                const double y = point.y;
+                const double z = point.z;
+
+                const double error = x * x * XX + y * y * YY + z * z * ZZ +
+                    2.0 * (x * y * XY + x * z * XZ + y * z * YZ) + 2.0 * (x * XW + y * YW + z * ZW) + WW;
+
+                return std::max(error, 0.0) / Weight;
+            }
+        };
+
+        /** Collapse of all vertices at one position into the vertices at a neighbouring position. */
+        struct Collapse
+        {
+            UINT32 From;
+            UINT32 To;
+            double Error;
+        };
+
+        UINT64 GetEdgeKey(UINT32 from, UINT32 to)
+        {
+            return ((UINT64)from << 32) | to;
+        }
+
+        bool HasEdge(const Vector<UINT64>& sortedEdges, UINT32 from, UINT32 to)
+        {
+            return std::binary_search(sortedEdges.begin(), sortedEdges.end(), GetEdgeKey(from, to));
+        }
+
+        /** Orders positions lexicographically, so that identical positions end up next to each other. */
+        bool IsLess(const Vector3& lhs, const Vector3& rhs)
+        {
+            if (lhs.x != rhs.x)
+                return lhs.x < rhs.x;
+
+            if (lhs.y != rhs.y)
+                return lhs.y < rhs.y;
+
+            return lhs.z < rhs.z;
+        }
+
+        /**
+         * Flags the vertices at positions used by more than one sub-mesh. Sub-meshes are simplified independently, so
+         * these have to stay in place for the sub-meshes to stay connected.
+         */
+        Vector<UINT8> FindSharedVertices(const MeshData& mesh, const Vector<SubMesh>& subMeshes)
+        {
+            if (subMeshes.size() <= 1)
+                return Vector<UINT8>();
+
+            const UINT32 numVertices = (UINT32)mesh.Positions.size();
+
+            // Positions are identified by their first vertex
+            Vector<UINT32> order(numVertices);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(),
+                [&mesh](UINT32 a, UINT32 b) { return IsLess(mesh.Positions[a], mesh.Positions[b]); });
+
+            Vector<UINT32> positionIds(numVertices);
+            for (UINT32 i = 0; i < numVertices; i++)
+            {
+                const bool samePosition = i > 0 && mesh.Positions[order[i]] == mesh.Positions[order[i - 1]];
+                positionIds[order[i]] = samePosition ? positionIds[order[i - 1]] : order[i];
+            }
+
+            Vector<UINT32> owners(numVertices, INVALID_INDEX);
+            Vector<UINT8> sharedPositions(numVertices);
+
+            for (UINT32 i = 0; i < (UINT32)subMeshes.size(); i++)
+            {
+                const UINT32 end = subMeshes[i].IndexOffset + subMeshes[i].IndexCount / 3 * 3;
+                for (UINT32 j = subMeshes[i].IndexOffset; j < end; j++)
+                {
+                    const UINT32 position = positionIds[mesh.Indices[j]];
+
+                    if (owners[position] == INVALID_INDEX)
+                        owners[position] = i;
+                    else if (owners[position] != i)
+                        sharedPositions[position] = 1;
+                }
+            }
+
+            Vector<UINT8> sharedVertices(numVertices);
+            for (UINT32 i = 0; i < numVertices; i++)
+                sharedVertices[i] = sharedPositions[positionIds[i]];
+
+            return sharedVertices;
+        }
+
+        void ParallelFor(UINT32 count, const std::function<void(UINT32)>& function)
+        {
+            if (count <= 1 || !TaskScheduler::IsStarted())
+            {
+                for (UINT32 i = 0; i < count; i++)
+                    function(i);
+
+                return;
+            }
+
+            Vector<SPtr<Task>> tasks;
+            tasks.reserve(count);
+
+            for (UINT32 i = 0; i < count; i++)
+            {
+                tasks.push_back(Task::Create("MeshSimplify", [&function, i]() { function(i); }));
+                gTaskScheduler().AddTask(tasks.back());
+            }
+
+            for (auto& task : tasks)
+                task->Wait();
+        }
+    }
+
+    void MeshSimplifier::GenerateLods(MeshData& mesh, const Vector<float>& ratios)
+    {
+        mesh.Lods.clear();
+
+        Vector<float> sortedRatios;
+        for (float ratio : ratios)
+        {
+            if (ratio > 0.0f && ratio < 1.0f)
+                sortedRatios.push_back(ratio);
+        }
+
+        std::sort(sortedRatios.begin(), sortedRatios.end(), std::greater<float>());
+        sortedRatios.erase(std::unique(sortedRatios.begin(), sortedRatios.end()), sortedRatios.end());
+
+        if (sortedRatios.empty())
+            return;
+
+        // A mesh without sub-meshes is simplified as a single one
+        Vector<SubMesh> subMeshes = mesh.SubMeshes;
+        if (subMeshes.empty())
+        {
+            SubMesh subMesh;
+            subMesh.IndexCount = (UINT32)mesh.Indices.size();
+            subMeshes.push_back(subMesh);
+        }
+
+        struct SubMeshLods
+        {
+            Vector<Vector<UINT32>> Indices;
+            Vector<float> Errors;
+        };
+
+        Vector<SubMeshLods> subMeshLods(subMeshes.size());
+        const Vector<UINT8> lockedVertices = FindSharedVertices(mesh, subMeshes);
+
+        ParallelFor((UINT32)subMeshes.size(), [&](UINT32 i)
+        {
+            const SubMesh& subMesh = subMeshes[i];
+            const UINT32 numTriangles = subMesh.IndexCount / 3;
+
+            Vector<UINT32> targetTriangleCounts;
+            for (float ratio : sortedRatios)
+                targetTriangleCounts.push_back(std::max((UINT32)(numTriangles * ratio), 1U));
+
+            Simplify(mesh.Indices.data() + subMesh.IndexOffset, numTriangles * 3, mesh.Positions, lockedVertices,
+                targetTriangleCounts, subMeshLods[i].Indices, subMeshLods[i].Errors);
+        });
+
+        mesh.Lods.resize(sortedRatios.size());
+        for (size_t i = 0; i < sortedRatios.size(); i++)
+        {
+            MeshLod& lod = mesh.Lods[i];
+
+            for (size_t j = 0; j < subMeshes.size(); j++)
+            {
+                const Vector<UINT32>& indices = subMeshLods[j].Indices[i];
+
+                if (!mesh.SubMeshes.empty())
+                {
+                    SubMesh subMesh;
+                    subMesh.IndexOffset = (UINT32)lod.Indices.size();
+                    subMesh.IndexCount = (UINT32)indices.size();
+                    subMesh.MaterialName = subMeshes[j].MaterialName;
+
+                    lod.SubMeshes.push_back(subMesh);
+                }
+
+                lod.Indices.insert(lod.Indices.end(), indices.begin(), indices.end());
+                lod.Error = std::max(lod.Error, subMeshLods[j].Errors[i]);
+            }
+        }
+    }
+
+    void MeshSimplifier::Simplify(const UINT32* indices, UINT32 numIndices, const Vector<Vector3>& positions,
+        const Vector<UINT8>& lockedVertices, const Vector<UINT32>& targetTriangleCounts,
+        Vector<Vector<UINT32>>& outIndices, Vector<float>& outErrors)
+    {
+        outIndices.assign(targetTriangleCounts.size(), Vector<UINT32>());
+        outErrors.assign(targetTriangleCounts.size(), 0.0f);
+
+        // Work with local vertex indices, so memory use only depends on the size of the triangle list
+        Vector<UINT32> vertices(indices, indices + numIndices);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+        const UINT32 numVertices = (UINT32)vertices.size();
+
+        Vector<UINT32> triangles(numIndices);
+        for (UINT32 i = 0; i < numIndices; i++)
+            triangles[i] = (UINT32)(std::lower_bound(vertices.begin(), vertices.end(), indices[i]) - vertices.begin());
+
+        Vector<Vector3> localPositions(numVertices);
+        for (UINT32 i = 0; i < numVertices; i++)
+            localPositions[i] = positions[vertices[i]];
+
+        // Vertices with the same position are wedges of a single position, linked in a ring by nextWedge. Positions
+        // are identified by their first wedge.
+        Vector<UINT32> order(numVertices);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+            [&localPositions](UINT32 a, UINT32 b) { return IsLess(localPositions[a], localPositions[b]); });
+
+        Vector<UINT32> positionIds(numVertices);
+        Vector<UINT32> nextWedge(numVertices);
+
+        for (UINT32 i = 0; i < numVertices;)
+        {
+            UINT32 end = i + 1;
+            while (end < numVertices && localPositions[order[end]] == localPositions[order[i]])
+                end++;
+
+            for (UINT32 j = i; j < end; j++)
+            {
+                positionIds[order[j]] = order[i];
+                nextWedge[order[j]] = order[j + 1 < end ? j + 1 : i];
+            }
+
+            i = end;
+        }
+
+        // A position is locked if any of its wedges is
+        Vector<UINT8> lockedPositions(numVertices);
+        if (!lockedVertices.empty())
+        {
+            for (UINT32 i = 0; i < numVertices; i++)
+                lockedPositions[positionIds[i]] |= lockedVertices[vertices[i]];
+        }
+
+        Vector<UINT64> wedgeEdges;
+        Vector<UINT64> positionEdges;
+        Vector<UINT8> onBorder(numVertices);
+        Vector<UINT32> adjacencyOffsets;
+        Vector<UINT32> adjacentTriangles;
+
+        // Finds the directed edges between wedges and between positions, positions on open borders and the triangles
+        // around every position
+        auto buildTopology = [&]()
+        {
+            const UINT32 numTriangles = (UINT32)triangles.size() / 3;
+
+            wedgeEdges.clear();
+            positionEdges.clear();
+
+            for (UINT32 i = 0; i < numTriangles * 3; i++)
+            {
+                const UINT32 from = triangles[i];
+                const UINT32 to = triangles[i % 3 == 2 ? i - 2 : i + 1];
+
+                wedgeEdges.push_back(GetEdgeKey(from, to));
+                positionEdges.push_back(GetEdgeKey(positionIds[from], positionIds[to]));
+            }
+
+            std::sort(wedgeEdges.begin(), wedgeEdges.end());
+            std::sort(positionEdges.begin(), positionEdges.end());
+
+            std::fill(onBorder.begin(), onBorder.end(), 0);
+            for (UINT64 edge : positionEdges)
+            {
+                const UINT32 from = (UINT32)(edge >> 32);
+                const UINT32 to = (UINT32)edge;
+
+                if (!HasEdge(positionEdges, to, from))
+                    onBorder[from] = onBorder[to] = 1;
+            }
+
+            adjacencyOffsets.assign((size_t)numVertices + 1, 0);
+            for (UINT32 index : triangles)
+                adjacencyOffsets[positionIds[index] + 1]++;
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+            Vector<UINT32> writeOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+            adjacentTriangles.resize(triangles.size());
+            for (UINT32 i = 0; i < numTriangles * 3; i++)
+                adjacentTriangles[writeOffsets[positionIds[triangles[i]]]++] = i / 3;
+        };
+
+        auto isBorderEdge = [&](UINT32 a, UINT32 b)
+        {
+            return HasEdge(positionEdges, a, b) != HasEdge(positionEdges, b, a);
+        };
+
+        // Returns the wedge at position @p to connected to the wedge @p from by an edge
+        auto findConnectedWedge = [&](UINT32 from, UINT32 to)
+        {
+            UINT32 wedge = to;
+            do
+            {
+                if (HasEdge(wedgeEdges, from, wedge) || HasEdge(wedgeEdges, wedge, from))
+                    return wedge;
+
+                wedge = nextWedge[wedge];
+            } while (wedge != to);
+
+            return INVALID_INDEX;
+        };
+
+        // Collapsing a position is valid if every one of its wedges can be merged with a wedge of the target, which
+        // keeps seams closed, if it doesn't move borders inwards, and if the position isn't locked
+        auto canCollapse = [&](UINT32 from, UINT32 to)
+        {
+            if (lockedPositions[from])
+                return false;
+
+            if (onBorder[from] && !isBorderEdge(from, to))
+                return false;
+
+            UINT32 wedge = from;
+            do
+            {
+                if (findConnectedWedge(wedge, to) == INVALID_INDEX)
+                    return false;
+
+                wedge = nextWedge[wedge];
+            } while (wedge != from);
+
+            return true;
+        };
+
+        // Checks if moving a position would flip, or almost flip, any of the triangles around it
+        auto flipsTriangles = [&](UINT32 from, UINT32 to)
+        {
+            for (UINT32 i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++)
+            {
+                const UINT32* triangle = &triangles[adjacentTriangles[i] * 3];
+
+                Vector3 corners[3];
+                Vector3 movedCorners[3];
+                bool usesTarget = false;
+
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    const UINT32 position = positionIds[triangle[j]];
+
+                    corners[j] = localPositions[position];
+                    movedCorners[j] = position == from ? localPositions[to] : corners[j];
+                    usesTarget |= position == to;
+                }
+
+                // Triangles on the collapsed edge are removed
+                if (usesTarget)
+                    continue;
+
+                const Vector3 normal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+                const Vector3 movedNormal =
+                    (movedCorners[1] - movedCorners[0]).Cross(movedCorners[2] - movedCorners[0]);
+
+                // Not allowing rotations close to 90 degrees either, as a series of them could still flip triangles
+                if (normal.Dot(movedNormal) <= MAX_NORMAL_ROTATION_COS * normal.Length() * movedNormal.Length())
+                    return true;
+            }
+
+            return false;
+        };
+
+        buildTopology();
+
+        // Every position starts with the planes of its triangles. Planes perpendicular to the triangles along borders
+        // and seams keep them from moving.
+        Vector<Quadric> quadrics(numVertices);
+
+        for (UINT32 i = 0; i < numIndices / 3; i++)
+        {
+            const UINT32* triangle = &triangles[i * 3];
+
+            const Vector3& a = localPositions[triangle[0]];
+            const Vector3& b = localPositions[triangle[1]];
+            const Vector3& c = localPositions[triangle[2]];
+
+            Vector3 normal = (b - a).Cross(c - a);
+            const float area = normal.Normalize() * 0.5f;
+            if (area == 0.0f)
+                continue;
+
+            for (UINT32 j = 0; j < 3; j++)
+                quadrics[positionIds[triangle[j]]].AddPlane(normal, -normal.Dot(a), area);
+
+            for (UINT32 j = 0; j < 3; j++)
+            {
+                const UINT32 from = triangle[j];
+                const UINT32 to = triangle[(j + 1) % 3];
+
+                const bool border = !HasEdge(positionEdges, positionIds[to], positionIds[from]);
+                const bool seam = !border && !HasEdge(wedgeEdges, to, from);
+                if (!border && !seam)
+                    continue;
+
+                const Vector3 edge = localPositions[to] - localPositions[from];
+                Vector3 edgeNormal = edge.Cross(normal);
+                edgeNormal.Normalize();
+
+                const float d = -edgeNormal.Dot(localPositions[from]);
+                const double weight = edge.SquaredLength() * BORDER_WEIGHT;
+
+                quadrics[positionIds[from]].AddPlane(edgeNormal, d, weight);
+                quadrics[positionIds[to]].AddPlane(edgeNormal, d, weight);
+            }
+        }
+
+        Vector<Collapse> collapses;
+        Vector<UINT32> wedgeRemap(numVertices, INVALID_INDEX);
+        Vector<UINT8> locked(numVertices);
+        double maxError = 0.0;
+
+        size_t nextTarget = 0;
+        auto outputReachedTargets = [&](bool force)
+        {
+            while (nextTarget < targetTriangleCounts.size() &&
+                (force || triangles.size() / 3 <= targetTriangleCounts[nextTarget]))
+            {
+                Vector<UINT32>& output = outIndices[nextTarget];
+
+                output.resize(triangles.size());
+                for (size_t i = 0; i < triangles.size(); i++)
+                    output[i] = vertices[triangles[i]];
+
+                outErrors[nextTarget] = (float)std::sqrt(maxError);
+                nextTarget++;
+            }
+        };
+
+        outputReachedTargets(false);
+
+        while (nextTarget < targetTriangleCounts.size())
+        {
+            const UINT32 numTriangles = (UINT32)triangles.size() / 3;
+
+            // Every edge can be collapsed in both directions
+            collapses.clear();
+            for (UINT32 i = 0; i < numTriangles * 3; i++)
+            {
+                const UINT32 a = positionIds[triangles[i]];
+                const UINT32 b = positionIds[triangles[i % 3 == 2 ? i - 2 : i + 1]];
+                if (a == b)
+                    continue;
+
+                for (UINT32 j = 0; j < 2; j++)
+                {
+                    const UINT32 from = j == 0 ? a : b;
+                    const UINT32 to = j == 0 ? b : a;
+
+                    if (!canCollapse(from, to))
+                        continue;
+
+                    Quadric quadric = quadrics[from];
+                    quadric.Add(quadrics[to]);
+
+                    collapses.push_back({ from, to, quadric.GetError(localPositions[to]) });
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(),
+                [](const Collapse& a, const Collapse& b) { return a.Error < b.Error; });
+
+            // Collapse the cheapest edges whose neighbourhoods don't overlap, as costs and flips are only valid until
+            // the triangles around them change. Collapses remove about two triangles each.
+            const UINT32 trianglesToRemove = numTriangles - targetTriangleCounts[nextTarget];
+            const UINT32 maxCollapses = std::max(std::min((trianglesToRemove + 1) / 2,
+                numTriangles / TRIANGLES_PER_COLLAPSE), 1U);
+
+            std::fill(locked.begin(), locked.end(), 0);
+            UINT32 numCollapses = 0;
+
+            for (auto& collapse : collapses)
+            {
+                if (numCollapses == maxCollapses)
+                    break;
+
+                if (locked[collapse.From] || locked[collapse.To] || flipsTriangles(collapse.From, collapse.To))
+                    continue;
+
+                UINT32 wedge = collapse.From;
+                do
+                {
+                    wedgeRemap[wedge] = findConnectedWedge(wedge, collapse.To);
+                    wedge = nextWedge[wedge];
+                } while (wedge != collapse.From);
+
+                quadrics[collapse.To].Add(quadrics[collapse.From]);
+                maxError = std::max(maxError, collapse.Error);
+
+                locked[collapse.To] = 1;
+                for (UINT32 i = adjacencyOffsets[collapse.From]; i < adjacencyOffsets[collapse.From + 1]; i++)
+                {
+                    const UINT32* triangle = &triangles[adjacentTriangles[i] * 3];
+
+                    for (UINT32 j = 0; j < 3; j++)
+                        locked[positionIds[triangle[j]]] = 1;
+                }
+
+                numCollapses++;
+            }
+
+            if (numCollapses == 0)
+                break;
+
+            // Apply the collapses and remove the triangles that became degenerate
+            UINT32 numRemaining = 0;
+            for (UINT32 i = 0; i < numTriangles; i++)
+            {
+                UINT32 triangle[3];
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    const UINT32 wedge = triangles[i * 3 + j];
+                    triangle[j] = wedgeRemap[wedge] != INVALID_INDEX ? wedgeRemap[wedge] : wedge;
+                }
+
+                const UINT32 a = positionIds[triangle[0]];
+                const UINT32 b = positionIds[triangle[1]];
+                const UINT32 c = positionIds[triangle[2]];
+
+                if (a == b || b == c || a == c)
+                    continue;
+
+                for (UINT32 j = 0; j < 3; j++)
+                    triangles[numRemaining * 3 + j] = triangle[j];
+
+                numRemaining++;
+            }
+
+            triangles.resize(numRemaining * 3);
+            std::fill(wedgeRemap.begin(), wedgeRemap.end(), INVALID_INDEX);
+
+            outputReachedTargets(false);
+
+            if (nextTarget < targetTriangleCounts.size())
+                buildTopology();
+        }
+
+        outputReachedTargets(true);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    /**
+     * Generates LODs of meshes by collapsing edges in the order of their quadric error (Garland and Heckbert, "Surface
+     * Simplification Using Quadric Error Metrics"). Vertices are only collapsed into one of their neighbours, so the
+     * simplified meshes reuse the vertices of the source mesh.
+     *
+     * Vertices that share a position but have different attributes (on UV or normal seams) are collapsed together and
+     * only along the seam, so seams stay closed. Vertices on open borders only move along the border.
+     */
+    class TE_CORE_EXPORT MeshSimplifier
+    {
+    public:
+        /**
+         * Replaces MeshData::Lods with a LOD for every ratio in @p ratios, the fraction of triangles kept in the LOD.
+         * Sub-meshes are simplified in parallel on the TaskScheduler, if it is running. Positions shared by several
+         * sub-meshes are locked, so that sub-meshes stay connected.
+         */
+        static void GenerateLods(MeshData& mesh, const Vector<float>& ratios);
+
+        /**
+         * Progressively simplifies a list of triangles. Every time the number of triangles drops to one of
+         * @p targetTriangleCounts (sorted from the largest), the current triangles are output in @p outIndices, and the
+         * estimated distance to the source surface in @p outErrors. Targets that can't be reached get the most
+         * simplified triangles.
+         *
+         * Vertices flagged in @p lockedVertices, indexed like @p positions, never move, nor do the other vertices at
+         * their position. It can be left empty if no vertex is locked.
+         */
+        static void Simplify(const UINT32* indices, UINT32 numIndices, const Vector<Vector3>& positions,
+            const Vector<UINT8>& lockedVertices, const Vector<UINT32>& targetTriangleCounts,
+            Vector<Vector<UINT32>>& outIndices, Vector<float>& outErrors);
+    };
+}
\ No newline at end of file
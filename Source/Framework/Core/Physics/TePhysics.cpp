@@ -2,6 +2,17 @@
 
  namespace te
  {
+    UPDATE_DESC Physics::GetUpdateDesc() const
+    {
+        UPDATE_DESC desc;
+        desc.Name = "Physics";
+        desc.Phase = UpdatePhase::Update;
+        desc.Writes = { "Physics" };
+        desc.MainThread = true; // CoreApplication::FixedUpdate() runs together with physics
+
+        return desc;
+    }
+
     TE_CORE_EXPORT Physics& gPhysics()
     {
         return Physics::Instance();
@@ -7,6 +7,7 @@ namespace te
     /** Contains private data for the Linux Gamepad implementation. */
 	struct GamePad::Pimpl
 	{
+        UINT32 Id;
         bool HasInputFocus;
     };
 
@@ -15,6 +16,8 @@ namespace te
         , _owner(owner)
     {
         _data = te_new<Pimpl>();
+        _data->Id = gamepadInfo.Id;
+        _data->HasInputFocus = true;
     }
 
     GamePad::~GamePad()
@@ -24,6 +27,13 @@ namespace te
 
     void GamePad::Capture()
 	{
+        InputPrivateData* pvtData = _owner->GetPrivateData();
+
+        for (auto& device : pvtData->Devices)
+        {
+            if (device.Owner == EventDeviceType::Gamepad && device.GamepadIdx == _data->Id)
+                CaptureEventDevice(_owner, pvtData, device, _data->HasInputFocus);
+        }
     }
 
     void GamePad::ChangeCaptureContext(UINT64 windowHandle)
@@ -5,11 +5,671 @@
 #include "Input/TeKeyboard.h"
 #include "Input/TeGamePad.h"
 
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+
 namespace te
 {
+    #define BITS_PER_LONG (sizeof(unsigned long) * 8)
+    #define NUM_LONGS(x) (((x) + BITS_PER_LONG - 1) / BITS_PER_LONG)
+    #define TEST_BIT(bit, array) ((array[(bit) / BITS_PER_LONG] >> ((bit) % BITS_PER_LONG)) & 1)
+
+    /** Returns true if the provided file name looks like an evdev event node (e.g. "event12"). */
+    bool IsEventNodeName(const char* name)
+    {
+        return strncmp(name, "event", 5) == 0 && name[5] >= '0' && name[5] <= '9';
+    }
+
+    /** Maps an evdev gamepad button to a ButtonCode, or returns BC_UNASSIGNED if the button has no dedicated code. */
+    ButtonCode GamepadButtonToButtonCode(INT32 code)
+    {
+        switch (code)
+        {
+        case BTN_SOUTH: return BC_GAMEPAD_A;
+        case BTN_EAST: return BC_GAMEPAD_B;
+        case BTN_NORTH: return BC_GAMEPAD_X;
+        case BTN_WEST: return BC_GAMEPAD_Y;
+        case BTN_TL: return BC_GAMEPAD_LB;
+        case BTN_TR: return BC_GAMEPAD_RB;
+        case BTN_THUMBL: return BC_GAMEPAD_LS;
+        case BTN_THUMBR: return BC_GAMEPAD_RS;
+        case BTN_SELECT: return BC_GAMEPAD_BACK;
+        case BTN_START: return BC_GAMEPAD_START;
+        case BTN_DPAD_UP: return BC_GAMEPAD_DPAD_UP;
+        case BTN_DPAD_DOWN: return BC_GAMEPAD_DPAD_DOWN;
+        case BTN_DPAD_LEFT: return BC_GAMEPAD_DPAD_LEFT;
+        case BTN_DPAD_RIGHT: return BC_GAMEPAD_DPAD_RIGHT;
+        default: return BC_UNASSIGNED;
+        }
+    }
+
+    /** Maps an evdev mouse button to a ButtonCode. */
+    ButtonCode MouseButtonToButtonCode(INT32 code)
+    {
+        switch (code)
+        {
+        case BTN_LEFT: return BC_MOUSE_LEFT;
+        case BTN_RIGHT: return BC_MOUSE_RIGHT;
+        case BTN_MIDDLE: return BC_MOUSE_MIDDLE;
+        default: return (ButtonCode)(BC_MOUSE_BTN4 + (code - BTN_SIDE));
+        }
+    }
+
+    ButtonCode KeyCodeToButtonCode(INT32 code)
+    {
+        // Evdev codes up to KEY_F12 match the PC set 1 scan codes used by ButtonCode
+        if (code > KEY_RESERVED && code <= KEY_F12)
+            return (ButtonCode)code;
+
+        switch (code)
+        {
+        case KEY_RO: return BC_ABNT_C1;
+        case KEY_HENKAN: return BC_CONVERT;
+        case KEY_KATAKANAHIRAGANA: return BC_KANA;
+        case KEY_MUHENKAN: return BC_NOCONVERT;
+        case KEY_KPENTER: return BC_NUMPADENTER;
+        case KEY_RIGHTCTRL: return BC_RCONTROL;
+        case KEY_KPSLASH: return BC_DIVIDE;
+        case KEY_SYSRQ: return BC_SYSRQ;
+        case KEY_RIGHTALT: return BC_RMENU;
+        case KEY_HOME: return BC_HOME;
+        case KEY_UP: return BC_UP;
+        case KEY_PAGEUP: return BC_PGUP;
+        case KEY_LEFT: return BC_LEFT;
+        case KEY_RIGHT: return BC_RIGHT;
+        case KEY_END: return BC_END;
+        case KEY_DOWN: return BC_DOWN;
+        case KEY_PAGEDOWN: return BC_PGDOWN;
+        case KEY_INSERT: return BC_INSERT;
+        case KEY_DELETE: return BC_DELETE;
+        case KEY_MUTE: return BC_MUTE;
+        case KEY_VOLUMEDOWN: return BC_VOLUMEDOWN;
+        case KEY_VOLUMEUP: return BC_VOLUMEUP;
+        case KEY_POWER: return BC_POWER;
+        case KEY_KPEQUAL: return BC_NUMPADEQUALS;
+        case KEY_PAUSE: return BC_PAUSE;
+        case KEY_KPCOMMA: return BC_NUMPADCOMMA;
+        case KEY_YEN: return BC_YEN;
+        case KEY_LEFTMETA: return BC_LWIN;
+        case KEY_RIGHTMETA: return BC_RWIN;
+        case KEY_COMPOSE: return BC_APPS;
+        case KEY_STOP: return BC_STOP;
+        case KEY_CALC: return BC_CALCULATOR;
+        case KEY_SLEEP: return BC_SLEEP;
+        case KEY_WAKEUP: return BC_WAKE;
+        case KEY_MAIL: return BC_MAIL;
+        case KEY_BOOKMARKS: return BC_WEBFAVORITES;
+        case KEY_COMPUTER: return BC_MYCOMPUTER;
+        case KEY_BACK: return BC_WEBBACK;
+        case KEY_FORWARD: return BC_WEBFORWARD;
+        case KEY_NEXTSONG: return BC_NEXTTRACK;
+        case KEY_PLAYPAUSE: return BC_PLAYPAUSE;
+        case KEY_PREVIOUSSONG: return BC_PREVTRACK;
+        case KEY_STOPCD: return BC_MEDIASTOP;
+        case KEY_HOMEPAGE: return BC_WEBHOME;
+        case KEY_REFRESH: return BC_WEBREFRESH;
+        case KEY_F13: return BC_F13;
+        case KEY_F14: return BC_F14;
+        case KEY_F15: return BC_F15;
+        case KEY_SEARCH: return BC_WEBSEARCH;
+        case KEY_MEDIA: return BC_MEDIASELECT;
+        default: return BC_UNASSIGNED;
+        }
+    }
+
+    /** Returns the InputAxis an evdev absolute axis maps to, or -1 if the axis isn't reported. */
+    INT32 AbsCodeToAxis(INT32 code)
+    {
+        switch (code)
+        {
+        case ABS_X: return (INT32)InputAxis::LeftStickX;
+        case ABS_Y: return (INT32)InputAxis::LeftStickY;
+        case ABS_RX: return (INT32)InputAxis::RightStickX;
+        case ABS_RY: return (INT32)InputAxis::RightStickY;
+        case ABS_Z:
+        case ABS_BRAKE: return (INT32)InputAxis::LeftTrigger;
+        case ABS_RZ:
+        case ABS_GAS: return (INT32)InputAxis::RightTrigger;
+        default: return -1;
+        }
+    }
+
+    /**
+     * Fills the button and axis maps of a gamepad. @p keyBits and @p absBits are the capabilities reported by the device,
+     * or null if the node doesn't answer evdev ioctls, in which case a standard gamepad layout is assumed.
+     */
+    void BuildGamepadInfo(INT32 fd, GamePadInfo& info, const unsigned long* keyBits, const unsigned long* absBits)
+    {
+        info.ButtonMap.clear();
+        info.AxisMap.clear();
+
+        UINT32 numUnnamedButtons = 0;
+        for (INT32 code = BTN_MISC; code < KEY_MAX; code++)
+        {
+            if (code >= BTN_MOUSE && code < BTN_JOYSTICK)
+                continue;
+
+            if (code > BTN_THUMBR && code < BTN_DPAD_UP)
+                continue;
+
+            if (code > BTN_DPAD_RIGHT)
+                break;
+
+            if (keyBits != nullptr && !TEST_BIT(code, keyBits))
+                continue;
+
+            ButtonCode buttonCode = GamepadButtonToButtonCode(code);
+            if (buttonCode == BC_UNASSIGNED)
+            {
+                if (keyBits == nullptr || numUnnamedButtons >= 20)
+                    continue;
+
+                buttonCode = (ButtonCode)(BC_GAMEPAD_BTN1 + numUnnamedButtons++);
+            }
+
+            info.ButtonMap[code] = buttonCode;
+        }
+
+        for (INT32 code = ABS_X; code <= ABS_BRAKE; code++)
+        {
+            INT32 axisIdx = AbsCodeToAxis(code);
+            if (axisIdx == -1)
+                continue;
+
+            AxisInfo axisInfo;
+            axisInfo.AxisIdx = axisIdx;
+
+            bool isTrigger = axisIdx == (INT32)InputAxis::LeftTrigger || axisIdx == (INT32)InputAxis::RightTrigger;
+            axisInfo.Min = isTrigger ? 0 : GamePad::MIN_AXIS;
+            axisInfo.Max = isTrigger ? 255 : GamePad::MAX_AXIS;
+
+            if (absBits != nullptr)
+            {
+                if (!TEST_BIT(code, absBits))
+                    continue;
+
+                input_absinfo absInfo;
+                if (ioctl(fd, EVIOCGABS(code), &absInfo) == 0)
+                {
+                    axisInfo.Min = absInfo.minimum;
+                    axisInfo.Max = absInfo.maximum;
+                }
+            }
+
+            info.AxisMap[code] = axisInfo;
+        }
+    }
+
+    /**
+     * Opens the event node at the provided path, determines which kind of events it reports and registers it for
+     * polling. Returns false if the node could not be opened or reports nothing the input system is interested in.
+     */
+    bool OpenEventDevice(InputPrivateData* data, const String& path, INT32 nodeIdx)
+    {
+        for (auto& device : data->Devices)
+        {
+            if (device.Path == path && device.FileDesc != -1)
+                return false;
+        }
+
+        INT32 fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0)
+        {
+            // Permissions are usually applied by udev after the node is created, we'll retry on IN_ATTRIB
+            if (errno != EACCES)
+            {
+                TE_DEBUG("Unable to open input device " + path);
+            }
+
+            return false;
+        }
+
+        EventDevice device;
+        device.Path = path;
+        device.FileDesc = fd;
+        device.Types = 0;
+        device.GamepadIdx = 0;
+        device.Owner = EventDeviceType::Keyboard;
+        device.Ready = false;
+        device.Pollable = true;
+        device.Dropped = false;
+        device.HatState[0] = device.HatState[1] = 0;
+
+        unsigned long evBits[NUM_LONGS(EV_MAX + 1)];
+        unsigned long keyBits[NUM_LONGS(KEY_MAX + 1)];
+        unsigned long relBits[NUM_LONGS(REL_MAX + 1)];
+        unsigned long absBits[NUM_LONGS(ABS_MAX + 1)];
+        te_zero_out(evBits);
+        te_zero_out(keyBits);
+        te_zero_out(relBits);
+        te_zero_out(absBits);
+
+        bool isEvdev = ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits) >= 0;
+        if (isEvdev)
+        {
+            char name[256] = "Unknown";
+            ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+            device.Name = name;
+
+            if (TEST_BIT(EV_KEY, evBits))
+                ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+
+            if (TEST_BIT(EV_REL, evBits))
+                ioctl(fd, EVIOCGBIT(EV_REL, sizeof(relBits)), relBits);
+
+            if (TEST_BIT(EV_ABS, evBits))
+                ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+
+            if (TEST_BIT(KEY_A, keyBits) || TEST_BIT(KEY_1, keyBits))
+                device.Types |= (UINT32)EventDeviceType::Keyboard;
+
+            if (TEST_BIT(REL_X, relBits) && TEST_BIT(REL_Y, relBits))
+                device.Types |= (UINT32)EventDeviceType::Mouse;
+
+            if ((TEST_BIT(BTN_GAMEPAD, keyBits) || TEST_BIT(BTN_JOYSTICK, keyBits)) && TEST_BIT(EV_ABS, evBits))
+                device.Types |= (UINT32)EventDeviceType::Gamepad;
+        }
+        else
+        {
+            // Not an evdev node (e.g. a file with recorded input_event structures). Report everything it contains.
+            device.Name = path;
+            device.Types = (UINT32)EventDeviceType::Keyboard | (UINT32)EventDeviceType::Mouse |
+                (UINT32)EventDeviceType::Gamepad;
+        }
+
+        if (device.Types == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        if (device.Types & (UINT32)EventDeviceType::Gamepad)
+        {
+            device.Owner = EventDeviceType::Gamepad;
+
+            // Reuse the slot of a disconnected gamepad so device indices stay stable across reconnects
+            GamePadInfo* info = nullptr;
+            for (auto& entry : data->GamepadInfos)
+            {
+                if (entry.EventHandlerIdx == -1)
+                {
+                    info = &entry;
+                    break;
+                }
+            }
+
+            if (info == nullptr)
+            {
+                data->GamepadInfos.push_back(GamePadInfo());
+                info = &data->GamepadInfos.back();
+                info->Id = (UINT32)data->GamepadInfos.size() - 1;
+            }
+
+            info->Name = device.Name;
+            info->EventHandlerIdx = nodeIdx;
+            BuildGamepadInfo(fd, *info, isEvdev ? keyBits : nullptr, isEvdev ? absBits : nullptr);
+
+            device.GamepadIdx = info->Id;
+        }
+        else if (device.Types & (UINT32)EventDeviceType::Mouse)
+        {
+            device.Owner = EventDeviceType::Mouse;
+        }
+
+        if (data->EpollFd != -1)
+        {
+            epoll_event event;
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+
+            // Regular files can't be polled, they are simply read every frame
+            if (epoll_ctl(data->EpollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+                device.Pollable = false;
+        }
+        else
+        {
+            device.Pollable = false;
+        }
+
+        device.Ready = !device.Pollable;
+        data->Devices.push_back(device);
+
+        return true;
+    }
+
+    /** Closes the device and releases its gamepad slot (if any). The device is removed from the list by the caller. */
+    void CloseEventDevice(InputPrivateData* data, EventDevice& device)
+    {
+        if (device.FileDesc != -1)
+        {
+            if (device.Pollable && data->EpollFd != -1)
+                epoll_ctl(data->EpollFd, EPOLL_CTL_DEL, device.FileDesc, nullptr);
+
+            close(device.FileDesc);
+            device.FileDesc = -1;
+        }
+
+        if (device.Owner == EventDeviceType::Gamepad && device.GamepadIdx < (UINT32)data->GamepadInfos.size())
+            data->GamepadInfos[device.GamepadIdx].EventHandlerIdx = -1;
+    }
+
+    /** Processes all pending inotify notifications, opening newly created event nodes and closing removed ones. */
+    void HandleHotplug(InputPrivateData* data)
+    {
+        alignas(inotify_event) char buffer[4096];
+
+        for (;;)
+        {
+            ssize_t numRead = read(data->InotifyFd, buffer, sizeof(buffer));
+            if (numRead <= 0)
+                break;
+
+            for (char* ptr = buffer; ptr < buffer + numRead; )
+            {
+                const inotify_event* event = (const inotify_event*)ptr;
+                ptr += sizeof(inotify_event) + event->len;
+
+                if (event->len == 0 || !IsEventNodeName(event->name))
+                    continue;
+
+                String path = data->DeviceDir + "/" + event->name;
+
+                if (event->mask & (IN_CREATE | IN_ATTRIB | IN_MOVED_TO))
+                {
+                    OpenEventDevice(data, path, atoi(event->name + 5));
+                }
+                else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                {
+                    for (auto& device : data->Devices)
+                    {
+                        if (device.Path == path)
+                            CloseEventDevice(data, device);
+                    }
+                }
+            }
+        }
+    }
+
+    void CaptureEventDevice(Input* owner, InputPrivateData* data, EventDevice& device, bool report)
+    {
+        if (device.FileDesc == -1 || !device.Ready)
+            return;
+
+        INT32 relX = 0, relY = 0, relZ = 0;
+        bool mouseMoved = false;
+
+        INT32 axisValues[(UINT32)InputAxis::Count];
+        bool axisMoved[(UINT32)InputAxis::Count];
+        te_zero_out(axisMoved);
+
+        GamePadInfo* gamepadInfo = nullptr;
+        if (device.Owner == EventDeviceType::Gamepad)
+            gamepadInfo = &data->GamepadInfos[device.GamepadIdx];
+
+        input_event events[EVDEV_BUFFER_SIZE];
+        for (;;)
+        {
+            ssize_t numRead = read(device.FileDesc, events, sizeof(events));
+            if (numRead < 0)
+            {
+                // Device was unplugged, it will be cleaned up on the next update
+                if (errno == ENODEV)
+                    CloseEventDevice(data, device);
+
+                break;
+            }
+
+            if (numRead == 0)
+                break;
+
+            UINT32 numEvents = (UINT32)(numRead / sizeof(input_event));
+            for (UINT32 i = 0; i < numEvents; i++)
+            {
+                const input_event& event = events[i];
+
+                if (event.type == EV_SYN)
+                {
+                    // Kernel buffer overran, ignore everything up to the next report as the packet is incomplete
+                    if (event.code == SYN_DROPPED)
+                        device.Dropped = true;
+                    else if (event.code == SYN_REPORT)
+                        device.Dropped = false;
+
+                    continue;
+                }
+
+                if (device.Dropped || !report)
+                    continue;
+
+                UINT64 timestamp = (UINT64)event.time.tv_sec * 1000 + (UINT64)event.time.tv_usec / 1000;
+
+                switch (event.type)
+                {
+                case EV_KEY:
+                {
+                    // Ignore auto-repeat
+                    if (event.value == 2)
+                        break;
+
+                    UINT32 deviceIdx = 0;
+                    ButtonCode buttonCode = BC_UNASSIGNED;
+
+                    if (event.code >= BTN_MOUSE && event.code < BTN_JOYSTICK)
+                    {
+                        buttonCode = MouseButtonToButtonCode(event.code);
+                    }
+                    else if (gamepadInfo != nullptr && event.code >= BTN_MISC && event.code < KEY_OK)
+                    {
+                        auto found = gamepadInfo->ButtonMap.find(event.code);
+                        if (found != gamepadInfo->ButtonMap.end())
+                        {
+                            buttonCode = found->second;
+                            deviceIdx = gamepadInfo->Id;
+                        }
+                    }
+                    else
+                    {
+                        buttonCode = KeyCodeToButtonCode(event.code);
+                    }
+
+                    if (buttonCode == BC_UNASSIGNED)
+                        break;
+
+                    if (event.value)
+                        owner->NotifyButtonPressed(deviceIdx, buttonCode, timestamp);
+                    else
+                        owner->NotifyButtonReleased(deviceIdx, buttonCode, timestamp);
+                }
+                break;
+                case EV_REL:
+                {
+                    switch (event.code)
+                    {
+                    case REL_X: relX += event.value; mouseMoved = true; break;
+                    case REL_Y: relY += event.value; mouseMoved = true; break;
+                    case REL_WHEEL: relZ += event.value * 120; mouseMoved = true; break; // Match the Win32 wheel delta
+                    default: break;
+                    }
+                }
+                break;
+                case EV_ABS:
+                {
+                    if (gamepadInfo == nullptr)
+                        break;
+
+                    // DPad reported as a hat, convert into button presses
+                    if (event.code == ABS_HAT0X || event.code == ABS_HAT0Y)
+                    {
+                        INT32 hatIdx = event.code - ABS_HAT0X;
+                        INT32 value = event.value < 0 ? -1 : (event.value > 0 ? 1 : 0);
+
+                        ButtonCode negative = hatIdx == 0 ? BC_GAMEPAD_DPAD_LEFT : BC_GAMEPAD_DPAD_UP;
+                        ButtonCode positive = hatIdx == 0 ? BC_GAMEPAD_DPAD_RIGHT : BC_GAMEPAD_DPAD_DOWN;
+
+                        if (device.HatState[hatIdx] != value)
+                        {
+                            if (device.HatState[hatIdx] != 0)
+                                owner->NotifyButtonReleased(gamepadInfo->Id, device.HatState[hatIdx] < 0 ? negative : positive, timestamp);
+
+                            if (value != 0)
+                                owner->NotifyButtonPressed(gamepadInfo->Id, value < 0 ? negative : positive, timestamp);
+
+                            device.HatState[hatIdx] = value;
+                        }
+
+                        break;
+                    }
+
+                    auto found = gamepadInfo->AxisMap.find(event.code);
+                    if (found == gamepadInfo->AxisMap.end())
+                        break;
+
+                    const AxisInfo& axisInfo = found->second;
+                    bool isTrigger = axisInfo.AxisIdx == (INT32)InputAxis::LeftTrigger ||
+                        axisInfo.AxisIdx == (INT32)InputAxis::RightTrigger;
+
+                    // Remap into [MIN_AXIS, MAX_AXIS] range, or [0, MAX_AXIS] for triggers
+                    INT64 outMin = isTrigger ? 0 : GamePad::MIN_AXIS;
+                    INT64 outMax = GamePad::MAX_AXIS;
+                    INT64 range = std::max(axisInfo.Max - axisInfo.Min, 1);
+                    INT64 value = Math::Clamp(event.value, axisInfo.Min, axisInfo.Max) - axisInfo.Min;
+
+                    // Only the last value of an axis within a capture matters
+                    axisValues[axisInfo.AxisIdx] = (INT32)(outMin + (value * (outMax - outMin)) / range);
+                    axisMoved[axisInfo.AxisIdx] = true;
+                }
+                break;
+                default:
+                    break;
+                }
+            }
+
+            if ((size_t)numRead < sizeof(events))
+                break;
+        }
+
+        if (device.Pollable)
+            device.Ready = false;
+
+        if (mouseMoved)
+            owner->NotifyMouseMoved(relX, relY, relZ);
+
+        if (gamepadInfo != nullptr)
+        {
+            for (UINT32 i = 0; i < (UINT32)InputAxis::Count; i++)
+            {
+                if (axisMoved[i])
+                    owner->NotifyAxisMoved(gamepadInfo->Id, i, axisValues[i]);
+            }
+        }
+    }
+
     void Input::InitRawInput()
     {
-        // TODO
+        _platformData = te_new<InputPrivateData>();
+
+        const char* deviceDir = getenv(TE_LINUX_INPUT_DEVICE_DIR_ENV);
+        _platformData->DeviceDir = deviceDir != nullptr ? deviceDir : TE_LINUX_INPUT_DEVICE_DIR;
+
+        _platformData->EpollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (_platformData->EpollFd < 0)
+        {
+            TE_DEBUG("Unable to create epoll instance, input devices will be polled every frame");
+        }
+
+        _platformData->InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_platformData->InotifyFd >= 0)
+        {
+            int watch = inotify_add_watch(_platformData->InotifyFd, _platformData->DeviceDir.c_str(),
+                IN_CREATE | IN_ATTRIB | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM);
+
+            if (watch < 0 || _platformData->EpollFd < 0)
+            {
+                close(_platformData->InotifyFd);
+                _platformData->InotifyFd = -1;
+            }
+            else
+            {
+                epoll_event event;
+                event.events = EPOLLIN;
+                event.data.fd = _platformData->InotifyFd;
+
+                epoll_ctl(_platformData->EpollFd, EPOLL_CTL_ADD, _platformData->InotifyFd, &event);
+            }
+        }
+
+        if (_platformData->InotifyFd < 0)
+        {
+            TE_DEBUG("Unable to watch " + _platformData->DeviceDir + ", input device hotplug is disabled");
+        }
+
+        // Enumerate all attached devices
+        DIR* dir = opendir(_platformData->DeviceDir.c_str());
+        if (dir != nullptr)
+        {
+            while (dirent* entry = readdir(dir))
+            {
+                if (IsEventNodeName(entry->d_name))
+                    OpenEventDevice(_platformData, _platformData->DeviceDir + "/" + entry->d_name, atoi(entry->d_name + 5));
+            }
+
+            closedir(dir);
+        }
+
+        // Note: All keyboards and mice are merged into a single device, same as on other platforms
+        if (GetDeviceCount(InputDevice::Keyboard) > 0)
+            _keyboard = te_new<Keyboard>("Keyboard", this);
+
+        if (GetDeviceCount(InputDevice::Mouse) > 0)
+            _mouse = te_new<Mouse>("Mouse", this);
+
+        UINT32 numGamepads = GetDeviceCount(InputDevice::Gamepad);
+        for (UINT32 i = 0; i < numGamepads; i++)
+            _gamepads.push_back(te_new<GamePad>(_platformData->GamepadInfos[i].Name, _platformData->GamepadInfos[i], this));
+    }
+
+    void Input::UpdateRawInput()
+    {
+        if (_platformData->EpollFd != -1)
+        {
+            epoll_event events[EPOLL_BUFFER_SIZE];
+
+            INT32 numEvents;
+            do
+            {
+                numEvents = epoll_wait(_platformData->EpollFd, events, EPOLL_BUFFER_SIZE, 0);
+
+                for (INT32 i = 0; i < numEvents; i++)
+                {
+                    if (events[i].data.fd == _platformData->InotifyFd)
+                    {
+                        HandleHotplug(_platformData);
+                        continue;
+                    }
+
+                    for (auto& device : _platformData->Devices)
+                    {
+                        if (device.FileDesc == events[i].data.fd)
+                        {
+                            device.Ready = true;
+                            break;
+                        }
+                    }
+                }
+            } while (numEvents == EPOLL_BUFFER_SIZE);
+        }
+
+        // Remove devices that were unplugged
+        _platformData->Devices.erase(std::remove_if(_platformData->Devices.begin(), _platformData->Devices.end(),
+            [](const EventDevice& device) { return device.FileDesc == -1; }), _platformData->Devices.end());
+
+        // Create gamepads for newly connected devices. Slots of disconnected gamepads are reused, so never removed.
+        for (UINT32 i = (UINT32)_gamepads.size(); i < (UINT32)_platformData->GamepadInfos.size(); i++)
+            _gamepads.push_back(te_new<GamePad>(_platformData->GamepadInfos[i].Name, _platformData->GamepadInfos[i], this));
     }
 
     void Input::CleanUpRawInput()
@@ -29,6 +689,21 @@ namespace te
             te_delete(gamepad);
         }
 
+        for (auto& device : _platformData->Devices)
+        {
+            CloseEventDevice(_platformData, device);
+        }
+
+        if (_platformData->InotifyFd != -1)
+        {
+            close(_platformData->InotifyFd);
+        }
+
+        if (_platformData->EpollFd != -1)
+        {
+            close(_platformData->EpollFd);
+        }
+
         te_delete(_platformData);
     }
 
@@ -43,4 +718,4 @@ namespace te
             case InputDevice::Count: return 0;
         }
     }
-}
\ No newline at end of file
+}
@@ -3,33 +3,94 @@
 #include "TeCorePrerequisites.h"
 #include "Input/TeInputData.h"
 
+#include <linux/input.h>
+
 namespace te
 {
+    /** Default directory scanned (and watched for hotplug) for evdev event nodes. */
+    #define TE_LINUX_INPUT_DEVICE_DIR "/dev/input"
+
+    /**
+     * Environment variable that can be used to point the input system to another directory of event nodes. Useful on
+     * headless machines where devices are created through uinput, or where recorded event streams are replayed.
+     */
+    #define TE_LINUX_INPUT_DEVICE_DIR_ENV "TE_INPUT_DEVICE_DIR"
+
+    /** Max number of evdev events read from a device with a single read() call. */
+    #define EVDEV_BUFFER_SIZE 64
+
+    /** Max number of epoll events collected per frame. */
+    #define EPOLL_BUFFER_SIZE 32
+
     /** Infomation about an analog axis that's part of a gamepad. */
-	struct AxisInfo
-	{
-		INT32 AxisIdx;
-		INT32 Min;
-		INT32 Max;
-	};
-
-	/** Information about a gamepad. */
-	struct GamepadInfo
-	{
-		UINT32 Id;
-		UINT32 EventHandlerIdx;
-		String Name;
-
-		UnorderedMap<INT32, ButtonCode> ButtonMap;
-		UnorderedMap<INT32, AxisInfo> AxisMap;
-	};
-
-	/**
-	 * Data specific to Linux implementation of the input system. Can be passed to platform specific implementations of
-	 * the individual device types.
-	 */
-	struct InputPrivateData
-	{
-		Vector<GamepadInfo> GamepadInfos;
-	};
-}
\ No newline at end of file
+    struct AxisInfo
+    {
+        INT32 AxisIdx;
+        INT32 Min;
+        INT32 Max;
+    };
+
+    /** Information about a gamepad. */
+    struct GamePadInfo
+    {
+        UINT32 Id;
+        INT32 EventHandlerIdx;
+        String Name;
+
+        UnorderedMap<INT32, ButtonCode> ButtonMap;
+        UnorderedMap<INT32, AxisInfo> AxisMap;
+    };
+
+    /** Kind of events an evdev node is able to report. A single node can be more than one kind. */
+    enum class EventDeviceType
+    {
+        Keyboard = 1 << 0,
+        Mouse = 1 << 1,
+        Gamepad = 1 << 2
+    };
+
+    /** A single opened evdev event node (e.g. /dev/input/event3). */
+    struct EventDevice
+    {
+        String Path;
+        String Name;
+        INT32 FileDesc;
+        UINT32 Types; /**< Combination of EventDeviceType flags. */
+        EventDeviceType Owner; /**< Device type whose Capture() reads this node. */
+        UINT32 GamepadIdx; /**< Index into InputPrivateData::GamepadInfos, if the node is a gamepad. */
+
+        /**
+         * True if epoll reported the device as readable since the last capture. Nodes that can't be registered with epoll
+         * (regular files containing recorded events) are always considered ready.
+         */
+        bool Ready;
+        bool Pollable;
+        bool Dropped; /**< Kernel reported SYN_DROPPED, events are skipped until the next SYN_REPORT. */
+
+        INT32 HatState[2]; /**< Last reported values of ABS_HAT0X and ABS_HAT0Y. */
+    };
+
+    /**
+     * Data specific to Linux implementation of the input system. Can be passed to platform specific implementations of
+     * the individual device types.
+     */
+    struct InputPrivateData
+    {
+        INT32 EpollFd;
+        INT32 InotifyFd;
+        String DeviceDir;
+
+        Vector<EventDevice> Devices;
+        Vector<GamePadInfo> GamepadInfos;
+    };
+
+    /**
+     * Reads all pending events from the provided device and reports them to the owner Input. Events are read in batches
+     * of EVDEV_BUFFER_SIZE and relative mouse movement is accumulated so a single NotifyMouseMoved() call is made per
+     * capture. If @p report is false the events are drained and discarded (e.g. when the application has no input focus).
+     */
+    void CaptureEventDevice(Input* owner, InputPrivateData* data, EventDevice& device, bool report);
+
+    /** Converts an evdev KEY_* code into a ButtonCode. Returns BC_UNASSIGNED for unknown keys. */
+    ButtonCode KeyCodeToButtonCode(INT32 code);
+}
@@ -5,6 +5,7 @@
 
 namespace te
 {
+    /** Contains private data for the Linux Keyboard implementation. */
     struct Keyboard::Pimpl
 	{
 		bool HasInputFocus;
@@ -25,6 +26,14 @@ namespace te
 
     void Keyboard::Capture()
 	{
+		InputPrivateData* pvtData = _owner->GetPrivateData();
+
+		// Evdev events aren't tied to a window, so they are drained but not reported while out of focus
+		for (auto& device : pvtData->Devices)
+		{
+			if (device.Owner == EventDeviceType::Keyboard)
+				CaptureEventDevice(_owner, pvtData, device, _data->HasInputFocus);
+		}
     }
 
     void Keyboard::ChangeCaptureContext(UINT64 windowHandle)
@@ -12,6 +12,9 @@ namespace te
         // TODO
     }
 
+    void Input::UpdateRawInput()
+    { }
+
     void Input::CleanUpRawInput()
     {
         if (_mouse != nullptr)
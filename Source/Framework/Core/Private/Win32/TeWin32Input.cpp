@@ -189,6 +189,9 @@ namespace te
             _gamepads.push_back(te_new<GamePad>(_platformData->GamepadInfos[i].Name, _platformData->GamepadInfos[i], this));
     }
 
+    void Input::UpdateRawInput()
+    { }
+
     void Input::CleanUpRawInput()
     {
         if (_mouse != nullptr)
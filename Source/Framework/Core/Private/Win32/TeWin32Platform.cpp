@@ -45,6 +45,9 @@ namespace te
     bool IsShiftPressed = false;
     bool IsCtrlPressed = false;
 
+    /** First half of a surrogate pair received through WM_CHAR, waiting for the second half. */
+    UINT32 HighSurrogate = 0;
+
     /** Checks if any of the windows of the current application are active. */
     bool IsAppActive(Platform::Pimpl* data)
     {
@@ -628,6 +631,23 @@ namespace te
                     {
                         UINT32 finalChar = (UINT32)wParam;
 
+                        // Characters outside of the BMP are sent as two UTF-16 surrogates, one message each
+                        if (finalChar >= 0xD800 && finalChar <= 0xDBFF)
+                        {
+                            HighSurrogate = finalChar;
+                            return 0;
+                        }
+
+                        if (finalChar >= 0xDC00 && finalChar <= 0xDFFF)
+                        {
+                            if (HighSurrogate == 0)
+                                return 0;
+
+                            finalChar = 0x10000 + ((HighSurrogate - 0xD800) << 10) + (finalChar - 0xDC00);
+                        }
+
+                        HighSurrogate = 0;
+
                         if (!OnCharInput.Empty())
                             OnCharInput(finalChar);
 
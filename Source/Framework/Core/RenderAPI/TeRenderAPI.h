@@ -5,6 +5,15 @@
 
 namespace te
 {
+    /** Counters of the work submitted to a render API. Useful for validating and benchmarking the frame on any backend. */
+    struct RenderAPIStats
+    {
+        UINT64 NumFrames = 0; /**< Number of times the render API was updated. */
+        UINT64 NumWindowsCreated = 0;
+        UINT64 NumWindowUpdates = 0; /**< Number of window updates (presented frames) across all windows. */
+        UINT64 NumWindowResizes = 0;
+    };
+
     class TE_CORE_EXPORT RenderAPI : public Module<RenderAPI>
     {
     public:
@@ -15,5 +24,11 @@ namespace te
 
         virtual void Initialize() = 0;
         virtual void Update() = 0;
+
+        /**
+         * Returns counters of the work submitted so far. Render APIs that don't keep track of their work return all
+         * zeroes.
+         */
+        virtual RenderAPIStats GetStats() const { return RenderAPIStats(); }
     };
 }
\ No newline at end of file
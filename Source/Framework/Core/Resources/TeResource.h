@@ -20,13 +20,25 @@ namespace te
         /**	Retrieves meta-data containing various information describing a resource. */
         SPtr<ResourceMetaData> GetMetaData() const { return _metaData; }
 
+        /** Returns the name of the resource type. Used for grouping resources, e.g. in memory statistics. */
+        virtual String GetTypeName() const { return "Resource"; }
+
+        /** Returns the amount of memory used by the resource, in bytes. */
+        UINT32 GetSize() const { return mSize; }
+
         /**	Returns whether or not this resource is allowed to be asynchronously loaded. */
         virtual bool AllowAsyncLoading() const { return true; }
 
     protected:
-        friend class Resources;
+        friend class ResourceManager;
         friend class ResourceHandleBase;
 
+        /**
+         * Called on the sim thread once the resource data has been loaded, before the resource is made available
+         * through its handle. Use this for work that can't be done on a worker thread (e.g. creating GPU objects).
+         */
+        virtual void Initialize() { }
+
         /**	Retrieves a list of all resources that this resource depends on. */
         virtual void GetResourceDependencies(Vector<HResource>& dependencies) const { }
 
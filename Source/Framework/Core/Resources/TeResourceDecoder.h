@@ -0,0 +1,33 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    enum class ResourceLoadFlag;
+
+    /**
+     * Converts the raw contents of a file into a resource. Decoders are registered with the ResourceManager for one or
+     * more file extensions.
+     *
+     * @note	Decode() is called from TaskScheduler threads and must be thread safe.
+     */
+    class TE_CORE_EXPORT ResourceDecoder
+    {
+    public:
+        virtual ~ResourceDecoder() = default;
+
+        /**
+         * Creates a resource from the contents of a file. Returns null if the data can't be decoded.
+         *
+         * Decoders of resources that reference other resources should request them with ResourceManager::LoadAsync()
+         * when @p loadFlags contains ResourceLoadFlag::LoadDependencies, so dependencies load in parallel with the
+         * resource itself.
+         *
+         * @param[in]	filePath	Path the data was read from.
+         * @param[in]	data		Contents of the file.
+         * @param[in]	loadFlags	Flags the load was requested with.
+         */
+        virtual SPtr<Resource> Decode(const String& filePath, const Vector<UINT8>& data, ResourceLoadFlag loadFlags) = 0;
+    };
+}
\ No newline at end of file
@@ -1,11 +1,82 @@
 #include "TeCorePrerequisites.h"
 #include "Resources/TeResourceHandle.h"
 #include "Resources/TeResource.h"
+#include "Resources/TeResourceManager.h"
 
 namespace te
 {
-    Signal ResourceHandleBase::_resourceCreatedCondition;
-	Mutex ResourceHandleBase::_resourceCreatedMutex;
+    namespace
+    {
+        /**
+         * Recycles the memory of handle data, so that creating handles doesn't go through the general purpose
+         * allocator. Memory is never returned to the system, so handles destroyed during static destruction stay safe.
+         */
+        class ResourceHandleDataPool
+        {
+        public:
+            static constexpr UINT32 ELEMENTS_PER_BLOCK = 128;
+
+            void* Allocate()
+            {
+                Lock lock(_mutex);
+
+                if (_freeList == nullptr)
+                {
+                    constexpr UINT32 elementSize = (UINT32)sizeof(Element);
+                    UINT8* block = (UINT8*)te_allocate(elementSize * ELEMENTS_PER_BLOCK);
+
+                    for (UINT32 i = 0; i < ELEMENTS_PER_BLOCK; i++)
+                    {
+                        Element* element = (Element*)(block + i * elementSize);
+                        element->Next = _freeList;
+                        _freeList = element;
+                    }
+                }
+
+                Element* element = _freeList;
+                _freeList = element->Next;
+
+                return element;
+            }
+
+            void Free(void* data)
+            {
+                Lock lock(_mutex);
+
+                Element* element = (Element*)data;
+                element->Next = _freeList;
+                _freeList = element;
+            }
+
+        private:
+            union Element
+            {
+                Element* Next;
+                alignas(ResourceHandleData) UINT8 Data[sizeof(ResourceHandleData)];
+            };
+
+            Mutex _mutex;
+            Element* _freeList = nullptr;
+        };
+
+        ResourceHandleDataPool& GetHandleDataPool()
+        {
+            // Never destroyed, see ResourceHandleDataPool
+            static ResourceHandleDataPool* pool = te_new<ResourceHandleDataPool>();
+            return *pool;
+        }
+    }
+
+    ResourceHandleData* ResourceHandleData::Create()
+    {
+        return new (GetHandleDataPool().Allocate()) ResourceHandleData();
+    }
+
+    void ResourceHandleData::Destroy(ResourceHandleData* data)
+    {
+        data->~ResourceHandleData();
+        GetHandleDataPool().Free(data);
+    }
 
     bool ResourceHandleBase::IsLoaded(bool checkDependencies) const
 	{
@@ -24,10 +95,10 @@ namespace te
 
         if (!_data->_isCreated)
         {
-            Lock lock(_resourceCreatedMutex);
-            while (!_data->_isCreated)
+            Lock lock(_data->_createdMutex);
+            while (!_data->_isCreated && !_data->_isFailed)
             {
-                _resourceCreatedCondition.wait(lock);
+                _data->_createdCondition.wait(lock);
             }
 
             // Send out ResourceListener events right away, as whatever called this method
@@ -36,23 +107,42 @@ namespace te
             //TODO
         }
 
-        if (waitForDependencies)
+        if (waitForDependencies && _data->_ptr != nullptr)
         {
-            //TODO
+            Vector<HResource> dependencies;
+            _data->_ptr->GetResourceDependencies(dependencies);
+
+            for (auto& dependency : dependencies)
+            {
+                if (dependency != nullptr)
+                    dependency.BlockUntilLoaded(waitForDependencies);
+            }
         }
     }
 
     void ResourceHandleBase::Release()
     {
-        //gResources().release(*this);
-        //TODO
+        if (_data != nullptr && ResourceManager::IsStarted())
+            gResourceManager().Release(*this);
     }
 
-    void ResourceHandleBase::Destroy()
+    void ResourceHandleBase::ReleaseLastRef()
     {
-        //if (_data->_ptr)
-        //    gResources().destroy(*this);
-        //TODO
+        // The manager decides under its lock, so it never races with a handle being revived from its cache
+        if (ResourceManager::IsStarted())
+        {
+            gResourceManager().NotifyUnreferenced(_data);
+            return;
+        }
+
+        const UINT32 refCount = _data->_refCount.fetch_sub(1, std::memory_order_acq_rel);
+        if ((refCount & ResourceHandleData::COUNT_MASK) != 1)
+            return;
+
+        _data->_ptr = nullptr;
+
+        if ((refCount & ResourceHandleData::REGISTERED_FLAG) == 0)
+            ResourceHandleData::Destroy(_data);
     }
 
     void ResourceHandleBase::SetHandleData(const SPtr<Resource> & ptr, const UUID & uuid)
@@ -65,12 +155,13 @@ namespace te
 
             if (!_data->_isCreated)
             {
-                Lock lock(_resourceCreatedMutex);
                 {
+                    Lock lock(_data->_createdMutex);
                     _data->_isCreated = true;
+                    _data->_isFailed = false;
                 }
 
-                _resourceCreatedCondition.notify_all();
+                _data->_createdCondition.notify_all();
             }
         }
     }
@@ -79,10 +170,20 @@ namespace te
     {
         _data->_ptr = nullptr;
 
-        Lock lock(_resourceCreatedMutex);
+        Lock lock(_data->_createdMutex);
         _data->_isCreated = false;
     }
 
+    void ResourceHandleBase::NotifyLoadFailed()
+    {
+        {
+            Lock lock(_data->_createdMutex);
+            _data->_isFailed = true;
+        }
+
+        _data->_createdCondition.notify_all();
+    }
+
     void ResourceHandleBase::AddInternalRef()
     {
         _data->_refCount.fetch_add(1, std::memory_order_relaxed);
@@ -102,4 +203,12 @@ namespace te
         }
 #endif
     }
+
+    HResource GetLoadedResourceHandle(const UUID& uuid)
+    {
+        if (!ResourceManager::IsStarted())
+            return HResource();
+
+        return gResourceManager().Get(uuid);
+    }
 }
\ No newline at end of file
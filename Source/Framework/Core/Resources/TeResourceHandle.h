@@ -3,16 +3,37 @@
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Threading/TeThreading.h"
 #include "Utility/TeUUID.h"
+#include "Serialization/TeBinarySerializer.h"
 
 namespace te
 {
-    /**	Data that is shared between all resource handles. */
+    /**
+     * Data that is shared between all resource handles. Allocated from a pool, and reference counted intrusively by the
+     * handles, so that copying a handle only touches a single atomic.
+     */
 	struct TE_CORE_EXPORT ResourceHandleData
 	{
+		/** Set in the reference count while the ResourceManager keeps the data registered, which keeps it alive. */
+		static constexpr UINT32 REGISTERED_FLAG = 1U << 31;
+
+		/** Bits of the reference count holding the number of references. */
+		static constexpr UINT32 COUNT_MASK = REGISTERED_FLAG - 1;
+
 		SPtr<Resource> _ptr;
 		UUID _uuid;
-		bool _isCreated = false;
-		std::atomic<std::uint32_t> _refCount{0};
+		std::atomic<bool> _isCreated{false};
+		std::atomic<bool> _isFailed{false}; /**< Set if the resource was being loaded but the load failed. */
+		std::atomic<UINT32> _refCount{0}; /**< Number of references, plus REGISTERED_FLAG. */
+
+		/** Used for waking threads waiting on this particular resource to load. */
+		Mutex _createdMutex;
+		Signal _createdCondition;
+
+		/** Allocates new handle data from the pool. */
+		static ResourceHandleData* Create();
+
+		/** Destroys handle data and returns its memory to the pool. */
+		static void Destroy(ResourceHandleData* data);
 	};
 
     /**
@@ -32,14 +53,15 @@ namespace te
 		bool IsLoaded(bool checkDependencies = true) const;
 
 		/**
-		 * Blocks the current thread until the resource is fully loaded.		
-		 * @note	Careful not to call this on the thread that does the loading.
+		 * Blocks the current thread until the resource is fully loaded, or its load fails.
+		 * @note	Careful not to call this on the thread that does the loading. Resources loaded asynchronously are only
+		 *			made available during ResourceManager::Update(), so the sim thread must not block on them either.
 		 */
 		void BlockUntilLoaded(bool waitForDependencies = true) const;
 
 		/**
-		 * Releases an internal reference to this resource held by the resources system, if there is one.		
-		 * @see		Resources::Release(ResourceHandleBase&)
+		 * Tells the resource system not to keep this resource cached once it is no longer referenced.
+		 * @see		ResourceManager::Release(ResourceHandleBase&)
 		 */
 		void Release();
 
@@ -49,11 +71,41 @@ namespace te
 	public: // ***** INTERNAL ******
 		
 		/**	Gets the handle data. For internal use only. */
-		const SPtr<ResourceHandleData>& GetHandleData() const { return _data; }
+		ResourceHandleData* GetHandleData() const { return _data; }
 
 	protected:
-		/**	Destroys the resource the handle is pointing to. */
-		void Destroy();
+		/** Increments the reference count of the handle data. */
+		void AddRef()
+		{
+			if (_data != nullptr)
+				_data->_refCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/** Decrements the reference count of the handle data. Doesn't clear the data pointer. */
+		void ReleaseRef()
+		{
+			if (_data == nullptr)
+				return;
+
+			// Only the last reference needs the slow path, other ones are dropped with a single atomic operation
+			UINT32 refCount = _data->_refCount.load(std::memory_order_relaxed);
+			while ((refCount & ResourceHandleData::COUNT_MASK) > 1)
+			{
+				if (_data->_refCount.compare_exchange_weak(refCount, refCount - 1, std::memory_order_release,
+					std::memory_order_relaxed))
+				{
+					return;
+				}
+			}
+
+			ReleaseLastRef();
+		}
+
+		/**
+		 * Called when the last reference to the resource might go away. Lets the resource system cache or destroy the
+		 * resource, and destroys the handle data once nothing references it anymore.
+		 */
+		void ReleaseLastRef();
 
 		/**
 		 * Sets the created flag to true and assigns the resource pointer. Called by the constructors, or if you 
@@ -73,6 +125,9 @@ namespace te
 		 */
 		void ClearHandleData();
 
+		/** Marks the load of the resource as failed and wakes up any threads waiting for it. */
+		void NotifyLoadFailed();
+
 		/** Increments the reference count of the handle. Only to be used by Resources for keeping internal references. */
 		void AddInternalRef();
 
@@ -84,14 +139,11 @@ namespace te
 		 * @note	
 		 * All handles to the same source must share this same handle data. Otherwise things like counting number of 
 		 * references or replacing pointed to resource become impossible without additional logic. */
-		SPtr<ResourceHandleData> _data;
+		ResourceHandleData* _data = nullptr;
 
 	private:
 		friend class ResourceManager;
 
-		static Signal _resourceCreatedCondition;
-		static Mutex _resourceCreatedMutex;
-
 	protected:
 		void AbortIfNotLoaded() const;
 	};
@@ -110,7 +162,10 @@ namespace te
         }
 
         /** Move constructor. */
-        TResourceHandle(TResourceHandle&& other) = default;
+        TResourceHandle(TResourceHandle&& other)
+        {
+            this->_data = std::exchange(other._data, nullptr);
+        }
 
         ~TResourceHandle()
         {
@@ -211,29 +266,13 @@ namespace te
 
     protected:
         friend ResourceManager;
+        template<class _Ty>
+        friend class TResourceHandle;
+        template<class _Ty>
+        friend class TBorrowedResourceHandle;
         template<class _Ty1, class _Ty2>
         friend TResourceHandle<_Ty1> static_resource_cast(const TResourceHandle<_Ty2>& other);
 
-        void AddRef()
-        {
-            if (_data)
-                _data->_refCount.fetch_add(1, std::memory_order_relaxed);
-        };
-
-        void ReleaseRef()
-        {
-            if (_data)
-            {
-                std::uint32_t refCount = _data->_refCount.fetch_sub(1, std::memory_order_release);
-
-                if (refCount == 1)
-                {
-                    std::atomic_thread_fence(std::memory_order_acquire);
-                    Destroy();
-                }
-            }
-        };
-
         /**
          * Constructs a new valid handle for the provided resource with the provided UUID.
          *
@@ -242,7 +281,7 @@ namespace te
         explicit TResourceHandle(T* ptr, const UUID& uuid)
             : ResourceHandleBase()
         {
-            this->_data = te_shared_ptr_new<ResourceHandleData>();
+            this->_data = ResourceHandleData::Create();
             this->AddRef();
 
             this->SetHandleData(SPtr<Resource>(ptr), uuid);
@@ -254,7 +293,7 @@ namespace te
          */
         TResourceHandle(const UUID& uuid)
         {
-            this->_data = te_shared_ptr_new<ResourceHandleData>();
+            this->_data = ResourceHandleData::Create();
             this->_data->_uuid = uuid;
 
             this->AddRef();
@@ -263,18 +302,21 @@ namespace te
         /**	Constructs a new valid handle for the provided resource with the provided UUID. */
         TResourceHandle(const SPtr<T> ptr, const UUID& uuid)
         {
-            this->_data = te_shared_ptr_new<ResourceHandleData>();
+            this->_data = ResourceHandleData::Create();
             this->AddRef();
 
             SetHandleData(ptr, uuid);
         }
 
         /**	Replaces the internal handle data pointer, effectively transforming the handle into a different handle. */
-        void SetHandleData(const SPtr<ResourceHandleData>& data)
+        void SetHandleData(ResourceHandleData* data)
         {
+            // Reference the new data first, so assigning a handle to itself never drops the last reference
+            if (data != nullptr)
+                data->_refCount.fetch_add(1, std::memory_order_relaxed);
+
             this->ReleaseRef();
             this->_data = data;
-            this->AddRef();
         }
 
         using ResourceHandleBase::SetHandleData;
@@ -285,7 +327,7 @@ namespace te
     bool operator==(const TResourceHandle<_Ty1>& _Left, const TResourceHandle<_Ty2>& _Right)
     {
         if (_Left.GetHandleData() != nullptr && _Right.GetHandleData() != nullptr)
-            return _Left.GetHandleData()->mPtr == _Right.GetHandleData()->mPtr;
+            return _Left.GetHandleData()->_ptr == _Right.GetHandleData()->_ptr;
 
         return _Left.GetHandleData() == _Right.GetHandleData();
     }
@@ -294,7 +336,7 @@ namespace te
     template<class _Ty1, class _Ty2>
     bool operator==(const TResourceHandle<_Ty1>& _Left, std::nullptr_t  _Right)
     {
-        return _Left.GetHandleData() == nullptr || _Left.GetHandleData()->mUUID.empty();
+        return _Left.GetHandleData() == nullptr || _Left.GetHandleData()->_uuid.Empty();
     }
 
     template<class _Ty1, class _Ty2>
@@ -313,7 +355,110 @@ namespace te
         return handle;
     }
 
+    /**
+     * Non-owning reference to a resource, for code that only uses resources kept alive by other handles, like render
+     * queues and other per-frame loops. Borrowed handles aren't reference counted, so copying one is as cheap as
+     * copying a pointer.
+     *
+     * @note	A borrowed handle must not be used once every TResourceHandle to its resource is gone. Use Lock() to get
+     *			an owning handle back, e.g. to keep the resource alive past the current frame.
+     */
+    template<typename T>
+    class TBorrowedResourceHandle
+    {
+    public:
+        TBorrowedResourceHandle() = default;
+        TBorrowedResourceHandle(std::nullptr_t) { }
+
+        /** Borrows the resource referenced by a handle. */
+        TBorrowedResourceHandle(const TResourceHandle<T>& handle)
+            : _data(handle.GetHandleData())
+        { }
+
+        /**
+         * Returns internal resource pointer.
+         *
+         * @note	Throws exception if handle is invalid.
+         */
+        T* operator->() const { return get(); }
+
+        /**
+         * Returns internal resource pointer and dereferences it.
+         *
+         * @note	Throws exception if handle is invalid.
+         */
+        T& operator*() const { return *get(); }
+
+        /**
+         * Returns internal resource pointer.
+         *
+         * @note	Throws exception if handle is invalid.
+         */
+        T* get() const
+        {
+            TE_ASSERT_ERROR(IsLoaded(), "Trying to access a resource that hasn't been loaded yet.");
+            return reinterpret_cast<T*>(_data->_ptr.get());
+        }
+
+        /** Checks if the resource is loaded. Doesn't check its dependencies. */
+        bool IsLoaded() const { return _data != nullptr && _data->_isCreated && _data->_ptr != nullptr; }
+
+        /** Returns the UUID of the resource the handle is referring to. */
+        const UUID& GetUUID() const { return _data != nullptr ? _data->_uuid : UUID::EMPTY; }
+
+        /** Returns an owning handle to the resource. */
+        TResourceHandle<T> Lock() const
+        {
+            TResourceHandle<T> handle;
+            handle.SetHandleData(_data);
+
+            return handle;
+        }
+
+        /** Checks if the handle references a resource. */
+        explicit operator bool() const { return _data != nullptr && !_data->_uuid.Empty(); }
+
+        bool operator==(const TBorrowedResourceHandle& rhs) const { return _data == rhs._data; }
+        bool operator!=(const TBorrowedResourceHandle& rhs) const { return _data != rhs._data; }
+
+    private:
+        ResourceHandleData* _data = nullptr;
+    };
+
     /** @copydoc ResourceHandleBase */
     template <typename T>
     using ResourceHandle = TResourceHandle<T>;
+
+    /** @copydoc TBorrowedResourceHandle */
+    template <typename T>
+    using BorrowedResourceHandle = TBorrowedResourceHandle<T>;
+
+    /** Returns a handle to the resource with the provided UUID if it is currently loaded, or an empty handle otherwise. */
+    TE_CORE_EXPORT ResourceHandle<Resource> GetLoadedResourceHandle(const UUID& uuid);
+
+    /**
+     * Resource handles are serialized as the UUID of the resource they point to. When read the handle is resolved
+     * against the resources currently loaded by the ResourceManager, so dependencies need to be loaded first.
+     */
+    template<class T>
+    struct SerializableType<TResourceHandle<T>>
+    {
+        static constexpr bool FixedLayout = false;
+
+        static void Write(const TResourceHandle<T>& value, BinaryWriter& writer)
+        {
+            writer.Write(value.GetUUID());
+        }
+
+        static void Read(TResourceHandle<T>& value, BinaryReader& reader)
+        {
+            UUID uuid;
+            reader.Read(uuid);
+
+            if (uuid.Empty())
+                value = TResourceHandle<T>();
+            else
+                value = static_resource_cast<T>(GetLoadedResourceHandle(uuid));
+        }
+    };
 }
\ No newline at end of file
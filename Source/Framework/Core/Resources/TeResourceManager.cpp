@@ -1,8 +1,14 @@
 #include "Resources/TeResourceManager.h"
 #include "Resources/TeResource.h"
+#include "Resources/TeResourceDecoder.h"
+#include "FileSystem/TeFileSystem.h"
+#include "FileSystem/TeDataStream.h"
+#include "FileSystem/TePackArchive.h"
+#include "FileSystem/TeIOScheduler.h"
 #include "Threading/TeTaskScheduler.h"
 #include "Utility/TeUUID.h"
 #include "Utility/TeUtility.h"
+#include "Utility/TeTime.h"
 
 namespace te
 {
@@ -14,9 +20,642 @@ namespace te
 	{
 	}
 
+    void ResourceManager::OnStartUp()
+    { }
+
+    void ResourceManager::OnShutDown()
+    {
+        // Decode tasks reference the requests, make sure none of them outlive the manager
+        Vector<SPtr<LoadRequest>> requests;
+        {
+            Lock lock(_mutex);
+            for (auto& entry : _inProgressLoads)
+                requests.push_back(entry.second);
+
+            _inProgressLoads.clear();
+            _finalizeQueue = Queue<SPtr<LoadRequest>>();
+        }
+
+        for (auto& request : requests)
+        {
+            // Completion of the read queues the decode task
+            if (request->Read != nullptr)
+            {
+                request->Read->Wait();
+                request->Read = nullptr;
+            }
+
+            if (request->DecodeTask != nullptr)
+                request->DecodeTask->Wait();
+
+            // Loads that didn't finish won't be finalized anymore, don't leave anyone waiting on them
+            if (request->CurrentState != LoadRequest::Finalized)
+                request->Handle.NotifyLoadFailed();
+        }
+
+        // Releases the handles held by the requests, must happen while the manager is still fully alive
+        requests.clear();
+
+        // Cached resources have no handles left, nothing else will destroy them
+        ClearCache();
+
+        // Resources still referenced stay alive, their handle data is destroyed along with their last handle
+        {
+            Lock lock(_mutex);
+            for (auto& entry : _loadedResources)
+            {
+                ResourceHandleData* data = entry.second.Data;
+                const UINT32 refCount =
+                    data->_refCount.fetch_and(ResourceHandleData::COUNT_MASK, std::memory_order_acq_rel);
+
+                if ((refCount & ResourceHandleData::COUNT_MASK) == 0)
+                    ResourceHandleData::Destroy(data);
+            }
+
+            _loadedResources.clear();
+        }
+
+        _archives.clear();
+    }
+
     HResource ResourceManager::Load(const String& filePath, ResourceLoadFlag loadFlags)
     {
-        HResource resource;
-        return resource;
+        bool isNew;
+        HResource loaded;
+        SPtr<LoadRequest> request = QueueLoad(filePath, loadFlags, loaded, isNew);
+        if (request == nullptr)
+            return loaded;
+
+        if (isNew)
+        {
+            // Run the whole pipeline on the calling thread
+            if (ReadFile(*request))
+                Decode(*request);
+
+            {
+                Lock lock(_mutex);
+                request->CurrentState = LoadRequest::Decoded;
+            }
+
+            Finalize(request);
+            return request->Handle.IsLoaded(false) ? request->Handle : HResource();
+        }
+
+        // Already in progress asynchronously, wait for the data and then finalize it right away
+        {
+            Lock lock(_mutex);
+            while (request->CurrentState < LoadRequest::Decoded)
+                _decodedCond.wait(lock);
+        }
+
+        Finalize(request);
+        return request->Handle.IsLoaded(false) ? request->Handle : HResource();
+    }
+
+    HResource ResourceManager::LoadAsync(const String& filePath, ResourceLoadFlag loadFlags)
+    {
+        bool isNew;
+        HResource loaded;
+        SPtr<LoadRequest> request = QueueLoad(filePath, loadFlags, loaded, isNew);
+        if (request == nullptr)
+            return loaded;
+
+        if (isNew)
+            StartRead(request);
+
+        return request->Handle;
+    }
+
+    HResource ResourceManager::Load(const UUID& uuid, ResourceLoadFlag loadFlags)
+    {
+        String filePath;
+        {
+            Lock lock(_mutex);
+
+            auto iterFind = _loadedResources.find(uuid);
+            if (iterFind != _loadedResources.end())
+                return Revive(iterFind->second);
+
+            const PackEntry* entry = nullptr;
+            SPtr<PackArchive> archive = FindInArchives(nullptr, uuid, entry);
+            if (archive == nullptr)
+            {
+                TE_DEBUG("No mounted archive contains resource: " + uuid.ToString());
+                return HResource();
+            }
+
+            filePath = archive->GetEntryPath(*entry);
+        }
+
+        return Load(filePath, loadFlags);
+    }
+
+    HResource ResourceManager::LoadAsync(const UUID& uuid, ResourceLoadFlag loadFlags)
+    {
+        String filePath;
+        {
+            Lock lock(_mutex);
+
+            auto iterFind = _loadedResources.find(uuid);
+            if (iterFind != _loadedResources.end())
+                return Revive(iterFind->second);
+
+            const PackEntry* entry = nullptr;
+            SPtr<PackArchive> archive = FindInArchives(nullptr, uuid, entry);
+            if (archive == nullptr)
+            {
+                TE_DEBUG("No mounted archive contains resource: " + uuid.ToString());
+                return HResource();
+            }
+
+            filePath = archive->GetEntryPath(*entry);
+        }
+
+        return LoadAsync(filePath, loadFlags);
+    }
+
+    bool ResourceManager::MountArchive(const String& path)
+    {
+        SPtr<PackArchive> archive = te_shared_ptr_new<PackArchive>(path);
+        if (!archive->IsValid())
+            return false;
+
+        Lock lock(_mutex);
+        _archives.push_back(archive);
+
+        return true;
+    }
+
+    void ResourceManager::UnmountArchive(const String& path)
+    {
+        Lock lock(_mutex);
+
+        auto iterFind = std::find_if(_archives.begin(), _archives.end(),
+            [&path](const SPtr<PackArchive>& archive) { return archive->GetPath() == path; });
+
+        if (iterFind != _archives.end())
+            _archives.erase(iterFind);
+    }
+
+    SPtr<PackArchive> ResourceManager::FindInArchives(const String* path, const UUID& uuid, const PackEntry*& entry) const
+    {
+        for (auto iter = _archives.rbegin(); iter != _archives.rend(); ++iter)
+        {
+            entry = path != nullptr ? (*iter)->Find(*path) : (*iter)->Find(uuid);
+            if (entry != nullptr)
+                return *iter;
+        }
+
+        entry = nullptr;
+        return nullptr;
+    }
+
+    void ResourceManager::RegisterDecoder(const String& extension, SPtr<ResourceDecoder> decoder)
+    {
+        Lock lock(_mutex);
+        _decoders[extension] = std::move(decoder);
+    }
+
+    void ResourceManager::Update()
+    {
+        const UINT64 startTime = gTime().GetTimePrecise();
+
+        while (true)
+        {
+            SPtr<LoadRequest> request;
+            {
+                Lock lock(_mutex);
+                if (_finalizeQueue.empty())
+                    break;
+
+                request = _finalizeQueue.front();
+                _finalizeQueue.pop();
+            }
+
+            Finalize(request);
+
+            if (_finalizeBudget > 0 && gTime().GetTimePrecise() - startTime >= _finalizeBudget)
+                break;
+        }
+    }
+
+    UINT32 ResourceManager::GetNumLoadsInProgress() const
+    {
+        Lock lock(_mutex);
+        return (UINT32)_inProgressLoads.size();
+    }
+
+    SPtr<ResourceManager::LoadRequest> ResourceManager::QueueLoad(const String& filePath, ResourceLoadFlag loadFlags,
+        HResource& loaded, bool& isNew)
+    {
+        isNew = false;
+
+        Lock lock(_mutex);
+
+        auto iterFind = _inProgressLoads.find(filePath);
+        if (iterFind != _inProgressLoads.end())
+            return iterFind->second;
+
+        // Archives store the UUIDs of their resources, so they stay the same between runs
+        const PackEntry* archiveEntry = nullptr;
+        SPtr<PackArchive> archive = FindInArchives(&filePath, UUID::EMPTY, archiveEntry);
+
+        UUID uuid;
+        auto iterFindUUID = _filePathToUUID.find(filePath);
+        if (iterFindUUID != _filePathToUUID.end())
+        {
+            uuid = iterFindUUID->second;
+
+            auto iterFindLoaded = _loadedResources.find(uuid);
+            if (iterFindLoaded != _loadedResources.end())
+            {
+                loaded = Revive(iterFindLoaded->second);
+                return nullptr;
+            }
+        }
+        else
+        {
+            if (archive != nullptr)
+            {
+                uuid = archiveEntry->Id;
+
+                auto iterFindLoaded = _loadedResources.find(uuid);
+                if (iterFindLoaded != _loadedResources.end())
+                {
+                    loaded = Revive(iterFindLoaded->second);
+                    return nullptr;
+                }
+            }
+            else
+                uuid = UUIDGenerator::GenerateRandom();
+
+            _filePathToUUID[filePath] = uuid;
+        }
+
+        SPtr<ResourceDecoder> decoder = FindDecoder(filePath);
+        if (decoder == nullptr)
+        {
+            TE_DEBUG("No resource decoder registered for file: " + filePath);
+            return nullptr;
+        }
+
+        SPtr<LoadRequest> request = te_shared_ptr_new<LoadRequest>();
+        request->FilePath = filePath;
+        request->LoadFlags = loadFlags;
+        request->Handle = HResource(uuid);
+        request->Decoder = std::move(decoder);
+        request->Archive = std::move(archive);
+        request->ArchiveEntry = archiveEntry;
+
+        _inProgressLoads[filePath] = request;
+        isNew = true;
+
+        return request;
+    }
+
+    SPtr<ResourceDecoder> ResourceManager::FindDecoder(const String& filePath) const
+    {
+        const size_t extensionStart = filePath.find_last_of('.');
+        if (extensionStart == String::npos)
+            return nullptr;
+
+        auto iterFind = _decoders.find(filePath.substr(extensionStart));
+        if (iterFind == _decoders.end())
+            return nullptr;
+
+        return iterFind->second;
+    }
+
+    void ResourceManager::StartRead(const SPtr<LoadRequest>& request)
+    {
+        // Archive data is mapped into memory, it is read as part of the decode task
+        if (request->Archive != nullptr)
+        {
+            QueueDecode(request, true, true);
+            return;
+        }
+
+        {
+            Lock lock(_mutex);
+            request->CurrentState = LoadRequest::Reading;
+        }
+
+        SPtr<IORequest> read = gIOScheduler().Read(request->FilePath, IOPriority::Normal, [this, request](IORequest& read)
+        {
+            if (read.HasFailed())
+            {
+                TE_DEBUG("Unable to read resource file: " + request->FilePath);
+            }
+            else
+                request->Data = std::move(read.GetData());
+
+            QueueDecode(request, false, !read.HasFailed());
+        });
+
+        Lock lock(_mutex);
+        if (request->CurrentState != LoadRequest::Finalized)
+            request->Read = std::move(read);
+    }
+
+    void ResourceManager::QueueDecode(const SPtr<LoadRequest>& request, bool readFromArchive, bool readSuccess)
+    {
+        // Decoding is CPU bound, keep it off the I/O threads so the next read can start right away
+        auto decode = [this, request, readFromArchive, readSuccess]()
+        {
+            bool success = readSuccess;
+            if (readFromArchive)
+                success = ReadFile(*request);
+
+            if (success)
+                Decode(*request);
+
+            {
+                Lock lock(_mutex);
+                request->CurrentState = LoadRequest::Decoded;
+                _finalizeQueue.push(request);
+            }
+
+            _decodedCond.notify_all();
+        };
+
+        {
+            Lock lock(_mutex);
+            request->CurrentState = LoadRequest::Decoding;
+            request->DecodeTask = Task::Create("ResourceDecode", decode);
+        }
+
+        gTaskScheduler().AddTask(request->DecodeTask);
+    }
+
+    bool ResourceManager::ReadFile(LoadRequest& request)
+    {
+        // Archive data is mapped into memory, reading it only page faults and doesn't need to be serialized
+        if (request.Archive != nullptr)
+        {
+            if (!request.Archive->Read(*request.ArchiveEntry, request.Data))
+            {
+                TE_DEBUG("Unable to read resource from archive: " + request.FilePath);
+                request.Data.clear();
+                return false;
+            }
+
+            return true;
+        }
+
+        // Sync loads block the caller, they go ahead of everything else queued on the device
+        if (IOScheduler::IsStarted())
+        {
+            if (!gIOScheduler().ReadSync(request.FilePath, request.Data, IOPriority::Streaming))
+            {
+                TE_DEBUG("Unable to read resource file: " + request.FilePath);
+                request.Data.clear();
+                return false;
+            }
+
+            return true;
+        }
+
+        FileDataStream stream(request.FilePath, DataStream::READ, 0);
+        if (!stream.IsOpen())
+        {
+            TE_DEBUG("Unable to open resource file: " + request.FilePath);
+            return false;
+        }
+
+        // Whole file is read at once, so the stream doesn't need its own buffer
+        request.Data.resize(stream.Size());
+        if (stream.Read(request.Data.data(), request.Data.size()) != request.Data.size())
+        {
+            TE_DEBUG("Unable to read resource file: " + request.FilePath);
+            request.Data.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void ResourceManager::Decode(LoadRequest& request)
+    {
+        request.LoadedResource = request.Decoder->Decode(request.FilePath, request.Data, request.LoadFlags);
+
+        // Source data isn't needed anymore, don't keep it around until finalization
+        request.Data = Vector<UINT8>();
+    }
+
+    void ResourceManager::Finalize(const SPtr<LoadRequest>& request)
+    {
+        {
+            Lock lock(_mutex);
+
+            // Might have been finalized already by a synchronous Load() of the same file
+            if (request->CurrentState == LoadRequest::Finalized)
+                return;
+
+            request->CurrentState = LoadRequest::Finalized;
+            _inProgressLoads.erase(request->FilePath);
+            request->Read = nullptr;
+        }
+
+        if (request->LoadedResource != nullptr)
+        {
+            request->LoadedResource->Initialize();
+            request->Handle.SetHandleData(request->LoadedResource, request->Handle.GetUUID());
+
+            LoadedResource loadedResource;
+            loadedResource.Data = request->Handle.GetHandleData();
+            loadedResource.TypeName = request->LoadedResource->GetTypeName();
+            loadedResource.Size = request->LoadedResource->GetSize();
+
+            // Registered handle data stays alive without handles, for as long as the resource is cached
+            loadedResource.Data->_refCount.fetch_or(ResourceHandleData::REGISTERED_FLAG, std::memory_order_relaxed);
+
+            Lock lock(_mutex);
+            UpdateMemoryStats(loadedResource, 1, 0);
+            _loadedResources[request->Handle.GetUUID()] = std::move(loadedResource);
+        }
+        else
+            request->Handle.NotifyLoadFailed();
+
+        request->LoadedResource = nullptr;
+        request->DecodeTask = nullptr;
+    }
+
+    HResource ResourceManager::Get(const UUID& uuid)
+    {
+        Lock lock(_mutex);
+
+        auto iterFind = _loadedResources.find(uuid);
+        if (iterFind == _loadedResources.end())
+            return HResource();
+
+        return Revive(iterFind->second);
+    }
+
+    void ResourceManager::Release(ResourceHandleBase& resource)
+    {
+        Vector<SPtr<Resource>> destroyed;
+        {
+            Lock lock(_mutex);
+
+            auto iterFind = _loadedResources.find(resource.GetUUID());
+            if (iterFind == _loadedResources.end())
+                return;
+
+            iterFind->second.KeepCached = false;
+
+            if (iterFind->second.IsCached)
+                Evict(resource.GetUUID(), destroyed);
+        }
+    }
+
+    void ResourceManager::ClearCache()
+    {
+        Vector<SPtr<Resource>> destroyed;
+        {
+            Lock lock(_mutex);
+
+            while (!_cachedResources.empty())
+                Evict(_cachedResources.back(), destroyed);
+        }
+    }
+
+    void ResourceManager::SetCacheBudget(UINT64 budget)
+    {
+        Vector<SPtr<Resource>> destroyed;
+        {
+            Lock lock(_mutex);
+
+            _cacheBudget = budget;
+            TrimCache(destroyed);
+        }
+    }
+
+    ResourceMemoryStats ResourceManager::GetMemoryStats() const
+    {
+        Lock lock(_mutex);
+        return _memoryStats;
+    }
+
+    Map<String, ResourceMemoryStats> ResourceManager::GetMemoryStatsPerType() const
+    {
+        Lock lock(_mutex);
+        return _memoryStatsPerType;
+    }
+
+    HResource ResourceManager::Revive(LoadedResource& resource)
+    {
+        if (resource.IsCached)
+        {
+            _cachedResources.erase(resource.CacheIter);
+            resource.IsCached = false;
+
+            UpdateMemoryStats(resource, 0, -1);
+        }
+
+        HResource handle;
+        handle.SetHandleData(resource.Data);
+
+        return handle;
+    }
+
+    void ResourceManager::NotifyUnreferenced(ResourceHandleData* data)
+    {
+        // Destructors of resources can release other resources, so they must run without the lock held
+        Vector<SPtr<Resource>> destroyed;
+        {
+            Lock lock(_mutex);
+
+            const UINT32 refCount = data->_refCount.fetch_sub(1, std::memory_order_acq_rel);
+
+            // Revived or copied by another thread in the meantime
+            if ((refCount & ResourceHandleData::COUNT_MASK) != 1)
+                return;
+
+            if ((refCount & ResourceHandleData::REGISTERED_FLAG) == 0)
+            {
+                // Not managed by the resource manager (anymore), nothing else can reference the resource
+                destroyed.push_back(std::move(data->_ptr));
+                ResourceHandleData::Destroy(data);
+                return;
+            }
+
+            auto iterFind = _loadedResources.find(data->_uuid);
+            TE_ASSERT_ERROR(iterFind != _loadedResources.end() && iterFind->second.Data == data,
+                "Registered resource handle data missing from the loaded resources");
+
+            LoadedResource& resource = iterFind->second;
+            if (resource.IsCached)
+                return;
+
+            if (!resource.KeepCached || resource.Size > _cacheBudget)
+            {
+                Evict(data->_uuid, destroyed);
+                return;
+            }
+
+            resource.IsCached = true;
+            resource.CacheIter = _cachedResources.insert(_cachedResources.begin(), data->_uuid);
+            UpdateMemoryStats(resource, 0, 1);
+
+            TrimCache(destroyed);
+        }
+    }
+
+    void ResourceManager::Evict(const UUID& uuid, Vector<SPtr<Resource>>& destroyed)
+    {
+        auto iterFind = _loadedResources.find(uuid);
+        if (iterFind == _loadedResources.end())
+            return;
+
+        LoadedResource& resource = iterFind->second;
+        if (resource.IsCached)
+        {
+            _cachedResources.erase(resource.CacheIter);
+            UpdateMemoryStats(resource, 0, -1);
+        }
+
+        UpdateMemoryStats(resource, -1, 0);
+
+        {
+            Lock dataLock(resource.Data->_createdMutex);
+            resource.Data->_isCreated = false;
+        }
+
+        destroyed.push_back(std::move(resource.Data->_ptr));
+
+        // Remaining handles destroy the data once they go away, otherwise nothing references it anymore
+        const UINT32 refCount =
+            resource.Data->_refCount.fetch_and(ResourceHandleData::COUNT_MASK, std::memory_order_acq_rel);
+
+        if ((refCount & ResourceHandleData::COUNT_MASK) == 0)
+            ResourceHandleData::Destroy(resource.Data);
+
+        _loadedResources.erase(iterFind);
+    }
+
+    void ResourceManager::TrimCache(Vector<SPtr<Resource>>& destroyed)
+    {
+        while (!_cachedResources.empty() && _memoryStats.CachedMemory > _cacheBudget)
+            Evict(_cachedResources.back(), destroyed);
+    }
+
+    void ResourceManager::UpdateMemoryStats(const LoadedResource& resource, INT32 numResources, INT32 numCached)
+    {
+        auto update = [&resource, numResources, numCached](ResourceMemoryStats& stats)
+        {
+            // Negative counts wrap around, which subtracts from the unsigned totals
+            stats.NumResources += numResources;
+            stats.MemoryUsed += (INT64)numResources * (INT64)resource.Size;
+            stats.NumCached += numCached;
+            stats.CachedMemory += (INT64)numCached * (INT64)resource.Size;
+        };
+
+        update(_memoryStats);
+        update(_memoryStatsPerType[resource.TypeName]);
+    }
+
+    ResourceManager& gResourceManager()
+    {
+        return ResourceManager::Instance();
     }
 }
\ No newline at end of file
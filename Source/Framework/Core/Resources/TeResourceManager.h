@@ -2,6 +2,9 @@
 
 #include "TeCorePrerequisites.h"
 #include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
+#include "Threading/TeThreadPool.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
@@ -14,12 +17,37 @@ namespace te
         LoadDependencies = 1
     };
 
+    /** Memory used by loaded resources. Kept per resource type and for all resources together. */
+    struct ResourceMemoryStats
+    {
+        UINT32 NumResources = 0; /**< Number of loaded resources, including the cached ones. */
+        UINT64 MemoryUsed = 0; /**< Memory used by loaded resources, including the cached ones, in bytes. */
+        UINT32 NumCached = 0; /**< Number of unreferenced resources kept in the cache. */
+        UINT64 CachedMemory = 0; /**< Memory used by unreferenced resources kept in the cache, in bytes. */
+    };
+
     /**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
+	 *
+	 * Asynchronous loads go through three stages:
+	 *  - File contents are read through the IOScheduler, or from a mounted archive by a TaskScheduler task.
+	 *  - Contents are decoded into a resource by a ResourceDecoder, as a TaskScheduler task.
+	 *  - Resource is initialized on the sim thread during Update(), within a per-frame time budget.
+	 *
+	 * Loaded resources are registered by UUID, and loading an already loaded file returns the existing resource. Once
+	 * the last handle to a resource goes away the resource isn't destroyed right away, but is moved into a cache from
+	 * which it can be revived without reading it again. Least recently used resources are evicted from the cache once
+	 * its memory budget is exceeded.
 	 */
 	class TE_CORE_EXPORT ResourceManager: public Module<ResourceManager>
 	{
     public:
+        /** Default time the sim thread may spend on initializing loaded resources each frame, in microseconds. */
+        static constexpr UINT64 DEFAULT_FINALIZE_BUDGET = 2000;
+
+        /** Default amount of memory unreferenced resources can use before getting evicted, in bytes. */
+        static constexpr UINT64 DEFAULT_CACHE_BUDGET = 256 * 1024 * 1024;
+
 		ResourceManager();
 		~ResourceManager();
 
@@ -29,7 +57,217 @@ namespace te
          *
          * @param[in]	filePath	File path to the resource to load. This can be absolute or relative to the working folder.
          * @param[in]	loadFlags	Flags used to control the load process.
+         *
+         * @note	Sim thread only.
          */
         HResource Load(const String& filePath, ResourceLoadFlag loadFlags = ResourceLoadFlag::None);
+
+        /**
+         * Starts loading the resource from a given path and returns its handle immediately. The handle becomes valid
+         * once loading completes, which can be checked with ResourceHandleBase::IsLoaded() or waited for with
+         * ResourceHandleBase::BlockUntilLoaded(). Requesting a file that is already being loaded returns the existing
+         * handle.
+         *
+         * @param[in]	filePath	File path to the resource to load. This can be absolute or relative to the working folder.
+         * @param[in]	loadFlags	Flags used to control the load process.
+         *
+         * @note	Thread safe.
+         */
+        HResource LoadAsync(const String& filePath, ResourceLoadFlag loadFlags = ResourceLoadFlag::None);
+
+        /**
+         * Loads the resource with the provided UUID from one of the mounted archives. Returns the resource directly if
+         * it is already loaded, or an empty handle if no mounted archive contains it.
+         *
+         * @see	Load(const String&, ResourceLoadFlag)
+         */
+        HResource Load(const UUID& uuid, ResourceLoadFlag loadFlags = ResourceLoadFlag::None);
+
+        /**
+         * Starts loading the resource with the provided UUID from one of the mounted archives.
+         *
+         * @see	LoadAsync(const String&, ResourceLoadFlag)
+         */
+        HResource LoadAsync(const UUID& uuid, ResourceLoadFlag loadFlags = ResourceLoadFlag::None);
+
+        /**
+         * Mounts a pack archive. Loads of paths contained in a mounted archive are served from the archive instead of
+         * the file system, and resources loaded from archives keep the UUIDs stored in the archive. Archives mounted
+         * later take precedence. Returns false if the archive can't be opened.
+         *
+         * @note	Thread safe.
+         */
+        bool MountArchive(const String& path);
+
+        /** Unmounts an archive mounted with MountArchive(). Loads already in progress still complete. */
+        void UnmountArchive(const String& path);
+
+        /**
+         * Registers a decoder used for loading files with the provided extension (including the leading dot, e.g.
+         * ".mesh"). Replaces any decoder previously registered for the extension.
+         */
+        void RegisterDecoder(const String& extension, SPtr<ResourceDecoder> decoder);
+
+        /**
+         * Initializes resources whose data finished loading. Stops once the finalize budget for the frame is spent, and
+         * continues on the next call. Called once per frame by the CoreApplication.
+         *
+         * @note	Sim thread only.
+         */
+        void Update();
+
+        /** Sets how much time Update() may spend on initializing resources, in microseconds. Zero means unlimited. */
+        void SetFinalizeBudget(UINT64 budget) { _finalizeBudget = budget; }
+
+        /** Returns the number of asynchronous loads that haven't completed yet. */
+        UINT32 GetNumLoadsInProgress() const;
+
+        /**
+         * Returns a handle to the loaded resource with the provided UUID, reviving it from the cache if needed. Returns
+         * an empty handle if the resource isn't loaded.
+         *
+         * @note	Thread safe.
+         */
+        HResource Get(const UUID& uuid);
+
+        /**
+         * Marks the resource as not worth caching. The resource will be destroyed as soon as its last handle goes away,
+         * instead of being moved into the cache. If the resource is already cached it is evicted immediately.
+         *
+         * @note	Thread safe.
+         */
+        void Release(ResourceHandleBase& resource);
+
+        /** Evicts all unreferenced resources from the cache. */
+        void ClearCache();
+
+        /** Sets how much memory unreferenced resources may use before they start getting evicted, in bytes. */
+        void SetCacheBudget(UINT64 budget);
+
+        /** @copydoc SetCacheBudget */
+        UINT64 GetCacheBudget() const { return _cacheBudget; }
+
+        /** Returns the memory used by all loaded resources. */
+        ResourceMemoryStats GetMemoryStats() const;
+
+        /** Returns the memory used by loaded resources, per resource type (see Resource::GetTypeName()). */
+        Map<String, ResourceMemoryStats> GetMemoryStatsPerType() const;
+
+    protected:
+        /** Single in-progress load. */
+        struct LoadRequest
+        {
+            enum State
+            {
+                Queued, Reading, Decoding, Decoded, Finalized
+            };
+
+            String FilePath;
+            ResourceLoadFlag LoadFlags;
+            HResource Handle;
+            SPtr<ResourceDecoder> Decoder;
+            SPtr<PackArchive> Archive; /**< Archive to read the data from, null if read from the file system. */
+            const PackEntry* ArchiveEntry = nullptr;
+
+            Vector<UINT8> Data;
+            SPtr<Resource> LoadedResource;
+            SPtr<IORequest> Read;
+            SPtr<Task> DecodeTask;
+            State CurrentState = Queued;
+        };
+
+        /** Loaded resource, along with the information needed for caching it. */
+        struct LoadedResource
+        {
+            ResourceHandleData* Data = nullptr; /**< Kept alive by ResourceHandleData::REGISTERED_FLAG. */
+            String TypeName;
+            UINT64 Size = 0;
+            bool IsCached = false; /**< True if the resource has no references and is in the LRU list. */
+            bool KeepCached = true;
+            List<UUID>::iterator CacheIter;
+        };
+
+        friend class ResourceHandleBase;
+
+        /** @copydoc Module::OnStartUp */
+        void OnStartUp() override;
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /**
+         * Creates a new load request, or returns an existing one for the same file. If the file was already loaded
+         * returns null and outputs the handle to the loaded resource in @p loaded.
+         */
+        SPtr<LoadRequest> QueueLoad(const String& filePath, ResourceLoadFlag loadFlags, HResource& loaded, bool& isNew);
+
+        /**
+         * Returns the most recently mounted archive containing the provided path (if @p path is not null) or UUID, or
+         * null if none does. Caller must hold the lock.
+         */
+        SPtr<PackArchive> FindInArchives(const String* path, const UUID& uuid, const PackEntry*& entry) const;
+
+        /** Returns the decoder registered for the extension of the provided file, or null if there is none. */
+        SPtr<ResourceDecoder> FindDecoder(const String& filePath) const;
+
+        /** Issues the read of an asynchronous load. Once the data is available it is decoded as a task. */
+        void StartRead(const SPtr<LoadRequest>& request);
+
+        /** Queues the task that decodes the read data. */
+        void QueueDecode(const SPtr<LoadRequest>& request, bool readFromArchive, bool readSuccess);
+
+        /** Reads the contents of the requested file, blocking. Returns false if the file couldn't be read. */
+        static bool ReadFile(LoadRequest& request);
+
+        /** Decodes the read data into a resource. */
+        static void Decode(LoadRequest& request);
+
+        /** Initializes the decoded resource and makes it available through its handle. */
+        void Finalize(const SPtr<LoadRequest>& request);
+
+        /** Returns a new handle to the loaded resource, moving it out of the cache if needed. Caller must hold the lock. */
+        HResource Revive(LoadedResource& resource);
+
+        /**
+         * Called when the last handle to a resource might go away, releases the reference of that handle. Moves the
+         * resource into the cache if no other reference remains, or destroys it if it isn't managed by the resource
+         * manager.
+         */
+        void NotifyUnreferenced(ResourceHandleData* data);
+
+        /**
+         * Removes the resource from the registry. Resource object is moved to @p destroyed, so it can be destroyed once
+         * the lock is released. Caller must hold the lock.
+         */
+        void Evict(const UUID& uuid, Vector<SPtr<Resource>>& destroyed);
+
+        /** Evicts least recently used resources until the cache fits its budget. Caller must hold the lock. */
+        void TrimCache(Vector<SPtr<Resource>>& destroyed);
+
+        /** Updates the memory statistics of a resource type, and the global ones. Caller must hold the lock. */
+        void UpdateMemoryStats(const LoadedResource& resource, INT32 numResources, INT32 numCached);
+
+    protected:
+        UINT64 _finalizeBudget = DEFAULT_FINALIZE_BUDGET;
+
+        Map<String, SPtr<ResourceDecoder>> _decoders;
+        Map<String, SPtr<LoadRequest>> _inProgressLoads;
+        Map<String, UUID> _filePathToUUID;
+        Vector<SPtr<PackArchive>> _archives;
+
+        UnorderedMap<UUID, LoadedResource> _loadedResources;
+        List<UUID> _cachedResources; /**< Unreferenced resources, most recently used first. */
+        UINT64 _cacheBudget = DEFAULT_CACHE_BUDGET;
+
+        ResourceMemoryStats _memoryStats;
+        Map<String, ResourceMemoryStats> _memoryStatsPerType;
+
+        Queue<SPtr<LoadRequest>> _finalizeQueue;
+
+        mutable Mutex _mutex;
+        Signal _decodedCond;
     };
+
+    /** Provides easy access to ResourceManager. */
+    TE_CORE_EXPORT ResourceManager& gResourceManager();
 }
\ No newline at end of file
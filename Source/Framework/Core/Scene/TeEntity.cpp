@@ -0,0 +1,81 @@
+#include "Scene/TeEntity.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Registered component types. Entries are never moved, so references to them stay valid. */
+        struct ComponentTypeRegistry
+        {
+            ComponentTypeInfo Types[MAX_COMPONENT_TYPES];
+            std::atomic<UINT32> Count{0};
+            Mutex RegisterMutex;
+        };
+
+        ComponentTypeRegistry& GetRegistry()
+        {
+            static ComponentTypeRegistry registry;
+            return registry;
+        }
+    }
+
+    ComponentTypeId ComponentTypes::Register(const ComponentTypeInfo& info)
+    {
+        ComponentTypeRegistry& registry = GetRegistry();
+        Lock lock(registry.RegisterMutex);
+
+        const UINT32 count = registry.Count.load(std::memory_order_relaxed);
+        for (UINT32 i = 0; i < count; i++)
+        {
+            if (registry.Types[i].Key == info.Key)
+                return i;
+        }
+
+        TE_ASSERT_ERROR(count < MAX_COMPONENT_TYPES, "Too many component types, increase MAX_COMPONENT_TYPES");
+
+        registry.Types[count] = info;
+        registry.Count.store(count + 1, std::memory_order_release);
+
+        return count;
+    }
+
+    String ComponentTypes::GetTypeName(const char* signature)
+    {
+        const String text = signature;
+
+        // GCC and Clang print "[with T = Type; ...]" or "[T = Type]", MSVC prints "GetSignature<Type>(void)"
+        size_t start = text.find("T = ");
+        size_t end = String::npos;
+
+        if (start != String::npos)
+        {
+            start += 4;
+            end = text.find_first_of(";]", start);
+        }
+        else
+        {
+            start = text.find("GetSignature<");
+            if (start != String::npos)
+            {
+                start += 13;
+                end = text.rfind(">(");
+            }
+        }
+
+        if (start == String::npos || end == String::npos || end <= start)
+            return text;
+
+        return text.substr(start, end - start);
+    }
+
+    const ComponentTypeInfo& ComponentTypes::GetInfo(ComponentTypeId id)
+    {
+        return GetRegistry().Types[id];
+    }
+
+    UINT32 ComponentTypes::GetCount()
+    {
+        return GetRegistry().Count.load(std::memory_order_acquire);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Threading/TeThreading.h"
+
+namespace te
+{
+    /**
+     * Identifies an entity of a World. The generation makes identifiers of destroyed entities stay invalid once their
+     * index is reused by a new entity.
+     */
+    struct Entity
+    {
+        UINT32 Index = (UINT32)-1;
+        UINT32 Generation = 0;
+
+        bool operator== (const Entity& rhs) const { return Index == rhs.Index && Generation == rhs.Generation; }
+        bool operator!= (const Entity& rhs) const { return !(*this == rhs); }
+
+        /** Returns true if the identifier was never assigned. Use World::IsAlive() to know if the entity still exists. */
+        bool IsNull() const { return Index == (UINT32)-1; }
+    };
+
+    /** Index of a component type, assigned the first time the type is used. */
+    typedef UINT32 ComponentTypeId;
+
+    /** Maximum number of different component types in the application. */
+    constexpr UINT32 MAX_COMPONENT_TYPES = 256;
+
+    /** Set of component types, one bit per ComponentTypeId. */
+    typedef std::bitset<MAX_COMPONENT_TYPES> ComponentMask;
+
+    /**
+     * Describes how components of a type are laid out and moved in memory. Components are plain structures stored by
+     * value in entity chunks, and moved around whenever entities change archetype.
+     */
+    struct ComponentTypeInfo
+    {
+        String Name; /**< Name of the type, also used as the data name of systems accessing it. */
+        const void* Key = nullptr; /**< Address unique to the type, identifying it in the registry. */
+        UINT32 Size = 0;
+        UINT32 Alignment = 0;
+
+        /** If true components can be moved with memcpy and don't need to be destroyed. */
+        bool Trivial = false;
+
+        /** Move constructs a component at @p destination from @p source, and destroys @p source. */
+        void(*Relocate)(void* destination, void* source) = nullptr;
+
+        /** Destroys a component. */
+        void(*Destroy)(void* component) = nullptr;
+    };
+
+    /**
+     * Registry of the component types. Any copyable or movable type can be used as a component, and gets an identifier
+     * when first used. Types are identified without RTTI, by the address of a variable instantiated once per type.
+     *
+     * @note	Thread safe.
+     */
+    class TE_CORE_EXPORT ComponentTypes
+    {
+    public:
+        /** Returns the identifier of a component type, registering the type if needed. */
+        template <typename T>
+        static ComponentTypeId GetId()
+        {
+            typedef typename std::remove_cv<T>::type Type;
+
+            static const ComponentTypeId id = Register(CreateInfo<Type>());
+            return id;
+        }
+
+        /** Returns the description of a registered component type. */
+        static const ComponentTypeInfo& GetInfo(ComponentTypeId id);
+
+        /** Returns the number of registered component types. */
+        static UINT32 GetCount();
+
+    private:
+        /** Variable whose address identifies a type. Distinct types never share it, even if their names are equal. */
+        template <typename T>
+        struct TypeKey
+        {
+            static const char Value;
+        };
+
+        /**
+         * Adds a type to the registry, or returns the identifier it already has. Types are matched by their key, which
+         * modules loaded at runtime share with the core as long as their template instantiations are merged by the
+         * dynamic linker.
+         */
+        static ComponentTypeId Register(const ComponentTypeInfo& info);
+
+        /** Returns the signature of the GetSignature<T>() instantiation, which contains the name of @p T. */
+        template <typename T>
+        static const char* GetSignature() { return __PRETTY_FUNCTION__; }
+
+        /** Extracts the name of the type from a signature returned by GetSignature(). */
+        static String GetTypeName(const char* signature);
+
+        /** Fills the description of a component type. */
+        template <typename T>
+        static ComponentTypeInfo CreateInfo()
+        {
+            static_assert(std::is_move_constructible<T>::value, "Components must be movable.");
+
+            ComponentTypeInfo info;
+            info.Name = GetTypeName(GetSignature<T>());
+            info.Key = &TypeKey<T>::Value;
+            info.Size = (UINT32)sizeof(T);
+            info.Alignment = (UINT32)alignof(T);
+            info.Trivial = std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value;
+
+            info.Relocate = [](void* destination, void* source)
+            {
+                new (destination) T(std::move(*(T*)source));
+                ((T*)source)->~T();
+            };
+
+            info.Destroy = [](void* component) { ((T*)component)->~T(); };
+            return info;
+        }
+    };
+
+    template <typename T>
+    const char ComponentTypes::TypeKey<T>::Value = 0;
+}
+
+namespace std
+{
+    /** Hash value generator for Entity. */
+    template<>
+    struct hash<te::Entity>
+    {
+        size_t operator()(const te::Entity& entity) const
+        {
+            return std::hash<te::UINT64>()(((te::UINT64)entity.Generation << 32) | entity.Index);
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "Scene/TeSceneManager.h"
+
+namespace te
+{
+    void SceneManager::OnStartUp()
+    {
+        UPDATE_DESC desc;
+        desc.Name = "Transforms";
+        desc.Phase = UpdatePhase::PostUpdate;
+        desc.Writes = { "Transforms" };
+
+        _transformUpdate = gUpdateScheduler().Register(desc, [this]() { _transforms.Update(); });
+    }
+
+    void SceneManager::OnShutDown()
+    {
+        gUpdateScheduler().Unregister(_transformUpdate);
+    }
+
+    SceneManager& gSceneManager()
+    {
+        return SceneManager::Instance();
+    }
+}
\ No newline at end of file
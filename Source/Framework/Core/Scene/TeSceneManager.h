@@ -0,0 +1,45 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Scene/TeWorld.h"
+#include "Scene/TeTransformHierarchy.h"
+#include "Utility/TeModule.h"
+
+namespace te
+{
+    /**
+     * Owns the world simulated by the main loop and the transform hierarchy of the scene. Systems of the world run in
+     * the UpdateScheduler phases, and the structural changes they record are applied after each phase. World transforms
+     * are recomputed during the PostUpdate phase, by an update that writes the "Transforms" data: systems moving nodes
+     * should declare they write it too.
+     *
+     * @note	Sim thread only.
+     */
+    class TE_CORE_EXPORT SceneManager : public Module<SceneManager>
+    {
+    public:
+        SceneManager() = default;
+        ~SceneManager() = default;
+
+        /** Returns the world updated by the main loop. */
+        World& GetWorld() { return _world; }
+
+        /** Returns the transform hierarchy of the scene. */
+        TransformHierarchy& GetTransforms() { return _transforms; }
+
+    protected:
+        /** @copydoc Module::OnStartUp */
+        void OnStartUp() override;
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+    protected:
+        World _world;
+        TransformHierarchy _transforms;
+        UINT32 _transformUpdate = 0;
+    };
+
+    /** Provides easy access to SceneManager. */
+    TE_CORE_EXPORT SceneManager& gSceneManager();
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include "Scene/TeTransformHierarchy.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    TransformHierarchy::~TransformHierarchy()
+    {
+        for (auto& level : _levels)
+            te_delete(level);
+    }
+
+    TransformId TransformHierarchy::Create(TransformId parent)
+    {
+        TE_ASSERT_ERROR(parent.IsNull() || IsValid(parent), "Creating a transform with an invalid parent");
+
+        UINT32 index;
+        if (!_freeNodes.empty())
+        {
+            index = _freeNodes.back();
+            _freeNodes.pop_back();
+        }
+        else
+        {
+            index = (UINT32)_nodes.size();
+            _nodes.push_back(Node());
+        }
+
+        Node& node = _nodes[index];
+        node.Alive = true;
+        node.Depth = 0;
+
+        if (!parent.IsNull())
+        {
+            Link(index, parent.Index);
+            node.Depth = _nodes[parent.Index].Depth + 1;
+        }
+
+        AddToLevel(index, { Vector3::ZERO, Quaternion::IDENTITY, Vector3::ONE, AABox::BOX_EMPTY });
+        _numNodes++;
+
+        return { index, node.Generation };
+    }
+
+    void TransformHierarchy::Destroy(TransformId id)
+    {
+        if (!IsValid(id))
+            return;
+
+        Unlink(id.Index);
+
+        _subtree.clear();
+        GetSubtree(id.Index, _subtree);
+
+        for (auto& index : _subtree)
+        {
+            RemoveFromLevel(index);
+
+            Node& node = _nodes[index];
+            node.Alive = false;
+            node.Generation++;
+            node.Parent = INVALID_INDEX;
+            node.FirstChild = INVALID_INDEX;
+            node.PrevSibling = INVALID_INDEX;
+            node.NextSibling = INVALID_INDEX;
+
+            _freeNodes.push_back(index);
+        }
+
+        _numNodes -= (UINT32)_subtree.size();
+    }
+
+    bool TransformHierarchy::IsValid(TransformId id) const
+    {
+        return id.Index < (UINT32)_nodes.size() && _nodes[id.Index].Alive &&
+            _nodes[id.Index].Generation == id.Generation;
+    }
+
+    void TransformHierarchy::SetParent(TransformId id, TransformId parent)
+    {
+        TE_ASSERT_ERROR(IsValid(id) && (parent.IsNull() || IsValid(parent)), "Re-parenting an invalid transform");
+
+        const UINT32 parentIndex = parent.IsNull() ? INVALID_INDEX : parent.Index;
+        if (_nodes[id.Index].Parent == parentIndex)
+            return;
+
+        for (UINT32 ancestor = parentIndex; ancestor != INVALID_INDEX; ancestor = _nodes[ancestor].Parent)
+            TE_ASSERT_ERROR(ancestor != id.Index, "Re-parenting a transform under one of its descendants");
+
+        Unlink(id.Index);
+        if (parentIndex != INVALID_INDEX)
+            Link(id.Index, parentIndex);
+
+        // The whole subtree moves to other levels, parents first so that children find their parent's new slot
+        _subtree.clear();
+        GetSubtree(id.Index, _subtree);
+
+        for (auto& index : _subtree)
+        {
+            const LocalState state = RemoveFromLevel(index);
+
+            Node& node = _nodes[index];
+            node.Depth = node.Parent != INVALID_INDEX ? _nodes[node.Parent].Depth + 1 : 0;
+
+            AddToLevel(index, state);
+        }
+    }
+
+    TransformId TransformHierarchy::GetParent(TransformId id) const
+    {
+        const UINT32 parent = _nodes[id.Index].Parent;
+        if (parent == INVALID_INDEX)
+            return TransformId();
+
+        return { parent, _nodes[parent].Generation };
+    }
+
+    void TransformHierarchy::SetPosition(TransformId id, const Vector3& position)
+    {
+        GetLevel(id).Positions[_nodes[id.Index].Slot] = position;
+        MarkDirty(id);
+    }
+
+    void TransformHierarchy::SetRotation(TransformId id, const Quaternion& rotation)
+    {
+        GetLevel(id).Rotations[_nodes[id.Index].Slot] = rotation;
+        MarkDirty(id);
+    }
+
+    void TransformHierarchy::SetScale(TransformId id, const Vector3& scale)
+    {
+        GetLevel(id).Scales[_nodes[id.Index].Slot] = scale;
+        MarkDirty(id);
+    }
+
+    void TransformHierarchy::SetLocalTransform(TransformId id, const Vector3& position, const Quaternion& rotation,
+        const Vector3& scale)
+    {
+        Level& level = GetLevel(id);
+        const UINT32 slot = _nodes[id.Index].Slot;
+
+        level.Positions[slot] = position;
+        level.Rotations[slot] = rotation;
+        level.Scales[slot] = scale;
+        MarkDirty(id);
+    }
+
+    void TransformHierarchy::SetLocalBounds(TransformId id, const AABox& bounds)
+    {
+        GetLevel(id).LocalBounds[_nodes[id.Index].Slot] = bounds;
+        MarkDirty(id);
+    }
+
+    void TransformHierarchy::Update()
+    {
+        const Level* parent = nullptr;
+
+        for (auto& level : _levels)
+        {
+            const UINT32 count = (UINT32)level->Nodes.size();
+
+            if (level->ParentSlotsStale)
+            {
+                for (UINT32 i = 0; i < count; i++)
+                    level->ParentSlots[i] = _nodes[_nodes[level->Nodes[i]].Parent].Slot;
+
+                level->ParentSlotsStale = false;
+            }
+
+            const bool parentChanged = parent != nullptr && parent->HasChanged;
+            if (!parentChanged && !level->HasDirty.load(std::memory_order_relaxed))
+            {
+                // Nothing to recompute, only forget about the changes of the last update
+                if (level->HasChanged)
+                {
+                    memset(level->Changed.data(), 0, count);
+                    level->HasChanged = false;
+                }
+
+                parent = level;
+                continue;
+            }
+
+            level->HasDirty.store(false, std::memory_order_relaxed);
+
+            UINT32 numTasks = 1;
+            if (TaskScheduler::IsStarted())
+                numTasks = std::max(std::min(gTaskScheduler().getNumWorkers(), count / MIN_NODES_PER_TASK), 1U);
+
+            if (numTasks == 1)
+                level->HasChanged = UpdateRange(*level, parent, 0, count);
+            else
+            {
+                Vector<UINT8> changed(numTasks, 0);
+                auto updateTask = [&changed, &level, parent, count, numTasks](UINT32 task)
+                {
+                    const UINT32 begin = (UINT32)((UINT64)count * task / numTasks);
+                    const UINT32 end = (UINT32)((UINT64)count * (task + 1) / numTasks);
+
+                    changed[task] = UpdateRange(*level, parent, begin, end) ? 1 : 0;
+                };
+
+                Vector<SPtr<Task>> tasks;
+                tasks.reserve(numTasks - 1);
+
+                for (UINT32 i = 1; i < numTasks; i++)
+                {
+                    tasks.push_back(Task::Create("TransformUpdate", [&updateTask, i]() { updateTask(i); }));
+                    gTaskScheduler().AddTask(tasks.back());
+                }
+
+                updateTask(0);
+
+                for (auto& task : tasks)
+                    task->Wait();
+
+                level->HasChanged = std::find(changed.begin(), changed.end(), 1) != changed.end();
+            }
+
+            parent = level;
+        }
+    }
+
+    bool TransformHierarchy::UpdateRange(Level& level, const Level* parent, UINT32 begin, UINT32 end)
+    {
+        bool anyChanged = false;
+
+        for (UINT32 i = begin; i < end; i++)
+        {
+            const bool changed = level.Dirty[i] != 0 ||
+                (parent != nullptr && parent->Changed[level.ParentSlots[i]] != 0);
+
+            level.Changed[i] = changed ? 1 : 0;
+            if (!changed)
+                continue;
+
+            level.Dirty[i] = 0;
+            anyChanged = true;
+
+            Matrix4 world = Matrix4::TRS(level.Positions[i], level.Rotations[i], level.Scales[i]);
+            if (parent != nullptr)
+                world = parent->WorldMatrices[level.ParentSlots[i]].ConcatenateAffine(world);
+
+            AABox bounds = level.LocalBounds[i];
+            bounds.TransformAffine(world);
+
+            level.WorldMatrices[i] = world;
+            level.WorldBounds[i] = bounds;
+        }
+
+        return anyChanged;
+    }
+
+    void TransformHierarchy::MarkDirty(TransformId id)
+    {
+        Level& level = GetLevel(id);
+        level.Dirty[_nodes[id.Index].Slot] = 1;
+
+        if (!level.HasDirty.load(std::memory_order_relaxed))
+            level.HasDirty.store(true, std::memory_order_relaxed);
+    }
+
+    void TransformHierarchy::AddToLevel(UINT32 index, const LocalState& state)
+    {
+        Node& node = _nodes[index];
+
+        while ((UINT32)_levels.size() <= node.Depth)
+            _levels.push_back(te_new<Level>());
+
+        Level& level = *_levels[node.Depth];
+        node.Slot = (UINT32)level.Nodes.size();
+
+        level.Nodes.push_back(index);
+        level.ParentSlots.push_back(node.Parent != INVALID_INDEX ? _nodes[node.Parent].Slot : 0);
+        level.Positions.push_back(state.Position);
+        level.Rotations.push_back(state.Rotation);
+        level.Scales.push_back(state.Scale);
+        level.LocalBounds.push_back(state.Bounds);
+        level.WorldMatrices.push_back(Matrix4::IDENTITY);
+        level.WorldBounds.push_back(state.Bounds);
+        level.Dirty.push_back(1);
+        level.Changed.push_back(0);
+        level.HasDirty.store(true, std::memory_order_relaxed);
+    }
+
+    TransformHierarchy::LocalState TransformHierarchy::RemoveFromLevel(UINT32 index)
+    {
+        const Node& node = _nodes[index];
+        Level& level = *_levels[node.Depth];
+
+        const UINT32 slot = node.Slot;
+        const UINT32 last = (UINT32)level.Nodes.size() - 1;
+        const LocalState state =
+            { level.Positions[slot], level.Rotations[slot], level.Scales[slot], level.LocalBounds[slot] };
+
+        if (slot != last)
+        {
+            level.Nodes[slot] = level.Nodes[last];
+            level.ParentSlots[slot] = level.ParentSlots[last];
+            level.Positions[slot] = level.Positions[last];
+            level.Rotations[slot] = level.Rotations[last];
+            level.Scales[slot] = level.Scales[last];
+            level.LocalBounds[slot] = level.LocalBounds[last];
+            level.WorldMatrices[slot] = level.WorldMatrices[last];
+            level.WorldBounds[slot] = level.WorldBounds[last];
+            level.Dirty[slot] = level.Dirty[last];
+            level.Changed[slot] = level.Changed[last];
+
+            _nodes[level.Nodes[slot]].Slot = slot;
+
+            // Children of the moved node still point to its previous slot
+            if (node.Depth + 1 < (UINT32)_levels.size())
+                _levels[node.Depth + 1]->ParentSlotsStale = true;
+        }
+
+        level.Nodes.pop_back();
+        level.ParentSlots.pop_back();
+        level.Positions.pop_back();
+        level.Rotations.pop_back();
+        level.Scales.pop_back();
+        level.LocalBounds.pop_back();
+        level.WorldMatrices.pop_back();
+        level.WorldBounds.pop_back();
+        level.Dirty.pop_back();
+        level.Changed.pop_back();
+
+        return state;
+    }
+
+    void TransformHierarchy::Link(UINT32 index, UINT32 parent)
+    {
+        Node& node = _nodes[index];
+        Node& parentNode = _nodes[parent];
+
+        node.Parent = parent;
+        node.PrevSibling = INVALID_INDEX;
+        node.NextSibling = parentNode.FirstChild;
+
+        if (parentNode.FirstChild != INVALID_INDEX)
+            _nodes[parentNode.FirstChild].PrevSibling = index;
+
+        parentNode.FirstChild = index;
+    }
+
+    void TransformHierarchy::Unlink(UINT32 index)
+    {
+        Node& node = _nodes[index];
+        if (node.Parent == INVALID_INDEX)
+            return;
+
+        if (node.PrevSibling != INVALID_INDEX)
+            _nodes[node.PrevSibling].NextSibling = node.NextSibling;
+        else
+            _nodes[node.Parent].FirstChild = node.NextSibling;
+
+        if (node.NextSibling != INVALID_INDEX)
+            _nodes[node.NextSibling].PrevSibling = node.PrevSibling;
+
+        node.Parent = INVALID_INDEX;
+        node.PrevSibling = INVALID_INDEX;
+        node.NextSibling = INVALID_INDEX;
+    }
+
+    void TransformHierarchy::GetSubtree(UINT32 index, Vector<UINT32>& output) const
+    {
+        // Breadth first, so that every node comes after its parent
+        const size_t start = output.size();
+        output.push_back(index);
+
+        for (size_t i = start; i < output.size(); i++)
+        {
+            for (UINT32 child = _nodes[output[i]].FirstChild; child != INVALID_INDEX; child = _nodes[child].NextSibling)
+                output.push_back(child);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeAABox.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeQuaternion.h"
+#include "Math/TeVector3.h"
+#include "Utility/TeNonCopyable.h"
+
+namespace te
+{
+    /**
+     * Identifies a node of a TransformHierarchy. The generation makes identifiers of destroyed nodes stay invalid once
+     * their index is reused by a new node.
+     */
+    struct TransformId
+    {
+        UINT32 Index = (UINT32)-1;
+        UINT32 Generation = 0;
+
+        bool operator== (const TransformId& rhs) const { return Index == rhs.Index && Generation == rhs.Generation; }
+        bool operator!= (const TransformId& rhs) const { return !(*this == rhs); }
+
+        /** Returns true if the identifier was never assigned. */
+        bool IsNull() const { return Index == (UINT32)-1; }
+    };
+
+    /**
+     * Scene graph of transforms. Each node has a local position, rotation and scale relative to its parent, and local
+     * bounds. Update() computes the world matrix and world bounds of the nodes whose local transform changed, and of
+     * their descendants, leaving all other nodes untouched.
+     *
+     * Nodes are stored by depth, with one structure of arrays per level of the hierarchy, so that parents are always
+     * updated before their children. Levels are updated one after another, and the nodes of a large level are split
+     * between TaskScheduler threads.
+     *
+     * @note	Setting the local transform or bounds of different nodes can be done from multiple threads at once, as long
+     *			as Update() doesn't run at the same time. Creating, destroying and re-parenting nodes is sim thread only.
+     */
+    class TE_CORE_EXPORT TransformHierarchy : public NonCopyable
+    {
+    public:
+        TransformHierarchy() = default;
+        ~TransformHierarchy();
+
+        /** Creates a node with an identity local transform. The node is a root if @p parent is null. */
+        TransformId Create(TransformId parent = TransformId());
+
+        /** Destroys a node and all of its descendants. */
+        void Destroy(TransformId id);
+
+        /** Checks if a node was created and not destroyed yet. */
+        bool IsValid(TransformId id) const;
+
+        /**
+         * Moves a node and its descendants under a new parent, or makes it a root if @p parent is null. The local
+         * transform is kept, so the world transform changes.
+         */
+        void SetParent(TransformId id, TransformId parent);
+
+        /** Returns the parent of a node, null for roots. */
+        TransformId GetParent(TransformId id) const;
+
+        /** Returns the number of ancestors of a node. */
+        UINT32 GetDepth(TransformId id) const { return _nodes[id.Index].Depth; }
+
+        /** Sets the position of a node relative to its parent. */
+        void SetPosition(TransformId id, const Vector3& position);
+
+        /** Sets the rotation of a node relative to its parent. */
+        void SetRotation(TransformId id, const Quaternion& rotation);
+
+        /** Sets the scale of a node relative to its parent. */
+        void SetScale(TransformId id, const Vector3& scale);
+
+        /** Sets the position, rotation and scale of a node relative to its parent. */
+        void SetLocalTransform(TransformId id, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+        /** Sets the bounds of a node, in its own space. World bounds encompass them once transformed. */
+        void SetLocalBounds(TransformId id, const AABox& bounds);
+
+        /** Returns the position of a node relative to its parent. */
+        const Vector3& GetPosition(TransformId id) const { return GetLevel(id).Positions[_nodes[id.Index].Slot]; }
+
+        /** Returns the rotation of a node relative to its parent. */
+        const Quaternion& GetRotation(TransformId id) const { return GetLevel(id).Rotations[_nodes[id.Index].Slot]; }
+
+        /** Returns the scale of a node relative to its parent. */
+        const Vector3& GetScale(TransformId id) const { return GetLevel(id).Scales[_nodes[id.Index].Slot]; }
+
+        /** Returns the bounds of a node in its own space. */
+        const AABox& GetLocalBounds(TransformId id) const { return GetLevel(id).LocalBounds[_nodes[id.Index].Slot]; }
+
+        /** Returns the transform from the space of a node to world space, as of the last Update(). */
+        const Matrix4& GetWorldMatrix(TransformId id) const
+        {
+            return GetLevel(id).WorldMatrices[_nodes[id.Index].Slot];
+        }
+
+        /** Returns the bounds of a node in world space, as of the last Update(). */
+        const AABox& GetWorldBounds(TransformId id) const { return GetLevel(id).WorldBounds[_nodes[id.Index].Slot]; }
+
+        /** Checks if the world transform of a node was recomputed by the last Update(). */
+        bool HasChanged(TransformId id) const { return GetLevel(id).Changed[_nodes[id.Index].Slot] != 0; }
+
+        /** Recomputes the world transform and bounds of modified nodes and their descendants. */
+        void Update();
+
+        /** Returns the number of nodes in the hierarchy. */
+        UINT32 GetNumNodes() const { return _numNodes; }
+
+        /** Minimum number of nodes updated by a task, so that small levels aren't slowed down by scheduling overhead. */
+        static constexpr UINT32 MIN_NODES_PER_TASK = 2048;
+
+    private:
+        static constexpr UINT32 INVALID_INDEX = (UINT32)-1;
+
+        /** Position of a node in the levels, and links to its relatives (as node indices). */
+        struct Node
+        {
+            UINT32 Generation = 0;
+            UINT32 Depth = 0;
+            UINT32 Slot = 0;
+            UINT32 Parent = INVALID_INDEX;
+            UINT32 FirstChild = INVALID_INDEX;
+            UINT32 PrevSibling = INVALID_INDEX;
+            UINT32 NextSibling = INVALID_INDEX;
+            bool Alive = false;
+        };
+
+        /** Nodes at one depth of the hierarchy, as a structure of arrays indexed by slot. */
+        struct Level
+        {
+            Vector<UINT32> Nodes; /**< Index of the node in each slot. */
+            Vector<UINT32> ParentSlots; /**< Slot of the parent of each node, in the previous level. */
+            Vector<Vector3> Positions;
+            Vector<Quaternion> Rotations;
+            Vector<Vector3> Scales;
+            Vector<AABox> LocalBounds;
+            Vector<Matrix4> WorldMatrices;
+            Vector<AABox> WorldBounds;
+            Vector<UINT8> Dirty; /**< Non zero if the local transform or bounds changed since the last update. */
+            Vector<UINT8> Changed; /**< Non zero if the world transform was recomputed by the last update. */
+
+            std::atomic<bool> HasDirty{false}; /**< True if any slot is dirty. */
+            bool HasChanged = false; /**< True if any slot changed during the last update. */
+            bool ParentSlotsStale = false; /**< True if nodes of the previous level moved to other slots. */
+        };
+
+        /** Local state of a node, kept while it moves between levels. */
+        struct LocalState
+        {
+            Vector3 Position;
+            Quaternion Rotation;
+            Vector3 Scale;
+            AABox Bounds;
+        };
+
+        const Level& GetLevel(TransformId id) const { return *_levels[_nodes[id.Index].Depth]; }
+        Level& GetLevel(TransformId id) { return *_levels[_nodes[id.Index].Depth]; }
+
+        /** Marks the slot of a node as needing an update. */
+        void MarkDirty(TransformId id);
+
+        /** Appends a node to the level of its depth. */
+        void AddToLevel(UINT32 node, const LocalState& state);
+
+        /** Removes a node from its level, moving the last node of the level into its slot. Returns its local state. */
+        LocalState RemoveFromLevel(UINT32 node);
+
+        /** Adds a node to the children of a parent node. */
+        void Link(UINT32 node, UINT32 parent);
+
+        /** Removes a node from the children of its parent. */
+        void Unlink(UINT32 node);
+
+        /** Outputs a node followed by all of its descendants, parents always before their children. */
+        void GetSubtree(UINT32 node, Vector<UINT32>& output) const;
+
+        /**
+         * Updates a range of slots of a level. Returns true if any world transform changed. @p parent is the previous
+         * level, null for roots.
+         */
+        static bool UpdateRange(Level& level, const Level* parent, UINT32 begin, UINT32 end);
+
+    private:
+        Vector<Node> _nodes;
+        Vector<UINT32> _freeNodes;
+        Vector<Level*> _levels;
+        Vector<UINT32> _subtree; /**< Scratch list of nodes used by structural changes. */
+        UINT32 _numNodes = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,529 @@
+#include "Scene/TeWorld.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    namespace
+    {
+        UINT32 AlignOffset(UINT32 offset, UINT32 alignment)
+        {
+            return (offset + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    Archetype::Archetype(const ComponentMask& mask)
+        : _mask(mask)
+    {
+        UINT32 rowSize = (UINT32)sizeof(Entity);
+        for (UINT32 i = 0; i < MAX_COMPONENT_TYPES; i++)
+        {
+            if (!mask.test(i))
+                continue;
+
+            const ComponentTypeInfo& info = ComponentTypes::GetInfo(i);
+            TE_ASSERT_ERROR(info.Alignment <= ENTITY_CHUNK_ALIGNMENT, "Unsupported alignment for component " + info.Name);
+
+            _types.push_back(i);
+            _trivial = _trivial && info.Trivial;
+            rowSize += info.Size;
+        }
+
+        memset(_offsets, 0, sizeof(_offsets));
+
+        // Look for the largest number of entities that fits, once component arrays are aligned
+        for (_chunkCapacity = ENTITY_CHUNK_SIZE / rowSize; _chunkCapacity > 0; _chunkCapacity--)
+        {
+            UINT32 offset = (UINT32)sizeof(Entity) * _chunkCapacity;
+            for (auto& type : _types)
+            {
+                const ComponentTypeInfo& info = ComponentTypes::GetInfo(type);
+
+                offset = AlignOffset(offset, info.Alignment);
+                _offsets[type] = offset;
+                offset += info.Size * _chunkCapacity;
+            }
+
+            if (offset <= ENTITY_CHUNK_SIZE)
+                break;
+        }
+
+        TE_ASSERT_ERROR(_chunkCapacity > 0, "Components of an entity don't fit in a chunk");
+    }
+
+    Archetype::~Archetype()
+    {
+        for (auto& chunk : _chunks)
+        {
+            for (UINT32 row = 0; row < chunk->Count; row++)
+                DestroyComponents(chunk, row);
+
+            te_free(chunk->Memory);
+            te_delete(chunk);
+        }
+
+        if (_spareChunk != nullptr)
+        {
+            te_free(_spareChunk->Memory);
+            te_delete(_spareChunk);
+        }
+    }
+
+    EntityChunk* Archetype::Allocate(Entity entity, UINT32& row)
+    {
+        if (_chunks.empty() || _chunks.back()->Count == _chunkCapacity)
+        {
+            EntityChunk* chunk = _spareChunk;
+            _spareChunk = nullptr;
+
+            if (chunk == nullptr)
+            {
+                chunk = te_new<EntityChunk>();
+                chunk->Owner = this;
+                chunk->Memory = (UINT8*)te_allocate(ENTITY_CHUNK_SIZE + ENTITY_CHUNK_ALIGNMENT);
+                chunk->Data = (UINT8*)(((uintptr_t)chunk->Memory + ENTITY_CHUNK_ALIGNMENT - 1) &
+                    ~(uintptr_t)(ENTITY_CHUNK_ALIGNMENT - 1));
+            }
+
+            _chunks.push_back(chunk);
+        }
+
+        EntityChunk* chunk = _chunks.back();
+        row = chunk->Count++;
+        chunk->GetEntities()[row] = entity;
+
+        _numEntities++;
+        return chunk;
+    }
+
+    Entity Archetype::Remove(EntityChunk* chunk, UINT32 row)
+    {
+        EntityChunk* last = _chunks.back();
+        const UINT32 lastRow = last->Count - 1;
+
+        Entity moved;
+        if (last != chunk || lastRow != row)
+        {
+            for (auto& type : _types)
+            {
+                const ComponentTypeInfo& info = ComponentTypes::GetInfo(type);
+                UINT8* destination = chunk->Data + _offsets[type] + (size_t)row * info.Size;
+                UINT8* source = last->Data + _offsets[type] + (size_t)lastRow * info.Size;
+
+                if (info.Trivial)
+                    memcpy(destination, source, info.Size);
+                else
+                    info.Relocate(destination, source);
+            }
+
+            moved = last->GetEntities()[lastRow];
+            chunk->GetEntities()[row] = moved;
+        }
+
+        last->Count--;
+        _numEntities--;
+
+        if (last->Count == 0)
+        {
+            _chunks.pop_back();
+
+            if (_spareChunk == nullptr)
+                _spareChunk = last;
+            else
+            {
+                te_free(last->Memory);
+                te_delete(last);
+            }
+        }
+
+        return moved;
+    }
+
+    void Archetype::DestroyComponents(EntityChunk* chunk, UINT32 row)
+    {
+        if (_trivial)
+            return;
+
+        for (auto& type : _types)
+        {
+            const ComponentTypeInfo& info = ComponentTypes::GetInfo(type);
+            if (!info.Trivial)
+                info.Destroy(chunk->Data + _offsets[type] + (size_t)row * info.Size);
+        }
+    }
+
+    CommandBuffer::CommandBuffer(World& world)
+        : _world(&world)
+    { }
+
+    CommandBuffer::~CommandBuffer()
+    {
+        Clear();
+
+        for (auto& page : _pages)
+            te_free(page);
+    }
+
+    Entity CommandBuffer::CreateEntity()
+    {
+        const Entity entity = _world->ReserveEntity();
+
+        Lock lock(_mutex);
+        _commands.push_back({ CommandType::CreateEntity, 0, entity, nullptr });
+
+        return entity;
+    }
+
+    void CommandBuffer::DestroyEntity(Entity entity)
+    {
+        Lock lock(_mutex);
+        _commands.push_back({ CommandType::DestroyEntity, 0, entity, nullptr });
+    }
+
+    bool CommandBuffer::IsEmpty() const
+    {
+        Lock lock(_mutex);
+        return _commands.empty();
+    }
+
+    void CommandBuffer::Execute()
+    {
+        Lock lock(_mutex);
+
+        if (_commands.empty())
+            return;
+
+        _world->Execute(*this);
+        Clear();
+    }
+
+    void* CommandBuffer::AllocatePayload(UINT32 size, UINT32 alignment)
+    {
+        if (size + alignment > PAGE_SIZE)
+        {
+            TE_ASSERT_ERROR(alignment <= 16, "Unsupported component alignment");
+
+            _largePayloads.push_back((UINT8*)te_allocate(size));
+            return _largePayloads.back();
+        }
+
+        while (true)
+        {
+            if (_pageIndex == (UINT32)_pages.size())
+                _pages.push_back((UINT8*)te_allocate(PAGE_SIZE));
+
+            UINT8* page = _pages[_pageIndex];
+            const uintptr_t address = ((uintptr_t)page + _pageOffset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            const UINT32 end = (UINT32)(address - (uintptr_t)page) + size;
+
+            if (end <= PAGE_SIZE)
+            {
+                _pageOffset = end;
+                return (void*)address;
+            }
+
+            _pageIndex++;
+            _pageOffset = 0;
+        }
+    }
+
+    void CommandBuffer::Clear()
+    {
+        for (auto& command : _commands)
+        {
+            if (command.Payload != nullptr)
+                ComponentTypes::GetInfo(command.Component).Destroy(command.Payload);
+        }
+
+        for (auto& payload : _largePayloads)
+            te_free(payload);
+
+        _commands.clear();
+        _largePayloads.clear();
+        _pageIndex = 0;
+        _pageOffset = 0;
+    }
+
+    World::World()
+        : _commands(*this)
+    {
+        _emptyArchetype = GetArchetype(ComponentMask());
+    }
+
+    World::~World()
+    {
+        if (UpdateScheduler::IsStarted())
+        {
+            for (auto& system : _systems)
+                gUpdateScheduler().Unregister(system);
+        }
+
+        // Payloads of pending commands are component values that must be destroyed before the archetypes
+        _commands.Clear();
+
+        for (auto& archetype : _archetypes)
+            te_delete(archetype);
+    }
+
+    void World::DestroyEntity(Entity entity)
+    {
+        if (!IsAlive(entity))
+            return;
+
+        EntityRecord& record = _records[entity.Index];
+        record.Owner->DestroyComponents(record.Chunk, record.Row);
+        RemoveRow(record.Owner, record.Chunk, record.Row);
+
+        record.Owner = nullptr;
+        record.Chunk = nullptr;
+        record.Generation++;
+        _numEntities--;
+
+        Lock lock(_reserveMutex);
+        _freeIndices.push_back(entity.Index);
+    }
+
+    bool World::IsAlive(Entity entity) const
+    {
+        return entity.Index < (UINT32)_records.size() && _records[entity.Index].Owner != nullptr &&
+            _records[entity.Index].Generation == entity.Generation;
+    }
+
+    Entity World::ReserveEntity()
+    {
+        Lock lock(_reserveMutex);
+
+        if (!_freeIndices.empty())
+        {
+            const UINT32 index = _freeIndices.back();
+            _freeIndices.pop_back();
+
+            return { index, _records[index].Generation };
+        }
+
+        return { (UINT32)_records.size() + _numReserved++, 0 };
+    }
+
+    void World::RemoveComponent(Entity entity, ComponentTypeId type)
+    {
+        if (!IsAlive(entity))
+            return;
+
+        EntityRecord& record = _records[entity.Index];
+        if (!record.Owner->HasComponent(type))
+            return;
+
+        Move(record, GetRemoveTarget(record.Owner, type));
+    }
+
+    void* World::GetComponent(Entity entity, ComponentTypeId type) const
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        const EntityRecord& record = _records[entity.Index];
+        if (!record.Owner->HasComponent(type))
+            return nullptr;
+
+        return GetComponentAddress(record, type);
+    }
+
+    void World::RemoveSystem(UINT32 id)
+    {
+        auto iterFind = std::find(_systems.begin(), _systems.end(), id);
+        if (iterFind == _systems.end())
+            return;
+
+        gUpdateScheduler().Unregister(id);
+        _systems.erase(iterFind);
+    }
+
+    Archetype* World::GetArchetype(const ComponentMask& mask)
+    {
+        auto iterFind = _archetypeLookup.find(mask);
+        if (iterFind != _archetypeLookup.end())
+            return iterFind->second;
+
+        Archetype* archetype = te_new<Archetype>(mask);
+        _archetypes.push_back(archetype);
+        _archetypeLookup[mask] = archetype;
+
+        return archetype;
+    }
+
+    Archetype* World::GetAddTarget(Archetype* archetype, ComponentTypeId type)
+    {
+        auto iterFind = archetype->_addEdges.find(type);
+        if (iterFind != archetype->_addEdges.end())
+            return iterFind->second;
+
+        ComponentMask mask = archetype->GetMask();
+        mask.set(type);
+
+        Archetype* target = GetArchetype(mask);
+        archetype->_addEdges[type] = target;
+        target->_removeEdges[type] = archetype;
+
+        return target;
+    }
+
+    Archetype* World::GetRemoveTarget(Archetype* archetype, ComponentTypeId type)
+    {
+        auto iterFind = archetype->_removeEdges.find(type);
+        if (iterFind != archetype->_removeEdges.end())
+            return iterFind->second;
+
+        ComponentMask mask = archetype->GetMask();
+        mask.reset(type);
+
+        Archetype* target = GetArchetype(mask);
+        archetype->_removeEdges[type] = target;
+        target->_addEdges[type] = archetype;
+
+        return target;
+    }
+
+    World::EntityRecord& World::Place(Entity entity, Archetype* archetype)
+    {
+        if (entity.Index >= (UINT32)_records.size())
+        {
+            Lock lock(_reserveMutex);
+            _records.resize(_records.size() + _numReserved);
+            _numReserved = 0;
+        }
+
+        EntityRecord& record = _records[entity.Index];
+        record.Owner = archetype;
+        record.Chunk = archetype->Allocate(entity, record.Row);
+        _numEntities++;
+
+        return record;
+    }
+
+    void World::Move(EntityRecord& record, Archetype* target)
+    {
+        Archetype* source = record.Owner;
+        EntityChunk* chunk = record.Chunk;
+        const UINT32 row = record.Row;
+
+        UINT32 targetRow;
+        EntityChunk* targetChunk = target->Allocate(chunk->GetEntities()[row], targetRow);
+
+        for (auto& type : source->GetTypes())
+        {
+            const ComponentTypeInfo& info = ComponentTypes::GetInfo(type);
+            UINT8* component = chunk->Data + source->GetOffset(type) + (size_t)row * info.Size;
+
+            if (target->HasComponent(type))
+            {
+                UINT8* destination = targetChunk->Data + target->GetOffset(type) + (size_t)targetRow * info.Size;
+
+                if (info.Trivial)
+                    memcpy(destination, component, info.Size);
+                else
+                    info.Relocate(destination, component);
+            }
+            else if (!info.Trivial)
+                info.Destroy(component);
+        }
+
+        RemoveRow(source, chunk, row);
+
+        record.Owner = target;
+        record.Chunk = targetChunk;
+        record.Row = targetRow;
+    }
+
+    void World::RemoveRow(Archetype* archetype, EntityChunk* chunk, UINT32 row)
+    {
+        const Entity moved = archetype->Remove(chunk, row);
+        if (moved.IsNull())
+            return;
+
+        EntityRecord& record = _records[moved.Index];
+        record.Chunk = chunk;
+        record.Row = row;
+    }
+
+    void* World::AddComponentStorage(Entity entity, ComponentTypeId type)
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        EntityRecord& record = _records[entity.Index];
+        Move(record, GetAddTarget(record.Owner, type));
+
+        return GetComponentAddress(record, type);
+    }
+
+    void World::Execute(CommandBuffer& commands)
+    {
+        Vector<CommandBuffer::Command>& list = commands._commands;
+        const UINT32 numCommands = (UINT32)list.size();
+
+        for (UINT32 i = 0; i < numCommands; )
+        {
+            CommandBuffer::Command& command = list[i];
+
+            switch (command.Type)
+            {
+            case CommandBuffer::CommandType::CreateEntity:
+                Place(command.Target, _emptyArchetype);
+                i++;
+                break;
+            case CommandBuffer::CommandType::DestroyEntity:
+                DestroyEntity(command.Target);
+                i++;
+                break;
+            case CommandBuffer::CommandType::RemoveComponent:
+                RemoveComponent(command.Target, command.Component);
+                i++;
+                break;
+            case CommandBuffer::CommandType::AddComponent:
+            {
+                // Components added to the same entity in a row are applied together, so that the entity only moves
+                // once instead of going through every intermediate archetype
+                UINT32 end = i + 1;
+                while (end < numCommands && list[end].Type == CommandBuffer::CommandType::AddComponent &&
+                    list[end].Target == command.Target)
+                {
+                    end++;
+                }
+
+                if (IsAlive(command.Target))
+                {
+                    EntityRecord& record = _records[command.Target.Index];
+
+                    // Components already there are replaced, the new ones are constructed in uninitialized memory
+                    ComponentMask initialized = record.Owner->GetMask();
+                    Archetype* target = record.Owner;
+
+                    for (UINT32 j = i; j < end; j++)
+                    {
+                        if (!target->HasComponent(list[j].Component))
+                            target = GetAddTarget(target, list[j].Component);
+                    }
+
+                    if (target != record.Owner)
+                        Move(record, target);
+
+                    for (UINT32 j = i; j < end; j++)
+                    {
+                        const ComponentTypeInfo& info = ComponentTypes::GetInfo(list[j].Component);
+                        void* component = GetComponentAddress(record, list[j].Component);
+
+                        if (initialized.test(list[j].Component))
+                            info.Destroy(component);
+
+                        info.Relocate(component, list[j].Payload);
+                        initialized.set(list[j].Component);
+                        list[j].Payload = nullptr;
+                    }
+                }
+
+                i = end;
+            }
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file
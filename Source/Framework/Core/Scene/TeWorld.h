@@ -0,0 +1,620 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Scene/TeEntity.h"
+#include "Scheduler/TeUpdateScheduler.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Utility/TeFlatHashMap.h"
+#include "Utility/TeNonCopyable.h"
+
+namespace te
+{
+    class World;
+    class Archetype;
+
+    /** Size in bytes of the blocks of memory entities are stored in. */
+    constexpr UINT32 ENTITY_CHUNK_SIZE = 16 * 1024;
+
+    /** Alignment of the data of entity chunks. Component types can't require more. */
+    constexpr UINT32 ENTITY_CHUNK_ALIGNMENT = 64;
+
+    /**
+     * Fixed size block of memory storing entities of a single archetype. The data starts with the identifiers of the
+     * entities, followed by one array per component type of the archetype (structure of arrays), so that systems
+     * iterate over tightly packed components.
+     */
+    struct EntityChunk
+    {
+        Archetype* Owner = nullptr;
+        UINT8* Data = nullptr; /**< ENTITY_CHUNK_SIZE bytes, aligned to ENTITY_CHUNK_ALIGNMENT. */
+        UINT8* Memory = nullptr; /**< Allocation the data lives in. */
+        UINT32 Count = 0; /**< Number of entities in the chunk. */
+
+        /** Returns the identifiers of the entities in the chunk. */
+        Entity* GetEntities() const { return (Entity*)Data; }
+    };
+
+    /**
+     * Unique set of component types. All entities with exactly these components are stored together in the chunks of
+     * the archetype. Entities are kept packed: every chunk is full except the last one.
+     */
+    class TE_CORE_EXPORT Archetype : public NonCopyable
+    {
+    public:
+        Archetype(const ComponentMask& mask);
+        ~Archetype();
+
+        /** Returns the set of component types of the archetype. */
+        const ComponentMask& GetMask() const { return _mask; }
+
+        /** Returns the component types of the archetype, sorted by identifier. */
+        const Vector<ComponentTypeId>& GetTypes() const { return _types; }
+
+        /** Checks if entities of the archetype have a component of the provided type. */
+        bool HasComponent(ComponentTypeId type) const { return _mask.test(type); }
+
+        /** Returns the maximum number of entities in a chunk. */
+        UINT32 GetChunkCapacity() const { return _chunkCapacity; }
+
+        /** Returns the chunks entities of the archetype are stored in. */
+        const Vector<EntityChunk*>& GetChunks() const { return _chunks; }
+
+        /** Returns the number of entities of the archetype. */
+        UINT32 GetNumEntities() const { return _numEntities; }
+
+        /** Returns the offset of the array of a component type in the chunks. The archetype must have the component. */
+        UINT32 GetOffset(ComponentTypeId type) const { return _offsets[type]; }
+
+        /** Returns the array of a component type in a chunk. The archetype must have the component. */
+        template <typename T>
+        T* GetComponents(const EntityChunk& chunk) const
+        {
+            return (T*)(chunk.Data + GetOffset(ComponentTypes::GetId<T>()));
+        }
+
+    private:
+        friend class World;
+
+        /** Adds an entity at the end of the archetype and outputs where it is. Its components are left uninitialized. */
+        EntityChunk* Allocate(Entity entity, UINT32& row);
+
+        /**
+         * Fills the row of a removed entity by relocating the last entity of the archetype into it. Components of the
+         * removed entity must already be destroyed or relocated. Returns the entity that was relocated, or a null entity
+         * if the removed entity was the last one.
+         */
+        Entity Remove(EntityChunk* chunk, UINT32 row);
+
+        /** Destroys the components of an entity, leaving the row uninitialized. */
+        void DestroyComponents(EntityChunk* chunk, UINT32 row);
+
+    private:
+        ComponentMask _mask;
+        Vector<ComponentTypeId> _types;
+        UINT32 _offsets[MAX_COMPONENT_TYPES];
+        bool _trivial = true; /**< True if all component types can be moved with memcpy and need no destruction. */
+
+        UINT32 _chunkCapacity = 0;
+        UINT32 _numEntities = 0;
+        Vector<EntityChunk*> _chunks;
+        EntityChunk* _spareChunk = nullptr; /**< Last emptied chunk, kept to avoid churn at a chunk boundary. */
+
+        /** Archetypes reached by adding or removing a component type, cached as they are looked up. */
+        FlatHashMap<ComponentTypeId, Archetype*> _addEdges;
+        FlatHashMap<ComponentTypeId, Archetype*> _removeEdges;
+    };
+
+    /**
+     * Records structural changes (creating and destroying entities, adding and removing components) to apply them later,
+     * at a point where no system iterates over the world. Changes are applied in the order they were recorded in, and
+     * the ones targeting entities destroyed in the meantime are ignored.
+     *
+     * @note	Thread safe. Systems running in parallel can record into the same buffer.
+     */
+    class TE_CORE_EXPORT CommandBuffer : public NonCopyable
+    {
+    public:
+        CommandBuffer(World& world);
+        ~CommandBuffer();
+
+        /**
+         * Reserves an entity that gets created when the buffer is executed. The identifier can be used by the following
+         * commands right away.
+         */
+        Entity CreateEntity();
+
+        /** Destroys an entity and all of its components. */
+        void DestroyEntity(Entity entity);
+
+        /** Adds a component to an entity, or replaces its value if the entity already has one. */
+        template <typename T, typename... Args>
+        void AddComponent(Entity entity, Args&&... args)
+        {
+            typedef typename std::decay<T>::type Type;
+
+            Lock lock(_mutex);
+
+            void* payload = AllocatePayload((UINT32)sizeof(Type), (UINT32)alignof(Type));
+            new (payload) Type(std::forward<Args>(args)...);
+
+            _commands.push_back({ CommandType::AddComponent, ComponentTypes::GetId<Type>(), entity, payload });
+        }
+
+        /** Removes a component from an entity, if it has one. */
+        template <typename T>
+        void RemoveComponent(Entity entity)
+        {
+            Lock lock(_mutex);
+            _commands.push_back({ CommandType::RemoveComponent, ComponentTypes::GetId<T>(), entity, nullptr });
+        }
+
+        /** Checks if there is any recorded command. */
+        bool IsEmpty() const;
+
+        /** Applies all the recorded commands to the world, in order, and clears the buffer. */
+        void Execute();
+
+    private:
+        friend class World;
+
+        enum class CommandType : UINT8
+        {
+            CreateEntity, DestroyEntity, AddComponent, RemoveComponent
+        };
+
+        struct Command
+        {
+            CommandType Type;
+            ComponentTypeId Component;
+            Entity Target;
+            void* Payload; /**< Value of the component to add, destroyed or relocated once the command is applied. */
+        };
+
+        static constexpr UINT32 PAGE_SIZE = 16 * 1024;
+
+        /**
+         * Returns memory for a component value. Values are stored in pages that never move, unlike the command array,
+         * so they don't need to be relocated when the buffer grows.
+         */
+        void* AllocatePayload(UINT32 size, UINT32 alignment);
+
+        /** Destroys the payloads of commands that weren't applied and empties the buffer, keeping its memory. */
+        void Clear();
+
+    private:
+        World* _world;
+        Vector<Command> _commands;
+        Vector<UINT8*> _pages;
+        Vector<UINT8*> _largePayloads; /**< Payloads bigger than a page, allocated separately. */
+        UINT32 _pageIndex = 0;
+        UINT32 _pageOffset = 0;
+        mutable Mutex _mutex;
+    };
+
+    /**
+     * Iterates over all entities that have the components @p T. Components declared const are only read, which lets
+     * systems reading the same components run in parallel.
+     *
+     * Matching archetypes are found once and cached, later calls only check the archetypes created in the meantime.
+     * Iteration goes linearly over the chunks of the matching archetypes.
+     *
+     * @code
+     * Query<Position, const Velocity> query(world);
+     * query.ForEach([](Position& position, const Velocity& velocity) { position.Value += velocity.Value; });
+     * @endcode
+     *
+     * @note	The world must not be structurally modified while iterating, record changes in a CommandBuffer instead.
+     */
+    template <typename... T>
+    class Query
+    {
+    public:
+        Query(World& world);
+
+        /** Excludes entities that have a component of type @p U. Must be called before iterating. */
+        template <typename U>
+        Query& Without()
+        {
+            _exclude.set(ComponentTypes::GetId<U>());
+            return *this;
+        }
+
+        /**
+         * Calls @p func for every matching entity. The function receives references to the components, optionally
+         * preceded by the Entity.
+         */
+        template <typename F>
+        void ForEach(F func)
+        {
+            Update();
+
+            for (auto& match : _matches)
+            {
+                for (auto& chunk : match.Owner->GetChunks())
+                    RunRows(match, *chunk, func, std::index_sequence_for<T...>());
+            }
+        }
+
+        /**
+         * Calls @p func once per matching chunk, with the number of entities in the chunk, their identifiers and one
+         * array per component type. Useful for processing components in batches (e.g. with SIMD).
+         */
+        template <typename F>
+        void ForEachChunk(F func)
+        {
+            Update();
+
+            for (auto& match : _matches)
+            {
+                for (auto& chunk : match.Owner->GetChunks())
+                    RunChunk(match, *chunk, func, std::index_sequence_for<T...>());
+            }
+        }
+
+        /**
+         * Same as ForEach(), but splits the matching chunks into ranges processed in parallel on the TaskScheduler.
+         * Blocks until all entities were processed. The function is called concurrently, so it must only modify the
+         * components it receives and record structural changes in a CommandBuffer.
+         *
+         * @param[in]	func				Function called for every matching entity.
+         * @param[in]	minChunksPerTask	Minimum number of chunks processed by a task, so that small queries aren't
+         *									slowed down by scheduling overhead.
+         */
+        template <typename F>
+        void ForEachParallel(const F& func, UINT32 minChunksPerTask = 4)
+        {
+            Update();
+
+            _chunks.clear();
+            for (auto& match : _matches)
+            {
+                for (auto& chunk : match.Owner->GetChunks())
+                    _chunks.push_back({ &match, chunk });
+            }
+
+            const UINT32 numChunks = (UINT32)_chunks.size();
+            UINT32 numTasks = 1;
+
+            if (TaskScheduler::IsStarted())
+            {
+                // A few tasks per worker balances chunks that take longer than others
+                numTasks = std::min(gTaskScheduler().getNumWorkers() * 4, numChunks / std::max(minChunksPerTask, 1U));
+                numTasks = std::max(numTasks, 1U);
+            }
+
+            auto processRange = [this, &func, numChunks, numTasks](UINT32 task)
+            {
+                const UINT32 end = (UINT32)((UINT64)numChunks * (task + 1) / numTasks);
+                for (UINT32 i = (UINT32)((UINT64)numChunks * task / numTasks); i < end; i++)
+                    RunRows(*_chunks[i].first, *_chunks[i].second, func, std::index_sequence_for<T...>());
+            };
+
+            Vector<SPtr<Task>> tasks;
+            tasks.reserve(numTasks - 1);
+
+            for (UINT32 i = 1; i < numTasks; i++)
+            {
+                tasks.push_back(Task::Create("Query", [&processRange, i]() { processRange(i); }));
+                gTaskScheduler().AddTask(tasks.back());
+            }
+
+            // The calling thread takes its share instead of only waiting
+            processRange(0);
+
+            for (auto& task : tasks)
+                task->Wait();
+        }
+
+        /** Returns the number of entities matching the query. */
+        UINT32 GetNumEntities()
+        {
+            Update();
+
+            UINT32 count = 0;
+            for (auto& match : _matches)
+                count += match.Owner->GetNumEntities();
+
+            return count;
+        }
+
+    private:
+        /** Matching archetype, with the offsets of the queried component arrays in its chunks. */
+        struct Match
+        {
+            Archetype* Owner;
+            UINT32 Offsets[sizeof...(T) > 0 ? sizeof...(T) : 1];
+        };
+
+        /** Adds the archetypes created since the last call that match the query. */
+        void Update();
+
+        template <typename F, size_t... I>
+        static void RunRows(const Match& match, const EntityChunk& chunk, F& func, std::index_sequence<I...>)
+        {
+            const Entity* entities = chunk.GetEntities();
+            std::tuple<T*...> arrays((T*)(chunk.Data + match.Offsets[I])...);
+
+            for (UINT32 row = 0; row < chunk.Count; row++)
+            {
+                if constexpr (std::is_invocable<F&, Entity, T&...>::value)
+                    func(entities[row], std::get<I>(arrays)[row]...);
+                else
+                    func(std::get<I>(arrays)[row]...);
+            }
+        }
+
+        template <typename F, size_t... I>
+        static void RunChunk(const Match& match, const EntityChunk& chunk, F& func, std::index_sequence<I...>)
+        {
+            func(chunk.Count, (const Entity*)chunk.GetEntities(), (T*)(chunk.Data + match.Offsets[I])...);
+        }
+
+    private:
+        World* _world;
+        ComponentMask _include;
+        ComponentMask _exclude;
+        Vector<Match> _matches;
+        UINT32 _numCheckedArchetypes = 0;
+        Vector<std::pair<const Match*, EntityChunk*>> _chunks; /**< Chunks split between tasks by ForEachParallel. */
+    };
+
+    /** Describes when a system runs. See World::AddSystem(). */
+    struct SYSTEM_DESC
+    {
+        String Name; /**< Unique name of the system, used for ordering and debugging. */
+        UpdatePhase Phase = UpdatePhase::Update;
+        Vector<String> Reads; /**< Names of data besides components the system reads, see UPDATE_DESC. */
+        Vector<String> Writes; /**< Names of data besides components the system modifies, see UPDATE_DESC. */
+        Vector<String> After; /**< Names of systems or updates that must complete before this one starts. */
+
+        /** If true the system always runs on the sim thread. */
+        bool MainThread = false;
+
+        /** If true entities are split between TaskScheduler threads, see Query::ForEachParallel(). */
+        bool Parallel = false;
+    };
+
+    /**
+     * Stores entities and their components, grouped by archetype in 16 KB chunks, and runs the systems processing
+     * them. Structural changes made directly on the world (e.g. AddComponent()) take effect immediately and must only
+     * happen while no system runs. Systems record them in the command buffer returned by GetCommands() instead, which
+     * is applied by Flush().
+     *
+     * @note	Sim thread only, except for ReserveEntity() and command recording.
+     */
+    class TE_CORE_EXPORT World : public NonCopyable
+    {
+    public:
+        World();
+        ~World();
+
+        /** Creates an entity with the provided components. */
+        template <typename... T>
+        Entity CreateEntity(T&&... components)
+        {
+            ComponentMask mask;
+            (mask.set(ComponentTypes::GetId<typename std::decay<T>::type>()), ...);
+
+            const Entity entity = ReserveEntity();
+            EntityRecord& record = Place(entity, GetArchetype(mask));
+
+            (new (GetComponentAddress(record, ComponentTypes::GetId<typename std::decay<T>::type>()))
+                typename std::decay<T>::type(std::forward<T>(components)), ...);
+
+            return entity;
+        }
+
+        /** Destroys an entity and its components. Does nothing if the entity isn't alive. */
+        void DestroyEntity(Entity entity);
+
+        /** Checks if an entity was created and not destroyed yet. */
+        bool IsAlive(Entity entity) const;
+
+        /**
+         * Returns an identifier for an entity that will be created later, see CommandBuffer::CreateEntity(). Can be
+         * called from any thread.
+         */
+        Entity ReserveEntity();
+
+        /**
+         * Adds a component to an entity, moving the entity to the archetype with the component. If the entity already
+         * has a component of this type its value is replaced. Returns the component, or null if the entity isn't alive.
+         */
+        template <typename T, typename... Args>
+        T* AddComponent(Entity entity, Args&&... args)
+        {
+            const ComponentTypeId type = ComponentTypes::GetId<T>();
+            if (T* component = (T*)GetComponent(entity, type))
+            {
+                *component = T(std::forward<Args>(args)...);
+                return component;
+            }
+
+            void* storage = AddComponentStorage(entity, type);
+            if (storage == nullptr)
+                return nullptr;
+
+            return new (storage) T(std::forward<Args>(args)...);
+        }
+
+        /** Removes a component from an entity. Does nothing if the entity doesn't have it. */
+        template <typename T>
+        void RemoveComponent(Entity entity)
+        {
+            RemoveComponent(entity, ComponentTypes::GetId<T>());
+        }
+
+        /** Returns a component of an entity, or null if the entity doesn't have it or isn't alive. */
+        template <typename T>
+        T* GetComponent(Entity entity) const
+        {
+            return (T*)GetComponent(entity, ComponentTypes::GetId<T>());
+        }
+
+        /** Checks if an entity is alive and has a component. */
+        template <typename T>
+        bool HasComponent(Entity entity) const
+        {
+            return GetComponent(entity, ComponentTypes::GetId<T>()) != nullptr;
+        }
+
+        /** Removes a component from an entity. Does nothing if the entity doesn't have it. */
+        void RemoveComponent(Entity entity, ComponentTypeId type);
+
+        /** Returns a component of an entity, or null if the entity doesn't have it or isn't alive. */
+        void* GetComponent(Entity entity, ComponentTypeId type) const;
+
+        /** Returns the number of entities alive. */
+        UINT32 GetNumEntities() const { return _numEntities; }
+
+        /** Returns all archetypes created so far. Archetypes live as long as the world, new ones are appended. */
+        const Vector<Archetype*>& GetArchetypes() const { return _archetypes; }
+
+        /** Returns the command buffer applied by Flush(). */
+        CommandBuffer& GetCommands() { return _commands; }
+
+        /** Applies the changes recorded in GetCommands(). */
+        void Flush() { _commands.Execute(); }
+
+        /**
+         * Registers a system with the UpdateScheduler, calling @p func for every entity with the components @p T each
+         * time its phase runs (see Query::ForEach). Components the system writes are declared as written data and const
+         * components as read data, so systems that don't touch the same components run in parallel.
+         *
+         * @return	Identifier of the system, to remove it with RemoveSystem().
+         */
+        template <typename... T, typename F>
+        UINT32 AddSystem(const SYSTEM_DESC& desc, F func)
+        {
+            UPDATE_DESC updateDesc;
+            updateDesc.Name = desc.Name;
+            updateDesc.Phase = desc.Phase;
+            updateDesc.Reads = desc.Reads;
+            updateDesc.Writes = desc.Writes;
+            updateDesc.After = desc.After;
+            updateDesc.MainThread = desc.MainThread;
+            (AddAccess<T>(updateDesc), ...);
+
+            SPtr<Query<T...>> query = te_shared_ptr_new<Query<T...>>(*this);
+
+            UpdateScheduler::UpdateFunc update;
+            if (desc.Parallel)
+                update = [query, func]() { query->ForEachParallel(func); };
+            else
+                update = [query, func]() { query->ForEach(func); };
+
+            const UINT32 id = gUpdateScheduler().Register(updateDesc, std::move(update));
+            _systems.push_back(id);
+
+            return id;
+        }
+
+        /** Unregisters a system added with AddSystem(). */
+        void RemoveSystem(UINT32 id);
+
+    private:
+        friend class CommandBuffer;
+
+        /** Location of an entity. */
+        struct EntityRecord
+        {
+            Archetype* Owner = nullptr; /**< Null if the entity isn't alive. */
+            EntityChunk* Chunk = nullptr;
+            UINT32 Row = 0;
+            UINT32 Generation = 0;
+        };
+
+        /** Returns the archetype with exactly the provided components, creating it if needed. */
+        Archetype* GetArchetype(const ComponentMask& mask);
+
+        /** Returns the archetype reached by adding a component type to an archetype. */
+        Archetype* GetAddTarget(Archetype* archetype, ComponentTypeId type);
+
+        /** Returns the archetype reached by removing a component type from an archetype. */
+        Archetype* GetRemoveTarget(Archetype* archetype, ComponentTypeId type);
+
+        /** Creates a reserved entity in an archetype, leaving its components uninitialized. */
+        EntityRecord& Place(Entity entity, Archetype* archetype);
+
+        /**
+         * Moves an entity to another archetype. Shared components are relocated, components the target archetype doesn't
+         * have are destroyed, and components only the target has are left uninitialized.
+         */
+        void Move(EntityRecord& record, Archetype* target);
+
+        /** Fills the hole left by an entity that moved or was destroyed, and updates the entity moved to fill it. */
+        void RemoveRow(Archetype* archetype, EntityChunk* chunk, UINT32 row);
+
+        /** Returns the address of a component of an entity. The entity must have the component. */
+        static void* GetComponentAddress(const EntityRecord& record, ComponentTypeId type)
+        {
+            return record.Chunk->Data + record.Owner->GetOffset(type) +
+                (size_t)record.Row * ComponentTypes::GetInfo(type).Size;
+        }
+
+        /**
+         * Moves an entity to the archetype with an extra component and returns the uninitialized component, or null if
+         * the entity isn't alive.
+         */
+        void* AddComponentStorage(Entity entity, ComponentTypeId type);
+
+        /** Applies the commands of a buffer. */
+        void Execute(CommandBuffer& commands);
+
+        /** Adds the access of a system to a component type to its update description. */
+        template <typename T>
+        static void AddAccess(UPDATE_DESC& desc)
+        {
+            const String& name = ComponentTypes::GetInfo(ComponentTypes::GetId<T>()).Name;
+            if (std::is_const<T>::value)
+                desc.Reads.push_back(name);
+            else
+                desc.Writes.push_back(name);
+        }
+
+    private:
+        Vector<EntityRecord> _records;
+        Vector<UINT32> _freeIndices; /**< Indices of destroyed entities, reused by new entities. */
+        UINT32 _numReserved = 0; /**< Reserved entities with an index past the end of the records. */
+        UINT32 _numEntities = 0;
+        Mutex _reserveMutex;
+
+        Vector<Archetype*> _archetypes;
+        FlatHashMap<ComponentMask, Archetype*> _archetypeLookup;
+        Archetype* _emptyArchetype = nullptr;
+
+        CommandBuffer _commands;
+        Vector<UINT32> _systems;
+    };
+
+    template <typename... T>
+    Query<T...>::Query(World& world)
+        : _world(&world)
+    {
+        (_include.set(ComponentTypes::GetId<T>()), ...);
+    }
+
+    template <typename... T>
+    void Query<T...>::Update()
+    {
+        const Vector<Archetype*>& archetypes = _world->GetArchetypes();
+
+        for (; _numCheckedArchetypes < (UINT32)archetypes.size(); _numCheckedArchetypes++)
+        {
+            Archetype* archetype = archetypes[_numCheckedArchetypes];
+            const ComponentMask& mask = archetype->GetMask();
+
+            if ((mask & _include) != _include || (mask & _exclude).any())
+                continue;
+
+            Match match;
+            match.Owner = archetype;
+
+            UINT32 index = 0;
+            ((match.Offsets[index++] = archetype->GetOffset(ComponentTypes::GetId<T>())), ...);
+            (void)index;
+
+            _matches.push_back(match);
+        }
+    }
+}
\ No newline at end of file
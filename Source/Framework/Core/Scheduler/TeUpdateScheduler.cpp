@@ -0,0 +1,231 @@
+#include "Scheduler/TeUpdateScheduler.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    UINT32 UpdateScheduler::Register(const UPDATE_DESC& desc, UpdateFunc func)
+    {
+        TE_ASSERT_ERROR(desc.Phase < UpdatePhase::Count, "Invalid update phase");
+
+        UINT32 id = _nextId++;
+        _entries.push_back({ id, desc, std::move(func) });
+        _dirty[(UINT32)desc.Phase] = true;
+
+        return id;
+    }
+
+    void UpdateScheduler::Unregister(UINT32 id)
+    {
+        auto iterFind = std::find_if(_entries.begin(), _entries.end(), [id](const UpdateEntry& entry) { return entry.Id == id; });
+        if (iterFind == _entries.end())
+            return;
+
+        _entries.erase(iterFind);
+
+        // Graphs reference entries by index, so all of them need to be rebuilt
+        for (UINT32 i = 0; i < (UINT32)UpdatePhase::Count; i++)
+            _dirty[i] = true;
+    }
+
+    void UpdateScheduler::Run(UpdatePhase phase)
+    {
+        if (_dirty[(UINT32)phase])
+            BuildGraph(phase);
+
+        const Vector<UpdateNode>& graph = _graphs[(UINT32)phase];
+        const UINT32 numNodes = (UINT32)graph.size();
+
+        if (!_parallel || numNodes <= 1)
+        {
+            for (auto& node : graph)
+                _entries[node.EntryIdx].Func();
+
+            return;
+        }
+
+        Vector<SPtr<Task>> tasks(numNodes);
+        Vector<bool> started(numNodes, false);
+        UINT32 numRemaining = numNodes;
+
+        while (numRemaining > 0)
+        {
+            // Queue every worker update whose sim thread dependencies already ran. Nodes are sorted so dependencies
+            // always come first, meaning a single pass is enough.
+            for (UINT32 i = 0; i < numNodes; i++)
+            {
+                const UpdateNode& node = graph[i];
+                const UpdateEntry& entry = _entries[node.EntryIdx];
+
+                if (started[i] || entry.Desc.MainThread)
+                    continue;
+
+                Vector<SPtr<Task>> dependencies;
+                bool ready = true;
+
+                for (auto& dependency : node.Dependencies)
+                {
+                    if (!started[dependency])
+                    {
+                        ready = false;
+                        break;
+                    }
+
+                    if (tasks[dependency] != nullptr)
+                        dependencies.push_back(tasks[dependency]);
+                }
+
+                if (!ready)
+                    continue;
+
+                tasks[i] = Task::Create(entry.Desc.Name, entry.Func, TaskPriority::Normal, std::move(dependencies));
+                gTaskScheduler().AddTask(tasks[i]);
+
+                started[i] = true;
+                numRemaining--;
+            }
+
+            // Run the first sim thread update that can be started. Since nodes are sorted, the first node that didn't
+            // start yet is always a sim thread update with all of its dependencies started.
+            for (UINT32 i = 0; i < numNodes; i++)
+            {
+                if (started[i])
+                    continue;
+
+                const UpdateNode& node = graph[i];
+                for (auto& dependency : node.Dependencies)
+                {
+                    if (tasks[dependency] != nullptr)
+                        tasks[dependency]->Wait();
+                }
+
+                _entries[node.EntryIdx].Func();
+
+                started[i] = true;
+                numRemaining--;
+                break;
+            }
+        }
+
+        for (auto& task : tasks)
+        {
+            if (task != nullptr)
+                task->Wait();
+        }
+    }
+
+    void UpdateScheduler::BuildGraph(UpdatePhase phase)
+    {
+        Vector<UINT32> entries;
+        for (UINT32 i = 0; i < (UINT32)_entries.size(); i++)
+        {
+            if (_entries[i].Desc.Phase == phase)
+                entries.push_back(i);
+        }
+
+        const UINT32 numEntries = (UINT32)entries.size();
+
+        // Dependencies between entries, as indices into the entries array
+        Vector<Vector<UINT32>> dependencies(numEntries);
+        for (UINT32 i = 0; i < numEntries; i++)
+        {
+            const UPDATE_DESC& desc = _entries[entries[i]].Desc;
+
+            for (UINT32 j = 0; j < i; j++)
+            {
+                if (Conflicts(_entries[entries[j]].Desc, desc))
+                    dependencies[i].push_back(j);
+            }
+
+            for (auto& name : desc.After)
+            {
+                for (UINT32 j = 0; j < numEntries; j++)
+                {
+                    if (j != i && _entries[entries[j]].Desc.Name == name)
+                    {
+                        if (std::find(dependencies[i].begin(), dependencies[i].end(), j) == dependencies[i].end())
+                            dependencies[i].push_back(j);
+                    }
+                }
+            }
+        }
+
+        // Topological sort, preferring registration order whenever there's a choice
+        Vector<UINT32> order;
+        Vector<UINT32> nodeIndices(numEntries, (UINT32)-1);
+        order.reserve(numEntries);
+
+        while (order.size() < numEntries)
+        {
+            UINT32 next = (UINT32)-1;
+            for (UINT32 i = 0; i < numEntries && next == (UINT32)-1; i++)
+            {
+                if (nodeIndices[i] != (UINT32)-1)
+                    continue;
+
+                bool ready = std::all_of(dependencies[i].begin(), dependencies[i].end(),
+                    [&nodeIndices](UINT32 dependency) { return nodeIndices[dependency] != (UINT32)-1; });
+
+                if (ready)
+                    next = i;
+            }
+
+            if (next == (UINT32)-1)
+            {
+                // Cyclic ordering constraints, break the cycle by ignoring the ones not satisfied yet
+                for (UINT32 i = 0; i < numEntries && next == (UINT32)-1; i++)
+                {
+                    if (nodeIndices[i] == (UINT32)-1)
+                        next = i;
+                }
+
+                TE_DEBUG("Cyclic update dependencies detected for update: " + _entries[entries[next]].Desc.Name);
+            }
+
+            nodeIndices[next] = (UINT32)order.size();
+            order.push_back(next);
+        }
+
+        Vector<UpdateNode>& graph = _graphs[(UINT32)phase];
+        graph.clear();
+
+        for (auto& entry : order)
+        {
+            UpdateNode node;
+            node.EntryIdx = entries[entry];
+
+            for (auto& dependency : dependencies[entry])
+            {
+                if (nodeIndices[dependency] < (UINT32)graph.size())
+                    node.Dependencies.push_back(nodeIndices[dependency]);
+            }
+
+            graph.push_back(std::move(node));
+        }
+
+        _dirty[(UINT32)phase] = false;
+    }
+
+    bool UpdateScheduler::Conflicts(const UPDATE_DESC& a, const UPDATE_DESC& b)
+    {
+        if (a.Exclusive || b.Exclusive)
+            return true;
+
+        auto intersects = [](const Vector<String>& lhs, const Vector<String>& rhs)
+        {
+            for (auto& entry : lhs)
+            {
+                if (std::find(rhs.begin(), rhs.end(), entry) != rhs.end())
+                    return true;
+            }
+
+            return false;
+        };
+
+        return intersects(a.Writes, b.Writes) || intersects(a.Writes, b.Reads) || intersects(b.Writes, a.Reads);
+    }
+
+    UpdateScheduler& gUpdateScheduler()
+    {
+        return UpdateScheduler::Instance();
+    }
+}
\ No newline at end of file
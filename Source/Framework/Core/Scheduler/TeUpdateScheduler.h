@@ -0,0 +1,107 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeModule.h"
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    /** Phases of the main loop in which updates can be scheduled. Phases are executed one after another. */
+    enum class UpdatePhase
+    {
+        PreUpdate, /**< Runs after CoreApplication::PreUpdate(). */
+        Update, /**< Runs after all PreUpdate phase updates complete. Physics and audio run here. */
+        PostUpdate, /**< Runs after all Update phase updates complete, and before CoreApplication::PostUpdate(). */
+        Count
+    };
+
+    /**
+     * Describes when an update can run and which data it touches. Two updates in the same phase run in parallel unless
+     * one writes data the other one reads or writes, or one is explicitly ordered after the other. Data is identified by
+     * an arbitrary name (e.g. "Physics", "Audio", "SceneGraph").
+     */
+    struct UPDATE_DESC
+    {
+        String Name; /**< Unique name of the update, used for ordering and debugging. */
+        UpdatePhase Phase = UpdatePhase::Update;
+        Vector<String> Reads; /**< Names of data the update reads. */
+        Vector<String> Writes; /**< Names of data the update modifies. */
+        Vector<String> After; /**< Names of updates (in the same phase) that must complete before this one starts. */
+
+        /** If true the update always runs on the sim thread. Otherwise it can run on any TaskScheduler thread. */
+        bool MainThread = false;
+
+        /**
+         * If true the update never runs in parallel with any other update in its phase. Used for updates that didn't
+         * declare what data they access.
+         */
+        bool Exclusive = false;
+    };
+
+    /**
+     * Runs the per-frame updates of modules and plugins. Each phase is turned into a task graph using the declared
+     * data accesses of its updates, and independent updates run in parallel on the TaskScheduler. When two updates
+     * conflict they run in the order they were registered in.
+     *
+     * @note	Sim thread only.
+     */
+    class TE_CORE_EXPORT UpdateScheduler : public Module<UpdateScheduler>
+    {
+    public:
+        typedef std::function<void()> UpdateFunc;
+
+        UpdateScheduler() = default;
+        ~UpdateScheduler() = default;
+
+        /** Registers a new update. Returns an identifier that can be used for unregistering it. */
+        UINT32 Register(const UPDATE_DESC& desc, UpdateFunc func);
+
+        /** Unregisters an update previously registered with Register(). */
+        void Unregister(UINT32 id);
+
+        /** Executes all updates in the provided phase and blocks until they complete. */
+        void Run(UpdatePhase phase);
+
+        /**
+         * Enables or disables parallel execution. When disabled all updates run on the sim thread, in the same order the
+         * task graph would respect. Useful for debugging.
+         */
+        void SetParallel(bool parallel) { _parallel = parallel; }
+
+        /** Checks if updates can run in parallel. See SetParallel(). */
+        bool GetParallel() const { return _parallel; }
+
+    protected:
+        /** Single registered update. */
+        struct UpdateEntry
+        {
+            UINT32 Id;
+            UPDATE_DESC Desc;
+            UpdateFunc Func;
+        };
+
+        /** Update with its dependencies resolved, in the order it must be started in. */
+        struct UpdateNode
+        {
+            UINT32 EntryIdx;
+            Vector<UINT32> Dependencies; /**< Indices of nodes in the same phase graph. */
+        };
+
+        /** Rebuilds the execution order and dependencies of the provided phase. */
+        void BuildGraph(UpdatePhase phase);
+
+        /** Returns true if the updates must not run in parallel because of their data accesses. */
+        static bool Conflicts(const UPDATE_DESC& a, const UPDATE_DESC& b);
+
+    protected:
+        Vector<UpdateEntry> _entries;
+        Vector<UpdateNode> _graphs[(UINT32)UpdatePhase::Count];
+        bool _dirty[(UINT32)UpdatePhase::Count] = { true, true, true };
+
+        UINT32 _nextId = 1;
+        bool _parallel = true;
+    };
+
+    /** Provides easy access to UpdateScheduler. */
+    TE_CORE_EXPORT UpdateScheduler& gUpdateScheduler();
+}
\ No newline at end of file
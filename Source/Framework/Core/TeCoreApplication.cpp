@@ -10,6 +10,7 @@
 #include "Manager/TeRendererManager.h"
 #include "Error/TeConsole.h"
 #include "Utility/TeTime.h"
+#include "Utility/TePlatformUtility.h"
 #include "Input/TeInput.h"
 #include "Input/TeVirtualInput.h"
 #include "Physics/TePhysics.h"
@@ -18,6 +19,10 @@
 #include "Renderer/TeRenderer.h"
 #include "Importer/TeImporter.h"
 #include "Resources/TeResourceManager.h"
+#include "FileSystem/TeIOScheduler.h"
+#include "CoreThread/TeCoreThread.h"
+#include "Scheduler/TeUpdateScheduler.h"
+#include "Scene/TeSceneManager.h"
 
 namespace te
 {
@@ -39,15 +44,44 @@ namespace te
     void CoreApplication::OnStartUp()
     {
         Console::StartUp();
+        Log::StartUp(_startUpDesc.LogDesc);
         Time::StartUp();
-        ThreadPool::StartUp();
+        // Leave room for long running threads (task scheduler, core and I/O threads) on top of the workers
+        ThreadPool::StartUp(TE_THREAD_HARDWARE_CONCURRENCY, TE_THREAD_HARDWARE_CONCURRENCY * 2 + 8);
         DynLibManager::StartUp();
         TaskScheduler::StartUp();
+        UpdateScheduler::StartUp();
+        SceneManager::StartUp();
+        IOScheduler::StartUp();
         ResourceManager::StartUp();
 
+        for (auto& archive : _startUpDesc.Archives)
+        {
+            if (!gResourceManager().MountArchive(archive))
+            {
+                TE_DEBUG("Unable to mount archive: " + archive);
+            }
+        }
+
         PluginManager<AudioFactory>::StartUp(_startUpDesc.Audio);
         PluginManager<PhysicsFactory>::StartUp(_startUpDesc.Physics);
 
+        gUpdateScheduler().Register(gPhysics().GetUpdateDesc(), [this]()
+        {
+            UINT64 step;
+            const UINT32 numIterations = gTime().GetFixedUpdateStep(step);
+
+            for (UINT32 i = 0; i < numIterations; i++)
+            {
+                FixedUpdate();
+                gPhysics().Update();
+
+                gTime().AdvanceFixedUpdate(step);
+            }
+        });
+
+        gUpdateScheduler().Register(gAudio().GetUpdateDesc(), []() { gAudio().Update(); });
+
         RenderAPIManager::StartUp();
         RendererManager::StartUp();
 
@@ -59,6 +93,8 @@ namespace te
         _window = RenderAPI::Instance().CreateRenderWindow(_startUpDesc.WindowDesc);
         _window->Initialize();
 
+        CoreThread::StartUp(_startUpDesc.FrameLatency, std::bind(&CoreApplication::RenderFrame, this, std::placeholders::_1));
+
         Input::StartUp();
         VirtualInput::StartUp();
 
@@ -92,6 +128,8 @@ namespace te
     
     void CoreApplication::OnShutDown()
     {
+        CoreThread::ShutDown();
+
         _renderer.reset();
         _window.reset();
 
@@ -104,10 +142,15 @@ namespace te
         PluginManager<PhysicsFactory>::ShutDown();
         PluginManager<AudioFactory>::ShutDown();
 
+        ResourceManager::ShutDown();
+        IOScheduler::ShutDown();
+        SceneManager::ShutDown();
+        UpdateScheduler::ShutDown();
         TaskScheduler::ShutDown();
         DynLibManager::ShutDown();
         ThreadPool::ShutDown();
         Time::ShutDown();
+        Log::ShutDown();
         Console::ShutDown();
     }
 
@@ -126,27 +169,38 @@ namespace te
             _window->Update();
             gInput().TriggerCallbacks();
             gVirtualInput().Update();
+            gResourceManager().Update();
 
             PreUpdate();
 
-            VirtualAxis lookLeftRightAxis("LookLeftRight");
+            VirtualAxis lookLeftRightAxis("LookLeftRight"_sid);
 
             float value = gVirtualInput().GetAxisValue(lookLeftRightAxis);
 
             if(value != 0.0f)
                 std::cout << value << std::endl;
 
-            gPhysics().Update();
-            gAudio().Update();
+            for (UINT32 phase = 0; phase < (UINT32)UpdatePhase::Count; phase++)
+            {
+                gUpdateScheduler().Run((UpdatePhase)phase);
 
-            for (auto& pluginUpdateFunc : _pluginUpdateFunctions)
-                pluginUpdateFunc.second();
+                // Structural changes recorded by systems are applied between phases, while no system runs
+                gSceneManager().GetWorld().Flush();
+            }
 
             PostUpdate();
 
-            RenderAPI::Instance().Update();
-            _renderer->Update();
+            gCoreThread().SubmitFrame();
         }
+
+        // Don't leave the main loop while the core thread still uses the frame data
+        gCoreThread().Flush();
+    }
+
+    void CoreApplication::RenderFrame(const FrameSnapshot& frame)
+    {
+        RenderAPI::Instance().Update();
+        _renderer->Update();
     }
 
     void CoreApplication::PreUpdate()
@@ -159,6 +213,11 @@ namespace te
         // Do nothing
     }
 
+    void CoreApplication::FixedUpdate()
+    {
+        // Do nothing
+    }
+
     void CoreApplication::StopMainLoop()
     {
         _runMainLoop = false;
@@ -202,29 +261,35 @@ namespace te
         {
             UINT64 currentTime = gTime().GetTimePrecise();
             UINT64 nextFrameTime = _lastFrameTime + _frameStep;
-            while (nextFrameTime > currentTime)
+
+            // Sleep for most of the wait. We wake up early by the amount the OS usually oversleeps.
+            if (nextFrameTime > currentTime + _sleepSlack)
             {
-                UINT32 waitTime = (UINT32)(nextFrameTime - currentTime);
+                UINT64 sleepTime = nextFrameTime - currentTime - _sleepSlack;
+                PlatformUtility::SleepMicroseconds(sleepTime);
 
-                // If waiting for longer, sleep
-                if (waitTime >= 2000)
-                {
-                    TE_SLEEP(waitTime / 1000);
-                    currentTime = gTime().GetTimePrecise();
-                }
-                else
-                {
-                    // Otherwise we just spin, sleep timer granularity is too low and we might end up wasting a 
-                    // millisecond otherwise. 
-                    // Note: For mobiles where power might be more important than input latency, consider using sleep.
-                    while (nextFrameTime > currentTime)
-                    {
-                        currentTime = gTime().GetTimePrecise();
-                    }  
-                }
+                UINT64 wakeTime = gTime().GetTimePrecise();
+                UINT64 overSleep = wakeTime - std::min(wakeTime, currentTime + sleepTime);
+
+                // Smooth the measurement, but react immediately to the OS sleeping longer than expected
+                _sleepSlack = std::max(overSleep, (_sleepSlack * 7 + overSleep) / 8);
+                _sleepSlack = Math::Clamp(_sleepSlack, MIN_SLEEP_SLACK, MAX_SLEEP_SLACK);
+
+                currentTime = wakeTime;
+            }
+
+            // Yield for the remaining time. Unlike a pure spin, this lets other threads use the core.
+            while (nextFrameTime > currentTime)
+            {
+                TE_THREAD_YIELD();
+                currentTime = gTime().GetTimePrecise();
             }
 
-            _lastFrameTime = currentTime;
+            // Keep a steady cadence unless we fell behind by more than a frame
+            if (currentTime - nextFrameTime < _frameStep)
+                _lastFrameTime = nextFrameTime;
+            else
+                _lastFrameTime = currentTime;
         }
     }
 
@@ -269,7 +334,23 @@ namespace te
 
             if (updatePluginFunc != nullptr)
             {
-                _pluginUpdateFunctions[loadedLibrary] = updatePluginFunc;
+                UPDATE_DESC desc;
+                desc.Name = pluginName;
+
+                GetUpdatePluginDescFunc getUpdatePluginDescFunc =
+                    (GetUpdatePluginDescFunc)loadedLibrary->GetSymbol("GetUpdatePluginDesc");
+
+                if (getUpdatePluginDescFunc != nullptr)
+                {
+                    getUpdatePluginDescFunc(desc);
+                }
+                else
+                {
+                    desc.MainThread = true;
+                    desc.Exclusive = true;
+                }
+
+                _pluginUpdates[loadedLibrary] = gUpdateScheduler().Register(desc, updatePluginFunc);
             }  
         }
 
@@ -287,7 +368,13 @@ namespace te
             unloadPluginFunc();
         }
 
-        _pluginUpdateFunctions.erase(library);
+        auto iterFind = _pluginUpdates.find(library);
+        if (iterFind != _pluginUpdates.end())
+        {
+            gUpdateScheduler().Unregister(iterFind->second);
+            _pluginUpdates.erase(iterFind);
+        }
+
         gDynLibManager().Unload(library);
     }
 
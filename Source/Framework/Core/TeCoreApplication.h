@@ -17,6 +17,18 @@ namespace te
         RENDER_WINDOW_DESC WindowDesc; /** Describes the window to create during start-up. */
 
         Vector<String> Importers; /** A list of importer plugins to load. */
+
+        /** Pack archives mounted by the ResourceManager during start-up. Later archives take precedence. */
+        Vector<String> Archives;
+
+        /**
+         * Number of frames the simulation is allowed to run ahead of rendering. Zero renders on the sim thread, any
+         * other value renders on a dedicated core thread (see CoreThread). Render API plugins must support being used
+         * from a thread other than the one that created them for values other than zero.
+         */
+        UINT32 FrameLatency = 0;
+
+        LOG_DESC LogDesc; /**< Configures where log messages go and what happens when threads log too much. */
     };
 
     /**
@@ -51,7 +63,10 @@ namespace te
         /** Changes the maximum FPS the application is allowed to run in. Zero means unlimited. */
         void SetFPSLimit(UINT32 limit);
 
-        /** Check if the number of FPS has already been reached. */
+        /**
+         * Waits until the next frame is allowed to start, according to the FPS limit. Most of the wait is spent sleeping,
+         * and only a small margin (adapted to the measured sleep accuracy) is spent yielding the thread.
+         */
         void CheckFPSLimit();
 
         /** Issues a request for the application to close. Application may choose to ignore the request */
@@ -66,6 +81,11 @@ namespace te
         /**
          * Loads a plugin.
          *
+         * If the plugin exports an "UpdatePlugin" method it will be called once per frame through UpdateScheduler. The
+         * plugin can describe when the update runs and which data it accesses by also exporting a
+         * "GetUpdatePluginDesc" method that fills an UPDATE_DESC. Updates of plugins that don't describe themselves
+         * run exclusively on the sim thread.
+         *
          * @param[in]	pluginName	Name of the plugin to load, without extension.
          * @param[out]	library		Specify as not null to receive a reference to the loaded library.
          * @param[in]	passThrough	Optional parameter that will be passed to the loadPlugin function.
@@ -89,11 +109,28 @@ namespace te
         /**	Called for each iteration of the main loop. Called after all game objects and plugins are updated. */
         virtual void PostUpdate();
 
+        /**
+         * Called zero or more times per iteration of the main loop, once for each elapsed fixed time step (see
+         * Time::GetFixedFrameDelta). Called before physics is updated.
+         */
+        virtual void FixedUpdate();
+
+        /**
+         * Executes the render stage of the main loop for the provided frame. Called on the core thread if the
+         * application was started with a non-zero frame latency, otherwise on the sim thread.
+         */
+        virtual void RenderFrame(const FrameSnapshot& frame);
+
         /**	Initializes the renderer specified during construction. Called during initialization. */
         virtual void StartUpRenderer();
 
     protected:
         typedef void(*UpdatePluginFunc)();
+        typedef void(*GetUpdatePluginDescFunc)(UPDATE_DESC&);
+
+        /** Bounds of the margin kept between the end of the FPS limiter sleep and the frame deadline, in microseconds. */
+        static constexpr UINT64 MIN_SLEEP_SLACK = 50;
+        static constexpr UINT64 MAX_SLEEP_SLACK = 4000;
 
         SPtr<Renderer> _renderer;
         SPtr<RenderWindow> _window;
@@ -102,10 +139,11 @@ namespace te
         // Frame limiting
         UINT64 _frameStep = 16666; // 60 times a second in microseconds
         UINT64 _lastFrameTime = 0; // Microseconds
+        UINT64 _sleepSlack = 1000; // Measured oversleep of the OS sleep, in microseconds
 
         DynLib* _rendererPlugin;
         DynLib* _renderAPIPlugin;
-        Map<DynLib*, UpdatePluginFunc> _pluginUpdateFunctions;
+        Map<DynLib*, UINT32> _pluginUpdates; /**< Update identifiers registered with UpdateScheduler. */
 
         bool _isFrameRenderingFinished;
 
@@ -51,6 +51,7 @@ namespace te
     struct START_UP_DESC;
 
     class RenderAPI;
+    struct RenderAPIStats;
     class RenderWindow;
     class RenderAPIFactory;
     class RenderWindow;
@@ -91,6 +92,35 @@ namespace te
     class Resource;
     class ResourceManager;
     class ResourceMetaData;
+    class ResourceDecoder;
+
+    class Importer;
+    class BaseImporter;
+    class ImportOptions;
+    class MeshImportOptions;
+    struct ImportResult;
+
+    struct MeshData;
+    struct MeshLod;
+    class MeshOptimizer;
+    class MeshSimplifier;
+    struct Meshlet;
+    struct SubMesh;
+
+    class CoreThread;
+    struct FrameSnapshot;
+
+    class UpdateScheduler;
+    struct UPDATE_DESC;
+
+    struct Entity;
+    class Archetype;
+    class CommandBuffer;
+    class World;
+    class TransformHierarchy;
+    struct TransformId;
+    class SceneManager;
+    struct SYSTEM_DESC;
 }
 
 #include "Resources/TeResourceHandle.h"
@@ -53,7 +53,7 @@ namespace te
     public:
         static void* Allocate(size_t bytes)
         {
-            return gBasicAllocator().Allocate((UINT32)bytes);
+            return gBasicAllocator().Allocate(bytes);
         }
 
         static void Deallocate(void* ptr)
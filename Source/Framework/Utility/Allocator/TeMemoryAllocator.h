@@ -52,7 +52,7 @@ namespace te
     * Allocates the specified number of bytes (custom allocator)
     */
     template<class Allocator = GeneralAllocator>
-    inline void* te_allocate(uint32_t count)
+    inline void* te_allocate(size_t count)
     {
         return MemoryAllocator<Allocator>::Allocate(count);
     }
@@ -84,17 +84,23 @@ set(TE_UTILITY_INC_ERROR
     "Utility/Error/TeConsole.h"
     "Utility/Error/TeError.h"
     "Utility/Error/TeDebug.h"
+    "Utility/Error/TeLog.h"
 )
 set(TE_UTILITY_SRC_ERROR
     "Utility/Error/TeConsole.cpp"
+    "Utility/Error/TeLog.cpp"
 )
 
 set(TE_UTILITY_INC_STRING
+    "Utility/String/TeInlineString.h"
     "Utility/String/TeString.h"
+    "Utility/String/TeStringId.h"
     "Utility/String/TeUnicode.h"
 )
 set(TE_UTILITY_SRC_STRING
     "Utility/String/TeString.cpp"
+    "Utility/String/TeStringId.cpp"
+    "Utility/String/TeUnicode.cpp"
 )
 
 set(TE_UTILITY_INC_UTILITY
@@ -110,6 +116,10 @@ set(TE_UTILITY_INC_UTILITY
     "Utility/Utility/TeEvent.h"
     "Utility/Utility/TePlatformUtility.h"
     "Utility/Utility/TeFlags.h"
+    "Utility/Utility/TeCompression.h"
+    "Utility/Utility/TeHash.h"
+    "Utility/Utility/TeFlatHashMap.h"
+    "Utility/Utility/TeSlotMap.h"
 )
 set(TE_UTILITY_SRC_UTILITY
     "Utility/Utility/TeDynLib.cpp"
@@ -118,6 +128,8 @@ set(TE_UTILITY_SRC_UTILITY
     "Utility/Utility/TeTimer.cpp"
     "Utility/Utility/TeUtility.cpp"
     "Utility/Utility/TeUUID.cpp"
+    "Utility/Utility/TeCompression.cpp"
+    "Utility/Utility/TeHash.cpp"
 )
 
 set(TE_UTILITY_INC_THREADING
@@ -133,10 +145,25 @@ set(TE_UTILITY_SRC_THREADING
 set(TE_UTILITY_INC_FILESYSTEM
     "Utility/FileSystem/TeFileSystem.h"
     "Utility/FileSystem/TeDataStream.h"
+    "Utility/FileSystem/TeCompressedDataStream.h"
+    "Utility/FileSystem/TePackArchive.h"
+    "Utility/FileSystem/TePackArchiveBuilder.h"
+    "Utility/FileSystem/TeIOScheduler.h"
 )
 set(TE_UTILITY_SRC_FILESYSTEM
     "Utility/FileSystem/TeFileSystem.cpp"
     "Utility/FileSystem/TeDataStream.cpp"
+    "Utility/FileSystem/TeCompressedDataStream.cpp"
+    "Utility/FileSystem/TePackArchive.cpp"
+    "Utility/FileSystem/TePackArchiveBuilder.cpp"
+    "Utility/FileSystem/TeIOScheduler.cpp"
+)
+
+set(TE_UTILITY_INC_SERIALIZATION
+    "Utility/Serialization/TeBinarySerializer.h"
+)
+set(TE_UTILITY_SRC_SERIALIZATION
+    "Utility/Serialization/TeBinarySerializer.cpp"
 )
 
 set(TE_UTILITY_INC_WIN32
@@ -146,9 +173,11 @@ set(TE_UTILITY_SRC_WIN32
 )
 
 set(TE_UTILITY_INC_LINUX
+    "Utility/Private/Linux/TeLinuxIORing.h"
 )
 set(TE_UTILITY_SRC_LINUX
     "Utility/Private/Linux/TeLinuxPlatformUtility.cpp"
+    "Utility/Private/Linux/TeLinuxIORing.cpp"
 )
 
 set(TE_UTILITY_INC_MACOS
@@ -177,6 +206,7 @@ source_group("Utility\\String" FILES ${TE_UTILITY_INC_STRING} ${TE_UTILITY_SRC_S
 source_group("Utility\\Utility" FILES ${TE_UTILITY_INC_UTILITY} ${TE_UTILITY_SRC_UTILITY})
 source_group("Utility\\Threading" FILES ${TE_UTILITY_INC_THREADING} ${TE_UTILITY_SRC_THREADING})
 source_group("Utility\\FileSystem" FILES ${TE_UTILITY_INC_FILESYSTEM} ${TE_UTILITY_SRC_FILESYSTEM})
+source_group("Utility\\Serialization" FILES ${TE_UTILITY_INC_SERIALIZATION} ${TE_UTILITY_SRC_SERIALIZATION})
 
 if(WIN32)
     source_group("Utility\\Win32" FILES ${TE_UTILITY_INC_PRIVATE} ${TE_UTILITY_SRC_PRIVATE})
@@ -207,4 +237,6 @@ set(TE_UTILITY_SRC
     ${TE_UTILITY_SRC_PRIVATE}
     ${TE_UTILITY_SRC_FILESYSTEM}
     ${TE_UTILITY_INC_FILESYSTEM}
+    ${TE_UTILITY_SRC_SERIALIZATION}
+    ${TE_UTILITY_INC_SERIALIZATION}
 )
\ No newline at end of file
@@ -2,30 +2,21 @@
 
 #include "TeEngineConfig.h"
 
-#if TE_DEBUG_MODE == 1
-#   ifndef TE_DEBUG_FILE
-#       define TE_DEBUG_FILE "Log/Debug.log"
-#   endif
+#include <string_view>
+
+#ifndef TE_DEBUG_FILE
+#   define TE_DEBUG_FILE "Log/Debug.log"
+#endif
 
+namespace te
+{
+    /** Writes a message of the Debug severity in the Generic category, see Log. Used by TE_DEBUG. */
+    TE_UTILITY_EXPORT void LogDebugMessage(std::string_view message, const char* file, unsigned int line);
+}
+
+#if TE_DEBUG_MODE == 1
 #   ifndef TE_DEBUG
-#   define TE_DEBUG(message)                                                                     \
-        {                                                                                        \
-            ::std::ofstream logFile(TE_DEBUG_FILE, ::std::ios_base::out | ::std::ios_base::app); \
-                                                                                                 \
-            logFile << "Log: " << __FILE__ << ":" << __LINE__ << std::endl;                      \
-            logFile << "Inside " << __FUNCTION__ << std::endl;                                   \
-            logFile << "Date: " << __DATE__ << std::endl;                                        \
-            logFile << "Time: " << __TIME__ << std::endl;                                        \
-            logFile << "Message: " << message << std::endl;                                      \
-            logFile << "############################################: " << std::endl;            \
-                                                                                                 \
-            std::cout << "Log: " << __FILE__ << ":" << __LINE__ << std::endl;                    \
-            std::cout << "Inside " << __FUNCTION__ << std::endl;                                 \
-            std::cout << "Date: " << __DATE__ << std::endl;                                      \
-            std::cout << "Time: " << __TIME__ << std::endl;                                      \
-            std::cout << "Message: " << message << std::endl;                                    \
-            std::cout << "############################################: " << std::endl;          \
-        }                                                                                   
+#       define TE_DEBUG(message) { ::te::LogDebugMessage(message, __FILE__, __LINE__); }
 #   endif
 #else 
 #   ifndef TE_DEBUG
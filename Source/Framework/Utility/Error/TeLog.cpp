@@ -0,0 +1,639 @@
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Error/TeLog.h"
+#include "FileSystem/TeFileSystem.h"
+
+namespace te
+{
+    /** Marks the size of a record that only pads the end of a buffer, so the next record can start at the beginning. */
+    constexpr UINT32 PADDING_RECORD = 0x80000000;
+
+    /** Smallest allowed buffer size. */
+    constexpr UINT32 MIN_BUFFER_SIZE = 4096;
+
+    /**
+     * Ring buffer holding the messages of a single thread. Written only by the thread that owns it and read only by
+     * the writer thread, so neither side ever locks. Records are always contiguous: when a record doesn't fit before
+     * the end of the buffer, the end is filled with a padding record and the record starts at the beginning.
+     */
+    class LogBuffer
+    {
+    public:
+        LogBuffer(UINT32 capacity)
+            : _capacity(capacity)
+        {
+            _data = (UINT8*)te_allocate(capacity);
+        }
+
+        ~LogBuffer()
+        {
+            te_free(_data);
+        }
+
+        /** Largest record the buffer accepts, so a record plus padding always fits in an empty buffer. */
+        UINT32 GetMaxRecordSize() const { return _capacity / 2; }
+
+        /** Returns room for a record of the provided size, or null if the buffer is too full. Owning thread only. */
+        UINT8* Reserve(UINT32 size)
+        {
+            const UINT64 head = _head.load(std::memory_order_relaxed);
+            const UINT64 tail = _tail.load(std::memory_order_acquire);
+
+            const UINT32 position = (UINT32)(head & (_capacity - 1));
+            const UINT32 contiguous = _capacity - position;
+            const UINT32 padding = contiguous < size ? contiguous : 0;
+            if (_capacity - (head - tail) < (UINT64)size + padding)
+                return nullptr;
+
+            if (padding > 0)
+            {
+                const UINT32 paddingSize = PADDING_RECORD | padding;
+                memcpy(_data + position, &paddingSize, sizeof(paddingSize));
+            }
+
+            _reservedHead = head + padding;
+            _reservedSize = size;
+            return _data + ((position + padding) & (_capacity - 1));
+        }
+
+        /** Makes the record returned by the last Reserve() call visible to the writer thread. Owning thread only. */
+        void Commit()
+        {
+            _head.store(_reservedHead + _reservedSize, std::memory_order_release);
+        }
+
+        /** Returns the number of bytes in use. */
+        UINT32 GetUsedSize() const
+        {
+            return (UINT32)(_head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_relaxed));
+        }
+
+        /** Calls @p func with each committed record, oldest first, and frees them. Writer thread only. */
+        template <typename F>
+        void Consume(F func)
+        {
+            UINT64 tail = _tail.load(std::memory_order_relaxed);
+            const UINT64 head = _head.load(std::memory_order_acquire);
+
+            while (tail != head)
+            {
+                const UINT8* record = _data + (tail & (_capacity - 1));
+
+                UINT32 size;
+                memcpy(&size, record, sizeof(size));
+
+                if ((size & PADDING_RECORD) == 0)
+                    func(*(const Log::RecordHeader*)record, record + sizeof(Log::RecordHeader));
+
+                tail += size & ~PADDING_RECORD;
+                _tail.store(tail, std::memory_order_release);
+            }
+        }
+
+        std::atomic<bool> InUse{true}; /**< False once the owning thread exited, so another thread can take over. */
+        std::atomic<UINT64> NumDropped{0}; /**< Messages dropped since the writer thread last checked. */
+
+    private:
+        UINT8* _data;
+        UINT32 _capacity;
+
+        // The position written by the owning thread and the one written by the writer thread are kept on different
+        // cache lines, so the two threads don't slow each other down
+        UINT8 _padding0[64];
+        std::atomic<UINT64> _head{0};
+        UINT64 _reservedHead = 0;
+        UINT32 _reservedSize = 0;
+
+        UINT8 _padding1[64];
+        std::atomic<UINT64> _tail{0};
+    };
+
+    /** Converts records into lines of text. */
+    class LogFormatter
+    {
+    public:
+        /** Appends the line of a record, including its line break. */
+        void Format(const Log::RecordHeader& header, const UINT8* args, String& output)
+        {
+            AppendTime(header.Timestamp, output);
+
+            output += ' ';
+            output += GetSeverityName(header.Severity);
+            output += " [";
+            output += header.Category->GetName();
+            output += "] (T";
+            AppendNumber(output, header.Thread);
+            output += ") ";
+
+            AppendMessage(header.Format, args, header.NumArgs, output);
+
+            if (header.File != nullptr)
+            {
+                // Messages mostly come from the same few places, so the file name is only looked up when it changes
+                if (header.File != _cachedFile)
+                {
+                    _cachedFile = header.File;
+                    _cachedFileName = header.File;
+                    for (const char* c = header.File; *c != '\0'; c++)
+                    {
+                        if (*c == '/' || *c == '\\')
+                            _cachedFileName = std::string_view(c + 1);
+                    }
+                }
+
+                output += " (";
+                output.append(_cachedFileName.data(), _cachedFileName.size());
+                output += ':';
+                AppendNumber(output, header.Line);
+                output += ')';
+            }
+
+            output += '\n';
+        }
+
+    private:
+        /** Captured argument, pointing into the record. */
+        struct Argument
+        {
+            Log::ArgumentType Type;
+            UINT64 Value;
+            std::string_view Text;
+        };
+
+        static const char* GetSeverityName(LogSeverity severity)
+        {
+            switch (severity)
+            {
+            case LogSeverity::Verbose: return "Verbose";
+            case LogSeverity::Debug: return "Debug";
+            case LogSeverity::Info: return "Info";
+            case LogSeverity::Warning: return "Warning";
+            case LogSeverity::Error: return "Error";
+            case LogSeverity::Fatal: return "Fatal";
+            }
+
+            return "Unknown";
+        }
+
+        /** Appends the local time as "YYYY-MM-DD HH:MM:SS.mmm". The date is only converted once per second. */
+        void AppendTime(UINT64 timestamp, String& output)
+        {
+            const time_t seconds = (time_t)(timestamp / 1000000);
+            if (seconds != _cachedSeconds)
+            {
+                tm local;
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+                localtime_s(&local, &seconds);
+#else
+                localtime_r(&seconds, &local);
+#endif
+                // Fields are clamped to their number of digits, so the output always fits
+                const UINT32 year = (UINT32)std::min(std::max(local.tm_year + 1900, 0), 9999);
+                snprintf(_cachedTime, sizeof(_cachedTime), "%04u-%02u-%02u %02u:%02u:%02u", year,
+                    (UINT32)(local.tm_mon + 1) % 100, (UINT32)local.tm_mday % 100, (UINT32)local.tm_hour % 100,
+                    (UINT32)local.tm_min % 100, (UINT32)local.tm_sec % 100);
+                _cachedSeconds = seconds;
+            }
+
+            const UINT32 milliseconds = (UINT32)(timestamp / 1000 % 1000);
+            const char fraction[] = { '.', (char)('0' + milliseconds / 100), (char)('0' + milliseconds / 10 % 10),
+                (char)('0' + milliseconds % 10) };
+
+            output += _cachedTime;
+            output.append(fraction, sizeof(fraction));
+        }
+
+        /** Replaces the placeholders of the format string with the captured arguments. */
+        static void AppendMessage(const char* format, const UINT8* args, UINT32 numArgs, String& output)
+        {
+            Argument arguments[Log::MAX_ARGUMENTS];
+            for (UINT32 i = 0; i < numArgs; i++)
+            {
+                arguments[i].Type = (Log::ArgumentType)*args++;
+                if (arguments[i].Type == Log::ArgumentType::String)
+                {
+                    UINT32 length;
+                    memcpy(&length, args, sizeof(length));
+
+                    arguments[i].Text = std::string_view((const char*)args + sizeof(length), length);
+                    args += sizeof(length) + length;
+                }
+                else
+                {
+                    memcpy(&arguments[i].Value, args, sizeof(UINT64));
+                    args += sizeof(UINT64);
+                }
+            }
+
+            UINT32 nextArg = 0;
+            const char* c = format;
+            while (*c != '\0')
+            {
+                const char* text = c;
+                while (*c != '\0' && *c != '{' && *c != '}')
+                    c++;
+
+                output.append(text, c);
+                if (*c == '\0')
+                    break;
+
+                if (c[0] == c[1])
+                {
+                    output += *c;
+                    c += 2;
+                    continue;
+                }
+
+                if (c[0] == '{')
+                {
+                    const char* end = c + 1;
+                    UINT32 index = 0;
+                    while (*end >= '0' && *end <= '9')
+                        index = index * 10 + (UINT32)(*end++ - '0');
+
+                    if (*end == '}')
+                    {
+                        if (end == c + 1)
+                            index = nextArg;
+
+                        nextArg = index + 1;
+                        if (index < numArgs)
+                            AppendArgument(arguments[index], output);
+                        else
+                            output.append(c, end + 1);
+
+                        c = end + 1;
+                        continue;
+                    }
+                }
+
+                output += *c++;
+            }
+        }
+
+        static void AppendArgument(const Argument& argument, String& output)
+        {
+            switch (argument.Type)
+            {
+            case Log::ArgumentType::Bool:
+                output += argument.Value != 0 ? "true" : "false";
+                break;
+            case Log::ArgumentType::Char:
+                output += (char)argument.Value;
+                break;
+            case Log::ArgumentType::Int:
+                AppendNumber(output, (INT64)argument.Value);
+                break;
+            case Log::ArgumentType::UInt:
+                AppendNumber(output, argument.Value);
+                break;
+            case Log::ArgumentType::Float:
+            {
+                float value;
+                memcpy(&value, &argument.Value, sizeof(value));
+                AppendNumber(output, value);
+                break;
+            }
+            case Log::ArgumentType::Double:
+            {
+                double value;
+                memcpy(&value, &argument.Value, sizeof(value));
+                AppendNumber(output, value);
+                break;
+            }
+            case Log::ArgumentType::String:
+                output.append(argument.Text.data(), argument.Text.size());
+                break;
+            case Log::ArgumentType::Pointer:
+            {
+                char digits[2 + 16];
+                digits[0] = '0';
+                digits[1] = 'x';
+                for (UINT32 i = 0; i < 16; i++)
+                    digits[2 + i] = "0123456789abcdef"[(argument.Value >> (60 - i * 4)) & 0xF];
+
+                output.append(digits, sizeof(digits));
+                break;
+            }
+            }
+        }
+
+        time_t _cachedSeconds = -1;
+        char _cachedTime[32] = { };
+
+        const char* _cachedFile = nullptr;
+        std::string_view _cachedFileName;
+    };
+
+    /** Logging state of a thread. */
+    struct LogThreadData
+    {
+        ~LogThreadData()
+        {
+            // Lets another thread take over the buffer once the writer thread emptied it
+            if (Buffer != nullptr && Log::IsStarted())
+                Buffer->InUse.store(false, std::memory_order_release);
+        }
+
+        LogBuffer* Buffer = nullptr;
+        UINT32 Thread = 0;
+
+        LogSeverity Severity = LogSeverity::Info;
+        bool Immediate = false; /**< The current record is written to Scratch, because the module isn't started. */
+        Vector<UINT8> Scratch;
+        LogFormatter Formatter;
+    };
+
+    static thread_local LogThreadData gThreadData;
+
+    Log::Log(const LOG_DESC& desc)
+        : _desc(desc)
+    {
+        UINT32 bufferSize = MIN_BUFFER_SIZE;
+        while (bufferSize < _desc.BufferSize && bufferSize < PADDING_RECORD)
+            bufferSize *= 2;
+
+        _desc.BufferSize = bufferSize;
+    }
+
+    Log::~Log()
+    {
+        for (auto& buffer : _buffers)
+            te_delete(buffer);
+    }
+
+    void Log::OnStartUp()
+    {
+        if (!_desc.FilePath.empty())
+        {
+            const String::size_type separator = _desc.FilePath.find_last_of("/\\");
+            if (separator != String::npos)
+                FileSystem::CreateFolder(_desc.FilePath.substr(0, separator));
+
+            _file = fopen(_desc.FilePath.c_str(), "ab");
+        }
+
+        _writer = Thread(&Log::RunWriter, this);
+    }
+
+    void Log::OnShutDown()
+    {
+        {
+            Lock lock(_mutex);
+            _stop = true;
+        }
+
+        _writerSignal.notify_one();
+        _writer.join();
+
+        if (_file != nullptr)
+        {
+            fclose(_file);
+            _file = nullptr;
+        }
+    }
+
+    UINT8* Log::BeginRecord(LogSeverity severity, const LogCategory& category, const char* file, UINT32 line,
+        const char* format, UINT8 numArgs, UINT32 size)
+    {
+        LogThreadData& threadData = gThreadData;
+        size = (size + 7) & ~7U;
+
+        UINT8* data = nullptr;
+        if (IsStarted())
+        {
+            Log& log = Instance();
+            if (threadData.Buffer == nullptr)
+                threadData.Buffer = log.AcquireBuffer(threadData.Thread);
+
+            LogBuffer* buffer = threadData.Buffer;
+            if (size <= buffer->GetMaxRecordSize())
+            {
+                data = buffer->Reserve(size);
+                while (data == nullptr && log._desc.Overflow == LogOverflow::Block)
+                {
+                    log.WakeUpWriter();
+                    TE_THREAD_YIELD();
+
+                    data = buffer->Reserve(size);
+                }
+            }
+
+            if (data == nullptr)
+            {
+                buffer->NumDropped.fetch_add(1, std::memory_order_relaxed);
+                log._numDropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            // Empties the buffer early when it gets full, instead of waiting for the flush interval
+            if (buffer->GetUsedSize() + size > buffer->GetMaxRecordSize())
+                log.WakeUpWriter();
+
+            threadData.Immediate = false;
+        }
+        else
+        {
+            threadData.Scratch.resize(size);
+            data = threadData.Scratch.data();
+            threadData.Immediate = true;
+        }
+
+        RecordHeader& header = *(RecordHeader*)data;
+        header.Size = size;
+        header.Line = line;
+        header.Timestamp = (UINT64)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        header.Category = &category;
+        header.Format = format;
+        header.File = file;
+        header.Thread = threadData.Thread;
+        header.Severity = severity;
+        header.NumArgs = numArgs;
+
+        threadData.Severity = severity;
+        return data + sizeof(RecordHeader);
+    }
+
+    void Log::EndRecord()
+    {
+        LogThreadData& threadData = gThreadData;
+        if (threadData.Immediate)
+        {
+            const UINT8* data = threadData.Scratch.data();
+
+            String line;
+            threadData.Formatter.Format(*(const RecordHeader*)data, data + sizeof(RecordHeader), line);
+
+            fwrite(line.data(), 1, line.size(), stdout);
+            fflush(stdout);
+            return;
+        }
+
+        threadData.Buffer->Commit();
+
+        if (threadData.Severity == LogSeverity::Fatal)
+            Flush();
+    }
+
+    void Log::Flush()
+    {
+        if (!IsStarted())
+        {
+            fflush(stdout);
+            return;
+        }
+
+        Log& log = Instance();
+
+        Lock lock(log._mutex);
+        const UINT64 request = ++log._flushRequested;
+        log._writerSignal.notify_one();
+        log._flushSignal.wait(lock, [&log, request]() { return log._flushCompleted >= request; });
+    }
+
+    void Log::WakeUpWriter()
+    {
+        if (_wakeUp.exchange(true, std::memory_order_relaxed))
+            return;
+
+        // Makes sure the writer thread is either waiting, or will check the flag before it waits again
+        {
+            Lock lock(_mutex);
+        }
+
+        _writerSignal.notify_one();
+    }
+
+    LogBuffer* Log::AcquireBuffer(UINT32& thread)
+    {
+        Lock lock(_mutex);
+        thread = _numThreads++;
+
+        for (auto& buffer : _buffers)
+        {
+            if (!buffer->InUse.load(std::memory_order_acquire) && buffer->GetUsedSize() == 0)
+            {
+                buffer->InUse.store(true, std::memory_order_relaxed);
+                return buffer;
+            }
+        }
+
+        _buffers.push_back(te_new<LogBuffer>(_desc.BufferSize));
+        return _buffers.back();
+    }
+
+    void Log::RunWriter()
+    {
+        while (true)
+        {
+            bool stop;
+            UINT64 flushRequest;
+            {
+                Lock lock(_mutex);
+                _writerSignal.wait_for(lock, std::chrono::milliseconds(_desc.FlushInterval), [this]()
+                {
+                    return _stop || _flushRequested > _flushCompleted || _wakeUp.load(std::memory_order_relaxed);
+                });
+
+                stop = _stop;
+                flushRequest = _flushRequested;
+                _drainBuffers = _buffers;
+            }
+
+            _wakeUp.store(false, std::memory_order_relaxed);
+            Drain();
+
+            {
+                Lock lock(_mutex);
+                _flushCompleted = flushRequest;
+            }
+
+            _flushSignal.notify_all();
+
+            if (stop)
+                break;
+        }
+    }
+
+    void Log::Drain()
+    {
+        /** Formatted line, ordered by the time its message was written. */
+        struct Line
+        {
+            UINT64 Timestamp;
+            size_t Offset;
+            size_t Length;
+        };
+
+        LogFormatter formatter;
+        String text;
+        Vector<Line> lines;
+
+        const auto addLine = [&formatter, &text, &lines](const RecordHeader& header, const UINT8* args)
+        {
+            const size_t offset = text.size();
+            formatter.Format(header, args, text);
+            lines.push_back({ header.Timestamp, offset, text.size() - offset });
+        };
+
+        UINT64 numDropped = 0;
+        for (auto& buffer : _drainBuffers)
+        {
+            buffer->Consume(addLine);
+            numDropped += buffer->NumDropped.exchange(0, std::memory_order_relaxed);
+        }
+
+        if (numDropped > 0)
+        {
+            RecordHeader header = { };
+            header.Timestamp = (UINT64)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            header.Category = &LogCategoryGeneric;
+            header.Format = "{0} messages were dropped because a thread's log buffer was full";
+            header.Severity = LogSeverity::Warning;
+            header.NumArgs = 1;
+
+            UINT8 args[1 + sizeof(UINT64)];
+            WriteValue(args, ArgumentType::UInt, numDropped);
+            addLine(header, args);
+        }
+
+        if (lines.empty())
+            return;
+
+        // Each buffer is already in order, only messages of different threads can be out of order
+        std::stable_sort(lines.begin(), lines.end(), [](const Line& lhs, const Line& rhs)
+        {
+            return lhs.Timestamp < rhs.Timestamp;
+        });
+
+        String output;
+        output.reserve(text.size());
+
+        for (auto& line : lines)
+            output.append(text, line.Offset, line.Length);
+
+        if (_file != nullptr)
+        {
+            fwrite(output.data(), 1, output.size(), _file);
+            fflush(_file);
+        }
+
+        if (_desc.Console)
+        {
+            fwrite(output.data(), 1, output.size(), stdout);
+            fflush(stdout);
+        }
+    }
+
+    void LogDebugMessage(std::string_view message, const char* file, unsigned int line)
+    {
+        if (LogCategoryGeneric.IsEnabled(LogSeverity::Debug))
+            Log::Write(LogSeverity::Debug, LogCategoryGeneric, file, line, "{0}", message);
+    }
+
+    Log& gLog()
+    {
+        return Log::Instance();
+    }
+}
\ No newline at end of file
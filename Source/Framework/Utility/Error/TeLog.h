@@ -0,0 +1,300 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
+
+namespace te
+{
+    class LogBuffer;
+
+    /** Importance of a log message. */
+    enum class LogSeverity : UINT8
+    {
+        Verbose, /**< Detailed tracing, usually only enabled while investigating a specific system. */
+        Debug, /**< Diagnostics, written by TE_DEBUG. */
+        Info,
+        Warning,
+        Error,
+        Fatal /**< Unrecoverable error. The log is flushed before the message call returns. */
+    };
+
+    /** Determines what a thread does when it writes messages faster than the writer thread can output them. */
+    enum class LogOverflow : UINT8
+    {
+        Block, /**< The thread waits until its buffer has room again, so no message is ever lost. */
+        Drop /**< The message is discarded and counted. The thread never waits and memory use stays bounded. */
+    };
+
+    /** Parameters of the Log module. */
+    struct LOG_DESC
+    {
+        String FilePath = TE_DEBUG_FILE; /**< File messages are appended to. Empty to only write to the console. */
+        bool Console = true; /**< Whether messages are also written to the standard output. */
+
+        /** Size of the message buffer of each thread that logs, in bytes. Rounded up to a power of two. */
+        UINT32 BufferSize = 256 * 1024;
+        LogOverflow Overflow = LogOverflow::Block;
+
+        /** Max number of milliseconds between a message being written and it reaching the file. */
+        UINT32 FlushInterval = 20;
+    };
+
+    /**
+     * Named group of log messages (e.g. "FileSystem"), with its own minimum severity. Messages below it are discarded
+     * before any of their arguments are captured. Declared with TE_LOG_CATEGORY.
+     */
+    class LogCategory
+    {
+    public:
+        LogCategory(const char* name, LogSeverity minSeverity = LogSeverity::Debug)
+            : _name(name), _minSeverity((UINT8)minSeverity)
+        { }
+
+        const char* GetName() const { return _name; }
+
+        LogSeverity GetMinSeverity() const { return (LogSeverity)_minSeverity.load(std::memory_order_relaxed); }
+        void SetMinSeverity(LogSeverity severity) { _minSeverity.store((UINT8)severity, std::memory_order_relaxed); }
+
+        /** Returns true if messages of the provided severity are written. */
+        bool IsEnabled(LogSeverity severity) const { return severity >= GetMinSeverity(); }
+
+    private:
+        const char* _name;
+        std::atomic<UINT8> _minSeverity;
+    };
+
+    /**
+     * Asynchronous logger. Messages are written by each thread into its own lock-free ring buffer, without taking any
+     * lock or doing any I/O, and a background thread periodically collects them, formats them and appends them to the
+     * log file in a single write.
+     *
+     * Formatting is deferred: the caller only copies the format string pointer and the argument values into its buffer,
+     * and "{0}", "{1}" (or "{}" for the next argument) placeholders are replaced on the writer thread. Supported
+     * arguments are numbers, booleans, characters, strings and pointers.
+     *
+     * Messages written while the module isn't started are formatted and written to the console immediately.
+     *
+     * @note	Thread safe. Threads that log must not outlive the module.
+     */
+    class TE_UTILITY_EXPORT Log : public Module<Log>
+    {
+    public:
+        Log(const LOG_DESC& desc = LOG_DESC());
+        ~Log();
+
+        /**
+         * Writes a message. Prefer the TE_LOG macro, which checks the category before evaluating the arguments.
+         *
+         * @param[in]	severity	Importance of the message.
+         * @param[in]	category	Category of the message, must outlive the module.
+         * @param[in]	file		Source file the message was written from, must be a string literal.
+         * @param[in]	line		Source line the message was written from.
+         * @param[in]	format		Text of the message with argument placeholders, must be a string literal.
+         * @param[in]	args		Values of the placeholders. Strings are copied, so they don't need to outlive the call.
+         */
+        template <typename... Args>
+        static void Write(LogSeverity severity, const LogCategory& category, const char* file, UINT32 line,
+            const char* format, const Args&... args)
+        {
+            static_assert(sizeof...(Args) <= MAX_ARGUMENTS, "Too many log message arguments.");
+
+            const UINT32 size = (UINT32)sizeof(RecordHeader) + (0 + ... + GetArgumentSize(args));
+            UINT8* data = BeginRecord(severity, category, file, line, format, (UINT8)sizeof...(Args), size);
+            if (data == nullptr)
+                return;
+
+            ((data = WriteArgument(data, args)), ...);
+            EndRecord();
+        }
+
+        /** Blocks until all messages written before the call, by any thread, have been output. */
+        static void Flush();
+
+        /** Returns the total number of messages discarded because a thread's buffer was full. */
+        UINT64 GetNumDropped() const { return _numDropped.load(std::memory_order_relaxed); }
+
+    protected:
+        friend class LogBuffer;
+        friend class LogFormatter;
+        friend struct LogThreadData;
+
+        static constexpr UINT32 MAX_ARGUMENTS = 16;
+
+        /** Type of a captured argument, stored before its value. */
+        enum class ArgumentType : UINT8
+        {
+            Bool, Char, Int, UInt, Float, Double, String, Pointer
+        };
+
+        /** Fixed part of a message in a thread's buffer, followed by the captured arguments. */
+        struct RecordHeader
+        {
+            UINT32 Size; /**< Size of the record including the arguments, a multiple of 8 bytes. */
+            UINT32 Line;
+            UINT64 Timestamp; /**< Microseconds since the epoch. */
+            const LogCategory* Category;
+            const char* Format;
+            const char* File;
+            UINT32 Thread; /**< Index of the thread that wrote the message, in the order threads first logged. */
+            LogSeverity Severity;
+            UINT8 NumArgs;
+        };
+
+        /** Returns the number of bytes an argument takes once captured. */
+        template <typename T>
+        static UINT32 GetArgumentSize(const T& value)
+        {
+            if constexpr (std::is_convertible<const T&, std::string_view>::value)
+                return 1 + sizeof(UINT32) + (UINT32)ToStringView(value).size();
+            else
+                return 1 + sizeof(UINT64);
+        }
+
+        /** Captures an argument at @p output and returns the position after it. */
+        template <typename T>
+        static UINT8* WriteArgument(UINT8* output, const T& value)
+        {
+            if constexpr (std::is_same<T, bool>::value)
+                return WriteValue(output, ArgumentType::Bool, (UINT64)value);
+            else if constexpr (std::is_same<T, char>::value)
+                return WriteValue(output, ArgumentType::Char, (UINT64)(UINT8)value);
+            else if constexpr (std::is_enum<T>::value)
+                return WriteArgument(output, (typename std::underlying_type<T>::type)value);
+            else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value)
+                return WriteValue(output, ArgumentType::Int, (UINT64)(INT64)value);
+            else if constexpr (std::is_integral<T>::value)
+                return WriteValue(output, ArgumentType::UInt, (UINT64)value);
+            else if constexpr (std::is_same<T, float>::value)
+            {
+                UINT32 bits;
+                memcpy(&bits, &value, sizeof(bits));
+                return WriteValue(output, ArgumentType::Float, bits);
+            }
+            else if constexpr (std::is_floating_point<T>::value)
+            {
+                const double number = (double)value;
+
+                UINT64 bits;
+                memcpy(&bits, &number, sizeof(bits));
+                return WriteValue(output, ArgumentType::Double, bits);
+            }
+            else if constexpr (std::is_convertible<const T&, std::string_view>::value)
+            {
+                const std::string_view text = ToStringView(value);
+                const UINT32 length = (UINT32)text.size();
+
+                *output++ = (UINT8)ArgumentType::String;
+                memcpy(output, &length, sizeof(length));
+                if (length > 0)
+                    memcpy(output + sizeof(length), text.data(), length);
+                return output + sizeof(length) + length;
+            }
+            else
+            {
+                static_assert(std::is_pointer<T>::value, "Unsupported log message argument, convert it to a string.");
+                return WriteValue(output, ArgumentType::Pointer, (UINT64)(uintptr_t)value);
+            }
+        }
+
+        /** Captures a fixed size argument. */
+        static UINT8* WriteValue(UINT8* output, ArgumentType type, UINT64 value)
+        {
+            *output++ = (UINT8)type;
+            memcpy(output, &value, sizeof(value));
+            return output + sizeof(value);
+        }
+
+        /** Converts a string argument, treating null character pointers as empty strings. */
+        template <typename T>
+        static std::string_view ToStringView(const T& value)
+        {
+            if constexpr (std::is_pointer<T>::value)
+                return value != nullptr ? std::string_view(value) : std::string_view();
+            else
+                return std::string_view(value);
+        }
+
+        /**
+         * Reserves room for a message in the calling thread's buffer and writes its header. Returns where the
+         * arguments go, or null if the message was dropped.
+         */
+        static UINT8* BeginRecord(LogSeverity severity, const LogCategory& category, const char* file, UINT32 line,
+            const char* format, UINT8 numArgs, UINT32 size);
+
+        /** Publishes the message started by BeginRecord() to the writer thread. */
+        static void EndRecord();
+
+        /** @copydoc Module::OnStartUp */
+        void OnStartUp() override;
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /**
+         * Returns a buffer for the calling thread, reusing the buffer of a thread that exited if possible. Outputs the
+         * index of the thread used in its messages.
+         */
+        LogBuffer* AcquireBuffer(UINT32& thread);
+
+        /** Wakes up the writer thread before the end of its flush interval, if not already requested. */
+        void WakeUpWriter();
+
+        /** Main method of the writer thread. */
+        void RunWriter();
+
+        /** Formats the messages of all the buffers, sorted by time, and outputs them. */
+        void Drain();
+
+    protected:
+        LOG_DESC _desc;
+        FILE* _file = nullptr;
+
+        Vector<LogBuffer*> _buffers;
+        Vector<LogBuffer*> _drainBuffers;
+        UINT32 _numThreads = 0;
+        std::atomic<UINT64> _numDropped{0};
+
+        Thread _writer;
+        bool _stop = false;
+        std::atomic<bool> _wakeUp{false};
+        UINT64 _flushRequested = 0;
+        UINT64 _flushCompleted = 0;
+
+        Mutex _mutex;
+        Signal _writerSignal;
+        Signal _flushSignal;
+    };
+
+    /** Provides easy access to Log. */
+    TE_UTILITY_EXPORT Log& gLog();
+}
+
+/**
+ * Declares a log category named @p name, usable as the category of TE_LOG. An optional second argument sets the
+ * minimum severity of the category (LogSeverity::Debug by default).
+ */
+#define TE_LOG_CATEGORY(name, ...) inline ::te::LogCategory LogCategory##name(#name, ##__VA_ARGS__);
+
+/**
+ * Writes a message to the log, see Log::Write(). The arguments are only evaluated if the category is enabled for
+ * the severity.
+ *
+ * @code
+ * TE_LOG(Warning, Generic, "Unable to open {0}, {1} attempts left", path, attempts);
+ * @endcode
+ */
+#define TE_LOG(severity, category, format, ...)                                                                     \
+    {                                                                                                               \
+        if (LogCategory##category.IsEnabled(::te::LogSeverity::severity))                                           \
+        {                                                                                                           \
+            ::te::Log::Write(::te::LogSeverity::severity, LogCategory##category, __FILE__, __LINE__, "" format,     \
+                ##__VA_ARGS__);                                                                                     \
+        }                                                                                                           \
+    }
+
+namespace te
+{
+    /** Category of messages that don't belong to a specific system, and of TE_DEBUG messages. */
+    TE_LOG_CATEGORY(Generic)
+}
\ No newline at end of file
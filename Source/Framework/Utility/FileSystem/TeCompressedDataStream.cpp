@@ -0,0 +1,281 @@
+#include "FileSystem/TeCompressedDataStream.h"
+#include "Utility/TeCompression.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 COMPRESSED_STREAM_MAGIC = 0x425A4554; // "TEZB"
+        constexpr UINT32 COMPRESSED_STREAM_VERSION = 1;
+
+        struct CompressedStreamHeader
+        {
+            UINT32 Magic;
+            UINT32 Version;
+            UINT32 BlockSize;
+            UINT32 Padding;
+        };
+
+        /** Written after the block table, at the end of the compressed data. */
+        struct CompressedStreamFooter
+        {
+            UINT64 TableOffset;
+            UINT64 UncompressedSize;
+            UINT32 NumBlocks;
+            UINT32 Magic;
+        };
+    }
+
+    CompressedDataStream::CompressedDataStream(const SPtr<DataStream>& stream, UINT16 accessMode, UINT32 blockSize)
+        : DataStream(stream->GetName(), accessMode)
+        , _stream(stream)
+        , _baseOffset(stream->Tell())
+        , _blockSize(blockSize)
+    {
+        TE_ASSERT_ERROR(accessMode == READ || accessMode == WRITE, "Compressed streams are either read or write only.");
+
+        if (accessMode == READ)
+        {
+            _valid = ReadHeader();
+            if (!_valid)
+            {
+                TE_DEBUG("Invalid compressed data in stream: " + _name);
+            }
+
+            return;
+        }
+
+        TE_ASSERT_ERROR(blockSize > 0, "Invalid block size.");
+
+        CompressedStreamHeader header = { COMPRESSED_STREAM_MAGIC, COMPRESSED_STREAM_VERSION, blockSize, 0 };
+        _valid = _stream->Write(&header, sizeof(header)) == sizeof(header);
+
+        _block.reserve(blockSize);
+    }
+
+    CompressedDataStream::~CompressedDataStream()
+    {
+        Close();
+    }
+
+    bool CompressedDataStream::ReadHeader()
+    {
+        CompressedStreamHeader header;
+        if (_stream->Read(&header, sizeof(header)) != sizeof(header))
+            return false;
+
+        if (header.Magic != COMPRESSED_STREAM_MAGIC || header.Version != COMPRESSED_STREAM_VERSION || header.BlockSize == 0)
+            return false;
+
+        const size_t streamSize = _stream->Size();
+        if (streamSize < _baseOffset + sizeof(header) + sizeof(CompressedStreamFooter))
+            return false;
+
+        CompressedStreamFooter footer;
+        _stream->Seek(streamSize - sizeof(footer));
+        if (_stream->Read(&footer, sizeof(footer)) != sizeof(footer) || footer.Magic != COMPRESSED_STREAM_MAGIC)
+            return false;
+
+        const UINT64 tableSize = (UINT64)footer.NumBlocks * sizeof(BlockEntry);
+        if (footer.TableOffset + tableSize + sizeof(footer) + _baseOffset != streamSize)
+            return false;
+
+        if (footer.UncompressedSize > (UINT64)footer.NumBlocks * header.BlockSize)
+            return false;
+
+        _blocks.resize(footer.NumBlocks);
+        _stream->Seek(_baseOffset + (size_t)footer.TableOffset);
+        if (_stream->Read(_blocks.data(), (size_t)tableSize) != tableSize)
+            return false;
+
+        _blockSize = header.BlockSize;
+        _size = (size_t)footer.UncompressedSize;
+
+        return true;
+    }
+
+    size_t CompressedDataStream::GetBlockSize(UINT32 idx) const
+    {
+        return std::min((size_t)_blockSize, _size - (size_t)idx * _blockSize);
+    }
+
+    bool CompressedDataStream::ReadBlock(UINT32 idx, Vector<UINT8>& output)
+    {
+        if (!_valid || !IsReadable() || idx >= _blocks.size())
+            return false;
+
+        const BlockEntry& entry = _blocks[idx];
+        const size_t size = GetBlockSize(idx);
+
+        output.resize(size);
+        _stream->Seek(_baseOffset + (size_t)entry.Offset);
+
+        if (entry.CompressedSize > Compression::GetMaxCompressedSize(size))
+            return false;
+
+        if (entry.CompressedSize == size)
+            return _stream->Read(output.data(), size) == size;
+
+        _compressed.resize(entry.CompressedSize);
+        if (_stream->Read(_compressed.data(), entry.CompressedSize) != entry.CompressedSize)
+            return false;
+
+        return Compression::DecompressBlock(_compressed.data(), entry.CompressedSize, output.data(), size);
+    }
+
+    bool CompressedDataStream::LoadBlock(UINT32 idx)
+    {
+        if (_blockIdx == idx)
+            return true;
+
+        if (!ReadBlock(idx, _block))
+        {
+            TE_DEBUG("Failed to decompress block " + ToString(idx) + " of stream: " + _name);
+
+            _block.clear();
+            _blockIdx = (UINT32)-1;
+            return false;
+        }
+
+        _blockIdx = idx;
+        return true;
+    }
+
+    size_t CompressedDataStream::Read(void* buf, size_t count)
+    {
+        if (!_valid || !IsReadable())
+            return 0;
+
+        UINT8* output = (UINT8*)buf;
+        size_t numRead = 0;
+
+        while (numRead < count && _pos < _size)
+        {
+            const UINT32 idx = (UINT32)(_pos / _blockSize);
+            if (!LoadBlock(idx))
+                break;
+
+            const size_t offset = _pos - (size_t)idx * _blockSize;
+            const size_t available = std::min(count - numRead, _block.size() - offset);
+
+            memcpy(output + numRead, _block.data() + offset, available);
+            numRead += available;
+            _pos += available;
+        }
+
+        return numRead;
+    }
+
+    size_t CompressedDataStream::Write(const void* buf, size_t count)
+    {
+        if (!_valid || !IsWriteable())
+            return 0;
+
+        const UINT8* input = (const UINT8*)buf;
+        size_t written = 0;
+
+        while (written < count)
+        {
+            const size_t available = std::min(count - written, (size_t)_blockSize - _block.size());
+            _block.insert(_block.end(), input + written, input + written + available);
+            written += available;
+
+            if (_block.size() == _blockSize)
+                WriteBlock();
+        }
+
+        _pos += written;
+        _size = _pos;
+
+        return written;
+    }
+
+    void CompressedDataStream::WriteBlock()
+    {
+        if (_block.empty())
+            return;
+
+        BlockEntry entry;
+        entry.Offset = _stream->Tell() - _baseOffset;
+        entry.Padding = 0;
+
+        _compressed.resize(Compression::GetMaxCompressedSize(_block.size()));
+        size_t compressedSize = Compression::CompressBlock(_block.data(), _block.size(), _compressed.data(),
+            _compressed.size());
+
+        // Store incompressible data as is
+        if (compressedSize == 0 || compressedSize >= _block.size())
+        {
+            entry.CompressedSize = (UINT32)_block.size();
+            _stream->Write(_block.data(), _block.size());
+        }
+        else
+        {
+            entry.CompressedSize = (UINT32)compressedSize;
+            _stream->Write(_compressed.data(), compressedSize);
+        }
+
+        _blocks.push_back(entry);
+        _block.clear();
+    }
+
+    void CompressedDataStream::Skip(size_t count)
+    {
+        Seek(_pos + count);
+    }
+
+    void CompressedDataStream::Seek(size_t pos)
+    {
+        TE_ASSERT_ERROR(IsReadable(), "Seeking is only supported when reading from compressed streams.");
+        TE_ASSERT_ERROR(pos <= _size, "Seeking past the end of the stream.");
+
+        _pos = pos;
+    }
+
+    size_t CompressedDataStream::Tell() const
+    {
+        return _pos;
+    }
+
+    bool CompressedDataStream::Eof() const
+    {
+        return _pos >= _size;
+    }
+
+    SPtr<DataStream> CompressedDataStream::Clone(bool copyData) const
+    {
+        TE_ASSERT_ERROR(IsReadable(), "Only compressed streams opened for reading can be cloned.");
+
+        SPtr<DataStream> stream = _stream->Clone(copyData);
+        stream->Seek(_baseOffset);
+
+        return te_shared_ptr_new<CompressedDataStream>(stream, (UINT16)READ);
+    }
+
+    void CompressedDataStream::Close()
+    {
+        if (_stream == nullptr)
+            return;
+
+        if (_valid && IsWriteable())
+        {
+            WriteBlock();
+
+            CompressedStreamFooter footer;
+            footer.TableOffset = _stream->Tell() - _baseOffset;
+            footer.UncompressedSize = _size;
+            footer.NumBlocks = (UINT32)_blocks.size();
+            footer.Magic = COMPRESSED_STREAM_MAGIC;
+
+            _stream->Write(_blocks.data(), _blocks.size() * sizeof(BlockEntry));
+            _stream->Write(&footer, sizeof(footer));
+        }
+
+        _stream = nullptr;
+        _blocks.clear();
+        _block.clear();
+        _blockIdx = (UINT32)-1;
+        _valid = false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "FileSystem/TeDataStream.h"
+
+namespace te
+{
+    /**
+     * Data stream that compresses data written to, and decompresses data read from, another stream. Data is split into
+     * fixed size blocks that are compressed independently, so any position can be reached by decompressing a single
+     * block.
+     *
+     * Streams are either read only or write only. Written data can only be appended, and is finalized when the stream
+     * is closed. The underlying stream is left open.
+     */
+    class TE_UTILITY_EXPORT CompressedDataStream : public DataStream
+    {
+    public:
+        /** Default size of a single block of uncompressed data, in bytes. */
+        static constexpr UINT32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        /**
+         * Creates a compressed stream starting at the current position of @p stream.
+         *
+         * @param[in]	stream		Stream to read the compressed data from or write it to. When reading, the compressed
+         *							data must end at the end of the stream.
+         * @param[in]	accessMode	Either READ or WRITE.
+         * @param[in]	blockSize	Size of a block of uncompressed data, in bytes. Only relevant when writing, when reading
+         *							the size used when writing is used.
+         */
+        CompressedDataStream(const SPtr<DataStream>& stream, UINT16 accessMode = READ,
+            UINT32 blockSize = DEFAULT_BLOCK_SIZE);
+
+        ~CompressedDataStream();
+
+        /** Returns false if the underlying stream doesn't contain valid compressed data. */
+        bool IsValid() const { return _valid; }
+
+        /** Returns the size of a single block of uncompressed data, in bytes. */
+        UINT32 GetBlockSize() const { return _blockSize; }
+
+        /** Returns the number of blocks in the stream. */
+        UINT32 GetNumBlocks() const { return (UINT32)_blocks.size(); }
+
+        /** Decompresses the block with the provided index into @p output. Returns false on failure. */
+        bool ReadBlock(UINT32 idx, Vector<UINT8>& output);
+
+        /** @copydoc DataStream::IsFile */
+        bool IsFile() const override { return _stream != nullptr && _stream->IsFile(); }
+
+        /** @copydoc DataStream::Read */
+        size_t Read(void* buf, size_t count) override;
+
+        /** @copydoc DataStream::Write */
+        size_t Write(const void* buf, size_t count) override;
+
+        /** @copydoc DataStream::Skip */
+        void Skip(size_t count) override;
+
+        /** @copydoc DataStream::Seek */
+        void Seek(size_t pos) override;
+
+        /** @copydoc DataStream::Tell */
+        size_t Tell() const override;
+
+        /** @copydoc DataStream::Eof */
+        bool Eof() const override;
+
+        /** @copydoc DataStream::Clone */
+        SPtr<DataStream> Clone(bool copyData = true) const override;
+
+        /** @copydoc DataStream::Close */
+        void Close() override;
+
+    private:
+        /** Location of a single compressed block in the underlying stream. */
+        struct BlockEntry
+        {
+            UINT64 Offset; /**< Relative to the start of the compressed data. */
+            UINT32 CompressedSize; /**< Equal to the uncompressed size if the block is stored uncompressed. */
+            UINT32 Padding;
+        };
+
+        /** Reads the block table of an existing compressed stream. */
+        bool ReadHeader();
+
+        /** Makes the block with the provided index the current block. */
+        bool LoadBlock(UINT32 idx);
+
+        /** Compresses the current block and writes it to the underlying stream. */
+        void WriteBlock();
+
+        /** Returns the uncompressed size of the block with the provided index. */
+        size_t GetBlockSize(UINT32 idx) const;
+
+    private:
+        SPtr<DataStream> _stream;
+        size_t _baseOffset;
+        UINT32 _blockSize;
+        bool _valid = false;
+
+        Vector<BlockEntry> _blocks;
+        Vector<UINT8> _block; /**< Uncompressed data of the current block. */
+        Vector<UINT8> _compressed; /**< Scratch buffer for compressed data. */
+        UINT32 _blockIdx = (UINT32)-1;
+        size_t _pos = 0;
+    };
+}
\ No newline at end of file
@@ -2,7 +2,632 @@
 #include "Error/TeDebug.h"
 #include "String/TeUnicode.h"
 
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   if !defined(NOMINMAX) && defined(_MSC_VER)
+#       define NOMINMAX // required to stop windows.h messing up std::min
+#   endif
+#   include <windows.h>
+#else
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+#include <cstdio>
+
 namespace te
 {
+    const UINT32 DataStream::StreamTempSize = 128;
+
+    namespace
+    {
+        bool FileSeek(FILE* file, size_t pos)
+        {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+            return _fseeki64(file, (INT64)pos, SEEK_SET) == 0;
+#else
+            return fseeko(file, (off_t)pos, SEEK_SET) == 0;
+#endif
+        }
+
+        size_t FileSize(FILE* file)
+        {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+            _fseeki64(file, 0, SEEK_END);
+            const INT64 size = _ftelli64(file);
+#else
+            fseeko(file, 0, SEEK_END);
+            const off_t size = ftello(file);
+#endif
+            FileSeek(file, 0);
+            return size > 0 ? (size_t)size : 0;
+        }
+    }
+
+    void DataStream::ReadAll(Vector<UINT8>& output)
+    {
+        const size_t position = Tell();
+
+        if (_size > position)
+        {
+            output.resize(_size - position);
+            output.resize(Read(output.data(), output.size()));
+            return;
+        }
+
+        // Size is unknown, read in chunks until the end of the stream
+        output.clear();
+
+        UINT8 chunk[StreamTempSize];
+        while (!Eof())
+        {
+            const size_t numRead = Read(chunk, StreamTempSize);
+            if (numRead == 0)
+                break;
+
+            output.insert(output.end(), chunk, chunk + numRead);
+        }
+    }
+
+    String DataStream::GetAsString()
+    {
+        Vector<UINT8> data;
+        ReadAll(data);
+
+        // Skip the UTF-8 byte order mark, if present
+        size_t start = 0;
+        if (data.size() >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+            start = 3;
+
+        return String((const char*)data.data() + start, data.size() - start);
+    }
+
+    MemoryDataStream::MemoryDataStream(size_t size)
+        : DataStream(READ | WRITE)
+        , _data(nullptr)
+        , _freeOnClose(true)
+    {
+        _data = _pos = (UINT8*)te_allocate(size);
+        _size = size;
+        _capacity = size;
+        _end = _data + _size;
+    }
+
+    MemoryDataStream::MemoryDataStream(void* memory, size_t size, bool freeOnClose)
+        : DataStream(READ | WRITE)
+        , _data(nullptr)
+        , _freeOnClose(freeOnClose)
+    {
+        _data = _pos = static_cast<UINT8*>(memory);
+        _size = size;
+        _capacity = size;
+        _end = _data + _size;
+    }
+
+    MemoryDataStream::MemoryDataStream(DataStream& sourceStream)
+        : DataStream(READ | WRITE)
+        , _data(nullptr)
+        , _freeOnClose(true)
+    {
+        Vector<UINT8> data;
+        sourceStream.ReadAll(data);
+
+        _size = data.size();
+        _capacity = _size;
+        _data = (UINT8*)te_allocate(_size);
+        _pos = _data;
+        _end = _data + _size;
+
+        if (_size > 0)
+            memcpy(_data, data.data(), _size);
+    }
+
+    MemoryDataStream::MemoryDataStream(const SPtr<DataStream>& sourceStream)
+        : MemoryDataStream(*sourceStream)
+    { }
+
+    MemoryDataStream::~MemoryDataStream()
+    {
+        Close();
+    }
+
+    size_t MemoryDataStream::Read(void* buf, size_t count)
+    {
+        size_t cnt = count;
+
+        if (_pos + cnt > _end)
+            cnt = _end - _pos;
+        if (cnt == 0)
+            return 0;
+
+        memcpy(buf, _pos, cnt);
+        _pos += cnt;
+
+        return cnt;
+    }
+
+    size_t MemoryDataStream::Write(const void* buf, size_t count)
+    {
+        if (!IsWriteable() || count == 0)
+            return 0;
+
+        const size_t offset = _pos - _data;
+        if (offset + count > _capacity && _freeOnClose)
+            Reserve(offset + count);
+
+        size_t written = count;
+        if (offset + written > _capacity)
+            written = _capacity - offset;
+
+        if (written == 0)
+            return 0;
+
+        memcpy(_pos, buf, written);
+        _pos += written;
+
+        if (_pos > _end)
+        {
+            _end = _pos;
+            _size = _end - _data;
+        }
+
+        return written;
+    }
+
+    void MemoryDataStream::Reserve(size_t size)
+    {
+        const size_t capacity = std::max(size, _capacity * 2);
+        UINT8* data = (UINT8*)te_allocate(capacity);
+
+        if (_data != nullptr)
+        {
+            memcpy(data, _data, _size);
+            te_free(_data);
+        }
+
+        _pos = data + (_pos - _data);
+        _end = data + _size;
+        _data = data;
+        _capacity = capacity;
+    }
+
+    void MemoryDataStream::Skip(size_t count)
+    {
+        size_t newpos = (size_t)((_pos - _data) + count);
+        TE_ASSERT_ERROR(_data + newpos <= _end, "Skipping past the end of the stream.");
+
+        _pos = _data + newpos;
+    }
+
+    void MemoryDataStream::Seek(size_t pos)
+    {
+        TE_ASSERT_ERROR(_data + pos <= _end, "Seeking past the end of the stream.");
+        _pos = _data + pos;
+    }
+
+    size_t MemoryDataStream::Tell() const
+    {
+        return _pos - _data;
+    }
+
+    bool MemoryDataStream::Eof() const
+    {
+        return _pos >= _end;
+    }
+
+    SPtr<DataStream> MemoryDataStream::Clone(bool copyData) const
+    {
+        if (!copyData)
+            return te_shared_ptr_new<MemoryDataStream>(_data, _size, false);
+
+        SPtr<MemoryDataStream> stream = te_shared_ptr_new<MemoryDataStream>(_size);
+        if (_size > 0)
+            memcpy(stream->_data, _data, _size);
+
+        return stream;
+    }
+
+    void MemoryDataStream::Close()
+    {
+        if (_data != nullptr)
+        {
+            if (_freeOnClose)
+                te_free(_data);
+
+            _data = nullptr;
+            _pos = nullptr;
+            _end = nullptr;
+            _size = 0;
+            _capacity = 0;
+        }
+    }
+
+    FileDataStream::FileDataStream(const String& path, UINT16 accessMode, size_t bufferSize)
+        : DataStream(path, accessMode)
+    {
+        const char* mode = "rb";
+        if ((accessMode & WRITE) != 0)
+        {
+            if ((accessMode & READ) != 0)
+            {
+                // Open existing files without truncating them, and create them if they don't exist
+                FILE* existing = fopen(path.c_str(), "ab");
+                if (existing != nullptr)
+                    fclose(existing);
+
+                mode = "r+b";
+            }
+            else
+                mode = "wb";
+        }
+
+        _file = fopen(path.c_str(), mode);
+        if (_file == nullptr)
+        {
+            TE_DEBUG("Cannot open file: " + path);
+            return;
+        }
+
+        // Buffering is handled by the stream itself
+        setvbuf(_file, nullptr, _IONBF, 0);
+
+        _size = FileSize(_file);
+        _buffer.resize(bufferSize);
+    }
+
+    FileDataStream::~FileDataStream()
+    {
+        Close();
+    }
+
+    size_t FileDataStream::Read(void* buf, size_t count)
+    {
+        if (_file == nullptr || !IsReadable() || count == 0)
+            return 0;
+
+        UINT8* output = (UINT8*)buf;
+        size_t numRead = 0;
+
+        // Serve whatever we can from the buffer first
+        if (!_bufferDirty && _bufferPos < _bufferEnd)
+        {
+            const size_t available = std::min(count, _bufferEnd - _bufferPos);
+            memcpy(output, &_buffer[_bufferPos], available);
+
+            _bufferPos += available;
+            numRead += available;
+        }
+
+        if (numRead == count)
+            return numRead;
+
+        // Anything remaining will need to come from the file, discard the buffer
+        const size_t position = _bufferStart + _bufferPos;
+        if (_bufferDirty)
+            Flush();
+
+        _bufferStart = position;
+        _bufferPos = 0;
+        _bufferEnd = 0;
+
+        const size_t remaining = count - numRead;
+        if (remaining >= _buffer.size())
+        {
+            // Large reads go straight into the caller's memory
+            const size_t fileRead = fread(output + numRead, 1, remaining, _file);
+            _bufferStart += fileRead;
+
+            return numRead + fileRead;
+        }
+
+        _bufferEnd = fread(_buffer.data(), 1, _buffer.size(), _file);
+
+        const size_t available = std::min(remaining, _bufferEnd);
+        memcpy(output + numRead, _buffer.data(), available);
+        _bufferPos = available;
+
+        return numRead + available;
+    }
+
+    size_t FileDataStream::Write(const void* buf, size_t count)
+    {
+        if (_file == nullptr || !IsWriteable() || count == 0)
+            return 0;
+
+        // Switching from reading to writing, move the file to the logical position and drop the read data
+        if (!_bufferDirty && _bufferEnd > 0)
+        {
+            if (!SeekFile(_bufferStart + _bufferPos))
+                return 0;
+        }
+
+        size_t written = 0;
+        if (_bufferPos + count > _buffer.size())
+        {
+            if (!Flush())
+                return 0;
+
+            if (count >= _buffer.size())
+            {
+                // Large writes go straight from the caller's memory
+                written = fwrite(buf, 1, count, _file);
+                _bufferStart += written;
+                _size = std::max(_size, _bufferStart);
+
+                return written;
+            }
+        }
+
+        memcpy(&_buffer[_bufferPos], buf, count);
+        _bufferPos += count;
+        _bufferEnd = std::max(_bufferEnd, _bufferPos);
+        _bufferDirty = true;
+        _size = std::max(_size, _bufferStart + _bufferPos);
+
+        return count;
+    }
+
+    bool FileDataStream::Flush()
+    {
+        if (_file == nullptr)
+            return false;
+
+        bool succeeded = true;
+        if (_bufferDirty)
+        {
+            succeeded = fwrite(_buffer.data(), 1, _bufferEnd, _file) == _bufferEnd;
+            succeeded = fflush(_file) == 0 && succeeded;
+
+            _bufferDirty = false;
+        }
+
+        _bufferStart += _bufferPos;
+        _bufferPos = 0;
+        _bufferEnd = 0;
+
+        FileSeek(_file, _bufferStart);
+        return succeeded;
+    }
+
+    bool FileDataStream::SeekFile(size_t pos)
+    {
+        if (_bufferDirty)
+            Flush();
+
+        _bufferStart = pos;
+        _bufferPos = 0;
+        _bufferEnd = 0;
+
+        return FileSeek(_file, pos);
+    }
+
+    void FileDataStream::Skip(size_t count)
+    {
+        Seek(Tell() + count);
+    }
+
+    void FileDataStream::Seek(size_t pos)
+    {
+        if (_file == nullptr)
+            return;
+
+        // Stay within the buffer if we can
+        if (!_bufferDirty && pos >= _bufferStart && pos <= _bufferStart + _bufferEnd)
+        {
+            _bufferPos = pos - _bufferStart;
+            return;
+        }
+
+        SeekFile(pos);
+    }
+
+    size_t FileDataStream::Tell() const
+    {
+        return _bufferStart + _bufferPos;
+    }
+
+    bool FileDataStream::Eof() const
+    {
+        return Tell() >= _size;
+    }
+
+    SPtr<DataStream> FileDataStream::Clone(bool copyData) const
+    {
+        return te_shared_ptr_new<FileDataStream>(_name, (UINT16)_access, _buffer.size());
+    }
+
+    void FileDataStream::Close()
+    {
+        if (_file == nullptr)
+            return;
+
+        Flush();
+        fclose(_file);
+
+        _file = nullptr;
+    }
+
+    MappedFileDataStream::MappedFileDataStream(const String& path, AccessHint hint)
+        : DataStream(path, READ)
+    {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            hint == AccessHint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN :
+            hint == AccessHint::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            TE_DEBUG("Cannot open file: " + path);
+            return;
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+
+        _fileHandle = file;
+        _size = (size_t)size.QuadPart;
+
+        if (_size > 0)
+        {
+            _mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (_mappingHandle != nullptr)
+                _data = (UINT8*)MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+            if (_data == nullptr)
+            {
+                TE_DEBUG("Cannot map file: " + path);
+                Close();
+                return;
+            }
+        }
+
+        _mapped = true;
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            TE_DEBUG("Cannot open file: " + path);
+            return;
+        }
+
+        struct stat info;
+        if (fstat(file, &info) != 0)
+        {
+            close(file);
+            return;
+        }
+
+        _size = (size_t)info.st_size;
+
+        if (_size > 0)
+        {
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (data == MAP_FAILED)
+            {
+                TE_DEBUG("Cannot map file: " + path);
+
+                close(file);
+                _size = 0;
+                return;
+            }
+
+            _data = (UINT8*)data;
+        }
+
+        // The mapping keeps its own reference to the file
+        close(file);
+
+        _mapped = true;
+        SetAccessHint(hint);
+#endif
+    }
+
+    MappedFileDataStream::~MappedFileDataStream()
+    {
+        Close();
+    }
+
+    void MappedFileDataStream::Prefetch(size_t offset, size_t size)
+    {
+        if (_data == nullptr || offset >= _size)
+            return;
+
+        size = std::min(size, _size - offset);
+
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = _data + offset;
+        range.NumberOfBytes = size;
+
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        // madvise requires a page aligned address
+        const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        const size_t alignedOffset = offset - (offset % pageSize);
+
+        madvise(_data + alignedOffset, size + (offset - alignedOffset), MADV_WILLNEED);
+#endif
+    }
+
+    void MappedFileDataStream::SetAccessHint(AccessHint hint)
+    {
+#if TE_PLATFORM != TE_PLATFORM_WIN32
+        if (_data == nullptr)
+            return;
+
+        int advice = MADV_NORMAL;
+        if (hint == AccessHint::Sequential)
+            advice = MADV_SEQUENTIAL;
+        else if (hint == AccessHint::Random)
+            advice = MADV_RANDOM;
+
+        madvise(_data, _size, advice);
+#endif
+        // Windows only supports access hints when opening the file
+    }
+
+    size_t MappedFileDataStream::Read(void* buf, size_t count)
+    {
+        if (_data == nullptr || _pos >= _size)
+            return 0;
+
+        const size_t cnt = std::min(count, _size - _pos);
+        memcpy(buf, _data + _pos, cnt);
+        _pos += cnt;
+
+        return cnt;
+    }
+
+    void MappedFileDataStream::Skip(size_t count)
+    {
+        Seek(_pos + count);
+    }
+
+    void MappedFileDataStream::Seek(size_t pos)
+    {
+        TE_ASSERT_ERROR(pos <= _size, "Seeking past the end of the stream.");
+        _pos = pos;
+    }
+
+    size_t MappedFileDataStream::Tell() const
+    {
+        return _pos;
+    }
+
+    bool MappedFileDataStream::Eof() const
+    {
+        return _pos >= _size;
+    }
+
+    SPtr<DataStream> MappedFileDataStream::Clone(bool copyData) const
+    {
+        return te_shared_ptr_new<MappedFileDataStream>(_name);
+    }
+
+    void MappedFileDataStream::Close()
+    {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        if (_data != nullptr)
+            UnmapViewOfFile(_data);
+
+        if (_mappingHandle != nullptr)
+            CloseHandle((HANDLE)_mappingHandle);
+
+        if (_fileHandle != nullptr)
+            CloseHandle((HANDLE)_fileHandle);
+
+        _mappingHandle = nullptr;
+        _fileHandle = nullptr;
+#else
+        if (_data != nullptr)
+            munmap(_data, _size);
+#endif
 
+        _data = nullptr;
+        _pos = 0;
+        _size = 0;
+        _mapped = false;
+    }
 }
\ No newline at end of file
@@ -3,26 +3,322 @@
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include <istream>
 
-namespace bs 
+namespace te
 {
-	/** Supported encoding types for strings. */
-	enum class StringEncoding
-	{
-		UTF8 = 1,
-		UTF16 = 2
-	};
-
-	/**
-	 * General purpose class used for encapsulating the reading and writing of data from and to various sources using a 
-	 * common interface.
-	 */
-	class TE_UTILITY_EXPORT DataStream
-	{
-	public:
-		enum AccessMode
-		{
-			READ = 1, 
-			WRITE = 2
-		};
-	};
+    /** Supported encoding types for strings. */
+    enum class StringEncoding
+    {
+        UTF8 = 1,
+        UTF16 = 2
+    };
+
+    /**
+     * General purpose class used for encapsulating the reading and writing of data from and to various sources using a 
+     * common interface.
+     */
+    class TE_UTILITY_EXPORT DataStream
+    {
+    public:
+        enum AccessMode
+        {
+            READ = 1, 
+            WRITE = 2
+        };
+
+    public:
+        /** Creates an unnamed stream. */
+        DataStream(UINT16 accessMode = READ)
+            : _access(accessMode)
+        { }
+
+        /** Creates a named stream. */
+        DataStream(const String& name, UINT16 accessMode = READ)
+            : _name(name)
+            , _access(accessMode)
+        { }
+
+        virtual ~DataStream() = default;
+
+        const String& GetName() const { return _name; }
+        UINT16 GetAccessMode() const { return _access; }
+
+        virtual bool IsReadable() const { return (_access & READ) != 0; }
+        virtual bool IsWriteable() const { return (_access & WRITE) != 0; }
+
+        /** Checks whether the stream reads/writes from a file system. */
+        virtual bool IsFile() const = 0;
+
+        /**
+         * Read the requisite number of bytes from the stream, stopping at the end of the file.
+         *
+         * @param[in]	buf		Pre-allocated buffer to read the data into.
+         * @param[in]	count	Number of bytes to read.
+         * @return				Number of bytes actually read.
+         */
+        virtual size_t Read(void* buf, size_t count) = 0;
+
+        /**
+         * Write the requisite number of bytes to the stream.
+         *
+         * @param[in]	buf		Buffer containing bytes to write.
+         * @param[in]	count	Number of bytes to write.
+         * @return				Number of bytes actually written.
+         */
+        virtual size_t Write(const void* buf, size_t count) { return 0; }
+
+        /** Skip a defined number of bytes. */
+        virtual void Skip(size_t count) = 0;
+
+        /** Repositions the read point to a specified byte. */
+        virtual void Seek(size_t pos) = 0;
+
+        /** Returns the current byte offset from beginning. */
+        virtual size_t Tell() const = 0;
+
+        /** Returns true if the stream has reached the end. */
+        virtual bool Eof() const = 0;
+
+        /** Returns the total size of the data to be read from the stream, or 0 if this is indeterminate for this stream. */
+        size_t Size() const { return _size; }
+
+        /**
+         * Creates a copy of this stream.
+         *
+         * @param[in]	copyData	If true the internal stream data will be copied as well, otherwise it will just
+         *							reference the data from the original stream (in which case the caller must ensure the
+         *							original stream outlives the clone). This is not relevant for file streams.
+         */
+        virtual SPtr<DataStream> Clone(bool copyData = true) const = 0;
+
+        /** Close the stream. This makes further operations invalid. */
+        virtual void Close() = 0;
+
+        /** Reads everything from the current position to the end of the stream into the provided buffer. */
+        void ReadAll(Vector<UINT8>& output);
+
+        /** Reads everything from the current position to the end of the stream and returns it as a string. */
+        String GetAsString();
+
+    protected:
+        static const UINT32 StreamTempSize;
+
+        String _name;
+        size_t _size = 0;
+        UINT16 _access;
+    };
+
+    /** Data stream for handling data from memory. */
+    class TE_UTILITY_EXPORT MemoryDataStream : public DataStream
+    {
+    public:
+        /** Allocates a new chunk of memory and wraps it in a stream. Stream is both readable and writeable. */
+        MemoryDataStream(size_t size);
+
+        /**
+         * Wrap an existing memory chunk in a stream.
+         *
+         * @param[in]	memory		Memory to wrap the data stream around.
+         * @param[in]	size		Size of the memory chunk in bytes.
+         * @param[in]	freeOnClose	Should the memory buffer be freed when the data stream goes out of scope. Only allowed
+         *							for memory allocated with te_allocate().
+         */
+        MemoryDataStream(void* memory, size_t size, bool freeOnClose = true);
+
+        /** Create a stream which pre-buffers the contents of another stream. Data from the other stream is copied. */
+        MemoryDataStream(DataStream& sourceStream);
+
+        /** Create a stream which pre-buffers the contents of another stream. Data from the other stream is copied. */
+        MemoryDataStream(const SPtr<DataStream>& sourceStream);
+
+        ~MemoryDataStream();
+
+        bool IsFile() const override { return false; }
+
+        /** Get a pointer to the start of the memory block this stream holds. */
+        UINT8* GetPtr() const { return _data; }
+
+        /** Get a pointer to the current position in the memory block this stream holds. */
+        UINT8* GetCurrentPtr() const { return _pos; }
+
+        /** @copydoc DataStream::Read */
+        size_t Read(void* buf, size_t count) override;
+
+        /**
+         * @copydoc DataStream::Write
+         *
+         * If the stream owns its memory, the memory block is grown to fit the written data. Otherwise the write is
+         * clipped to the end of the wrapped memory.
+         */
+        size_t Write(const void* buf, size_t count) override;
+
+        /** @copydoc DataStream::Skip */
+        void Skip(size_t count) override;
+
+        /** @copydoc DataStream::Seek */
+        void Seek(size_t pos) override;
+
+        /** @copydoc DataStream::Tell */
+        size_t Tell() const override;
+
+        /** @copydoc DataStream::Eof */
+        bool Eof() const override;
+
+        /** @copydoc DataStream::Clone */
+        SPtr<DataStream> Clone(bool copyData = true) const override;
+
+        /** @copydoc DataStream::Close */
+        void Close() override;
+
+        /** Sets whether or not to free the encapsulated memory on close. */
+        void SetFreeOnClose(bool freeOnClose) { _freeOnClose = freeOnClose; }
+
+    protected:
+        /** Grows the owned memory block so it can hold at least @p size bytes. */
+        void Reserve(size_t size);
+
+    protected:
+        UINT8* _data;
+        UINT8* _pos;
+        UINT8* _end;
+        size_t _capacity;
+
+        bool _freeOnClose;
+    };
+
+    /**
+     * Data stream for handling data from files. Reads and writes go through an internal buffer, except for requests
+     * at least as large as the buffer, which are transferred directly to and from the caller's memory.
+     */
+    class TE_UTILITY_EXPORT FileDataStream : public DataStream
+    {
+    public:
+        /** Size of the internal read/write buffer, in bytes. */
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * Opens a file.
+         *
+         * @param[in]	path		Path of the file to open.
+         * @param[in]	accessMode	Combination of AccessMode flags. If WRITE is specified the file is created if it doesn't
+         *							exist, and truncated if READ isn't specified as well.
+         * @param[in]	bufferSize	Size of the internal buffer in bytes. Can be zero to disable buffering.
+         */
+        FileDataStream(const String& path, UINT16 accessMode = READ, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        ~FileDataStream();
+
+        /** Returns true if the file was successfully opened. */
+        bool IsOpen() const { return _file != nullptr; }
+
+        bool IsFile() const override { return true; }
+
+        /** @copydoc DataStream::Read */
+        size_t Read(void* buf, size_t count) override;
+
+        /** @copydoc DataStream::Write */
+        size_t Write(const void* buf, size_t count) override;
+
+        /** @copydoc DataStream::Skip */
+        void Skip(size_t count) override;
+
+        /** @copydoc DataStream::Seek */
+        void Seek(size_t pos) override;
+
+        /** @copydoc DataStream::Tell */
+        size_t Tell() const override;
+
+        /** @copydoc DataStream::Eof */
+        bool Eof() const override;
+
+        /** @copydoc DataStream::Clone */
+        SPtr<DataStream> Clone(bool copyData = true) const override;
+
+        /** @copydoc DataStream::Close */
+        void Close() override;
+
+        /** Writes any buffered data to the file. Returns false if it couldn't all be written, e.g. on a full disk. */
+        bool Flush();
+
+    protected:
+        /** Moves the file position to the provided offset, discarding buffered data. */
+        bool SeekFile(size_t pos);
+
+    protected:
+        FILE* _file = nullptr;
+
+        Vector<UINT8> _buffer;
+        size_t _bufferStart = 0; /**< Offset in the file the buffer starts at. */
+        size_t _bufferPos = 0; /**< Current position within the buffer. */
+        size_t _bufferEnd = 0; /**< Number of valid bytes in the buffer. */
+        bool _bufferDirty = false; /**< True if the buffer contains written data not yet flushed to the file. */
+    };
+
+    /**
+     * Read-only data stream for handling data from files mapped into memory. Reads are plain memory copies, and the
+     * mapped memory can be accessed directly to avoid copying altogether.
+     */
+    class TE_UTILITY_EXPORT MappedFileDataStream : public DataStream
+    {
+    public:
+        /** Hints that let the operating system optimize paging for the expected access pattern. */
+        enum class AccessHint
+        {
+            Normal,
+            Sequential, /**< Data is read front to back, pages can be read ahead aggressively. */
+            Random /**< Data is read in no particular order, read ahead is wasteful. */
+        };
+
+        /** Maps the file at @p path into memory. */
+        MappedFileDataStream(const String& path, AccessHint hint = AccessHint::Normal);
+
+        ~MappedFileDataStream();
+
+        /** Returns true if the file was successfully mapped. */
+        bool IsOpen() const { return _data != nullptr || (_mapped && _size == 0); }
+
+        bool IsFile() const override { return true; }
+
+        /** Returns a pointer to the start of the mapped memory. Valid until the stream is closed. */
+        const UINT8* GetPtr() const { return _data; }
+
+        /** Returns a pointer to the current position in the mapped memory. */
+        const UINT8* GetCurrentPtr() const { return _data + _pos; }
+
+        /** Hints the operating system to start paging in the provided range, as it will be accessed soon. */
+        void Prefetch(size_t offset, size_t size);
+
+        /** Changes the access pattern hint for the whole file. */
+        void SetAccessHint(AccessHint hint);
+
+        /** @copydoc DataStream::Read */
+        size_t Read(void* buf, size_t count) override;
+
+        /** @copydoc DataStream::Skip */
+        void Skip(size_t count) override;
+
+        /** @copydoc DataStream::Seek */
+        void Seek(size_t pos) override;
+
+        /** @copydoc DataStream::Tell */
+        size_t Tell() const override;
+
+        /** @copydoc DataStream::Eof */
+        bool Eof() const override;
+
+        /** @copydoc DataStream::Clone */
+        SPtr<DataStream> Clone(bool copyData = true) const override;
+
+        /** @copydoc DataStream::Close */
+        void Close() override;
+
+    protected:
+        UINT8* _data = nullptr;
+        size_t _pos = 0;
+        bool _mapped = false;
+
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+    };
 }
\ No newline at end of file
@@ -1,6 +1,178 @@
 #include "FileSystem/TeFileSystem.h"
 
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   if !defined(NOMINMAX) && defined(_MSC_VER)
+#       define NOMINMAX // required to stop windows.h messing up std::min
+#   endif
+#   include <windows.h>
+#   include <winioctl.h>
+#else
+#   include <sys/stat.h>
+#   include <sys/types.h>
+#   include <errno.h>
+#   if TE_PLATFORM == TE_PLATFORM_LINUX
+#       include <sys/sysmacros.h>
+#   endif
+#   include <fstream>
+#endif
+
 namespace te
 {
-    Mutex FileLocker::_mutex;
+    namespace
+    {
+        /** Returns the parent folder of a path, or an empty string if the path has no parent. */
+        String GetParentPath(const String& path)
+        {
+            String parent = path;
+            while (!parent.empty() && (parent.back() == '/' || parent.back() == '\\'))
+                parent.pop_back();
+
+            const size_t separator = parent.find_last_of("/\\");
+            if (separator == String::npos)
+                return String();
+
+            return separator == 0 ? parent.substr(0, 1) : parent.substr(0, separator);
+        }
+    }
+
+    bool FileSystem::Exists(const String& path)
+    {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        return GetFileAttributesA(path.c_str()) != INVALID_FILE_ATTRIBUTES;
+#else
+        struct stat info;
+        return stat(path.c_str(), &info) == 0;
+#endif
+    }
+
+    UINT64 FileSystem::GetFileSize(const String& path)
+    {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+            return 0;
+
+        return ((UINT64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+#else
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0)
+            return 0;
+
+        return (UINT64)info.st_size;
+#endif
+    }
+
+    UINT64 FileSystem::GetLastModifiedTime(const String& path)
+    {
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+            return 0;
+
+        return ((UINT64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+#else
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0)
+            return 0;
+
+#   if TE_PLATFORM == TE_PLATFORM_OSX
+        return (UINT64)info.st_mtimespec.tv_sec * 1000000000ULL + (UINT64)info.st_mtimespec.tv_nsec;
+#   else
+        return (UINT64)info.st_mtim.tv_sec * 1000000000ULL + (UINT64)info.st_mtim.tv_nsec;
+#   endif
+#endif
+    }
+
+    bool FileSystem::CreateFolder(const String& path)
+    {
+        if (path.empty() || Exists(path))
+            return true;
+
+        const String parent = GetParentPath(path);
+        if (!parent.empty() && !CreateFolder(parent))
+            return false;
+
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        return CreateDirectoryA(path.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+        // Might have been created by another thread or process in the meantime
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    UINT64 FileSystem::GetDeviceId(const String& path)
+    {
+        const String fullPath = path.empty() ? "." : path;
+
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        char volumePath[MAX_PATH];
+        if (!GetVolumePathNameA(fullPath.c_str(), volumePath, MAX_PATH))
+            return 0;
+
+        // Drive letters are used as identifiers, so IsRotationalDevice() can open the volume
+        return (UINT64)(UINT8)toupper(volumePath[0]);
+#else
+        String current = fullPath;
+        while (!current.empty())
+        {
+            struct stat info;
+            if (stat(current.c_str(), &info) == 0)
+                return (UINT64)info.st_dev + 1;
+
+            current = GetParentPath(current);
+        }
+
+        struct stat info;
+        if (stat(".", &info) == 0)
+            return (UINT64)info.st_dev + 1;
+
+        return 0;
+#endif
+    }
+
+    bool FileSystem::IsRotationalDevice(UINT64 deviceId)
+    {
+        if (deviceId == 0)
+            return false;
+
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        const String volume = String("\\\\.\\") + (char)deviceId + ":";
+        HANDLE handle = CreateFileA(volume.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0,
+            nullptr);
+
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        STORAGE_PROPERTY_QUERY query = {};
+        query.PropertyId = StorageDeviceSeekPenaltyProperty;
+        query.QueryType = PropertyStandardQuery;
+
+        DEVICE_SEEK_PENALTY_DESCRIPTOR descriptor = {};
+        DWORD size = 0;
+
+        const BOOL success = DeviceIoControl(handle, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query), &descriptor,
+            sizeof(descriptor), &size, nullptr);
+
+        CloseHandle(handle);
+        return success && descriptor.IncursSeekPenalty;
+#elif TE_PLATFORM == TE_PLATFORM_LINUX
+        const dev_t device = (dev_t)(deviceId - 1);
+        const String devicePath = "/sys/dev/block/" + ToString(major(device)) + ":" + ToString(minor(device));
+
+        // Partitions don't have a queue of their own, the disk they're on is their parent
+        for (const char* queuePath : { "/queue/rotational", "/../queue/rotational" })
+        {
+            std::ifstream file((devicePath + queuePath).c_str());
+
+            int rotational = 0;
+            if (file >> rotational)
+                return rotational != 0;
+        }
+
+        return false;
+#else
+        return false;
+#endif
+    }
 }
\ No newline at end of file
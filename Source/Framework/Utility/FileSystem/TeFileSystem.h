@@ -1,48 +1,39 @@
 #pragma once
 
 #include "Prerequisites/TePrerequisitesUtility.h"
-#include "Threading/TeThreading.h"
 
 namespace te
 {
-    /** 
-	 * Locks access to files on the same drive, allowing only one file to be read at a time, per drive. This prevents
-	 * multiple threads accessing multiple files on the same drive at once, ruining performance on mechanical drives.
-	 */
-	class TE_UTILITY_EXPORT FileLocker final
-	{
-	public:
-		/** 
-		 * Locks access and doesn't allow other threads to get past this point until access is unlocked. Any scheduled
-		 * file access should happen past this point.
-		 */
-		static void Acquire()
-		{
-			// Note: File path should be analyzed and determined on which drive does the path belong to. Locks can then
-			// be issued on a per-drive basis, instead of having one global lock. This would allow multiple files to be
-			// accessed at the same time, as long as they're on different drives.
-			_mutex.lock();
-		}
+    /** Utility methods for querying the file system. */
+    class TE_UTILITY_EXPORT FileSystem
+    {
+    public:
+        /** Returns true if a file or a folder exists at the provided path. */
+        static bool Exists(const String& path);
 
-		/** 
-		 * Unlocks access and allows another thread to lock file access. Must be provided with the same file path as
-		 * lock().
-		 */
-		static void Unlock()
-		{
-			_mutex.unlock();
-		}
+        /** Returns the size of the file at the provided path in bytes, or 0 if it doesn't exist. */
+        static UINT64 GetFileSize(const String& path);
 
-		/**
-		 * Returns a lock object that immediately locks access (same as lock()), and then calls unlock() when it goes
-		 * out of scope.
-		 */
-		static Lock GetLock()
-		{
-			return Lock(_mutex);
-		}
+        /**
+         * Returns the time the file at the provided path was last modified, or 0 if it doesn't exist. Only meant for
+         * comparing against other values returned by this method.
+         */
+        static UINT64 GetLastModifiedTime(const String& path);
 
-	private:
-		static Mutex _mutex;
-	};
+        /** Creates the folder at the provided path, along with any missing parent folders. Returns false on failure. */
+        static bool CreateFolder(const String& path);
+
+        /**
+         * Returns an identifier of the storage device the provided path is located on. Paths on the same device return
+         * the same identifier. Paths that don't exist yet return the identifier of the closest existing parent folder.
+         * Returns 0 if the device can't be determined.
+         */
+        static UINT64 GetDeviceId(const String& path);
+
+        /**
+         * Returns true if the device with the provided identifier (see GetDeviceId()) is a rotational drive, whose
+         * performance suffers when accessed from multiple places at once.
+         */
+        static bool IsRotationalDevice(UINT64 deviceId);
+    };
 }
\ No newline at end of file
@@ -0,0 +1,678 @@
+#include "FileSystem/TeIOScheduler.h"
+#include "FileSystem/TeFileSystem.h"
+#include "FileSystem/TeDataStream.h"
+#include "Error/TeDebug.h"
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+#   include "Private/Linux/TeLinuxIORing.h"
+#   include <sys/eventfd.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <errno.h>
+#endif
+
+namespace te
+{
+    namespace
+    {
+        /** Returns the folder a file is in. */
+        String GetFolder(const String& path)
+        {
+            const size_t separator = path.find_last_of("/\\");
+            if (separator == String::npos)
+                return ".";
+
+            return path.substr(0, separator + 1);
+        }
+
+        /** Marks the request as completed and releases anyone waiting on it. */
+        void CompleteRequest(IORequest& request, std::function<void(IORequest&)>& callback, Mutex& mutex,
+            Signal& condition, std::atomic<bool>& complete)
+        {
+            // Callback is released once invoked, so it can safely reference the owner of the request
+            if (callback)
+            {
+                callback(request);
+                callback = nullptr;
+            }
+
+            {
+                Lock lock(mutex);
+                complete.store(true, std::memory_order_release);
+            }
+
+            condition.notify_all();
+        }
+    }
+
+    IORequest::IORequest(const String& path, UINT64 offset, UINT64 size, bool readAll, IOPriority priority,
+        std::function<void(IORequest&)> callback)
+        : _path(path)
+        , _offset(offset)
+        , _size(size)
+        , _readAll(readAll)
+        , _priority(priority)
+        , _callback(std::move(callback))
+    { }
+
+    void IORequest::Wait() const
+    {
+        Lock lock(_mutex);
+        while (!_complete.load(std::memory_order_acquire))
+            _completeCondition.wait(lock);
+    }
+
+    IOScheduler::IOScheduler(UINT32 queueDepth, bool useIORing)
+        : _queueDepth(std::max(queueDepth, 1U))
+        , _useIORing(useIORing)
+    {
+#if TE_PLATFORM != TE_PLATFORM_LINUX
+        _useIORing = false;
+#endif
+    }
+
+    IOScheduler::~IOScheduler()
+    { }
+
+    void IOScheduler::OnShutDown()
+    {
+        Vector<Device*> devices;
+        Vector<bool> usesIORing;
+        {
+            Lock lock(_mutex);
+            _shutdown = true;
+
+            for (auto& entry : _devices)
+            {
+                devices.push_back(entry.second.get());
+                usesIORing.push_back(entry.second->UsesIORing);
+            }
+        }
+
+        for (size_t i = 0; i < devices.size(); i++)
+        {
+            Device* device = devices[i];
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+            if (usesIORing[i])
+            {
+                const UINT64 value = 1;
+                if (write(device->WakeFd, &value, sizeof(value)) < 0)
+                {
+                    TE_DEBUG("Failed to wake up the I/O thread.");
+                }
+            }
+#endif
+
+            device->QueueCondition.notify_all();
+        }
+
+        for (auto& device : devices)
+        {
+            for (auto& thread : device->Threads)
+                thread.BlockUntilComplete();
+
+            device->Threads.clear();
+        }
+
+        // Requests that were never issued fail, so nobody keeps waiting on them
+        Vector<SPtr<IORequest>> requests;
+        for (auto& device : devices)
+        {
+            for (auto& queue : device->Queues)
+            {
+                requests.insert(requests.end(), queue.begin(), queue.end());
+                queue.clear();
+            }
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+            if (device->WakeFd >= 0)
+                close(device->WakeFd);
+#endif
+        }
+
+        for (auto& request : requests)
+        {
+            request->_failed = true;
+            CompleteRequest(*request, request->_callback, request->_mutex, request->_completeCondition,
+                request->_complete);
+        }
+
+        _devices.clear();
+    }
+
+    SPtr<IORequest> IOScheduler::Read(const String& path, IOPriority priority, std::function<void(IORequest&)> callback)
+    {
+        SPtr<IORequest> request = te_shared_ptr_new<IORequest>(path, 0, 0, true, priority, std::move(callback));
+        Enqueue(request);
+
+        return request;
+    }
+
+    SPtr<IORequest> IOScheduler::Read(const String& path, UINT64 offset, UINT64 size, IOPriority priority,
+        std::function<void(IORequest&)> callback)
+    {
+        SPtr<IORequest> request = te_shared_ptr_new<IORequest>(path, offset, size, false, priority, std::move(callback));
+        Enqueue(request);
+
+        return request;
+    }
+
+    bool IOScheduler::ReadSync(const String& path, Vector<UINT8>& output, IOPriority priority)
+    {
+        SPtr<IORequest> request = Read(path, priority);
+        request->Wait();
+
+        output = std::move(request->GetData());
+        return !request->HasFailed();
+    }
+
+    IOSchedulerStats IOScheduler::GetStats() const
+    {
+        IOSchedulerStats stats;
+        stats.NumRequests = _numRequests.load(std::memory_order_relaxed);
+        stats.NumReads = _numReads.load(std::memory_order_relaxed);
+        stats.NumMerged = _numMerged.load(std::memory_order_relaxed);
+        stats.BytesRead = _bytesRead.load(std::memory_order_relaxed);
+
+        Lock lock(_mutex);
+        stats.NumDevices = (UINT32)_devices.size();
+
+        return stats;
+    }
+
+    void IOScheduler::Enqueue(const SPtr<IORequest>& request)
+    {
+        Device* device = nullptr;
+        bool usesIORing = false;
+        {
+            Lock lock(_mutex);
+
+            if (!_shutdown)
+            {
+                device = &GetDevice(request->_path);
+                device->Queues[(UINT32)request->_priority].push_back(request);
+                usesIORing = device->UsesIORing;
+            }
+        }
+
+        if (device == nullptr)
+        {
+            request->_failed = true;
+            CompleteRequest(*request, request->_callback, request->_mutex, request->_completeCondition,
+                request->_complete);
+
+            return;
+        }
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+        if (usesIORing)
+        {
+            const UINT64 value = 1;
+            if (write(device->WakeFd, &value, sizeof(value)) < 0)
+            {
+                TE_DEBUG("Failed to wake up the I/O thread.");
+            }
+
+            return;
+        }
+#endif
+
+        device->QueueCondition.notify_one();
+    }
+
+    IOScheduler::Device& IOScheduler::GetDevice(const String& path)
+    {
+        const String folder = GetFolder(path);
+
+        UINT64 deviceId;
+        auto iterFindPath = _pathToDevice.find(folder);
+        if (iterFindPath != _pathToDevice.end())
+            deviceId = iterFindPath->second;
+        else
+        {
+            deviceId = FileSystem::GetDeviceId(folder);
+            _pathToDevice[folder] = deviceId;
+        }
+
+        auto iterFind = _devices.find(deviceId);
+        if (iterFind != _devices.end())
+            return *iterFind->second;
+
+        SPtr<Device> device = te_shared_ptr_new<Device>();
+        device->Id = deviceId;
+        device->Rotational = FileSystem::IsRotationalDevice(deviceId);
+
+        // Rotational drives perform best when reading one thing at a time
+        device->QueueDepth = device->Rotational ? 1 : _queueDepth;
+
+        Device* devicePtr = device.get();
+        _devices[deviceId] = device;
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+        if (_useIORing)
+        {
+            SPtr<IORing> ring = te_shared_ptr_new<IORing>();
+            if (ring->Initialize(device->QueueDepth + 1))
+            {
+                device->WakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                device->UsesIORing = device->WakeFd >= 0;
+            }
+
+            if (device->UsesIORing)
+            {
+                device->Threads.push_back(ThreadPool::Instance().Run("IORing",
+                    [this, devicePtr, ring]() { RunIORing(devicePtr, ring); }));
+
+                return *device;
+            }
+
+            TE_DEBUG("io_uring is not available, falling back to blocking reads.");
+            _useIORing = false;
+        }
+#endif
+
+        const UINT32 numThreads = std::min(device->QueueDepth, MAX_THREADS_PER_DEVICE);
+        for (UINT32 i = 0; i < numThreads; i++)
+        {
+            device->Threads.push_back(ThreadPool::Instance().Run("IOWorker",
+                [this, devicePtr]() { RunWorker(devicePtr); }));
+        }
+
+        return *device;
+    }
+
+    bool IOScheduler::PopBatch(Device& device, ReadBatch& batch)
+    {
+        SPtr<IORequest> first;
+        for (auto& queue : device.Queues)
+        {
+            if (!queue.empty())
+            {
+                first = queue.front();
+                queue.pop_front();
+                break;
+            }
+        }
+
+        if (first == nullptr)
+            return false;
+
+        batch.Path = first->_path;
+        batch.Offset = first->_offset;
+        batch.Size = first->_size;
+        batch.ReadAll = first->_readAll;
+        batch.Requests.push_back(first);
+
+        if (batch.ReadAll)
+            return true;
+
+        // Grow the range with pending requests that are directly before or after it, in any priority class
+        bool merged = true;
+        while (merged && batch.Size < MAX_MERGED_SIZE)
+        {
+            merged = false;
+
+            for (auto& queue : device.Queues)
+            {
+                for (auto iter = queue.begin(); iter != queue.end(); )
+                {
+                    const IORequest& request = **iter;
+                    if (request._readAll || request._path != batch.Path || batch.Size + request._size > MAX_MERGED_SIZE)
+                    {
+                        ++iter;
+                        continue;
+                    }
+
+                    if (request._offset == batch.Offset + batch.Size)
+                        batch.Requests.push_back(*iter);
+                    else if (request._offset + request._size == batch.Offset)
+                    {
+                        batch.Requests.insert(batch.Requests.begin(), *iter);
+                        batch.Offset = request._offset;
+                    }
+                    else
+                    {
+                        ++iter;
+                        continue;
+                    }
+
+                    batch.Size += request._size;
+                    iter = queue.erase(iter);
+                    merged = true;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    UINT8* IOScheduler::GetBatchBuffer(ReadBatch& batch)
+    {
+        if (batch.Requests.size() == 1)
+            return batch.Requests[0]->_data.data();
+
+        return batch.Buffer.data();
+    }
+
+    void IOScheduler::PrepareBatch(ReadBatch& batch)
+    {
+        if (batch.Requests.size() == 1)
+            batch.Requests[0]->_data.resize((size_t)batch.Size);
+        else
+            batch.Buffer.resize((size_t)batch.Size);
+    }
+
+    void IOScheduler::CompleteBatch(ReadBatch& batch)
+    {
+        _numReads.fetch_add(1, std::memory_order_relaxed);
+        _numMerged.fetch_add(batch.Requests.size() - 1, std::memory_order_relaxed);
+        _bytesRead.fetch_add(batch.NumRead, std::memory_order_relaxed);
+
+        for (auto& request : batch.Requests)
+        {
+            if (batch.Requests.size() == 1)
+            {
+                request->_data.resize((size_t)batch.NumRead);
+                request->_failed = batch.Failed || batch.NumRead < batch.Size;
+            }
+            else
+            {
+                const UINT64 start = request->_offset - batch.Offset;
+                const UINT64 available = batch.NumRead > start ? std::min(request->_size, batch.NumRead - start) : 0;
+
+                request->_data.assign(batch.Buffer.data() + start, batch.Buffer.data() + start + available);
+                request->_failed = batch.Failed || available < request->_size;
+            }
+
+            CompleteRequest(*request, request->_callback, request->_mutex, request->_completeCondition,
+                request->_complete);
+
+            _numRequests.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        batch.Requests.clear();
+    }
+
+    void IOScheduler::RunWorker(Device* device)
+    {
+        while (true)
+        {
+            ReadBatch batch;
+            {
+                Lock lock(_mutex);
+
+                while (!_shutdown && !PopBatch(*device, batch))
+                    device->QueueCondition.wait(lock);
+
+                if (_shutdown)
+                {
+                    // Put back what was taken, it gets failed along with the rest of the queue
+                    for (auto& request : batch.Requests)
+                        device->Queues[(UINT32)request->_priority].push_back(request);
+
+                    return;
+                }
+            }
+
+            ReadBlocking(batch);
+            CompleteBatch(batch);
+        }
+    }
+
+    void IOScheduler::ReadBlocking(ReadBatch& batch)
+    {
+        FileDataStream file(batch.Path, DataStream::READ, 0);
+        if (!file.IsOpen())
+        {
+            batch.Failed = true;
+            return;
+        }
+
+        if (batch.ReadAll)
+            batch.Size = file.Size();
+
+        PrepareBatch(batch);
+
+        file.Seek((size_t)batch.Offset);
+        batch.NumRead = file.Read(GetBatchBuffer(batch), (size_t)batch.Size);
+    }
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+    namespace
+    {
+        /** User data of the completion for the wake up event of the ring. */
+        constexpr UINT64 WAKE_USER_DATA = 0;
+
+        /** Max size of a single read issued to the ring, results are reported as 32-bit integers. */
+        constexpr UINT64 MAX_RING_READ_SIZE = 1024 * 1024 * 1024;
+    }
+
+    void IOScheduler::RunIORing(Device* device, SPtr<IORing> ring)
+    {
+        struct RingBatch
+        {
+            ReadBatch Batch;
+            struct iovec Vector;
+        };
+
+        auto queueRead = [&ring](RingBatch* entry)
+        {
+            ReadBatch& batch = entry->Batch;
+
+            entry->Vector.iov_base = GetBatchBuffer(batch) + batch.NumRead;
+            entry->Vector.iov_len = (size_t)std::min(batch.Size - batch.NumRead, MAX_RING_READ_SIZE);
+
+            // Ring holds one more entry than the queue depth, there is always room for the reads in flight
+            ring->QueueRead(batch.FileDesc, &entry->Vector, batch.Offset + batch.NumRead, (UINT64)entry);
+        };
+
+        // Reads what the ring didn't, once it can't be used anymore
+        auto readBlocking = [](RingBatch* entry)
+        {
+            ReadBatch& batch = entry->Batch;
+
+            while (!batch.Failed && batch.NumRead < batch.Size)
+            {
+                const size_t size = (size_t)std::min(batch.Size - batch.NumRead, MAX_RING_READ_SIZE);
+                const ssize_t result = pread(batch.FileDesc, GetBatchBuffer(batch) + batch.NumRead, size,
+                    (off_t)(batch.Offset + batch.NumRead));
+
+                if (result < 0 && errno == EINTR)
+                    continue;
+
+                if (result <= 0)
+                {
+                    batch.Failed = result < 0;
+                    break;
+                }
+
+                batch.NumRead += (UINT64)result;
+            }
+        };
+
+        // Accounts for the result of a read, and returns false if the batch needs more reads
+        auto processResult = [](RingBatch* entry, INT32 result)
+        {
+            ReadBatch& batch = entry->Batch;
+
+            if (result == -EINTR || result == -EAGAIN)
+                return false;
+
+            if (result < 0)
+                batch.Failed = true;
+            else
+                batch.NumRead += (UINT64)result;
+
+            // Continue short reads, unless the end of the file was reached
+            return result <= 0 || batch.NumRead >= batch.Size;
+        };
+
+        auto finish = [this](RingBatch* entry)
+        {
+            if (entry->Batch.FileDesc >= 0)
+                close(entry->Batch.FileDesc);
+
+            CompleteBatch(entry->Batch);
+            te_delete(entry);
+        };
+
+        UINT32 numInFlight = 0;
+        bool isWakeArmed = false;
+        bool ringFailed = false;
+
+        while (true)
+        {
+            if (!isWakeArmed)
+            {
+                ring->QueuePoll(device->WakeFd, WAKE_USER_DATA);
+                isWakeArmed = true;
+            }
+
+            UINT64 wakeValue;
+            while (read(device->WakeFd, &wakeValue, sizeof(wakeValue)) > 0)
+            { }
+
+            bool shutdown = false;
+            while (numInFlight < device->QueueDepth)
+            {
+                ReadBatch batch;
+                {
+                    Lock lock(_mutex);
+                    shutdown = _shutdown;
+
+                    if (shutdown || !PopBatch(*device, batch))
+                        break;
+                }
+
+                RingBatch* entry = te_new<RingBatch>();
+                entry->Batch = std::move(batch);
+                entry->Batch.FileDesc = open(entry->Batch.Path.c_str(), O_RDONLY | O_CLOEXEC);
+
+                if (entry->Batch.FileDesc < 0)
+                {
+                    entry->Batch.Failed = true;
+                    finish(entry);
+                    continue;
+                }
+
+                if (entry->Batch.ReadAll)
+                {
+                    struct stat info;
+                    if (fstat(entry->Batch.FileDesc, &info) == 0)
+                        entry->Batch.Size = (UINT64)info.st_size;
+                    else
+                        entry->Batch.Failed = true;
+                }
+
+                PrepareBatch(entry->Batch);
+
+                if (entry->Batch.Failed || entry->Batch.Size == 0)
+                {
+                    finish(entry);
+                    continue;
+                }
+
+                queueRead(entry);
+                numInFlight++;
+            }
+
+            // Let the reads in flight complete before exiting, the kernel is writing into their buffers
+            if (shutdown && numInFlight == 0)
+                break;
+
+            // Kernel being short on resources, or its completion queue being full, is temporary. Entries it didn't
+            // accept stay queued and are submitted again once completions have been retrieved.
+            const INT32 error = ring->Submit(1);
+            const bool isBusy = error == -EAGAIN || error == -EBUSY;
+
+            if (error < 0 && !isBusy)
+            {
+                TE_DEBUG("Failed to submit I/O requests to io_uring (error " + ToString(-error) +
+                    "), falling back to blocking reads.");
+
+                ringFailed = true;
+                break;
+            }
+
+            UINT32 numCompleted = 0;
+            UINT64 userData;
+            INT32 result;
+            while (ring->PopCompletion(userData, result))
+            {
+                numCompleted++;
+
+                if (userData == WAKE_USER_DATA)
+                {
+                    isWakeArmed = false;
+                    continue;
+                }
+
+                RingBatch* entry = (RingBatch*)userData;
+                if (!processResult(entry, result))
+                {
+                    queueRead(entry);
+                    continue;
+                }
+
+                finish(entry);
+                numInFlight--;
+            }
+
+            if (isBusy && numCompleted == 0)
+                TE_THREAD_SLEEP(1);
+        }
+
+        if (!ringFailed)
+            return;
+
+        // Reads the kernel never accepted won't complete, they are read here instead. The ones it accepted still write
+        // into their buffers, so they have to complete before the buffers can be released.
+        UINT64 userData;
+        while (ring->PopUnsubmitted(userData))
+        {
+            if (userData == WAKE_USER_DATA)
+                continue;
+
+            RingBatch* entry = (RingBatch*)userData;
+            readBlocking(entry);
+            finish(entry);
+            numInFlight--;
+        }
+
+        while (numInFlight > 0)
+        {
+            INT32 result;
+            if (!ring->PopCompletion(userData, result))
+            {
+                TE_THREAD_SLEEP(1);
+                continue;
+            }
+
+            if (userData == WAKE_USER_DATA)
+                continue;
+
+            RingBatch* entry = (RingBatch*)userData;
+            if (!processResult(entry, result))
+                readBlocking(entry);
+
+            finish(entry);
+            numInFlight--;
+        }
+
+        {
+            Lock lock(_mutex);
+            device->UsesIORing = false;
+            _useIORing = false;
+        }
+
+        RunWorker(device);
+    }
+#endif
+
+    IOScheduler& gIOScheduler()
+    {
+        return IOScheduler::Instance();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
+#include "Threading/TeThreadPool.h"
+
+namespace te
+{
+    class IORing;
+
+    /** Priority classes of I/O requests. Requests of a higher class are always issued before those of a lower one. */
+    enum class IOPriority
+    {
+        Streaming = 0, /**< Data needed as soon as possible, e.g. resources the application is waiting on. */
+        Normal = 1,
+        Background = 2, /**< Data that can wait, e.g. prefetching. */
+        Count
+    };
+
+    /** Single read issued through the IOScheduler. */
+    class TE_UTILITY_EXPORT IORequest
+    {
+    public:
+        IORequest(const String& path, UINT64 offset, UINT64 size, bool readAll, IOPriority priority,
+            std::function<void(IORequest&)> callback);
+
+        /** Returns true once the request completed, successfully or not. */
+        bool IsComplete() const { return _complete.load(std::memory_order_acquire); }
+
+        /** Blocks until the request completes. */
+        void Wait() const;
+
+        /** Returns true if the file couldn't be opened, or fewer bytes than requested could be read. */
+        bool HasFailed() const { return _failed; }
+
+        /** Returns the read data. Only valid once the request has completed. */
+        Vector<UINT8>& GetData() { return _data; }
+
+        /** Returns the path of the file being read. */
+        const String& GetPath() const { return _path; }
+
+        /** Returns the offset in the file the read starts at. */
+        UINT64 GetOffset() const { return _offset; }
+
+        /** Returns the priority class of the request. */
+        IOPriority GetPriority() const { return _priority; }
+
+    private:
+        friend class IOScheduler;
+
+        String _path;
+        UINT64 _offset;
+        UINT64 _size;
+        bool _readAll;
+        IOPriority _priority;
+        std::function<void(IORequest&)> _callback;
+
+        Vector<UINT8> _data;
+        bool _failed = false;
+        std::atomic<bool> _complete{false};
+
+        mutable Mutex _mutex;
+        mutable Signal _completeCondition;
+    };
+
+    /** Statistics about the reads performed by the IOScheduler. */
+    struct IOSchedulerStats
+    {
+        UINT64 NumRequests = 0; /**< Number of completed requests. */
+        UINT64 NumReads = 0; /**< Number of reads issued to the operating system. */
+        UINT64 NumMerged = 0; /**< Number of requests that were merged with an adjacent request. */
+        UINT64 BytesRead = 0;
+        UINT32 NumDevices = 0; /**< Number of storage devices accessed so far. */
+    };
+
+    /**
+     * Schedules file reads. Every storage device gets its own request queue, so devices don't wait on each other, and
+     * requests are issued to a device concurrently up to its queue depth (a single request at a time for rotational
+     * drives). Within a device, requests are issued by priority class, and pending requests for adjacent ranges of the
+     * same file are merged into a single read.
+     *
+     * On Linux reads are issued through io_uring, using a single thread per device. Elsewhere, or if io_uring isn't
+     * available, every device gets a set of threads that perform blocking reads.
+     *
+     * @note	Thread safe.
+     */
+    class TE_UTILITY_EXPORT IOScheduler : public Module<IOScheduler>
+    {
+    public:
+        /** Default number of concurrent reads issued to a non-rotational device. */
+        static constexpr UINT32 DEFAULT_QUEUE_DEPTH = 16;
+
+        /** Max number of threads per device when io_uring isn't used. */
+        static constexpr UINT32 MAX_THREADS_PER_DEVICE = 4;
+
+        /** Requests are only merged as long as the merged read stays below this size, in bytes. */
+        static constexpr UINT64 MAX_MERGED_SIZE = 4 * 1024 * 1024;
+
+        /**
+         * @param[in]	queueDepth	Number of concurrent reads issued to a non-rotational device.
+         * @param[in]	useIORing	Allows using io_uring where available.
+         */
+        IOScheduler(UINT32 queueDepth = DEFAULT_QUEUE_DEPTH, bool useIORing = true);
+        ~IOScheduler();
+
+        /**
+         * Queues a read of a whole file.
+         *
+         * @param[in]	path		Path of the file to read.
+         * @param[in]	priority	Priority class of the request.
+         * @param[in]	callback	Optional callback to trigger once the read completes. Called from an I/O thread,
+         *							before any threads waiting on the request are released, and must not block.
+         * @return					Request that can be used for waiting on the read, and retrieving the read data.
+         */
+        SPtr<IORequest> Read(const String& path, IOPriority priority = IOPriority::Normal,
+            std::function<void(IORequest&)> callback = nullptr);
+
+        /** Same as Read(const String&, IOPriority, ...), except only @p size bytes starting at @p offset are read. */
+        SPtr<IORequest> Read(const String& path, UINT64 offset, UINT64 size, IOPriority priority = IOPriority::Normal,
+            std::function<void(IORequest&)> callback = nullptr);
+
+        /** Reads a whole file and blocks until the read completes. Returns false if the read failed. */
+        bool ReadSync(const String& path, Vector<UINT8>& output, IOPriority priority = IOPriority::Streaming);
+
+        /** Returns statistics about the reads performed so far. */
+        IOSchedulerStats GetStats() const;
+
+        /** Returns true if reads are issued through io_uring. */
+        bool IsUsingIORing() const { return _useIORing.load(std::memory_order_relaxed); }
+
+    protected:
+        /** Contiguous range of a file, read by a single read operation on behalf of one or more requests. */
+        struct ReadBatch
+        {
+            String Path;
+            UINT64 Offset = 0;
+            UINT64 Size = 0;
+            bool ReadAll = false;
+            Vector<SPtr<IORequest>> Requests;
+
+            Vector<UINT8> Buffer; /**< Destination of merged reads, single requests are read directly into their data. */
+            UINT64 NumRead = 0;
+            INT32 FileDesc = -1;
+            bool Failed = false;
+        };
+
+        /** Request queues and threads of a single storage device. */
+        struct Device
+        {
+            UINT64 Id = 0;
+            bool Rotational = false;
+            UINT32 QueueDepth = 1;
+            List<SPtr<IORequest>> Queues[(UINT32)IOPriority::Count];
+
+            Signal QueueCondition;
+            Vector<HThread> Threads;
+
+            bool UsesIORing = false;
+            INT32 WakeFd = -1; /**< Event used for waking up the io_uring thread. */
+        };
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /** Queues a new request on the device the file is on. */
+        void Enqueue(const SPtr<IORequest>& request);
+
+        /** Creates the queues and threads of a device. Caller must hold the lock. */
+        Device& GetDevice(const String& path);
+
+        /**
+         * Removes the highest priority request from the device queues, along with any requests adjacent to it that can
+         * be merged. Returns false if the queues are empty. Caller must hold the lock.
+         */
+        bool PopBatch(Device& device, ReadBatch& batch);
+
+        /** Returns the buffer the batch reads into. */
+        static UINT8* GetBatchBuffer(ReadBatch& batch);
+
+        /** Sets up the buffers of a batch once the size of the read is known. */
+        static void PrepareBatch(ReadBatch& batch);
+
+        /** Distributes the read data to the requests and completes them. */
+        void CompleteBatch(ReadBatch& batch);
+
+        /** Main method of the threads of devices that perform blocking reads. */
+        void RunWorker(Device* device);
+
+        /** Performs a blocking read of a batch. */
+        void ReadBlocking(ReadBatch& batch);
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+        /**
+         * Main method of the thread of a device that uses io_uring. If the ring stops accepting requests, the thread
+         * switches the device to blocking reads.
+         */
+        void RunIORing(Device* device, SPtr<IORing> ring);
+#endif
+
+    protected:
+        UINT32 _queueDepth;
+        std::atomic<bool> _useIORing;
+        bool _shutdown = false;
+
+        UnorderedMap<UINT64, SPtr<Device>> _devices;
+        Map<String, UINT64> _pathToDevice; /**< Folders whose device was already determined. */
+
+        std::atomic<UINT64> _numRequests{0};
+        std::atomic<UINT64> _numReads{0};
+        std::atomic<UINT64> _numMerged{0};
+        std::atomic<UINT64> _bytesRead{0};
+
+        mutable Mutex _mutex;
+    };
+
+    /** Provides easy access to IOScheduler. */
+    TE_UTILITY_EXPORT IOScheduler& gIOScheduler();
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "FileSystem/TePackArchive.h"
+#include "FileSystem/TeDataStream.h"
+#include "FileSystem/TeCompressedDataStream.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Checks that [offset, offset + size) lies within a buffer of @p bufferSize bytes. */
+        bool IsInRange(UINT64 offset, UINT64 size, UINT64 bufferSize)
+        {
+            return offset <= bufferSize && size <= bufferSize - offset;
+        }
+    }
+
+    PackArchive::PackArchive(const String& path)
+        : _path(path)
+    {
+        _file = te_shared_ptr_new<MappedFileDataStream>(path, MappedFileDataStream::AccessHint::Random);
+
+        if (!Open())
+        {
+            TE_DEBUG("Invalid pack archive: " + path);
+
+            _header = nullptr;
+            _file->Close();
+        }
+    }
+
+    PackArchive::~PackArchive()
+    {
+        _file->Close();
+    }
+
+    bool PackArchive::Open()
+    {
+        if (!_file->IsOpen())
+            return false;
+
+        const UINT64 size = _file->Size();
+        _data = _file->GetPtr();
+
+        if (size < sizeof(PackHeader))
+            return false;
+
+        const PackHeader* header = (const PackHeader*)_data;
+        if (header->Magic != MAGIC || header->Version != VERSION)
+            return false;
+
+        if (header->IndexCapacity == 0 || (header->IndexCapacity & (header->IndexCapacity - 1)) != 0 ||
+            header->IndexCapacity < header->NumEntries)
+            return false;
+
+        const UINT64 indexSize = (UINT64)header->IndexCapacity * sizeof(UINT32);
+        if (!IsInRange(header->EntriesOffset, (UINT64)header->NumEntries * sizeof(PackEntry), size) ||
+            !IsInRange(header->UUIDIndexOffset, indexSize, size) ||
+            !IsInRange(header->PathIndexOffset, indexSize, size) ||
+            !IsInRange(header->StringsOffset, header->StringsSize, size))
+            return false;
+
+        if (header->EntriesOffset % alignof(PackEntry) != 0 || header->UUIDIndexOffset % alignof(UINT32) != 0 ||
+            header->PathIndexOffset % alignof(UINT32) != 0)
+            return false;
+
+        _entries = (const PackEntry*)(_data + header->EntriesOffset);
+        _uuidIndex = (const UINT32*)(_data + header->UUIDIndexOffset);
+        _pathIndex = (const UINT32*)(_data + header->PathIndexOffset);
+        _strings = (const char*)(_data + header->StringsOffset);
+
+        // Validate the entries once, so lookups and reads don't need to
+        for (UINT32 i = 0; i < header->NumEntries; i++)
+        {
+            const PackEntry& entry = _entries[i];
+
+            if (!IsInRange(entry.Offset, entry.Size, size) ||
+                !IsInRange(entry.PathOffset, entry.PathLength, header->StringsSize))
+                return false;
+
+            if (entry.Compression != PackCompression::None && entry.Compression != PackCompression::Block)
+                return false;
+
+            if (entry.Compression == PackCompression::None && entry.Size != entry.UncompressedSize)
+                return false;
+        }
+
+        for (UINT32 i = 0; i < header->IndexCapacity; i++)
+        {
+            if (_uuidIndex[i] > header->NumEntries || _pathIndex[i] > header->NumEntries)
+                return false;
+        }
+
+        _header = header;
+        return true;
+    }
+
+    const PackEntry* PackArchive::Find(const UUID& uuid) const
+    {
+        if (_header == nullptr)
+            return nullptr;
+
+        const UINT32 mask = _header->IndexCapacity - 1;
+        UINT32 slot = (UINT32)HashUUID(uuid) & mask;
+
+        // Index is never full, so the probe always ends on an empty slot
+        for (UINT32 i = 0; i < _header->IndexCapacity; i++)
+        {
+            const UINT32 entryIdx = _uuidIndex[slot];
+            if (entryIdx == 0)
+                return nullptr;
+
+            const PackEntry& entry = _entries[entryIdx - 1];
+            if (entry.Id == uuid)
+                return &entry;
+
+            slot = (slot + 1) & mask;
+        }
+
+        return nullptr;
+    }
+
+    const PackEntry* PackArchive::Find(const String& path) const
+    {
+        if (_header == nullptr)
+            return nullptr;
+
+        const String normalizedPath = NormalizePath(path);
+        const UINT64 hash = HashPath(normalizedPath);
+
+        const UINT32 mask = _header->IndexCapacity - 1;
+        UINT32 slot = (UINT32)hash & mask;
+
+        for (UINT32 i = 0; i < _header->IndexCapacity; i++)
+        {
+            const UINT32 entryIdx = _pathIndex[slot];
+            if (entryIdx == 0)
+                return nullptr;
+
+            const PackEntry& entry = _entries[entryIdx - 1];
+            if (entry.PathHash == hash && entry.PathLength == normalizedPath.size() &&
+                memcmp(_strings + entry.PathOffset, normalizedPath.data(), entry.PathLength) == 0)
+                return &entry;
+
+            slot = (slot + 1) & mask;
+        }
+
+        return nullptr;
+    }
+
+    String PackArchive::GetEntryPath(const PackEntry& entry) const
+    {
+        return String(_strings + entry.PathOffset, entry.PathLength);
+    }
+
+    bool PackArchive::Read(const PackEntry& entry, Vector<UINT8>& output) const
+    {
+        if (_header == nullptr)
+            return false;
+
+        if (entry.Compression == PackCompression::None)
+        {
+            output.assign(GetData(entry), GetData(entry) + entry.Size);
+            return true;
+        }
+
+        // Compressed stream reads straight from the mapped memory
+        SPtr<MemoryDataStream> source = te_shared_ptr_new<MemoryDataStream>((void*)GetData(entry), (size_t)entry.Size, false);
+        CompressedDataStream stream(source, DataStream::READ);
+
+        if (!stream.IsValid() || stream.Size() != entry.UncompressedSize)
+            return false;
+
+        output.resize((size_t)entry.UncompressedSize);
+        return stream.Read(output.data(), output.size()) == output.size();
+    }
+
+    String PackArchive::NormalizePath(const String& path)
+    {
+        String output = path;
+        std::replace(output.begin(), output.end(), '\\', '/');
+
+        while (output.compare(0, 2, "./") == 0)
+            output.erase(0, 2);
+
+        return output;
+    }
+
+    UINT64 PackArchive::HashPath(const String& path)
+    {
+        // FNV-1a
+        UINT64 hash = 14695981039346656037ULL;
+        for (char character : path)
+        {
+            hash ^= (UINT8)character;
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    UINT64 PackArchive::HashUUID(const UUID& uuid)
+    {
+        static_assert(sizeof(UUID) == sizeof(UINT64) * 2, "Unexpected UUID size.");
+
+        UINT64 data[2];
+        memcpy(data, &uuid, sizeof(data));
+
+        // UUIDs are already random, mixing the halves is enough
+        UINT64 hash = data[0] ^ (data[1] * 0x9E3779B97F4A7C15ULL);
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeUUID.h"
+
+namespace te
+{
+    class MappedFileDataStream;
+
+    /** Determines how the data of a pack archive entry is stored. */
+    enum class PackCompression : UINT32
+    {
+        None = 0, /**< Stored as is, can be accessed in place. */
+        Block = 1 /**< Stored in the CompressedDataStream format. */
+    };
+
+    /** Header at the start of every pack archive. All offsets are in bytes from the start of the file. */
+    struct PackHeader
+    {
+        UINT32 Magic;
+        UINT32 Version;
+        UINT32 NumEntries;
+        UINT32 IndexCapacity; /**< Number of slots in each of the hash indices, always a power of two. */
+        UINT64 EntriesOffset; /**< Array of NumEntries PackEntry structures. */
+        UINT64 UUIDIndexOffset; /**< Hash index of IndexCapacity slots, mapping UUIDs to entries. */
+        UINT64 PathIndexOffset; /**< Hash index of IndexCapacity slots, mapping path hashes to entries. */
+        UINT64 StringsOffset; /**< Paths of all entries. */
+        UINT64 StringsSize;
+    };
+
+    /** Single asset stored in a pack archive. */
+    struct PackEntry
+    {
+        UUID Id;
+        UINT64 Offset; /**< Offset of the stored data from the start of the file. */
+        UINT64 Size; /**< Size of the stored data. */
+        UINT64 UncompressedSize; /**< Size of the asset data, same as Size if the entry isn't compressed. */
+        UINT64 PathHash;
+        UINT32 PathOffset; /**< Offset of the path in the string section. */
+        UINT32 PathLength;
+        PackCompression Compression;
+        UINT32 Padding;
+    };
+
+    /**
+     * Read-only archive containing many assets in a single file, which avoids the cost of opening a file per asset. The
+     * file is mapped into memory, so finding an asset is a lookup in a hash index and reading it costs no system calls
+     * beyond the page faults needed to bring its data in.
+     *
+     * Assets are identified by their UUID and by the path they were added with. Archives are created with
+     * PackArchiveBuilder.
+     *
+     * @note	Thread safe, the archive is immutable once opened.
+     */
+    class TE_UTILITY_EXPORT PackArchive
+    {
+    public:
+        static constexpr UINT32 MAGIC = 0x4B504554; // "TEPK"
+        static constexpr UINT32 VERSION = 1;
+
+        /** Opens and maps the archive at the provided path. Check IsValid() to see if opening succeeded. */
+        PackArchive(const String& path);
+        ~PackArchive();
+
+        /** Returns true if the archive was successfully opened. */
+        bool IsValid() const { return _header != nullptr; }
+
+        /** Returns the path the archive was opened from. */
+        const String& GetPath() const { return _path; }
+
+        /** Returns the number of assets in the archive. */
+        UINT32 GetNumEntries() const { return _header != nullptr ? _header->NumEntries : 0; }
+
+        /** Returns the entry at the provided index, in range [0, GetNumEntries()). */
+        const PackEntry& GetEntry(UINT32 idx) const { return _entries[idx]; }
+
+        /** Returns the entry of the asset with the provided UUID, or null if the archive doesn't contain it. */
+        const PackEntry* Find(const UUID& uuid) const;
+
+        /** Returns the entry of the asset with the provided path, or null if the archive doesn't contain it. */
+        const PackEntry* Find(const String& path) const;
+
+        /** Returns the path the provided entry was added with. */
+        String GetEntryPath(const PackEntry& entry) const;
+
+        /**
+         * Returns the stored data of the entry, pointing directly into the mapped file. For uncompressed entries this is
+         * the asset data itself. Valid as long as the archive is.
+         */
+        const UINT8* GetData(const PackEntry& entry) const { return _data + entry.Offset; }
+
+        /** Reads the data of an asset, decompressing it if needed. Returns false if the data is corrupt. */
+        bool Read(const PackEntry& entry, Vector<UINT8>& output) const;
+
+        /** Converts a path into the form it is stored in (forward slashes, no leading "./"). */
+        static String NormalizePath(const String& path);
+
+        /** Hash used for the path index, @p path must be normalized. Stable across platforms and builds. */
+        static UINT64 HashPath(const String& path);
+
+        /** Hash used for the UUID index. Stable across platforms and builds. */
+        static UINT64 HashUUID(const UUID& uuid);
+
+    private:
+        /** Validates the mapped file and sets up pointers to its sections. */
+        bool Open();
+
+    private:
+        String _path;
+        SPtr<MappedFileDataStream> _file;
+
+        const UINT8* _data = nullptr;
+        const PackHeader* _header = nullptr;
+        const PackEntry* _entries = nullptr;
+        const UINT32* _uuidIndex = nullptr;
+        const UINT32* _pathIndex = nullptr;
+        const char* _strings = nullptr;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "FileSystem/TePackArchiveBuilder.h"
+#include "FileSystem/TeDataStream.h"
+#include "FileSystem/TeCompressedDataStream.h"
+#include "Error/TeDebug.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Block size used for compressed entries. */
+        constexpr UINT32 COMPRESSION_BLOCK_SIZE = 64 * 1024;
+
+        /** Compressed data is only used if it's at most this fraction of the original size. */
+        constexpr float MIN_COMPRESSION_RATIO = 0.9f;
+
+        /** Builds a hash index with @p capacity slots, pointing to entries by their index + 1. */
+        Vector<UINT32> BuildIndex(const Vector<UINT64>& hashes, UINT32 capacity)
+        {
+            Vector<UINT32> index(capacity, 0);
+            const UINT32 mask = capacity - 1;
+
+            for (UINT32 i = 0; i < (UINT32)hashes.size(); i++)
+            {
+                UINT32 slot = (UINT32)hashes[i] & mask;
+                while (index[slot] != 0)
+                    slot = (slot + 1) & mask;
+
+                index[slot] = i + 1;
+            }
+
+            return index;
+        }
+
+        /** Reports a failed write to an archive, e.g. because the disk is full, and returns false. */
+        bool ReportWriteError(const FileDataStream& stream)
+        {
+            TE_DEBUG("Failed to write pack archive: " + stream.GetName());
+            return false;
+        }
+    }
+
+    PackArchiveBuilder::PackArchiveBuilder(UINT32 alignment)
+        : _alignment(std::max(alignment, 1U))
+    { }
+
+    void PackArchiveBuilder::Add(const UUID& uuid, const String& path, const void* data, size_t size, bool compress)
+    {
+        PendingEntry entry;
+        entry.Id = uuid;
+        entry.Path = PackArchive::NormalizePath(path);
+        entry.Data.assign((const UINT8*)data, (const UINT8*)data + size);
+        entry.Compress = compress;
+
+        _pending.push_back(std::move(entry));
+    }
+
+    void PackArchiveBuilder::AddFile(const UUID& uuid, const String& path, const String& sourceFile, bool compress)
+    {
+        PendingEntry entry;
+        entry.Id = uuid;
+        entry.Path = PackArchive::NormalizePath(path);
+        entry.SourceFile = sourceFile;
+        entry.Compress = compress;
+
+        _pending.push_back(std::move(entry));
+    }
+
+    bool PackArchiveBuilder::Write(const String& path)
+    {
+        FileDataStream stream(path, DataStream::WRITE);
+        if (!stream.IsOpen())
+            return false;
+
+        // Header is written once everything else is
+        PackHeader header = {};
+        if (stream.Write(&header, sizeof(header)) != sizeof(header))
+            return ReportWriteError(stream);
+
+        Vector<PackEntry> entries;
+        Vector<String> paths;
+
+        return WriteEntries(stream, entries, paths);
+    }
+
+    bool PackArchiveBuilder::Append(const String& path)
+    {
+        Vector<PackEntry> entries;
+        Vector<String> paths;
+        {
+            PackArchive archive(path);
+            if (!archive.IsValid())
+                return Write(path);
+
+            for (UINT32 i = 0; i < archive.GetNumEntries(); i++)
+            {
+                entries.push_back(archive.GetEntry(i));
+                paths.push_back(archive.GetEntryPath(archive.GetEntry(i)));
+            }
+        }
+
+        FileDataStream stream(path, DataStream::READ | DataStream::WRITE);
+        if (!stream.IsOpen())
+            return false;
+
+        stream.Seek(stream.Size());
+        return WriteEntries(stream, entries, paths);
+    }
+
+    bool PackArchiveBuilder::WriteEntries(FileDataStream& stream, Vector<PackEntry>& entries, Vector<String>& paths)
+    {
+        Vector<PackEntry> newEntries;
+        Vector<String> newPaths;
+
+        for (auto& pending : _pending)
+        {
+            if (!pending.SourceFile.empty())
+            {
+                FileDataStream source(pending.SourceFile, DataStream::READ, 0);
+                if (!source.IsOpen())
+                {
+                    TE_DEBUG("Unable to read pack archive source file: " + pending.SourceFile);
+                    return false;
+                }
+
+                source.ReadAll(pending.Data);
+            }
+
+            PackEntry entry = {};
+            entry.Id = pending.Id;
+            entry.UncompressedSize = pending.Data.size();
+            entry.PathHash = PackArchive::HashPath(pending.Path);
+            entry.PathLength = (UINT32)pending.Path.size();
+            entry.Compression = PackCompression::None;
+
+            if (!WritePadding(stream, _alignment))
+                return ReportWriteError(stream);
+
+            entry.Offset = stream.Tell();
+
+            if (pending.Compress && !pending.Data.empty())
+            {
+                SPtr<MemoryDataStream> compressed = te_shared_ptr_new<MemoryDataStream>((size_t)0);
+                {
+                    CompressedDataStream compressor(compressed, DataStream::WRITE, COMPRESSION_BLOCK_SIZE);
+                    compressor.Write(pending.Data.data(), pending.Data.size());
+                }
+
+                if (compressed->Size() <= pending.Data.size() * MIN_COMPRESSION_RATIO)
+                {
+                    entry.Compression = PackCompression::Block;
+                    entry.Size = compressed->Size();
+
+                    if (stream.Write(compressed->GetPtr(), compressed->Size()) != compressed->Size())
+                        return ReportWriteError(stream);
+                }
+            }
+
+            if (entry.Compression == PackCompression::None)
+            {
+                entry.Size = pending.Data.size();
+
+                if (stream.Write(pending.Data.data(), pending.Data.size()) != pending.Data.size())
+                    return ReportWriteError(stream);
+            }
+
+            // Release the data early, archives can be much larger than memory
+            pending.Data = Vector<UINT8>();
+
+            newEntries.push_back(entry);
+            newPaths.push_back(pending.Path);
+        }
+
+        _pending.clear();
+
+        // New entries replace existing entries with the same UUID or path, later additions win over earlier ones
+        UnorderedSet<UUID> ids;
+        Map<String, UINT32> usedPaths;
+        Vector<PackEntry> finalEntries;
+        Vector<String> finalPaths;
+
+        auto keepEntry = [&](const PackEntry& entry, const String& path)
+        {
+            if (ids.find(entry.Id) != ids.end() || usedPaths.find(path) != usedPaths.end())
+                return;
+
+            ids.insert(entry.Id);
+            usedPaths[path] = (UINT32)finalEntries.size();
+            finalEntries.push_back(entry);
+            finalPaths.push_back(path);
+        };
+
+        for (size_t i = newEntries.size(); i > 0; i--)
+            keepEntry(newEntries[i - 1], newPaths[i - 1]);
+
+        for (size_t i = 0; i < entries.size(); i++)
+            keepEntry(entries[i], paths[i]);
+
+        entries = std::move(finalEntries);
+        paths = std::move(finalPaths);
+
+        PackHeader header = {};
+        header.Magic = PackArchive::MAGIC;
+        header.Version = PackArchive::VERSION;
+        header.NumEntries = (UINT32)entries.size();
+
+        // Keep the load factor at or below one half so probes stay short
+        header.IndexCapacity = 16;
+        while (header.IndexCapacity < entries.size() * 2)
+            header.IndexCapacity *= 2;
+
+        // Strings
+        String strings;
+        for (UINT32 i = 0; i < (UINT32)entries.size(); i++)
+        {
+            entries[i].PathOffset = (UINT32)strings.size();
+            entries[i].PathLength = (UINT32)paths[i].size();
+            strings += paths[i];
+        }
+
+        header.StringsOffset = stream.Tell();
+        header.StringsSize = strings.size();
+        if (stream.Write(strings.data(), strings.size()) != strings.size())
+            return ReportWriteError(stream);
+
+        // Entries
+        if (!WritePadding(stream, alignof(PackEntry)))
+            return ReportWriteError(stream);
+
+        header.EntriesOffset = stream.Tell();
+        if (stream.Write(entries.data(), entries.size() * sizeof(PackEntry)) != entries.size() * sizeof(PackEntry))
+            return ReportWriteError(stream);
+
+        // Indices
+        Vector<UINT64> uuidHashes;
+        Vector<UINT64> pathHashes;
+        for (auto& entry : entries)
+        {
+            uuidHashes.push_back(PackArchive::HashUUID(entry.Id));
+            pathHashes.push_back(entry.PathHash);
+        }
+
+        const Vector<UINT32> uuidIndex = BuildIndex(uuidHashes, header.IndexCapacity);
+        const Vector<UINT32> pathIndex = BuildIndex(pathHashes, header.IndexCapacity);
+
+        header.UUIDIndexOffset = stream.Tell();
+        if (stream.Write(uuidIndex.data(), uuidIndex.size() * sizeof(UINT32)) != uuidIndex.size() * sizeof(UINT32))
+            return ReportWriteError(stream);
+
+        header.PathIndexOffset = stream.Tell();
+        if (stream.Write(pathIndex.data(), pathIndex.size() * sizeof(UINT32)) != pathIndex.size() * sizeof(UINT32))
+            return ReportWriteError(stream);
+
+        // Everything the header points to is handed to the OS before the header, so a build that is interrupted or
+        // fails leaves the previous header in place. This isn't synced to disk, it doesn't protect against power loss.
+        if (!stream.Flush())
+            return ReportWriteError(stream);
+
+        stream.Seek(0);
+        if (stream.Write(&header, sizeof(header)) != sizeof(header) || !stream.Flush())
+            return ReportWriteError(stream);
+
+        stream.Close();
+        return true;
+    }
+
+    bool PackArchiveBuilder::WritePadding(FileDataStream& stream, size_t alignment)
+    {
+        static const UINT8 zeroes[256] = {};
+
+        size_t padding = (alignment - (stream.Tell() % alignment)) % alignment;
+        while (padding > 0)
+        {
+            const size_t size = std::min(padding, sizeof(zeroes));
+            if (stream.Write(zeroes, size) != size)
+                return false;
+
+            padding -= size;
+        }
+
+        return true;
+    }
+}
\ No newline at end of file
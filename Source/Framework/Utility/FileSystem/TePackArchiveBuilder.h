@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "FileSystem/TePackArchive.h"
+
+namespace te
+{
+    class FileDataStream;
+
+    /**
+     * Creates pack archives (see PackArchive). Assets are collected with Add() and AddFile(), and written out with
+     * Write() or appended to an existing archive with Append().
+     */
+    class TE_UTILITY_EXPORT PackArchiveBuilder
+    {
+    public:
+        /** Default alignment of asset data in the archive, in bytes. */
+        static constexpr UINT32 DEFAULT_ALIGNMENT = 16;
+
+        /**
+         * @param[in]	alignment	Alignment of asset data in the archive, in bytes. Data of fixed layout serialized
+         *							types can only be read in place if it is at least 16 byte aligned.
+         */
+        PackArchiveBuilder(UINT32 alignment = DEFAULT_ALIGNMENT);
+
+        /**
+         * Adds an asset from memory. The data is copied. An asset added with the same UUID or path as an asset already
+         * in the archive replaces it.
+         *
+         * @param[in]	uuid		Identifier of the asset.
+         * @param[in]	path		Path the asset can be looked up with.
+         * @param[in]	data		Asset data.
+         * @param[in]	size		Size of @p data in bytes.
+         * @param[in]	compress	If true the data is compressed, unless it doesn't compress well.
+         */
+        void Add(const UUID& uuid, const String& path, const void* data, size_t size, bool compress = false);
+
+        /** Same as Add(), except the data is read from @p sourceFile when the archive is written. */
+        void AddFile(const UUID& uuid, const String& path, const String& sourceFile, bool compress = false);
+
+        /** Returns the number of assets added since the last write. */
+        UINT32 GetNumPending() const { return (UINT32)_pending.size(); }
+
+        /**
+         * Writes a new archive with all added assets. Overwrites any existing file, which therefore must not be opened
+         * by a PackArchive at the same time.
+         */
+        bool Write(const String& path);
+
+        /**
+         * Adds all added assets to an existing archive, or creates a new one if it doesn't exist. Existing asset data
+         * isn't touched, new data and a new index are written at the end of the file and the header is updated last,
+         * so the archive stays valid if appending is interrupted. Data of replaced assets is left in the file as
+         * unused space, use Write() to compact the archive.
+         */
+        bool Append(const String& path);
+
+    private:
+        struct PendingEntry
+        {
+            UUID Id;
+            String Path;
+            String SourceFile;
+            Vector<UINT8> Data;
+            bool Compress;
+        };
+
+        /** Writes the pending entries and the index, starting at the current end of @p stream. */
+        bool WriteEntries(FileDataStream& stream, Vector<PackEntry>& entries, Vector<String>& paths);
+
+        /** Inserts padding until the stream position is aligned to @p alignment. Returns false if writing failed. */
+        static bool WritePadding(FileDataStream& stream, size_t alignment);
+
+    private:
+        UINT32 _alignment;
+        Vector<PendingEntry> _pending;
+    };
+}
\ No newline at end of file
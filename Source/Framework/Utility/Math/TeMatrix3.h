@@ -280,3 +280,16 @@ namespace te
         float m[3][3];
     };
 }
+
+namespace std
+{
+    /** Hash value generator for Matrix3. */
+    template<>
+    struct hash<te::Matrix3>
+    {
+        size_t operator()(const te::Matrix3& value) const
+        {
+            return (size_t)te::HashFloats<9>(value[0]);
+        }
+    };
+}
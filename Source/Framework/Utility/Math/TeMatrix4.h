@@ -496,3 +496,16 @@ namespace te
         float m[4][4];
     };
 }
+
+namespace std
+{
+    /** Hash value generator for Matrix4. */
+    template<>
+    struct hash<te::Matrix4>
+    {
+        size_t operator()(const te::Matrix4& value) const
+        {
+            return (size_t)te::HashFloats<16>(&value[0].x);
+        }
+    };
+}
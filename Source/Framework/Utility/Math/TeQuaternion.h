@@ -390,5 +390,15 @@ namespace std
                 std::numeric_limits<float>::infinity());
         }
     };
+
+    /** Hash value generator for Quaternion. */
+    template<>
+    struct hash<te::Quaternion>
+    {
+        size_t operator()(const te::Quaternion& value) const
+        {
+            return (size_t)te::HashFloats<4>(&value.x);
+        }
+    };
 }
 /** @endcond */
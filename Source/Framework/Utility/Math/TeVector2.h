@@ -352,4 +352,17 @@ namespace te
         static const Vector2 UNIT_X;
         static const Vector2 UNIT_Y;
     };
+}
+
+namespace std
+{
+    /** Hash value generator for Vector2. */
+    template<>
+    struct hash<te::Vector2>
+    {
+        size_t operator()(const te::Vector2& value) const
+        {
+            return (size_t)te::HashFloats<2>(&value.x);
+        }
+    };
 }
\ No newline at end of file
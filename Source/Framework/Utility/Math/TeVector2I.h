@@ -196,3 +196,16 @@ namespace te
         static const Vector2I ZERO;
     };
 }
+
+namespace std
+{
+    /** Hash value generator for Vector2I. */
+    template<>
+    struct hash<te::Vector2I>
+    {
+        size_t operator()(const te::Vector2I& value) const
+        {
+            return (size_t)te::HashBytes(&value.x, sizeof(te::INT32) * 2);
+        }
+    };
+}
@@ -423,5 +423,15 @@ namespace std
                 std::numeric_limits<float>::infinity());
         }
     };
+
+    /** Hash value generator for Vector3. */
+    template<>
+    struct hash<te::Vector3>
+    {
+        size_t operator()(const te::Vector3& value) const
+        {
+            return (size_t)te::HashFloats<3>(&value.x);
+        }
+    };
 }
 /** @endcond */
\ No newline at end of file
@@ -55,3 +55,16 @@ namespace te
         }
     };
 }
+
+namespace std
+{
+    /** Hash value generator for Vector3I. */
+    template<>
+    struct hash<te::Vector3I>
+    {
+        size_t operator()(const te::Vector3I& value) const
+        {
+            return (size_t)te::HashBytes(&value.x, sizeof(te::INT32) * 3);
+        }
+    };
+}
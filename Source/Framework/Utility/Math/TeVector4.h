@@ -261,3 +261,16 @@ namespace te
     };
 }
 
+namespace std
+{
+    /** Hash value generator for Vector4. */
+    template<>
+    struct hash<te::Vector4>
+    {
+        size_t operator()(const te::Vector4& value) const
+        {
+            return (size_t)te::HashFloats<4>(&value.x);
+        }
+    };
+}
+
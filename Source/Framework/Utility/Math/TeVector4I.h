@@ -58,3 +58,16 @@ namespace te
         }
     };
 }
+
+namespace std
+{
+    /** Hash value generator for Vector4I. */
+    template<>
+    struct hash<te::Vector4I>
+    {
+        size_t operator()(const te::Vector4I& value) const
+        {
+            return (size_t)te::HashBytes(&value.x, sizeof(te::INT32) * 4);
+        }
+    };
+}
@@ -40,6 +40,8 @@ namespace te
     class Time;
     class Timer;
 
+    class StringId;
+
     class AABox;
     class Bounds;
     class Line2;
@@ -88,6 +90,17 @@ namespace te
     class Event<ReturnType(Args...) >;
 
     class DataStream;
+    class MemoryDataStream;
+    class FileDataStream;
+    class MappedFileDataStream;
+    class CompressedDataStream;
+    class PackArchive;
+    class PackArchiveBuilder;
+    class IORequest;
+    class IOScheduler;
+    struct PackEntry;
+    class BinaryWriter;
+    class BinaryReader;
 
     template<typename Enum, typename Storage>
     class Flags;
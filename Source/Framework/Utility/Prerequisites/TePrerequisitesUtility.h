@@ -80,4 +80,6 @@
 
 #include "Utility/TeUtility.h"
 
-#include "Utility/TeFlags.h"
\ No newline at end of file
+#include "Utility/TeFlags.h"
+
+#include "Error/TeLog.h"
\ No newline at end of file
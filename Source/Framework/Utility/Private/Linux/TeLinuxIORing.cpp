@@ -0,0 +1,200 @@
+#include "Private/Linux/TeLinuxIORing.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+
+namespace te
+{
+    IORing::~IORing()
+    {
+        if (_entries != nullptr)
+            munmap(_entries, _entriesSize);
+
+        if (_completeRing != nullptr && _completeRing != _submitRing)
+            munmap(_completeRing, _completeRingSize);
+
+        if (_submitRing != nullptr)
+            munmap(_submitRing, _submitRingSize);
+
+        if (_ringFd >= 0)
+            close(_ringFd);
+    }
+
+    bool IORing::Initialize(UINT32 depth)
+    {
+#ifdef __NR_io_uring_setup
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        _ringFd = (INT32)syscall(__NR_io_uring_setup, depth, &params);
+        if (_ringFd < 0)
+            return false;
+
+        _submitRingSize = params.sq_off.array + params.sq_entries * sizeof(UINT32);
+        _completeRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap)
+            _submitRingSize = _completeRingSize = std::max(_submitRingSize, _completeRingSize);
+
+        _submitRing = mmap(nullptr, _submitRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd,
+            IORING_OFF_SQ_RING);
+
+        if (_submitRing == MAP_FAILED)
+        {
+            _submitRing = nullptr;
+            return false;
+        }
+
+        if (singleMap)
+            _completeRing = _submitRing;
+        else
+        {
+            _completeRing = mmap(nullptr, _completeRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd,
+                IORING_OFF_CQ_RING);
+
+            if (_completeRing == MAP_FAILED)
+            {
+                _completeRing = nullptr;
+                return false;
+            }
+        }
+
+        _entriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        void* entries = mmap(nullptr, _entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd,
+            IORING_OFF_SQES);
+
+        if (entries == MAP_FAILED)
+            return false;
+
+        _entries = (struct io_uring_sqe*)entries;
+
+        UINT8* submitRing = (UINT8*)_submitRing;
+        _submitHead = (UINT32*)(submitRing + params.sq_off.head);
+        _submitTail = (UINT32*)(submitRing + params.sq_off.tail);
+        _submitMask = *(UINT32*)(submitRing + params.sq_off.ring_mask);
+        _numEntries = *(UINT32*)(submitRing + params.sq_off.ring_entries);
+        _submitArray = (UINT32*)(submitRing + params.sq_off.array);
+
+        UINT8* completeRing = (UINT8*)_completeRing;
+        _completeHead = (UINT32*)(completeRing + params.cq_off.head);
+        _completeTail = (UINT32*)(completeRing + params.cq_off.tail);
+        _completeMask = *(UINT32*)(completeRing + params.cq_off.ring_mask);
+        _completions = (struct io_uring_cqe*)(completeRing + params.cq_off.cqes);
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    struct io_uring_sqe* IORing::GetEntry()
+    {
+        const UINT32 head = __atomic_load_n(_submitHead, __ATOMIC_ACQUIRE);
+        const UINT32 tail = *_submitTail + _numQueued;
+
+        if (tail - head >= _numEntries)
+            return nullptr;
+
+        const UINT32 idx = tail & _submitMask;
+        _submitArray[idx] = idx;
+        _numQueued++;
+
+        struct io_uring_sqe* entry = &_entries[idx];
+        memset(entry, 0, sizeof(*entry));
+
+        return entry;
+    }
+
+    bool IORing::QueueRead(INT32 fileDesc, struct iovec* buffer, UINT64 offset, UINT64 userData)
+    {
+        struct io_uring_sqe* entry = GetEntry();
+        if (entry == nullptr)
+            return false;
+
+        entry->opcode = IORING_OP_READV;
+        entry->fd = fileDesc;
+        entry->addr = (UINT64)buffer;
+        entry->len = 1;
+        entry->off = offset;
+        entry->user_data = userData;
+
+        return true;
+    }
+
+    bool IORing::QueuePoll(INT32 fileDesc, UINT64 userData)
+    {
+        struct io_uring_sqe* entry = GetEntry();
+        if (entry == nullptr)
+            return false;
+
+        entry->opcode = IORING_OP_POLL_ADD;
+        entry->fd = fileDesc;
+        entry->poll_events = POLLIN;
+        entry->user_data = userData;
+
+        return true;
+    }
+
+    INT32 IORing::Submit(UINT32 minComplete)
+    {
+        // Make the entries visible to the kernel before it sees the new tail
+        __atomic_store_n(_submitTail, *_submitTail + _numQueued, __ATOMIC_RELEASE);
+        _numUnsubmitted += _numQueued;
+        _numQueued = 0;
+
+        const UINT32 flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+        // Kernel never submits more entries than are pending, so retrying after an interruption is safe
+        long result;
+        do
+        {
+            result = syscall(__NR_io_uring_enter, _ringFd, _numUnsubmitted, minComplete, flags, nullptr, 0);
+        } while (result < 0 && errno == EINTR);
+
+        if (result < 0)
+            return -errno;
+
+        // Entries the kernel didn't consume stay in the queue, after the tail it already knows about
+        _numUnsubmitted -= std::min((UINT32)result, _numUnsubmitted);
+        return 0;
+    }
+
+    bool IORing::PopUnsubmitted(UINT64& userData)
+    {
+        if (_numQueued == 0 && _numUnsubmitted == 0)
+            return false;
+
+        const UINT32 tail = *_submitTail + _numQueued - 1;
+        userData = _entries[_submitArray[tail & _submitMask]].user_data;
+
+        // Kernel only consumes entries while in io_uring_enter, so the tail can safely be moved back in between
+        if (_numQueued > 0)
+            _numQueued--;
+        else
+        {
+            __atomic_store_n(_submitTail, tail, __ATOMIC_RELEASE);
+            _numUnsubmitted--;
+        }
+
+        return true;
+    }
+
+    bool IORing::PopCompletion(UINT64& userData, INT32& result)
+    {
+        const UINT32 head = *_completeHead;
+        if (head == __atomic_load_n(_completeTail, __ATOMIC_ACQUIRE))
+            return false;
+
+        const struct io_uring_cqe& completion = _completions[head & _completeMask];
+        userData = completion.user_data;
+        result = completion.res;
+
+        __atomic_store_n(_completeHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+}
\ No newline at end of file
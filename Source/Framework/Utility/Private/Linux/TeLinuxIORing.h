@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+namespace te
+{
+    /**
+     * Minimal wrapper around a Linux io_uring instance, using the raw system calls. Only supports the operations needed
+     * by the IOScheduler.
+     *
+     * @note	Not thread safe, a ring is meant to be owned by a single thread.
+     */
+    class IORing
+    {
+    public:
+        IORing() = default;
+        ~IORing();
+
+        /** Creates the ring. Returns false if io_uring isn't supported, or not allowed, by the kernel. */
+        bool Initialize(UINT32 depth);
+
+        /** Queues a read of @p size bytes at @p offset. Returns false if the submission queue is full. */
+        bool QueueRead(INT32 fileDesc, struct iovec* buffer, UINT64 offset, UINT64 userData);
+
+        /** Queues a one-shot poll for the file becoming readable. Returns false if the submission queue is full. */
+        bool QueuePoll(INT32 fileDesc, UINT64 userData);
+
+        /**
+         * Submits all queued operations to the kernel, and waits until at least @p minComplete operations have
+         * completed. Operations the kernel doesn't accept stay queued and are submitted again by the next call.
+         *
+         * Returns 0 on success, or a negated errno value. -EAGAIN and -EBUSY are transient: the kernel is short on
+         * resources or its completion queue is full, and submitting again after retrieving completions can succeed.
+         */
+        INT32 Submit(UINT32 minComplete);
+
+        /**
+         * Removes the last queued operation the kernel didn't accept yet. Returns false if there are none. Used for
+         * recovering operations after Submit() failed for good.
+         */
+        bool PopUnsubmitted(UINT64& userData);
+
+        /** Retrieves the result of a completed operation. Returns false if there are no completed operations. */
+        bool PopCompletion(UINT64& userData, INT32& result);
+
+    private:
+        /** Returns a free submission queue entry, or null if the queue is full. */
+        struct io_uring_sqe* GetEntry();
+
+    private:
+        INT32 _ringFd = -1;
+        UINT32 _numQueued = 0; /**< Entries filled in but not made visible to the kernel yet. */
+        UINT32 _numUnsubmitted = 0; /**< Entries visible to the kernel but not consumed by it yet. */
+
+        void* _submitRing = nullptr;
+        size_t _submitRingSize = 0;
+        void* _completeRing = nullptr;
+        size_t _completeRingSize = 0;
+        struct io_uring_sqe* _entries = nullptr;
+        size_t _entriesSize = 0;
+
+        UINT32* _submitHead = nullptr;
+        UINT32* _submitTail = nullptr;
+        UINT32 _submitMask = 0;
+        UINT32 _numEntries = 0;
+        UINT32* _submitArray = nullptr;
+
+        UINT32* _completeHead = nullptr;
+        UINT32* _completeTail = nullptr;
+        UINT32 _completeMask = 0;
+        struct io_uring_cqe* _completions = nullptr;
+    };
+}
\ No newline at end of file
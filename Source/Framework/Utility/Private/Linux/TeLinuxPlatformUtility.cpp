@@ -1,5 +1,7 @@
 #include "Utility/TePlatformUtility.h"
 #include <uuid/uuid.h>
+#include <time.h>
+#include <errno.h>
 
 namespace te
 {
@@ -19,4 +21,18 @@ namespace te
             *(UINT32*)&nativeUUID[8],
             *(UINT32*)&nativeUUID[12]);
     }
+
+    void PlatformUtility::SleepMicroseconds(UINT64 microseconds)
+    {
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        UINT64 nanoseconds = (UINT64)deadline.tv_nsec + microseconds * 1000;
+        deadline.tv_sec += (time_t)(nanoseconds / 1000000000);
+        deadline.tv_nsec = (long)(nanoseconds % 1000000000);
+
+        // Absolute deadline so that being interrupted by a signal doesn't extend the total sleep time
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+        { }
+    }
 }
\ No newline at end of file
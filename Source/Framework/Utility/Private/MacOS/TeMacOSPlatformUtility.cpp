@@ -1,6 +1,8 @@
 #include "Utility/TePlatformUtility.h"
 #include <uuid/uuid.h>
 #include <sys/sysctl.h>
+#include <time.h>
+#include <errno.h>
 
 namespace te
 {
@@ -20,4 +22,14 @@ namespace te
             *(UINT32*)&nativeUUID[8],
             *(UINT32*)&nativeUUID[12]);
     }
+
+    void PlatformUtility::SleepMicroseconds(UINT64 microseconds)
+    {
+        timespec remaining;
+        remaining.tv_sec = (time_t)(microseconds / 1000000);
+        remaining.tv_nsec = (long)((microseconds % 1000000) * 1000);
+
+        while (nanosleep(&remaining, &remaining) == -1 && errno == EINTR)
+        { }
+    }
 }
\ No newline at end of file
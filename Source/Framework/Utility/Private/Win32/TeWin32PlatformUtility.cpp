@@ -34,4 +34,27 @@ namespace te
 
         return UUID(data1, data2, data3, data4);
     }
+
+    void PlatformUtility::SleepMicroseconds(UINT64 microseconds)
+    {
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#   define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+        // High resolution timers are only available on Windows 10 1803+, otherwise fall back to a millisecond sleep
+        HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (timer == nullptr)
+        {
+            Sleep((DWORD)(microseconds / 1000));
+            return;
+        }
+
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -(LONGLONG)(microseconds * 10); // Relative time, in 100 nanosecond intervals
+
+        if (SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE))
+            WaitForSingleObject(timer, INFINITE);
+
+        CloseHandle(timer);
+    }
 }
\ No newline at end of file
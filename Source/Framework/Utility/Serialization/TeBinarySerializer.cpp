@@ -0,0 +1,53 @@
+#include "Serialization/TeBinarySerializer.h"
+
+namespace te
+{
+    void BinaryWriter::WriteBytes(const void* data, size_t size)
+    {
+        if (size == 0)
+            return;
+
+        const size_t offset = _data.size();
+        _data.resize(offset + size);
+        memcpy(&_data[offset], data, size);
+    }
+
+    void BinaryWriter::Align(size_t alignment)
+    {
+        const size_t padding = (alignment - (_data.size() % alignment)) % alignment;
+        _data.resize(_data.size() + padding, 0);
+    }
+
+    bool BinaryReader::ReadBytes(void* data, size_t size)
+    {
+        const UINT8* source = Skip(size);
+        if (source == nullptr)
+        {
+            memset(data, 0, size);
+            return false;
+        }
+
+        memcpy(data, source, size);
+        return true;
+    }
+
+    const UINT8* BinaryReader::Skip(size_t size)
+    {
+        if (_failed || size > _size - _position)
+        {
+            _failed = true;
+            return nullptr;
+        }
+
+        const UINT8* data = _data + _position;
+        _position += size;
+
+        return data;
+    }
+
+    void BinaryReader::Align(size_t alignment)
+    {
+        const size_t padding = (alignment - (_position % alignment)) % alignment;
+        Skip(padding);
+    }
+}
\ No newline at end of file
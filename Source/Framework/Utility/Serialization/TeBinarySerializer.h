@@ -0,0 +1,425 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeUUID.h"
+#include "Math/TeVector2.h"
+#include "Math/TeVector2I.h"
+#include "Math/TeVector3.h"
+#include "Math/TeVector3I.h"
+#include "Math/TeVector4.h"
+#include "Math/TeVector4I.h"
+#include "Math/TeQuaternion.h"
+#include "Math/TeMatrix3.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeRadian.h"
+#include "Math/TeDegree.h"
+
+#include <type_traits>
+
+namespace te
+{
+    class BinaryWriter;
+    class BinaryReader;
+
+    static_assert(TE_ENDIAN == TE_ENDIAN_LITTLE, "Binary serialization format is little endian and is read in place, "
+        "big endian platforms need byte swapping to be implemented.");
+
+    /**
+     * Read-only view into a contiguous array of elements, usually pointing directly into the buffer a BinaryReader reads
+     * from. Valid only as long as that buffer is.
+     */
+    template<class T>
+    struct ArrayView
+    {
+        const T* Data = nullptr;
+        UINT32 Size = 0;
+
+        const T* begin() const { return Data; }
+        const T* end() const { return Data + Size; }
+        const T& operator[](UINT32 idx) const { return Data[idx]; }
+        bool Empty() const { return Size == 0; }
+    };
+
+    /**
+     * Describes how a type is written to and read from the binary format. The default implementation handles objects
+     * that describe their own fields, by providing the following members:
+     *
+     * @code
+     * static constexpr UINT32 SERIALIZATION_VERSION = 2;
+     *
+     * template<class Archive>
+     * void Serialize(Archive& archive, UINT32 version)
+     * {
+     *     archive.Field(Position);
+     *     archive.Field(Name);
+     *
+     *     if (version >= 2)
+     *         archive.Field(Scale);
+     * }
+     * @endcode
+     *
+     * The same method is used for writing (Archive is BinaryWriter) and reading (Archive is BinaryReader). Every object
+     * is prefixed by its version and size, so data written by an older version can be read by checking @p version,
+     * and fields appended by a newer version are skipped by older readers.
+     *
+     * Specialize this for types that can't be changed, and set FixedLayout to true for types whose memory layout is
+     * the same as their serialized one (arrays of those are read in place, without copying).
+     */
+    template<class T, class Enable = void>
+    struct SerializableType
+    {
+        static constexpr bool FixedLayout = false;
+
+        static void Write(const T& value, BinaryWriter& writer);
+        static void Read(T& value, BinaryReader& reader);
+    };
+
+    /** Implementation of SerializableType for types that are stored as a plain copy of their memory. */
+    template<class T>
+    struct FixedLayoutSerializableType
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Fixed layout types must be trivially copyable.");
+
+        static constexpr bool FixedLayout = true;
+
+        static void Write(const T& value, BinaryWriter& writer);
+        static void Read(T& value, BinaryReader& reader);
+    };
+
+    /** Arithmetic and enum types. */
+    template<class T>
+    struct SerializableType<T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type>
+        : FixedLayoutSerializableType<T>
+    { };
+
+    template<> struct SerializableType<Vector2> : FixedLayoutSerializableType<Vector2> { };
+    template<> struct SerializableType<Vector2I> : FixedLayoutSerializableType<Vector2I> { };
+    template<> struct SerializableType<Vector3> : FixedLayoutSerializableType<Vector3> { };
+    template<> struct SerializableType<Vector3I> : FixedLayoutSerializableType<Vector3I> { };
+    template<> struct SerializableType<Vector4> : FixedLayoutSerializableType<Vector4> { };
+    template<> struct SerializableType<Vector4I> : FixedLayoutSerializableType<Vector4I> { };
+    template<> struct SerializableType<Quaternion> : FixedLayoutSerializableType<Quaternion> { };
+    template<> struct SerializableType<Matrix3> : FixedLayoutSerializableType<Matrix3> { };
+    template<> struct SerializableType<Matrix4> : FixedLayoutSerializableType<Matrix4> { };
+    template<> struct SerializableType<Radian> : FixedLayoutSerializableType<Radian> { };
+    template<> struct SerializableType<Degree> : FixedLayoutSerializableType<Degree> { };
+    template<> struct SerializableType<UUID> : FixedLayoutSerializableType<UUID> { };
+
+    /**
+     * Writes values in the binary serialization format into a memory buffer. All values are little endian. Arrays of
+     * fixed layout types are aligned to the alignment of their element type, relative to the start of the buffer, so
+     * they can be read in place from any buffer aligned to at least 16 bytes (e.g. a memory mapped file).
+     */
+    class TE_UTILITY_EXPORT BinaryWriter
+    {
+    public:
+        BinaryWriter() = default;
+
+        /** Writes a single value of any serializable type. */
+        template<class T>
+        void Write(const T& value) { SerializableType<T>::Write(value, *this); }
+
+        /** Same as Write(), so objects can use the same Serialize() method for reading and writing. */
+        template<class T>
+        void Field(const T& value) { Write(value); }
+
+        /** Writes an object that provides a Serialize() method, prefixed by its version and size. */
+        template<class T>
+        void WriteObject(const T& value);
+
+        /** Writes an array of elements, prefixed by the number of elements. */
+        template<class T>
+        void WriteArray(const T* data, UINT32 count);
+
+        /** Writes raw bytes. */
+        void WriteBytes(const void* data, size_t size);
+
+        /** Inserts padding so the next write starts at a multiple of @p alignment. */
+        void Align(size_t alignment);
+
+        /** Returns true, objects can use this to detect whether they are being written or read. */
+        static constexpr bool IsWriting() { return true; }
+
+        /** Returns the written data. */
+        const Vector<UINT8>& GetData() const { return _data; }
+
+        /** Moves the written data out of the writer, leaving it empty. */
+        Vector<UINT8> TakeData() { return std::move(_data); }
+
+        /** Returns the number of bytes written so far. */
+        size_t GetSize() const { return _data.size(); }
+
+    private:
+        friend class BinaryReader;
+
+        Vector<UINT8> _data;
+    };
+
+    /**
+     * Reads values in the binary serialization format from a memory buffer, without copying the buffer. Reading past the
+     * end of the buffer, or reading malformed data, marks the reader as failed and leaves values default initialized.
+     */
+    class TE_UTILITY_EXPORT BinaryReader
+    {
+    public:
+        BinaryReader(const UINT8* data, size_t size)
+            : _data(data), _size(size)
+        { }
+
+        /** Reads a single value of any serializable type. */
+        template<class T>
+        void Read(T& value) { SerializableType<T>::Read(value, *this); }
+
+        /** Same as Read(), so objects can use the same Serialize() method for reading and writing. */
+        template<class T>
+        void Field(T& value) { Read(value); }
+
+        /** Reads an object written with BinaryWriter::WriteObject(). */
+        template<class T>
+        void ReadObject(T& value);
+
+        /**
+         * Returns a view of an array written with BinaryWriter::WriteArray(), pointing directly into the source
+         * buffer. Only available for fixed layout types. Returns an empty view on failure, or if the buffer isn't
+         * sufficiently aligned for @p T.
+         */
+        template<class T>
+        ArrayView<T> ReadArrayView();
+
+        /** Reads raw bytes. Returns false if there isn't enough data left. */
+        bool ReadBytes(void* data, size_t size);
+
+        /** Returns a pointer to the next @p size bytes and moves past them, or null if there isn't enough data left. */
+        const UINT8* Skip(size_t size);
+
+        /** Skips the padding inserted by BinaryWriter::Align(). */
+        void Align(size_t alignment);
+
+        /** Returns false, objects can use this to detect whether they are being written or read. */
+        static constexpr bool IsWriting() { return false; }
+
+        /** Returns true if any read failed. */
+        bool HasFailed() const { return _failed; }
+
+        /** Returns the current read position, in bytes from the start of the buffer. */
+        size_t GetPosition() const { return _position; }
+
+        /** Returns the number of bytes left to read. */
+        size_t GetRemaining() const { return _size - _position; }
+
+    private:
+        const UINT8* _data;
+        size_t _size;
+        size_t _position = 0;
+        bool _failed = false;
+    };
+
+    /** Header written in front of every object, see SerializableType. */
+    struct SerializedObjectHeader
+    {
+        UINT32 Version;
+        UINT32 Size; /**< Size of the object data following the header, in bytes. */
+    };
+
+    template<class T, class Enable>
+    void SerializableType<T, Enable>::Write(const T& value, BinaryWriter& writer)
+    {
+        writer.WriteObject(value);
+    }
+
+    template<class T, class Enable>
+    void SerializableType<T, Enable>::Read(T& value, BinaryReader& reader)
+    {
+        reader.ReadObject(value);
+    }
+
+    template<class T>
+    void FixedLayoutSerializableType<T>::Write(const T& value, BinaryWriter& writer)
+    {
+        writer.WriteBytes(&value, sizeof(T));
+    }
+
+    template<class T>
+    void FixedLayoutSerializableType<T>::Read(T& value, BinaryReader& reader)
+    {
+        if (!reader.ReadBytes(&value, sizeof(T)))
+            value = T();
+    }
+
+    /** Strings are stored as a length followed by the characters, without a null terminator. */
+    template<>
+    struct SerializableType<String>
+    {
+        static constexpr bool FixedLayout = false;
+
+        static void Write(const String& value, BinaryWriter& writer)
+        {
+            writer.WriteArray(value.data(), (UINT32)value.size());
+        }
+
+        static void Read(String& value, BinaryReader& reader)
+        {
+            UINT32 size = 0;
+            reader.Read(size);
+
+            const char* data = (const char*)reader.Skip(size);
+            if (data != nullptr)
+                value.assign(data, size);
+            else
+                value.clear();
+        }
+    };
+
+    template<class T, class A>
+    struct SerializableType<std::vector<T, A>>
+    {
+        static constexpr bool FixedLayout = false;
+
+        static void Write(const std::vector<T, A>& value, BinaryWriter& writer)
+        {
+            writer.WriteArray(value.data(), (UINT32)value.size());
+        }
+
+        static void Read(std::vector<T, A>& value, BinaryReader& reader)
+        {
+            value.clear();
+
+            UINT32 size = 0;
+            reader.Read(size);
+
+            if (SerializableType<T>::FixedLayout)
+            {
+                reader.Align(alignof(T));
+
+                const UINT8* data = reader.Skip((size_t)size * sizeof(T));
+                if (data != nullptr && size > 0)
+                {
+                    value.resize(size);
+                    memcpy((void*)value.data(), data, (size_t)size * sizeof(T));
+                }
+
+                return;
+            }
+
+            // Every element needs at least one byte, don't let corrupt data allocate huge amounts of memory
+            if (size > reader.GetRemaining())
+            {
+                reader.Skip(reader.GetRemaining() + 1);
+                return;
+            }
+
+            value.resize(size);
+            for (auto& entry : value)
+                reader.Read(entry);
+        }
+    };
+
+    template<class K, class V, class P, class A>
+    struct SerializableType<std::map<K, V, P, A>>
+    {
+        static constexpr bool FixedLayout = false;
+
+        static void Write(const std::map<K, V, P, A>& value, BinaryWriter& writer)
+        {
+            writer.Write((UINT32)value.size());
+
+            for (auto& entry : value)
+            {
+                writer.Write(entry.first);
+                writer.Write(entry.second);
+            }
+        }
+
+        static void Read(std::map<K, V, P, A>& value, BinaryReader& reader)
+        {
+            value.clear();
+
+            UINT32 size = 0;
+            reader.Read(size);
+
+            for (UINT32 i = 0; i < size && !reader.HasFailed(); i++)
+            {
+                K key;
+                reader.Read(key);
+                reader.Read(value[key]);
+            }
+        }
+    };
+
+    template<class T>
+    void BinaryWriter::WriteObject(const T& value)
+    {
+        const size_t headerOffset = _data.size();
+
+        SerializedObjectHeader header;
+        header.Version = T::SERIALIZATION_VERSION;
+        header.Size = 0;
+        WriteBytes(&header, sizeof(header));
+
+        // Serialize() is shared with reading, so it isn't const
+        const_cast<T&>(value).Serialize(*this, T::SERIALIZATION_VERSION);
+
+        header.Size = (UINT32)(_data.size() - headerOffset - sizeof(header));
+        memcpy(&_data[headerOffset], &header, sizeof(header));
+    }
+
+    template<class T>
+    void BinaryWriter::WriteArray(const T* data, UINT32 count)
+    {
+        Write(count);
+
+        if (SerializableType<T>::FixedLayout)
+        {
+            Align(alignof(T));
+            WriteBytes(data, (size_t)count * sizeof(T));
+        }
+        else
+        {
+            for (UINT32 i = 0; i < count; i++)
+                Write(data[i]);
+        }
+    }
+
+    template<class T>
+    void BinaryReader::ReadObject(T& value)
+    {
+        SerializedObjectHeader header;
+        if (!ReadBytes(&header, sizeof(header)) || header.Size > GetRemaining())
+        {
+            _failed = true;
+            return;
+        }
+
+        const size_t end = _position + header.Size;
+
+        // Limit the object to its own data, so a malformed object can't read the data that follows it
+        const size_t size = _size;
+        _size = end;
+
+        value.Serialize(*this, header.Version);
+
+        // Skip any fields written by a newer version
+        _size = size;
+        _position = end;
+    }
+
+    template<class T>
+    ArrayView<T> BinaryReader::ReadArrayView()
+    {
+        static_assert(SerializableType<T>::FixedLayout, "Only arrays of fixed layout types can be read in place.");
+
+        UINT32 size = 0;
+        Read(size);
+        Align(alignof(T));
+
+        const UINT8* data = Skip((size_t)size * sizeof(T));
+        if (data == nullptr || ((UINT64)data % alignof(T)) != 0)
+            return ArrayView<T>();
+
+        ArrayView<T> view;
+        view.Data = (const T*)data;
+        view.Size = size;
+
+        return view;
+    }
+}
\ No newline at end of file
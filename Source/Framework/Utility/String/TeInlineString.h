@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    /**
+     * String with a fixed capacity, stored inline instead of on the heap. Meant for short strings built on hot paths,
+     * like file extensions or formatted numbers, where String would allocate once it outgrows its small buffer.
+     *
+     * The string is always null terminated. Appending past the capacity truncates the string and marks it as truncated,
+     * so callers can handle strings that didn't fit.
+     */
+    template <UINT32 Capacity, typename T = char>
+    class InlineString
+    {
+    public:
+        InlineString()
+        {
+            _data[0] = T();
+        }
+
+        InlineString(BasicStringView<T> value)
+            : InlineString()
+        {
+            Append(value);
+        }
+
+        InlineString(const T* value)
+            : InlineString(BasicStringView<T>(value))
+        { }
+
+        /** Appends characters, up to the capacity. */
+        InlineString& Append(BasicStringView<T> value)
+        {
+            UINT32 count = (UINT32)value.size();
+            if (count > Capacity - _size)
+            {
+                count = Capacity - _size;
+                _truncated = true;
+            }
+
+            if (count > 0)
+                memcpy(_data + _size, value.data(), count * sizeof(T));
+
+            _size += count;
+            _data[_size] = T();
+
+            return *this;
+        }
+
+        /** Appends a character, unless the string is full. */
+        InlineString& Append(T value)
+        {
+            if (_size == Capacity)
+            {
+                _truncated = true;
+                return *this;
+            }
+
+            _data[_size++] = value;
+            _data[_size] = T();
+
+            return *this;
+        }
+
+        InlineString& operator+=(BasicStringView<T> value) { return Append(value); }
+        InlineString& operator+=(T value) { return Append(value); }
+
+        /** Removes all characters, and clears the truncated flag. */
+        void Clear()
+        {
+            _size = 0;
+            _data[0] = T();
+            _truncated = false;
+        }
+
+        /** Changes the length of the string, which must not be larger than the current one. */
+        void Truncate(UINT32 size)
+        {
+            _size = size < _size ? size : _size;
+            _data[_size] = T();
+        }
+
+        /** Returns the number of characters, without the null terminator. */
+        UINT32 Size() const { return _size; }
+
+        /** Returns the max number of characters the string can hold. */
+        static constexpr UINT32 GetCapacity() { return Capacity; }
+
+        /** Checks is the string empty. */
+        bool Empty() const { return _size == 0; }
+
+        /** Checks were characters dropped because they didn't fit in the capacity. */
+        bool IsTruncated() const { return _truncated; }
+
+        /** Returns the null terminated characters. */
+        const T* CStr() const { return _data; }
+
+        T* Data() { return _data; }
+        const T* Data() const { return _data; }
+
+        T& operator[](UINT32 index) { return _data[index]; }
+        const T& operator[](UINT32 index) const { return _data[index]; }
+
+        operator BasicStringView<T>() const { return BasicStringView<T>(_data, _size); }
+
+        bool operator==(BasicStringView<T> rhs) const { return BasicStringView<T>(_data, _size) == rhs; }
+        bool operator!=(BasicStringView<T> rhs) const { return !(*this == rhs); }
+
+    private:
+        T _data[Capacity + 1];
+        UINT32 _size = 0;
+        bool _truncated = false;
+    };
+}
\ No newline at end of file
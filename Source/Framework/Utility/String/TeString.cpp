@@ -1,318 +1,388 @@
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "String/TeString.h"
+#include "String/TeUnicode.h"
+
+#include <charconv>
 
 namespace te
 {
-    WString ToWString(const String& source)
+    namespace
+    {
+        bool IsSpace(char c)
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        /** Formats a value with the standard stream, for formatting flags the other paths don't handle. */
+        template <typename C, typename T>
+        BasicString<C> FormatWithStream(T val, unsigned short precision, unsigned short width, char fill,
+            std::ios::fmtflags flags)
+        {
+            BasicStringStream<C> stream;
+            stream.precision(precision);
+            stream.width(width);
+            stream.fill(fill);
+            if (flags)
+                stream.setf(flags);
+            stream << val;
+            return stream.str();
+        }
+
+        /** Right aligns @p length characters from @p source within @p width characters, like streams do by default. */
+        template <typename C>
+        BasicString<C> Pad(const char* source, UINT32 length, unsigned short width, char fill)
+        {
+            UINT32 padding = width > length ? width - length : 0;
+
+            BasicString<C> output;
+            output.reserve(length + padding);
+            output.append(padding, (C)fill);
+            output.append(source, source + length);
+            return output;
+        }
+
+        template <typename C, typename T>
+        BasicString<C> FormatInteger(T val, unsigned short width, char fill, std::ios::fmtflags flags)
+        {
+            if (flags)
+                return FormatWithStream<C>(val, 6, width, fill, flags);
+
+            char buffer[NUMBER_BUFFER_SIZE];
+            return Pad<C>(buffer, FormatNumber(buffer, NUMBER_BUFFER_SIZE, val), width, fill);
+        }
+
+        /** Same output as streams without formatting flags, which format as printf's %g. */
+        template <typename C, typename T>
+        BasicString<C> FormatFloat(T val, unsigned short precision, unsigned short width, char fill,
+            std::ios::fmtflags flags)
+        {
+            if (!flags)
+            {
+                char buffer[64];
+                std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), val,
+                    std::chars_format::general, precision);
+
+                if (result.ec == std::errc())
+                    return Pad<C>(buffer, (UINT32)(result.ptr - buffer), width, fill);
+            }
+
+            return FormatWithStream<C>(val, precision, width, fill, flags);
+        }
+
+        template <typename T>
+        UINT32 FormatNumber(char* buffer, UINT32 size, T val)
+        {
+            std::to_chars_result result = std::to_chars(buffer, buffer + size, val);
+            return result.ec == std::errc() ? (UINT32)(result.ptr - buffer) : 0;
+        }
+
+        template <typename T>
+        const char* ParseNumber(const char* first, const char* last, T& val)
+        {
+            while (first < last && IsSpace(*first))
+                first++;
+
+            // Unlike streams, from_chars doesn't accept a leading plus
+            if (last - first > 1 && first[0] == '+' && first[1] != '-' && first[1] != '+')
+                first++;
+
+            T parsed;
+            std::from_chars_result result = std::from_chars(first, last, parsed);
+            if (result.ec != std::errc())
+                return nullptr;
+
+            val = parsed;
+            return result.ptr;
+        }
+
+        /**
+         * Parses a number from a wide string, narrowed into a stack buffer unless it is long. If @p wholeString is
+         * true, only succeeds if the number is the last thing in the string.
+         */
+        template <typename T>
+        bool ParseNumber(WStringView source, T& val, bool wholeString = false)
+        {
+            char stackBuffer[64];
+            String heapBuffer;
+
+            char* buffer = stackBuffer;
+            if (source.size() > sizeof(stackBuffer))
+            {
+                heapBuffer.resize(source.size());
+                buffer = &heapBuffer[0];
+            }
+
+            // Characters that can't be part of a number are replaced by one that can't either
+            for (size_t i = 0; i < source.size(); i++)
+                buffer[i] = (UINT32)source[i] < 128 ? (char)source[i] : '?';
+
+            const char* last = buffer + source.size();
+            const char* end = ParseNumber(buffer, last, val);
+            return end != nullptr && (!wholeString || end == last);
+        }
+    }
+
+    WString ToWString(StringView source)
     {
-        return WString(source.begin(), source.end());
+        return UTF8::ToWide(source);
     }
 
     WString ToWString(const char* source)
     {
-        return ToWString(String(source));
+        return UTF8::ToWide(source);
     }
 
     WString ToWString(float val, unsigned short precision,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.precision(precision);
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatFloat<wchar_t>(val, precision, width, fill, flags);
     }
 
     WString ToWString(double val, unsigned short precision,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.precision(precision);
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatFloat<wchar_t>(val, precision, width, fill, flags);
     }
 
     WString ToWString(int val,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<wchar_t>(val, width, fill, flags);
     }
 
     WString ToWString(unsigned int val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<wchar_t>(val, width, fill, flags);
     }
 
     WString ToWString(INT64 val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<wchar_t>(val, width, fill, flags);
     }
 
     WString ToWString(UINT64 val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<wchar_t>(val, width, fill, flags);
     }
 
     WString ToWString(char val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.width(width);
-        stream.fill(fill);
         if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+            return FormatWithStream<wchar_t>(val, 6, width, fill, flags);
+
+        return Pad<wchar_t>(&val, 1, width, fill);
     }
 
     WString ToWString(wchar_t val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        WStringStream stream;
-        stream.width(width);
-        stream.fill(fill);
         if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+            return FormatWithStream<wchar_t>(val, 6, width, fill, flags);
+
+        WString output = Pad<wchar_t>(nullptr, 0, width > 0 ? width - 1 : 0, fill);
+        output.push_back(val);
+        return output;
     }
 
-    String ToString(const WString& source)
+    String ToString(WStringView source)
     {
-        return String(source.begin(), source.end());
+        return UTF8::FromWide(source);
     }
 
     String ToString(const wchar_t* source)
     {
-        return ToString(WString(source));
+        return UTF8::FromWide(source);
     }
 
     String ToString(float val, unsigned short precision,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        StringStream stream;
-        stream.precision(precision);
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatFloat<char>(val, precision, width, fill, flags);
     }
 
     String ToString(double val, unsigned short precision,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        StringStream stream;
-        stream.precision(precision);
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatFloat<char>(val, precision, width, fill, flags);
     }
 
     String ToString(int val,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        StringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<char>(val, width, fill, flags);
     }
 
     String ToString(unsigned int val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        StringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<char>(val, width, fill, flags);
     }
 
     String ToString(INT64 val,
         unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        StringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<char>(val, width, fill, flags);
     }
 
     String ToString(UINT64 val, unsigned short width, char fill, std::ios::fmtflags flags)
     {
-        StringStream stream;
-        stream.width(width);
-        stream.fill(fill);
-        if (flags)
-            stream.setf(flags);
-        stream << val;
-        return stream.str();
+        return FormatInteger<char>(val, width, fill, flags);
     }
 
-    float ParseFloat(const String& val, float defaultValue)
+    float ParseFloat(StringView val, float defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        StringStream str(val);
         float ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val.data(), val.data() + val.size(), ret);
         return ret;
     }
 
-    INT32 ParseINT32(const String& val, INT32 defaultValue)
+    INT32 ParseINT32(StringView val, INT32 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        StringStream str(val);
         INT32 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val.data(), val.data() + val.size(), ret);
         return ret;
     }
 
-    UINT32 ParseUINT32(const String& val, UINT32 defaultValue)
+    UINT32 ParseUINT32(StringView val, UINT32 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        StringStream str(val);
         UINT32 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val.data(), val.data() + val.size(), ret);
         return ret;
     }
 
-    INT64 ParseINT64(const String& val, INT64 defaultValue)
+    INT64 ParseINT64(StringView val, INT64 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        StringStream str(val);
         INT64 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val.data(), val.data() + val.size(), ret);
         return ret;
     }
 
-    UINT64 ParseUINT64(const String& val, UINT64 defaultValue)
+    UINT64 ParseUINT64(StringView val, UINT64 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        StringStream str(val);
         UINT64 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val.data(), val.data() + val.size(), ret);
         return ret;
     }
 
-    bool IsNumber(const String& val)
+    bool IsNumber(StringView val)
     {
-        StringStream str(val);
         float tst;
-        str >> tst;
-        return !str.fail() && str.eof();
+        const char* last = val.data() + val.size();
+        return ParseNumber(val.data(), last, tst) == last;
     }
 
-    float ParseFloat(const WString& val, float defaultValue)
+    float ParseFloat(WStringView val, float defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        WStringStream str(val);
         float ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val, ret);
         return ret;
     }
 
-    INT32 ParseINT32(const WString& val, INT32 defaultValue)
+    INT32 ParseINT32(WStringView val, INT32 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        WStringStream str(val);
         INT32 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val, ret);
         return ret;
     }
 
-    UINT32 ParseUINT32(const WString& val, UINT32 defaultValue)
+    UINT32 ParseUINT32(WStringView val, UINT32 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        WStringStream str(val);
         UINT32 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val, ret);
         return ret;
     }
 
-    INT64 ParseINT64(const WString& val, INT64 defaultValue)
+    INT64 ParseINT64(WStringView val, INT64 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        WStringStream str(val);
         INT64 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val, ret);
         return ret;
     }
 
-    UINT64 ParseUINT64(const WString& val, UINT64 defaultValue)
+    UINT64 ParseUINT64(WStringView val, UINT64 defaultValue)
     {
-        // Use istringstream for direct correspondence with toString
-        WStringStream str(val);
         UINT64 ret = defaultValue;
-        str >> ret;
-
+        ParseNumber(val, ret);
         return ret;
     }
 
-    bool IsNumber(const WString& val)
+    bool IsNumber(WStringView val)
     {
-        WStringStream str(val);
         float tst;
-        str >> tst;
-        return !str.fail() && str.eof();
+        return ParseNumber(val, tst, true);
+    }
+
+    UINT32 FormatNumber(char* buffer, UINT32 size, float val)
+    {
+        return FormatNumber<float>(buffer, size, val);
+    }
+
+    UINT32 FormatNumber(char* buffer, UINT32 size, double val)
+    {
+        return FormatNumber<double>(buffer, size, val);
+    }
+
+    UINT32 FormatNumber(char* buffer, UINT32 size, INT32 val)
+    {
+        return FormatNumber<INT32>(buffer, size, val);
+    }
+
+    UINT32 FormatNumber(char* buffer, UINT32 size, UINT32 val)
+    {
+        return FormatNumber<UINT32>(buffer, size, val);
     }
 
-    Vector<String> Split(const String& s, char delimiter)
+    UINT32 FormatNumber(char* buffer, UINT32 size, INT64 val)
+    {
+        return FormatNumber<INT64>(buffer, size, val);
+    }
+
+    UINT32 FormatNumber(char* buffer, UINT32 size, UINT64 val)
+    {
+        return FormatNumber<UINT64>(buffer, size, val);
+    }
+
+    const char* ParseNumber(const char* first, const char* last, float& val)
+    {
+        return ParseNumber<float>(first, last, val);
+    }
+
+    const char* ParseNumber(const char* first, const char* last, double& val)
+    {
+        return ParseNumber<double>(first, last, val);
+    }
+
+    const char* ParseNumber(const char* first, const char* last, INT32& val)
+    {
+        return ParseNumber<INT32>(first, last, val);
+    }
+
+    const char* ParseNumber(const char* first, const char* last, UINT32& val)
+    {
+        return ParseNumber<UINT32>(first, last, val);
+    }
+
+    const char* ParseNumber(const char* first, const char* last, INT64& val)
+    {
+        return ParseNumber<INT64>(first, last, val);
+    }
+
+    const char* ParseNumber(const char* first, const char* last, UINT64& val)
+    {
+        return ParseNumber<UINT64>(first, last, val);
+    }
+
+    Vector<String> Split(StringView s, char delimiter)
     {
         Vector<String> tokens;
-        String token;
-        IStringStream tokenStream(s);
 
-        while (std::getline(tokenStream, token, delimiter))
+        size_t start = 0;
+        while (start < s.size())
         {
-            tokens.push_back(token);
+            size_t end = s.find(delimiter, start);
+            if (end == StringView::npos)
+                end = s.size();
+
+            tokens.push_back(String(s.substr(start, end - start)));
+            start = end + 1;
         }
 
         return tokens;
@@ -4,6 +4,7 @@
 #include "Prerequisites/TePlatformDefines.h"
 #include "Prerequisites/TeTypes.h"
 #include <string>
+#include <string_view>
 #include <sstream>
 
 namespace te
@@ -45,14 +46,30 @@ namespace te
     /** \brief Wide string stream used for primarily for constructing UTF-32 strings. */
     typedef BasicStringStream<char32_t> U32StringStream;
 
+    /** \brief Non-owning view of a string, or of part of one. */
+    template <typename T>
+    using BasicStringView = std::basic_string_view<T, std::char_traits<T>>;
+
+    /** \brief View of a narrow string, see String. */
+    typedef BasicStringView<char> StringView;
+
+    /** \brief View of a wide string, see WString. */
+    typedef BasicStringView<wchar_t> WStringView;
+
+    /** \brief View of an UTF-16 string. */
+    typedef BasicStringView<char16_t> U16StringView;
+
+    /** \brief View of an UTF-32 string. */
+    typedef BasicStringView<char32_t> U32StringView;
+
     /* ###################################################################
     *  ############# STRING CONVERSION FUNCTIONS #########################
     *  ################################################################ */
 
-    /** \brief Converts a narrow string to a wide string. */
-    TE_UTILITY_EXPORT WString ToWString(const String& source);
+    /** \brief Converts an UTF-8 encoded narrow string to a wide string. */
+    TE_UTILITY_EXPORT WString ToWString(StringView source);
 
-    /**	\brief Converts a narrow string to a wide string. */
+    /**	\brief Converts an UTF-8 encoded narrow string to a wide string. */
     TE_UTILITY_EXPORT WString ToWString(const char* source);
 
     /** \brief Converts a float to a string. */
@@ -96,10 +113,10 @@ namespace te
         unsigned short width = 0, char fill = ' ',
         std::ios::fmtflags flags = std::ios::fmtflags(0));
 
-    /** \brief Converts a wide string to a narrow string. */
-    TE_UTILITY_EXPORT String ToString(const WString& source);
+    /** \brief Converts a wide string to an UTF-8 encoded narrow string. */
+    TE_UTILITY_EXPORT String ToString(WStringView source);
 
-    /**	\brief Converts a wide string to a narrow string. */
+    /**	\brief Converts a wide string to an UTF-8 encoded narrow string. */
     TE_UTILITY_EXPORT String ToString(const wchar_t* source);
 
     /**	\brief Converts a float to a string. */
@@ -132,75 +149,138 @@ namespace te
         std::ios::fmtflags flags = std::ios::fmtflags(0));
 
     /**
-    * \brief Converts a String to a float.
-    * \note	0.0f if the value could not be parsed, otherwise the numeric version of the string.
+    * \brief Converts a string to a float.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT float ParseFloat(const String& val, float defaultValue = 0);
+    TE_UTILITY_EXPORT float ParseFloat(StringView val, float defaultValue = 0);
 
     /**
     * \brief Converts a String to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT INT32 ParseINT32(const String& val, INT32 defaultValue = 0);
+    TE_UTILITY_EXPORT INT32 ParseINT32(StringView val, INT32 defaultValue = 0);
 
     /**
     * \brief Converts a String to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT UINT32 ParseUINT32(const String& val, UINT32 defaultValue = 0);
+    TE_UTILITY_EXPORT UINT32 ParseUINT32(StringView val, UINT32 defaultValue = 0);
 
     /**
     * \brief Converts a String to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT INT64 ParseINT64(const String& val, INT64 defaultValue = 0);
+    TE_UTILITY_EXPORT INT64 ParseINT64(StringView val, INT64 defaultValue = 0);
 
     /**
     * \brief Converts a String to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT UINT64 ParseUINT64(const String& val, UINT64 defaultValue = 0);
+    TE_UTILITY_EXPORT UINT64 ParseUINT64(StringView val, UINT64 defaultValue = 0);
 
     /** \brief Checks the String is a valid number value. */
-    TE_UTILITY_EXPORT bool IsNumber(const String& val);
+    TE_UTILITY_EXPORT bool IsNumber(StringView val);
 
     /**
     * \brief Converts a WString to a float.
-    * \note	0.0f if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT float ParseFloat(const WString& val, float defaultValue = 0);
+    TE_UTILITY_EXPORT float ParseFloat(WStringView val, float defaultValue = 0);
 
     /**
     * \brief Converts a WString to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT INT32 ParseINT32(const WString& val, INT32 defaultValue = 0);
+    TE_UTILITY_EXPORT INT32 ParseINT32(WStringView val, INT32 defaultValue = 0);
 
     /**
     * \brief Converts a WString to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT UINT32 ParseUINT32(const WString& val, UINT32 defaultValue = 0);
+    TE_UTILITY_EXPORT UINT32 ParseUINT32(WStringView val, UINT32 defaultValue = 0);
 
     /**
     * \brief Converts a WString to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT INT64 ParseINT64(const WString& val, INT64 defaultValue = 0);
+    TE_UTILITY_EXPORT INT64 ParseINT64(WStringView val, INT64 defaultValue = 0);
 
     /**
     * \brief Converts a WString to a whole number.
-    * \note	0 if the value could not be parsed, otherwise the numeric version of the string.
+    * \note	@p defaultValue if the value could not be parsed, otherwise the numeric version of the string.
     */
-    TE_UTILITY_EXPORT UINT64 ParseUINT64(const WString& val, UINT64 defaultValue = 0);
+    TE_UTILITY_EXPORT UINT64 ParseUINT64(WStringView val, UINT64 defaultValue = 0);
 
     /**
     * \brief Checks the WString is a valid number value.
     */
-    TE_UTILITY_EXPORT bool IsNumber(const WString& val);
+    TE_UTILITY_EXPORT bool IsNumber(WStringView val);
+
+    /* ###################################################################
+    *  ############# ALLOCATION FREE NUMBER CONVERSION ###################
+    *  ################################################################ */
+
+    /** \brief Size of a buffer large enough for any number written by FormatNumber(). */
+    constexpr UINT32 NUMBER_BUFFER_SIZE = 32;
+
+    /**
+    * \brief Writes a number into @p buffer, without a null terminator. Floating point numbers use the shortest
+    *        representation that parses back to the same value. Never allocates.
+    * \note  Number of characters written, or 0 if the number doesn't fit in @p size characters.
+    */
+    TE_UTILITY_EXPORT UINT32 FormatNumber(char* buffer, UINT32 size, float val);
+
+    /** \copydoc FormatNumber(char*, UINT32, float) */
+    TE_UTILITY_EXPORT UINT32 FormatNumber(char* buffer, UINT32 size, double val);
+
+    /** \copydoc FormatNumber(char*, UINT32, float) */
+    TE_UTILITY_EXPORT UINT32 FormatNumber(char* buffer, UINT32 size, INT32 val);
+
+    /** \copydoc FormatNumber(char*, UINT32, float) */
+    TE_UTILITY_EXPORT UINT32 FormatNumber(char* buffer, UINT32 size, UINT32 val);
+
+    /** \copydoc FormatNumber(char*, UINT32, float) */
+    TE_UTILITY_EXPORT UINT32 FormatNumber(char* buffer, UINT32 size, INT64 val);
+
+    /** \copydoc FormatNumber(char*, UINT32, float) */
+    TE_UTILITY_EXPORT UINT32 FormatNumber(char* buffer, UINT32 size, UINT64 val);
+
+    /**
+    * \brief Appends a number to @p output, formatted as by FormatNumber(). Only allocates if @p output has to grow,
+    *        so reusing the same string for many numbers doesn't allocate once it is large enough.
+    */
+    template <typename T>
+    void AppendNumber(String& output, T val)
+    {
+        char buffer[NUMBER_BUFFER_SIZE];
+        output.append(buffer, FormatNumber(buffer, NUMBER_BUFFER_SIZE, val));
+    }
+
+    /**
+    * \brief Parses a number at the start of [@p first, @p last), after any whitespace. Accepts the same decimal
+    *        formats as the Parse* functions, including an optional '+' sign. Never allocates.
+    * \note  Position after the number, or null if there is no number in range of the type, in which case @p val
+    *        isn't modified.
+    */
+    TE_UTILITY_EXPORT const char* ParseNumber(const char* first, const char* last, float& val);
+
+    /** \copydoc ParseNumber(const char*, const char*, float&) */
+    TE_UTILITY_EXPORT const char* ParseNumber(const char* first, const char* last, double& val);
+
+    /** \copydoc ParseNumber(const char*, const char*, float&) */
+    TE_UTILITY_EXPORT const char* ParseNumber(const char* first, const char* last, INT32& val);
+
+    /** \copydoc ParseNumber(const char*, const char*, float&) */
+    TE_UTILITY_EXPORT const char* ParseNumber(const char* first, const char* last, UINT32& val);
+
+    /** \copydoc ParseNumber(const char*, const char*, float&) */
+    TE_UTILITY_EXPORT const char* ParseNumber(const char* first, const char* last, INT64& val);
+
+    /** \copydoc ParseNumber(const char*, const char*, float&) */
+    TE_UTILITY_EXPORT const char* ParseNumber(const char* first, const char* last, UINT64& val);
 
     /**
     * \brief Split string according to delimiter
     */
-    TE_UTILITY_EXPORT Vector<String> Split(const String& s, char delimiter);
+    TE_UTILITY_EXPORT Vector<String> Split(StringView s, char delimiter);
 }
\ No newline at end of file
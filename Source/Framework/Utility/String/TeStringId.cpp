@@ -0,0 +1,128 @@
+#include "String/TeStringId.h"
+#include "Threading/TeThreading.h"
+
+namespace te
+{
+    namespace
+    {
+        /**
+         * Interned strings, by hash. Strings are copied into large blocks that are only freed at shutdown, so the
+         * returned names stay valid.
+         */
+        class StringIdTable
+        {
+        public:
+            static constexpr UINT32 BLOCK_SIZE = 16 * 1024;
+
+            ~StringIdTable()
+            {
+                for (auto& block : _blocks)
+                    te_free(block);
+            }
+
+            /** Adds a string to the table, if it isn't in it already. */
+            void Intern(UINT64 hash, const char* name, size_t length)
+            {
+                {
+                    ReadLock lock(_mutex);
+
+                    auto found = _names.find(hash);
+                    if (found != _names.end())
+                    {
+                        CheckCollision(found->second, name, length);
+                        return;
+                    }
+                }
+
+                WriteLock lock(_mutex);
+
+                auto result = _names.insert(std::make_pair(hash, (const char*)nullptr));
+                if (result.second)
+                    result.first->second = Store(name, length);
+                else
+                    CheckCollision(result.first->second, name, length);
+            }
+
+            /** Returns the interned string with the provided hash, or null if there is none. */
+            const char* Find(UINT64 hash)
+            {
+                ReadLock lock(_mutex);
+
+                auto found = _names.find(hash);
+                return found != _names.end() ? found->second : nullptr;
+            }
+
+        private:
+            /** Copies a string into the blocks, with a null terminator. */
+            const char* Store(const char* name, size_t length)
+            {
+                char* output;
+                if (length + 1 > BLOCK_SIZE)
+                {
+                    output = (char*)te_allocate((UINT32)length + 1);
+                    _blocks.push_back(output);
+                }
+                else
+                {
+                    if (_blockUsed + length + 1 > BLOCK_SIZE)
+                    {
+                        _blocks.push_back((char*)te_allocate(BLOCK_SIZE));
+                        _block = _blocks.back();
+                        _blockUsed = 0;
+                    }
+
+                    output = _block + _blockUsed;
+                    _blockUsed += (UINT32)length + 1;
+                }
+
+                memcpy(output, name, length);
+                output[length] = '\0';
+                return output;
+            }
+
+            void CheckCollision(const char* interned, const char* name, size_t length)
+            {
+                TE_ASSERT_ERROR(strlen(interned) == length && memcmp(interned, name, length) == 0,
+                    "Strings \"" + String(interned) + "\" and \"" + String(name, length) + "\" have the same StringId");
+            }
+
+            RWMutex _mutex;
+            UnorderedMap<UINT64, const char*> _names;
+            Vector<char*> _blocks;
+            char* _block = nullptr;
+            UINT32 _blockUsed = BLOCK_SIZE;
+        };
+
+        StringIdTable& GetTable()
+        {
+            static StringIdTable table;
+            return table;
+        }
+    }
+
+    const StringId StringId::EMPTY;
+
+    StringId::StringId(const char* name)
+        : StringId(StringView(name))
+    { }
+
+    StringId::StringId(StringView name)
+        : _hash(Hash(name.data(), name.size()))
+    {
+        if (_hash != 0)
+            GetTable().Intern(_hash, name.data(), name.size());
+    }
+
+    StringId::StringId(const String& name)
+        : StringId(StringView(name))
+    { }
+
+    const char* StringId::GetName() const
+    {
+        if (_hash == 0)
+            return "";
+
+        const char* name = GetTable().Find(_hash);
+        return name != nullptr ? name : "";
+    }
+}
\ No newline at end of file
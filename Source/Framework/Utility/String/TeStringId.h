@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    /**
+     * Identifier of a string, compared and hashed as a precomputed 64-bit hash instead of the string itself. Strings
+     * used to create identifiers at runtime are interned in a global table, so the identifier can be converted back to
+     * its string with GetName().
+     *
+     * Identifiers of string literals can be created at compile time with the _sid suffix ("Name"_sid). These cost
+     * nothing at runtime, but aren't interned, so their name is only known if the same string was also used at runtime.
+     *
+     * @note	Thread safe.
+     */
+    class TE_UTILITY_EXPORT StringId
+    {
+    public:
+        /** Initializes the identifier of the empty string. */
+        constexpr StringId() = default;
+
+        /** Interns the string and initializes its identifier. */
+        StringId(const char* name);
+
+        /** @copydoc StringId(const char*) */
+        StringId(StringView name);
+
+        /** @copydoc StringId(const char*) */
+        StringId(const String& name);
+
+        /** Initializes an identifier from a hash returned by Hash() or GetHash(). */
+        static constexpr StringId FromHash(UINT64 hash)
+        {
+            StringId id;
+            id._hash = hash;
+            return id;
+        }
+
+        /** Computes the hash identifiers of the string are compared by (64-bit FNV-1a). The empty string hashes to 0. */
+        static constexpr UINT64 Hash(const char* name, size_t length)
+        {
+            if (length == 0)
+                return 0;
+
+            UINT64 hash = 0xcbf29ce484222325ULL;
+            for (size_t i = 0; i < length; i++)
+            {
+                hash ^= (UINT8)name[i];
+                hash *= 0x100000001b3ULL;
+            }
+
+            return hash;
+        }
+
+        /** Returns the hash of the string. */
+        constexpr UINT64 GetHash() const { return _hash; }
+
+        /**
+         * Returns the interned string. Returns an empty string if the identifier was only created at compile time, or
+         * from a hash.
+         */
+        const char* GetName() const;
+
+        /** Checks is this the identifier of the empty string. */
+        constexpr bool Empty() const { return _hash == 0; }
+
+        constexpr bool operator==(const StringId& rhs) const { return _hash == rhs._hash; }
+        constexpr bool operator!=(const StringId& rhs) const { return _hash != rhs._hash; }
+        constexpr bool operator<(const StringId& rhs) const { return _hash < rhs._hash; }
+
+        static const StringId EMPTY;
+
+    private:
+        UINT64 _hash = 0;
+    };
+
+    /** Creates the identifier of a string literal at compile time, see StringId. */
+    constexpr StringId operator"" _sid(const char* name, size_t length)
+    {
+        return StringId::FromHash(StringId::Hash(name, length));
+    }
+}
+
+namespace std
+{
+    /**	Hash value generator for StringId. */
+    template<>
+    struct hash<te::StringId>
+    {
+        size_t operator()(const te::StringId& value) const
+        {
+            return (size_t)value.GetHash();
+        }
+    };
+}
\ No newline at end of file
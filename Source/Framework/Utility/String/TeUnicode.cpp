@@ -0,0 +1,526 @@
+#include "String/TeUnicode.h"
+
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64)))
+#   define TE_UNICODE_SSE 1
+#   include <smmintrin.h>
+#else
+#   define TE_UNICODE_SSE 0
+#endif
+
+namespace te
+{
+    namespace
+    {
+        /**
+         * Decodes an UTF-8 sequence and advances @p input past it. Returns false if the sequence is invalid, in which
+         * case @p input is advanced past its maximal invalid part.
+         */
+        bool DecodeSequence(const UINT8*& input, const UINT8* end, char32_t& output)
+        {
+            const UINT8 lead = *input++;
+            if (lead < 0x80)
+            {
+                output = lead;
+                return true;
+            }
+
+            // Ranges of the second byte exclude overlong encodings, surrogates and code points above U+10FFFF
+            UINT32 length;
+            UINT8 min = 0x80;
+            UINT8 max = 0xBF;
+            if (lead >= 0xC2 && lead <= 0xDF)
+            {
+                length = 2;
+                output = lead & 0x1F;
+            }
+            else if (lead >= 0xE0 && lead <= 0xEF)
+            {
+                length = 3;
+                output = lead & 0x0F;
+                min = lead == 0xE0 ? 0xA0 : 0x80;
+                max = lead == 0xED ? 0x9F : 0xBF;
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+            {
+                length = 4;
+                output = lead & 0x07;
+                min = lead == 0xF0 ? 0x90 : 0x80;
+                max = lead == 0xF4 ? 0x8F : 0xBF;
+            }
+            else
+            {
+                output = UTF8::REPLACEMENT_CHARACTER;
+                return false;
+            }
+
+            for (UINT32 i = 1; i < length; i++)
+            {
+                if (input == end || *input < min || *input > max)
+                {
+                    output = UTF8::REPLACEMENT_CHARACTER;
+                    return false;
+                }
+
+                output = (output << 6) | (*input++ & 0x3F);
+                min = 0x80;
+                max = 0xBF;
+            }
+
+            return true;
+        }
+
+        /** Decodes an UTF-16 code point, or surrogate pair, and advances @p input past it. */
+        char32_t DecodeUTF16(const char16_t*& input, const char16_t* end)
+        {
+            const char32_t unit = *input++;
+            if (unit < 0xD800 || unit > 0xDFFF)
+                return unit;
+
+            if (unit <= 0xDBFF && input != end && *input >= 0xDC00 && *input <= 0xDFFF)
+                return 0x10000 + ((unit - 0xD800) << 10) + (*input++ - 0xDC00);
+
+            return UTF8::REPLACEMENT_CHARACTER;
+        }
+
+#if TE_UNICODE_SSE
+        /** Returns true if none of the 16 bytes have the high bit set. */
+        bool IsASCII(__m128i input)
+        {
+            return _mm_movemask_epi8(input) == 0;
+        }
+
+        /**
+         * State of the UTF-8 validation, using the lookup algorithm of Keiser and Lemire, "Validating UTF-8 In Less
+         * Than One Instruction Per Byte". Each pair of consecutive bytes is classified by three table lookups, on the
+         * nibbles of the first byte and the high nibble of the second one. The tables contain the errors the pair can
+         * be part of, so their AND is non-zero only for an error. Continuation bytes that are expected to be the third
+         * or fourth byte of a sequence are checked separately.
+         */
+        class UTF8Validator
+        {
+        public:
+            void Process(__m128i input)
+            {
+                if (IsASCII(input))
+                {
+                    // A sequence at the end of the previous block must continue in this one
+                    _error = _mm_or_si128(_error, _prevIncomplete);
+                }
+                else
+                {
+                    const __m128i prev1 = _mm_alignr_epi8(input, _prevInput, 15);
+                    const __m128i errors = GetPairErrors(prev1, input);
+
+                    // Only bytes 2 or 3 positions after 3 and 4 byte leads have the high bit set after subtracting
+                    const __m128i prev2 = _mm_alignr_epi8(input, _prevInput, 14);
+                    const __m128i prev3 = _mm_alignr_epi8(input, _prevInput, 13);
+                    const __m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+                    const __m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+                    const __m128i mustBeContinuation = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte),
+                        _mm_set1_epi8((char)0x80));
+
+                    _error = _mm_or_si128(_error, _mm_xor_si128(mustBeContinuation, errors));
+
+                    // Leads too close to the end of the block to be complete
+                    const __m128i maxValue = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+                    _prevIncomplete = _mm_subs_epu8(input, maxValue);
+                }
+
+                _prevInput = input;
+            }
+
+            bool IsValid() const
+            {
+                const __m128i error = _mm_or_si128(_error, _prevIncomplete);
+                return _mm_testz_si128(error, error) != 0;
+            }
+
+        private:
+            static constexpr UINT8 TOO_SHORT = 1 << 0; // Lead followed by a lead or ASCII
+            static constexpr UINT8 TOO_LONG = 1 << 1; // ASCII followed by a continuation
+            static constexpr UINT8 OVERLONG_3 = 1 << 2; // 11100000 100_____
+            static constexpr UINT8 TOO_LARGE = 1 << 3; // 11110100 1001____, 11110100 101_____, 11110101+ 1001____+
+            static constexpr UINT8 SURROGATE = 1 << 4; // 11101101 101_____
+            static constexpr UINT8 OVERLONG_2 = 1 << 5; // 1100000_ 10______
+            static constexpr UINT8 TOO_LARGE_1000 = 1 << 6; // 11110101+ 1000____
+            static constexpr UINT8 OVERLONG_4 = 1 << 6; // 11110000 1000____
+            static constexpr UINT8 TWO_CONTS = 1 << 7; // Continuation followed by a continuation
+            static constexpr UINT8 CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+            static __m128i GetPairErrors(__m128i prev1, __m128i input)
+            {
+                const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+
+                const __m128i byte1HighTable = _mm_setr_epi8(
+                    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+                    TOO_SHORT | OVERLONG_2,
+                    TOO_SHORT,
+                    TOO_SHORT | OVERLONG_3 | SURROGATE,
+                    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+
+                const __m128i byte1LowTable = _mm_setr_epi8(
+                    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+                    CARRY | OVERLONG_2,
+                    CARRY,
+                    CARRY,
+                    CARRY | TOO_LARGE,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000);
+
+                const __m128i byte2HighTable = _mm_setr_epi8(
+                    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                    (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+                    (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+                    (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+                    (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+                    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+
+                const __m128i byte1High = _mm_shuffle_epi8(byte1HighTable,
+                    _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibbleMask));
+                const __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, lowNibbleMask));
+                const __m128i byte2High = _mm_shuffle_epi8(byte2HighTable,
+                    _mm_and_si128(_mm_srli_epi16(input, 4), lowNibbleMask));
+
+                return _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+            }
+
+            __m128i _error = _mm_setzero_si128();
+            __m128i _prevInput = _mm_setzero_si128();
+            __m128i _prevIncomplete = _mm_setzero_si128();
+        };
+#endif
+
+        /**
+         * Converts UTF-8 to UTF-16, into a buffer with room for one unit per input byte. Returns the number of units
+         * written.
+         */
+        size_t ConvertUTF8ToUTF16(const char* data, size_t length, char16_t* output)
+        {
+            const UINT8* input = (const UINT8*)data;
+            const UINT8* end = input + length;
+            char16_t* outputStart = output;
+
+            while (input < end)
+            {
+#if TE_UNICODE_SSE
+                if (end - input >= 16)
+                {
+                    const __m128i block = _mm_loadu_si128((const __m128i*)input);
+                    if (IsASCII(block))
+                    {
+                        const __m128i zero = _mm_setzero_si128();
+                        _mm_storeu_si128((__m128i*)output, _mm_unpacklo_epi8(block, zero));
+                        _mm_storeu_si128((__m128i*)(output + 8), _mm_unpackhi_epi8(block, zero));
+
+                        input += 16;
+                        output += 16;
+                        continue;
+                    }
+                }
+#endif
+
+                // Decode the rest of the block one code point at a time
+                const UINT8* blockEnd = end - input > 16 ? input + 16 : end;
+                while (input < blockEnd)
+                {
+                    char32_t codePoint;
+                    DecodeSequence(input, end, codePoint);
+
+                    if (codePoint < 0x10000)
+                        *output++ = (char16_t)codePoint;
+                    else
+                    {
+                        codePoint -= 0x10000;
+                        *output++ = (char16_t)(0xD800 + (codePoint >> 10));
+                        *output++ = (char16_t)(0xDC00 + (codePoint & 0x3FF));
+                    }
+                }
+            }
+
+            return output - outputStart;
+        }
+
+        /**
+         * Converts UTF-8 to UTF-32, into a buffer with room for one code point per input byte. Returns the number of
+         * code points written.
+         */
+        size_t ConvertUTF8ToUTF32(const char* data, size_t length, char32_t* output)
+        {
+            const UINT8* input = (const UINT8*)data;
+            const UINT8* end = input + length;
+            char32_t* outputStart = output;
+
+            while (input < end)
+            {
+#if TE_UNICODE_SSE
+                if (end - input >= 16)
+                {
+                    const __m128i block = _mm_loadu_si128((const __m128i*)input);
+                    if (IsASCII(block))
+                    {
+                        _mm_storeu_si128((__m128i*)output, _mm_cvtepu8_epi32(block));
+                        _mm_storeu_si128((__m128i*)(output + 4), _mm_cvtepu8_epi32(_mm_srli_si128(block, 4)));
+                        _mm_storeu_si128((__m128i*)(output + 8), _mm_cvtepu8_epi32(_mm_srli_si128(block, 8)));
+                        _mm_storeu_si128((__m128i*)(output + 12), _mm_cvtepu8_epi32(_mm_srli_si128(block, 12)));
+
+                        input += 16;
+                        output += 16;
+                        continue;
+                    }
+                }
+#endif
+
+                const UINT8* blockEnd = end - input > 16 ? input + 16 : end;
+                while (input < blockEnd)
+                    DecodeSequence(input, end, *output++);
+            }
+
+            return output - outputStart;
+        }
+
+        /**
+         * Converts UTF-16 to UTF-8, into a buffer with room for three bytes per input unit. Returns the number of bytes
+         * written.
+         */
+        size_t ConvertUTF16ToUTF8(const char16_t* input, size_t length, char* output)
+        {
+            const char16_t* end = input + length;
+            char* outputStart = output;
+
+            while (input < end)
+            {
+#if TE_UNICODE_SSE
+                if (end - input >= 16)
+                {
+                    const __m128i first = _mm_loadu_si128((const __m128i*)input);
+                    const __m128i second = _mm_loadu_si128((const __m128i*)(input + 8));
+                    if (_mm_testz_si128(_mm_or_si128(first, second), _mm_set1_epi16((short)0xFF80)))
+                    {
+                        _mm_storeu_si128((__m128i*)output, _mm_packus_epi16(first, second));
+
+                        input += 16;
+                        output += 16;
+                        continue;
+                    }
+                }
+#endif
+
+                const char16_t* blockEnd = end - input > 16 ? input + 16 : end;
+                while (input < blockEnd)
+                    output += UTF8::Encode(DecodeUTF16(input, end), output);
+            }
+
+            return output - outputStart;
+        }
+
+        /**
+         * Converts UTF-32 to UTF-8, into a buffer with room for four bytes per input code point. Returns the number of
+         * bytes written.
+         */
+        size_t ConvertUTF32ToUTF8(const char32_t* input, size_t length, char* output)
+        {
+            const char32_t* end = input + length;
+            char* outputStart = output;
+
+            while (input < end)
+            {
+#if TE_UNICODE_SSE
+                if (end - input >= 16)
+                {
+                    const __m128i block0 = _mm_loadu_si128((const __m128i*)input);
+                    const __m128i block1 = _mm_loadu_si128((const __m128i*)(input + 4));
+                    const __m128i block2 = _mm_loadu_si128((const __m128i*)(input + 8));
+                    const __m128i block3 = _mm_loadu_si128((const __m128i*)(input + 12));
+
+                    const __m128i combined = _mm_or_si128(_mm_or_si128(block0, block1), _mm_or_si128(block2, block3));
+                    if (_mm_testz_si128(combined, _mm_set1_epi32((int)0xFFFFFF80)))
+                    {
+                        const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(block0, block1),
+                            _mm_packus_epi32(block2, block3));
+                        _mm_storeu_si128((__m128i*)output, packed);
+
+                        input += 16;
+                        output += 16;
+                        continue;
+                    }
+                }
+#endif
+
+                const char32_t* blockEnd = end - input > 16 ? input + 16 : end;
+                while (input < blockEnd)
+                    output += UTF8::Encode(*input++, output);
+            }
+
+            return output - outputStart;
+        }
+    }
+
+    bool UTF8::Validate(StringView input)
+    {
+        const UINT8* data = (const UINT8*)input.data();
+        const UINT8* end = data + input.size();
+
+#if TE_UNICODE_SSE
+        UTF8Validator validator;
+        for (; end - data >= 16; data += 16)
+            validator.Process(_mm_loadu_si128((const __m128i*)data));
+
+        if (data < end)
+        {
+            // Zero padding is ASCII, so sequences cut off by the end of the input are still detected
+            UINT8 lastBlock[16] = {};
+            memcpy(lastBlock, data, end - data);
+            validator.Process(_mm_loadu_si128((const __m128i*)lastBlock));
+        }
+
+        return validator.IsValid();
+#else
+        char32_t codePoint;
+        while (data < end)
+        {
+            if (!DecodeSequence(data, end, codePoint))
+                return false;
+        }
+
+        return true;
+#endif
+    }
+
+    size_t UTF8::Count(StringView input)
+    {
+        const UINT8* data = (const UINT8*)input.data();
+        const UINT8* end = data + input.size();
+
+        size_t count = 0;
+        while (data < end)
+        {
+#if TE_UNICODE_SSE
+            if (end - data >= 16 && IsASCII(_mm_loadu_si128((const __m128i*)data)))
+            {
+                data += 16;
+                count += 16;
+                continue;
+            }
+#endif
+
+            char32_t codePoint;
+            DecodeSequence(data, end, codePoint);
+            count++;
+        }
+
+        return count;
+    }
+
+    const char* UTF8::Decode(const char* input, const char* end, char32_t& output)
+    {
+        const UINT8* data = (const UINT8*)input;
+        DecodeSequence(data, (const UINT8*)end, output);
+
+        return (const char*)data;
+    }
+
+    UINT32 UTF8::Encode(char32_t codePoint, char* output)
+    {
+        if ((codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
+            codePoint = REPLACEMENT_CHARACTER;
+
+        if (codePoint < 0x80)
+        {
+            output[0] = (char)codePoint;
+            return 1;
+        }
+
+        if (codePoint < 0x800)
+        {
+            output[0] = (char)(0xC0 | (codePoint >> 6));
+            output[1] = (char)(0x80 | (codePoint & 0x3F));
+            return 2;
+        }
+
+        if (codePoint < 0x10000)
+        {
+            output[0] = (char)(0xE0 | (codePoint >> 12));
+            output[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            output[2] = (char)(0x80 | (codePoint & 0x3F));
+            return 3;
+        }
+
+        output[0] = (char)(0xF0 | (codePoint >> 18));
+        output[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        output[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        output[3] = (char)(0x80 | (codePoint & 0x3F));
+        return 4;
+    }
+
+    void UTF8::ToUTF16(StringView input, U16String& output)
+    {
+        const size_t offset = output.size();
+        output.resize(offset + input.size());
+        output.resize(offset + ConvertUTF8ToUTF16(input.data(), input.size(), &output[offset]));
+    }
+
+    void UTF8::ToUTF32(StringView input, U32String& output)
+    {
+        const size_t offset = output.size();
+        output.resize(offset + input.size());
+        output.resize(offset + ConvertUTF8ToUTF32(input.data(), input.size(), &output[offset]));
+    }
+
+    void UTF8::ToWide(StringView input, WString& output)
+    {
+        const size_t offset = output.size();
+        output.resize(offset + input.size());
+
+        size_t written;
+        if (sizeof(wchar_t) == sizeof(char16_t))
+            written = ConvertUTF8ToUTF16(input.data(), input.size(), (char16_t*)&output[offset]);
+        else
+            written = ConvertUTF8ToUTF32(input.data(), input.size(), (char32_t*)&output[offset]);
+
+        output.resize(offset + written);
+    }
+
+    void UTF8::FromUTF16(U16StringView input, String& output)
+    {
+        const size_t offset = output.size();
+        output.resize(offset + input.size() * 3);
+        output.resize(offset + ConvertUTF16ToUTF8(input.data(), input.size(), &output[offset]));
+    }
+
+    void UTF8::FromUTF32(U32StringView input, String& output)
+    {
+        const size_t offset = output.size();
+        output.resize(offset + input.size() * 4);
+        output.resize(offset + ConvertUTF32ToUTF8(input.data(), input.size(), &output[offset]));
+    }
+
+    void UTF8::FromWide(WStringView input, String& output)
+    {
+        const size_t offset = output.size();
+
+        size_t written;
+        if (sizeof(wchar_t) == sizeof(char16_t))
+        {
+            output.resize(offset + input.size() * 3);
+            written = ConvertUTF16ToUTF8((const char16_t*)input.data(), input.size(), &output[offset]);
+        }
+        else
+        {
+            output.resize(offset + input.size() * 4);
+            written = ConvertUTF32ToUTF8((const char32_t*)input.data(), input.size(), &output[offset]);
+        }
+
+        output.resize(offset + written);
+    }
+}
\ No newline at end of file
@@ -4,10 +4,71 @@
 
 namespace te
 {
-	/** Provides methods to converting between UTF-8 character encoding and other popular encodings. */
-	class TE_UTILITY_EXPORT UTF8
-	{
-	public:
+    /**
+     * Provides methods to converting between UTF-8 character encoding and other popular encodings. Bulk conversions
+     * and validation process 16 bytes at a time with SSE where available.
+     *
+     * Invalid input never fails a conversion. Malformed UTF-8 sequences, unpaired UTF-16 surrogates and out of range
+     * code points are replaced by REPLACEMENT_CHARACTER instead, one per maximal invalid sequence.
+     */
+    class TE_UTILITY_EXPORT UTF8
+    {
+    public:
+        /** Code point invalid input is replaced with. */
+        static constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
 
+        /** Checks is the input valid UTF-8: no malformed, overlong or truncated sequences, and no surrogates. */
+        static bool Validate(StringView input);
+
+        /** Returns the number of code points in the input. Each invalid sequence counts as one. */
+        static size_t Count(StringView input);
+
+        /**
+         * Decodes the code point starting at @p input into @p output, and returns the position of the next one. Must be
+         * called with @p input before @p end.
+         */
+        static const char* Decode(const char* input, const char* end, char32_t& output);
+
+        /** Encodes a code point into @p output, which must fit 4 bytes. Returns the number of bytes written. */
+        static UINT32 Encode(char32_t codePoint, char* output);
+
+        /** Converts from UTF-8 to UTF-16, appending to @p output. */
+        static void ToUTF16(StringView input, U16String& output);
+
+        /** Converts from UTF-8 to UTF-32, appending to @p output. */
+        static void ToUTF32(StringView input, U32String& output);
+
+        /**
+         * Converts from UTF-8 to the platform's wide encoding (UTF-16 on Windows, UTF-32 elsewhere), appending to
+         * @p output.
+         */
+        static void ToWide(StringView input, WString& output);
+
+        /** Converts from UTF-16 to UTF-8, appending to @p output. */
+        static void FromUTF16(U16StringView input, String& output);
+
+        /** Converts from UTF-32 to UTF-8, appending to @p output. */
+        static void FromUTF32(U32StringView input, String& output);
+
+        /** Converts from the platform's wide encoding to UTF-8, appending to @p output. */
+        static void FromWide(WStringView input, String& output);
+
+        /** @copydoc ToUTF16(StringView, U16String&) */
+        static U16String ToUTF16(StringView input) { U16String output; ToUTF16(input, output); return output; }
+
+        /** @copydoc ToUTF32(StringView, U32String&) */
+        static U32String ToUTF32(StringView input) { U32String output; ToUTF32(input, output); return output; }
+
+        /** @copydoc ToWide(StringView, WString&) */
+        static WString ToWide(StringView input) { WString output; ToWide(input, output); return output; }
+
+        /** @copydoc FromUTF16(U16StringView, String&) */
+        static String FromUTF16(U16StringView input) { String output; FromUTF16(input, output); return output; }
+
+        /** @copydoc FromUTF32(U32StringView, String&) */
+        static String FromUTF32(U32StringView input) { String output; FromUTF32(input, output); return output; }
+
+        /** @copydoc FromWide(WStringView, String&) */
+        static String FromWide(WStringView input) { String output; FromWide(input, output); return output; }
     };
 }
\ No newline at end of file
@@ -3,18 +3,39 @@
 
 namespace te
 {
-    Task::Task(const String& name, std::function<void()> taskWorker, TaskPriority priority, SPtr<Task> dependency)
+    Task::Task(const String& name, std::function<void()> taskWorker, TaskPriority priority, Vector<SPtr<Task>> dependencies)
         : _name(name)
         , _priority(priority)
         , _taskWorker(std::move(taskWorker))
-        , _taskDependency(std::move(dependency))
+        , _taskDependencies(std::move(dependencies))
     {
 
     }
 
     SPtr<Task> Task::Create(const String& name, std::function<void()> taskWorker, TaskPriority priority, SPtr<Task> dependency)
     {
-        return te_shared_ptr_new<Task>(name, std::move(taskWorker), priority, std::move(dependency));
+        Vector<SPtr<Task>> dependencies;
+        if (dependency != nullptr)
+            dependencies.push_back(std::move(dependency));
+
+        return te_shared_ptr_new<Task>(name, std::move(taskWorker), priority, std::move(dependencies));
+    }
+
+    SPtr<Task> Task::Create(const String& name, std::function<void()> taskWorker, TaskPriority priority,
+        Vector<SPtr<Task>> dependencies)
+    {
+        return te_shared_ptr_new<Task>(name, std::move(taskWorker), priority, std::move(dependencies));
+    }
+
+    bool Task::AreDependenciesComplete() const
+    {
+        for (auto& dependency : _taskDependencies)
+        {
+            if (dependency != nullptr && !dependency->IsComplete())
+                return false;
+        }
+
+        return true;
     }
 
     bool Task::IsComplete() const
@@ -133,7 +154,7 @@ namespace te
                     continue;
                 }
 
-                if (curTask->_taskDependency != nullptr && !curTask->_taskDependency->IsComplete())
+                if (!curTask->AreDependenciesComplete())
                 {
                     ++iter;
                     continue;
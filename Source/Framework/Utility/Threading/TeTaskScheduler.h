@@ -22,7 +22,7 @@ namespace te
 	class TE_UTILITY_EXPORT Task
 	{
     public:
-        Task(const String& name, std::function<void()> taskWorker, TaskPriority priority, SPtr<Task> dependency);
+        Task(const String& name, std::function<void()> taskWorker, TaskPriority priority, Vector<SPtr<Task>> dependencies);
         ~Task() = default;
 
         /**
@@ -37,6 +37,18 @@ namespace te
         static SPtr<Task> Create(const String& name, std::function<void()> taskWorker,
             TaskPriority priority = TaskPriority::Normal, SPtr<Task> dependency = nullptr);
 
+        /**
+         * Creates a new task that depends on multiple other tasks. The task will not be executed until all of its
+         * dependencies are complete.
+         *
+         * @see	Create
+         */
+        static SPtr<Task> Create(const String& name, std::function<void()> taskWorker, TaskPriority priority,
+            Vector<SPtr<Task>> dependencies);
+
+        /** Returns true if all the tasks this task depends on have completed. */
+        bool AreDependenciesComplete() const;
+
         /** Returns true if the task has completed. */
         bool IsComplete() const;
 
@@ -68,7 +80,7 @@ namespace te
         TaskPriority _priority;
         UINT32 _taskId = 0;
         std::function<void()> _taskWorker;
-        SPtr<Task> _taskDependency;
+        Vector<SPtr<Task>> _taskDependencies;
         std::atomic<UINT32> _state { Task::TaskInactive }; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
         TaskScheduler* _parent = nullptr;
@@ -5,6 +5,7 @@
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 
 /** Returns the number of logical CPU cores. */
@@ -16,6 +17,9 @@
 /** Causes the current thread to sleep for the provided amount of milliseconds. */
 #define TE_THREAD_SLEEP(ms) std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 
+/** Gives up the remainder of the current thread's time slice, if another thread is ready to run. */
+#define TE_THREAD_YIELD() std::this_thread::yield();
+
 /** Wrapper for the C++ std::mutex. */
 using Mutex = std::mutex;
 
@@ -35,4 +39,13 @@ using ThreadId = std::thread::id;
 using Lock = std::unique_lock<Mutex>;
 
 /** Wrapper for the C++ std::unique_lock<std::recursive_mutex>. */
-using RecursiveLock = std::unique_lock<RecursiveMutex>;
\ No newline at end of file
+using RecursiveLock = std::unique_lock<RecursiveMutex>;
+
+/** Wrapper for the C++ std::shared_mutex, a mutex that can be locked by multiple readers at once. */
+using RWMutex = std::shared_mutex;
+
+/** Wrapper for the C++ std::shared_lock<std::shared_mutex>, a read lock on a RWMutex. */
+using ReadLock = std::shared_lock<RWMutex>;
+
+/** Wrapper for the C++ std::unique_lock<std::shared_mutex>, a write lock on a RWMutex. */
+using WriteLock = std::unique_lock<RWMutex>;
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "Utility/TeCompression.h"
+
+namespace te
+{
+    namespace
+    {
+        constexpr size_t MIN_MATCH = 4;
+        constexpr size_t LAST_LITERALS = 5; /**< Last bytes of a block are always stored as literals. */
+        constexpr size_t MATCH_FIND_LIMIT = 12; /**< Last match must start at least this far from the end. */
+        constexpr size_t MAX_DISTANCE = 65535;
+        constexpr UINT32 HASH_BITS = 12;
+
+        UINT32 Read32(const UINT8* data)
+        {
+            UINT32 value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        UINT32 Hash(UINT32 sequence)
+        {
+            return (sequence * 2654435761U) >> (32 - HASH_BITS);
+        }
+
+        /** Writes a length that didn't fit in its token nibble. */
+        UINT8* WriteLength(UINT8* output, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+                *output++ = 255;
+
+            *output++ = (UINT8)length;
+            return output;
+        }
+
+        /** Writes a sequence of literals, optionally followed by a match. Returns null if it doesn't fit. */
+        UINT8* WriteSequence(UINT8* output, UINT8* outputEnd, const UINT8* literals, size_t numLiterals,
+            size_t offset, size_t matchLength)
+        {
+            const size_t maxSize = 1 + numLiterals + numLiterals / 255 + 1 + 2 + matchLength / 255 + 1;
+            if ((size_t)(outputEnd - output) < maxSize)
+                return nullptr;
+
+            UINT8* token = output++;
+            *token = (UINT8)(std::min(numLiterals, (size_t)15) << 4);
+
+            if (numLiterals >= 15)
+                output = WriteLength(output, numLiterals - 15);
+
+            memcpy(output, literals, numLiterals);
+            output += numLiterals;
+
+            if (matchLength == 0)
+                return output;
+
+            *output++ = (UINT8)(offset & 0xFF);
+            *output++ = (UINT8)(offset >> 8);
+
+            const size_t length = matchLength - MIN_MATCH;
+            *token |= (UINT8)std::min(length, (size_t)15);
+
+            if (length >= 15)
+                output = WriteLength(output, length - 15);
+
+            return output;
+        }
+
+        /** Reads a length that didn't fit in its token nibble. Returns false if the data ends prematurely. */
+        bool ReadLength(const UINT8*& input, const UINT8* inputEnd, size_t& length)
+        {
+            UINT8 value;
+            do
+            {
+                if (input >= inputEnd)
+                    return false;
+
+                value = *input++;
+                length += value;
+            } while (value == 255);
+
+            return true;
+        }
+    }
+
+    size_t Compression::CompressBlock(const UINT8* source, size_t sourceSize, UINT8* dest, size_t destCapacity)
+    {
+        UINT8* output = dest;
+        UINT8* outputEnd = dest + destCapacity;
+
+        size_t anchor = 0;
+
+        if (sourceSize >= MATCH_FIND_LIMIT)
+        {
+            UINT32 table[1 << HASH_BITS] = {};
+
+            const size_t matchLimit = sourceSize - LAST_LITERALS;
+            const size_t searchLimit = sourceSize - MATCH_FIND_LIMIT;
+
+            size_t position = 0;
+            while (position <= searchLimit)
+            {
+                const UINT32 sequence = Read32(source + position);
+                const UINT32 hash = Hash(sequence);
+
+                size_t reference = table[hash];
+                table[hash] = (UINT32)position;
+
+                if (reference >= position || position - reference > MAX_DISTANCE || Read32(source + reference) != sequence)
+                {
+                    position++;
+                    continue;
+                }
+
+                // Extend the match backwards into the pending literals
+                while (position > anchor && reference > 0 && source[position - 1] == source[reference - 1])
+                {
+                    position--;
+                    reference--;
+                }
+
+                size_t matchLength = MIN_MATCH;
+                while (position + matchLength < matchLimit && source[position + matchLength] == source[reference + matchLength])
+                    matchLength++;
+
+                output = WriteSequence(output, outputEnd, source + anchor, position - anchor, position - reference,
+                    matchLength);
+
+                if (output == nullptr)
+                    return 0;
+
+                position += matchLength;
+                anchor = position;
+            }
+        }
+
+        output = WriteSequence(output, outputEnd, source + anchor, sourceSize - anchor, 0, 0);
+        if (output == nullptr)
+            return 0;
+
+        return output - dest;
+    }
+
+    bool Compression::DecompressBlock(const UINT8* source, size_t sourceSize, UINT8* dest, size_t destSize)
+    {
+        const UINT8* input = source;
+        const UINT8* inputEnd = source + sourceSize;
+
+        UINT8* output = dest;
+        UINT8* outputEnd = dest + destSize;
+
+        while (input < inputEnd)
+        {
+            const UINT8 token = *input++;
+
+            size_t numLiterals = token >> 4;
+            if (numLiterals == 15 && !ReadLength(input, inputEnd, numLiterals))
+                return false;
+
+            if ((size_t)(inputEnd - input) < numLiterals || (size_t)(outputEnd - output) < numLiterals)
+                return false;
+
+            memcpy(output, input, numLiterals);
+            input += numLiterals;
+            output += numLiterals;
+
+            // Last sequence has no match
+            if (input == inputEnd)
+                break;
+
+            if (inputEnd - input < 2)
+                return false;
+
+            const size_t offset = (size_t)input[0] | ((size_t)input[1] << 8);
+            input += 2;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+                return false;
+
+            matchLength += MIN_MATCH;
+
+            if (offset == 0 || offset > (size_t)(output - dest) || (size_t)(outputEnd - output) < matchLength)
+                return false;
+
+            const UINT8* match = output - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(output, match, matchLength);
+                output += matchLength;
+            }
+            else
+            {
+                // Overlapping match, repeats the last offset bytes
+                for (size_t i = 0; i < matchLength; i++)
+                    *output++ = *match++;
+            }
+        }
+
+        return output == outputEnd;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    /**
+     * Fast lossless block compression, using the LZ4 block format. Meant for data that is decompressed often (e.g.
+     * when loading resources), compression ratio is traded for decompression speed.
+     */
+    class TE_UTILITY_EXPORT Compression
+    {
+    public:
+        /** Returns the size of the buffer needed to hold the compressed version of @p size bytes in the worst case. */
+        static size_t GetMaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+        /**
+         * Compresses a block of data.
+         *
+         * @param[in]	source			Data to compress.
+         * @param[in]	sourceSize		Size of @p source in bytes.
+         * @param[out]	dest			Buffer to write the compressed data to.
+         * @param[in]	destCapacity	Size of @p dest in bytes.
+         * @return						Size of the compressed data, or 0 if it doesn't fit in @p dest.
+         */
+        static size_t CompressBlock(const UINT8* source, size_t sourceSize, UINT8* dest, size_t destCapacity);
+
+        /**
+         * Decompresses a block of data compressed with CompressBlock(). Malformed data is detected and never results in
+         * accesses outside of the provided buffers.
+         *
+         * @param[in]	source			Compressed data.
+         * @param[in]	sourceSize		Size of @p source in bytes.
+         * @param[out]	dest			Buffer to write the decompressed data to.
+         * @param[in]	destSize		Size of the data before it was compressed.
+         * @return						True if the block was successfully decompressed.
+         */
+        static bool DecompressBlock(const UINT8* source, size_t sourceSize, UINT8* dest, size_t destSize);
+    };
+}
\ No newline at end of file
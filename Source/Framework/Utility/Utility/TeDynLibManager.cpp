@@ -9,27 +9,9 @@ namespace te
         te_delete(lib);
     }
 
-    static bool operator<(const UPtr<DynLib>& lhs, const String& rhs)
-    {
-        return lhs->GetName() < rhs;
-    }
-
-    static bool operator<(const String& lhs, const UPtr<DynLib>& rhs)
-    {
-        return lhs < rhs->GetName();
-    }
-
-    static bool operator<(const UPtr<DynLib>& lhs, const UPtr<DynLib>& rhs)
-    {
-        return lhs->GetName() < rhs->GetName();
-    }
-
     DynLib* DynLibManager::Load(String filename)
     {
         // Add the extension (.dll, .so, ...) if necessary.
-
-        // Note: The string comparison here could be slightly more efficent by using a templatized string_concat function
-        // for the lower_bound call and/or a custom comparitor that does comparison by parts.
         const String::size_type length = filename.length();
         const String extension = String(".") + DynLib::EXTENSION;
         const String::size_type extLength = extension.length();
@@ -39,15 +21,15 @@ namespace te
         if (DynLib::PREFIX != nullptr)
             filename.insert(0, DynLib::PREFIX);
 
-        const auto& iterFind = _loadedLibrairies.lower_bound(filename);
-        if (iterFind != _loadedLibrairies.end() && (*iterFind)->GetName() == filename)
+        const auto& iterFind = _loadedLibrairies.find(filename);
+        if (iterFind != _loadedLibrairies.end())
         {
-            return iterFind->get();
+            return iterFind->second.get();
         }
         else
         {
-            DynLib* newLib = te_new<DynLib>(std::move(filename));
-            _loadedLibrairies.emplace_hint(iterFind, newLib, &dynlib_delete);
+            DynLib* newLib = te_new<DynLib>(filename);
+            _loadedLibrairies.emplace(std::move(filename), UPtr<DynLib>(newLib, &dynlib_delete));
             return newLib;
         }
     }
@@ -2,6 +2,7 @@
 
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Utility/TeModule.h"
+#include "Utility/TeFlatHashMap.h"
 
 namespace te
 {
@@ -20,7 +21,7 @@ namespace te
         void Unload(DynLib* lib);
 
     protected:
-        Set<UPtr<DynLib>, std::less<>> _loadedLibrairies;
+        FlatHashMap<String, UPtr<DynLib>> _loadedLibrairies;
     };
 
     /** Easy way of accessing DynLibManager. */
@@ -0,0 +1,815 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64)))
+#   define TE_FLAT_HASH_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace te
+{
+    /**
+     * Group of 16 control bytes of a FlatHashTable, compared all at once with SSE2 where available. Each control byte
+     * is either EMPTY, SENTINEL (end of the table) or the low 7 bits of the hash of the element in that slot.
+     */
+    class FlatHashGroup
+    {
+    public:
+        static constexpr UINT32 SIZE = 16;
+        static constexpr INT8 EMPTY = -128;
+        static constexpr INT8 SENTINEL = -1;
+
+        explicit FlatHashGroup(const INT8* control)
+        {
+#if TE_FLAT_HASH_SSE2
+            _control = _mm_loadu_si128((const __m128i*)control);
+#else
+            memcpy(_control, control, SIZE);
+#endif
+        }
+
+        /** Returns a bit mask of the slots whose control byte equals @p value. */
+        UINT32 Match(INT8 value) const
+        {
+#if TE_FLAT_HASH_SSE2
+            return (UINT32)_mm_movemask_epi8(_mm_cmpeq_epi8(_control, _mm_set1_epi8(value)));
+#else
+            UINT32 mask = 0;
+            for (UINT32 i = 0; i < SIZE; i++)
+                mask |= (UINT32)(_control[i] == value) << i;
+
+            return mask;
+#endif
+        }
+
+        /** Returns a bit mask of the empty slots. */
+        UINT32 MatchEmpty() const { return Match(EMPTY); }
+
+        /** Returns a bit mask of the slots that are full, or are the end of the table. */
+        UINT32 MatchNonEmpty() const { return ~MatchEmpty() & 0xFFFF; }
+
+        /** Returns the index of the lowest set bit of a non-zero mask. */
+        static UINT32 FirstBit(UINT32 mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return (UINT32)index;
+#else
+            return (UINT32)__builtin_ctz(mask);
+#endif
+        }
+
+    private:
+#if TE_FLAT_HASH_SSE2
+        __m128i _control;
+#else
+        INT8 _control[SIZE];
+#endif
+    };
+
+    /**
+     * Open addressing hash table shared by FlatHashMap and FlatHashSet. Elements are stored in one contiguous array,
+     * with a separate array of control bytes that probing scans 16 slots at a time.
+     *
+     * Collisions are resolved by linear probing, which never wraps around: the slot array extends past the last home
+     * slot, and that tail grows if a probe would run past its end. Removal shifts the following elements of the probe
+     * sequence back instead of leaving tombstones, so lookups never slow down after many removals. Each slot also
+     * stores its distance from its home slot, so removal doesn't need to hash the elements it shifts, except for the
+     * rare elements too far from their home slot for the distance to fit in a byte.
+     *
+     * @tparam	Key		Type of the keys.
+     * @tparam	Slot	Type of the stored elements.
+     * @tparam	KeyOf	Functor returning the key of an element.
+     * @tparam	H		Hash functor of the keys.
+     * @tparam	C		Equality functor of the keys.
+     * @tparam	A		Allocator of the elements.
+     */
+    template <typename Key, typename Slot, typename KeyOf, typename H, typename C, typename A>
+    class FlatHashTable
+    {
+        using ControlAllocator = typename std::allocator_traits<A>::template rebind_alloc<INT8>;
+        using SlotAllocator = typename std::allocator_traits<A>::template rebind_alloc<Slot>;
+
+        static constexpr UINT32 GROUP_SIZE = FlatHashGroup::SIZE;
+        static constexpr size_t MIN_CAPACITY = 16;
+
+        /** Stored distance of elements at this distance from their home slot or further. */
+        static constexpr size_t SATURATED_DISTANCE = 255;
+
+        template <bool Const>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Slot;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<Const, const Slot*, Slot*>::type;
+            using reference = typename std::conditional<Const, const Slot&, Slot&>::type;
+
+            Iterator() = default;
+
+            Iterator(const INT8* control, pointer slot)
+                : _control(control), _slot(slot)
+            { }
+
+            /** Allows conversion from a non-const iterator. */
+            template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+            Iterator(const Iterator<OtherConst>& other)
+                : _control(other._control), _slot(other._slot)
+            { }
+
+            reference operator*() const { return *_slot; }
+            pointer operator->() const { return _slot; }
+
+            Iterator& operator++()
+            {
+                _control++;
+                _slot++;
+                SkipEmpty();
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator copy = *this;
+                ++(*this);
+
+                return copy;
+            }
+
+            template <bool OtherConst>
+            bool operator==(const Iterator<OtherConst>& rhs) const { return _control == rhs._control; }
+
+            template <bool OtherConst>
+            bool operator!=(const Iterator<OtherConst>& rhs) const { return _control != rhs._control; }
+
+        private:
+            friend class FlatHashTable;
+            template <bool> friend class Iterator;
+
+            /** Moves to the first full slot at or after the current one, or to the end of the table. */
+            void SkipEmpty()
+            {
+                while (*_control == FlatHashGroup::EMPTY)
+                {
+                    const UINT32 mask = FlatHashGroup(_control).MatchNonEmpty();
+                    const UINT32 skip = mask != 0 ? FlatHashGroup::FirstBit(mask) : GROUP_SIZE;
+
+                    _control += skip;
+                    _slot += skip;
+                }
+            }
+
+            const INT8* _control = nullptr;
+            pointer _slot = nullptr;
+        };
+
+    public:
+        using key_type = Key;
+        using value_type = Slot;
+        using size_type = size_t;
+        using hasher = H;
+        using key_equal = C;
+        using allocator_type = A;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatHashTable() = default;
+
+        FlatHashTable(const FlatHashTable& other)
+            : _hasher(other._hasher), _equal(other._equal), _allocator(other._allocator)
+        {
+            CopyFrom(other);
+        }
+
+        FlatHashTable(FlatHashTable&& other) noexcept
+            : _hasher(std::move(other._hasher)), _equal(std::move(other._equal))
+            , _allocator(std::move(other._allocator))
+        {
+            Steal(other);
+        }
+
+        ~FlatHashTable()
+        {
+            Release();
+        }
+
+        FlatHashTable& operator=(const FlatHashTable& other)
+        {
+            if (this != &other)
+            {
+                Release();
+
+                _hasher = other._hasher;
+                _equal = other._equal;
+                CopyFrom(other);
+            }
+
+            return *this;
+        }
+
+        FlatHashTable& operator=(FlatHashTable&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Release();
+
+                _hasher = std::move(other._hasher);
+                _equal = std::move(other._equal);
+                Steal(other);
+            }
+
+            return *this;
+        }
+
+        iterator begin()
+        {
+            iterator output(_control, _slots);
+            output.SkipEmpty();
+
+            return output;
+        }
+
+        const_iterator begin() const
+        {
+            const_iterator output(_control, _slots);
+            output.SkipEmpty();
+
+            return output;
+        }
+
+        iterator end() { return iterator(_control + _slotCount, _slots + _slotCount); }
+        const_iterator end() const { return const_iterator(_control + _slotCount, _slots + _slotCount); }
+
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        /** Returns the number of elements. */
+        size_t size() const { return _size; }
+
+        /** Checks is the table empty. */
+        bool empty() const { return _size == 0; }
+
+        /** Returns the number of home slots. Elements can be added until it is 7/8 full before the table grows. */
+        size_t capacity() const { return _capacity; }
+
+        /** Removes all elements. Keeps the allocated memory. */
+        void clear()
+        {
+            if (_size == 0)
+                return;
+
+            DestroySlots();
+            memset(_control, FlatHashGroup::EMPTY, _slotCount);
+            _size = 0;
+        }
+
+        /** Makes sure @p count elements can be added without the table growing. */
+        void reserve(size_t count)
+        {
+            size_t capacity = MIN_CAPACITY;
+            while (capacity - capacity / 8 < count)
+                capacity *= 2;
+
+            if (capacity > _capacity)
+                Rehash(capacity);
+        }
+
+        iterator find(const Key& key)
+        {
+            const size_t index = Find(key);
+            return index != NOT_FOUND ? iterator(_control + index, _slots + index) : end();
+        }
+
+        const_iterator find(const Key& key) const
+        {
+            const size_t index = Find(key);
+            return index != NOT_FOUND ? const_iterator(_control + index, _slots + index) : end();
+        }
+
+        bool contains(const Key& key) const { return Find(key) != NOT_FOUND; }
+        size_t count(const Key& key) const { return Find(key) != NOT_FOUND ? 1 : 0; }
+
+        /** Constructs an element from @p args, and adds it unless an element with the same key exists. */
+        template <typename... Args>
+        Pair<iterator, bool> emplace(Args&&... args)
+        {
+            Slot value(std::forward<Args>(args)...);
+            return EmplaceKey(KeyOf()(value), std::move(value));
+        }
+
+        /** Removes the element, and returns an iterator to the element that followed it. */
+        iterator erase(const_iterator position)
+        {
+            const size_t index = (size_t)(position._control - _control);
+            EraseAt(index);
+
+            iterator output(_control + index, _slots + index);
+            output.SkipEmpty();
+
+            return output;
+        }
+
+        /** @copydoc erase(const_iterator) */
+        iterator erase(iterator position)
+        {
+            return erase(const_iterator(position));
+        }
+
+        /** Removes the element with the provided key, if there is one. Returns the number of removed elements. */
+        size_t erase(const Key& key)
+        {
+            const size_t index = Find(key);
+            if (index == NOT_FOUND)
+                return 0;
+
+            EraseAt(index);
+            return 1;
+        }
+
+        void swap(FlatHashTable& other) noexcept
+        {
+            std::swap(_hasher, other._hasher);
+            std::swap(_equal, other._equal);
+            std::swap(_allocator, other._allocator);
+            std::swap(_control, other._control);
+            std::swap(_distances, other._distances);
+            std::swap(_slots, other._slots);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+            std::swap(_slotCount, other._slotCount);
+        }
+
+    protected:
+        static constexpr size_t NOT_FOUND = (size_t)-1;
+
+        /** Adds an element constructed from @p args, unless an element with key @p key exists already. */
+        template <typename K, typename... Args>
+        Pair<iterator, bool> EmplaceKey(const K& key, Args&&... args)
+        {
+            const UINT64 hash = Hash(key);
+            const INT8 fragment = Fragment(hash);
+
+            const size_t home = Home(hash);
+            size_t index = home;
+            if (_slotCount > 0)
+            {
+                while (true)
+                {
+                    const FlatHashGroup group(_control + index);
+
+                    // Only slots before the first empty one belong to the probe sequence
+                    const UINT32 empty = group.MatchEmpty();
+                    UINT32 match = group.Match(fragment) & (empty != 0 ? empty ^ (empty - 1) : 0xFFFF);
+                    while (match != 0)
+                    {
+                        const size_t candidate = index + FlatHashGroup::FirstBit(match);
+                        if (_equal(KeyOf()(_slots[candidate]), key))
+                            return Pair<iterator, bool>(iterator(_control + candidate, _slots + candidate), false);
+
+                        match &= match - 1;
+                    }
+
+                    if (empty != 0)
+                    {
+                        index += FlatHashGroup::FirstBit(empty);
+                        break;
+                    }
+
+                    index += GROUP_SIZE;
+                }
+            }
+
+            if (_size >= _capacity - _capacity / 8)
+            {
+                Rehash(_capacity > 0 ? _capacity * 2 : MIN_CAPACITY);
+                index = FindInsertIndex(hash);
+            }
+
+            // Probe runs past the last slot, which growing the capacity doesn't fix if many keys have the same hash
+            while (index == NOT_FOUND || index >= _slotCount)
+            {
+                Rehash(_capacity, (_slotCount - _capacity) * 2);
+                index = FindInsertIndex(hash);
+            }
+
+            new (&_slots[index]) Slot(std::forward<Args>(args)...);
+            _control[index] = fragment;
+            _distances[index] = Distance(index, Home(hash));
+            _size++;
+
+            return Pair<iterator, bool>(iterator(_control + index, _slots + index), true);
+        }
+
+        /** Returns the index of the element with the provided key, or NOT_FOUND. */
+        size_t Find(const Key& key) const
+        {
+            if (_size == 0)
+                return NOT_FOUND;
+
+            const UINT64 hash = Hash(key);
+            const INT8 fragment = Fragment(hash);
+
+            size_t index = Home(hash);
+            while (true)
+            {
+                const FlatHashGroup group(_control + index);
+
+                const UINT32 empty = group.MatchEmpty();
+                UINT32 match = group.Match(fragment) & (empty != 0 ? empty ^ (empty - 1) : 0xFFFF);
+                while (match != 0)
+                {
+                    const size_t candidate = index + FlatHashGroup::FirstBit(match);
+                    if (_equal(KeyOf()(_slots[candidate]), key))
+                        return candidate;
+
+                    match &= match - 1;
+                }
+
+                if (empty != 0)
+                    return NOT_FOUND;
+
+                index += GROUP_SIZE;
+            }
+        }
+
+    private:
+        /** Mixes the hash, so hashers returning the value itself (like std::hash for integers) still spread well. */
+        UINT64 Hash(const Key& key) const
+        {
+            const UINT64 hash = (UINT64)_hasher(key);
+            constexpr UINT64 MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = (unsigned __int128)hash * MULTIPLIER;
+            return (UINT64)product ^ (UINT64)(product >> 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+            UINT64 high;
+            const UINT64 low = _umul128(hash, MULTIPLIER, &high);
+            return low ^ high;
+#else
+            const UINT64 product = hash * MULTIPLIER;
+            return product ^ (product >> 32);
+#endif
+        }
+
+        /** Returns the 7 bits of the hash stored in the control bytes. */
+        static INT8 Fragment(UINT64 hash) { return (INT8)(hash & 0x7F); }
+
+        /** Returns the slot probing for the hash starts at. */
+        size_t Home(UINT64 hash) const { return (size_t)(hash >> 7) & (_capacity - 1); }
+
+        /** Returns the distance of a slot from a home slot, as stored in the distances array. */
+        static UINT8 Distance(size_t index, size_t home) { return (UINT8)std::min(index - home, SATURATED_DISTANCE); }
+
+        /** Returns the distance of the element in a slot from its home slot. */
+        size_t GetDistance(size_t index) const
+        {
+            return _distances[index] < SATURATED_DISTANCE ? _distances[index] : GetSaturatedDistance(index);
+        }
+
+        /** Computes the distance of an element too far from its home slot for the distance to be stored. */
+        size_t GetSaturatedDistance(size_t index) const
+        {
+            return index - Home(Hash(KeyOf()(_slots[index])));
+        }
+
+        /**
+         * Returns the first empty slot in the probe sequence of the hash. Returns NOT_FOUND if the element would be past
+         * the last slot.
+         */
+        size_t FindInsertIndex(UINT64 hash) const
+        {
+            size_t index = Home(hash);
+            while (true)
+            {
+                const UINT32 empty = FlatHashGroup(_control + index).MatchEmpty();
+                if (empty != 0)
+                {
+                    index += FlatHashGroup::FirstBit(empty);
+                    return index < _slotCount ? index : NOT_FOUND;
+                }
+
+                index += GROUP_SIZE;
+            }
+        }
+
+        void EraseAt(size_t index)
+        {
+            _slots[index].~Slot();
+
+            // Moves back elements that probed past the removed one, so no probe sequence contains an empty slot
+            size_t hole = index;
+            for (size_t i = index + 1; _control[i] >= 0; i++)
+            {
+                // Elements whose home slot is after the hole must stay
+                const size_t distance = GetDistance(i);
+                if (distance < i - hole)
+                    continue;
+
+                new (&_slots[hole]) Slot(std::move(_slots[i]));
+                _slots[i].~Slot();
+                _control[hole] = _control[i];
+                _distances[hole] = Distance(hole, i - distance);
+                hole = i;
+            }
+
+            _control[hole] = FlatHashGroup::EMPTY;
+            _size--;
+        }
+
+        /**
+         * Allocates arrays for the provided number of home slots, followed by @p tail more slots for probes that run
+         * past the last home slot, and moves the elements over. The tail is made longer if elements don't fit.
+         */
+        void Rehash(size_t capacity, size_t tail = GROUP_SIZE)
+        {
+            INT8* oldControl = _control;
+            Slot* oldSlots = _slots;
+            const size_t oldSlotCount = _slotCount;
+
+            Allocate(capacity, capacity + tail);
+
+            Vector<Slot, SlotAllocator> spilled;
+            for (size_t i = 0; i < oldSlotCount; i++)
+            {
+                if (oldControl[i] < 0)
+                    continue;
+
+                const UINT64 hash = Hash(KeyOf()(oldSlots[i]));
+                const size_t index = FindInsertIndex(hash);
+                if (index != NOT_FOUND)
+                    Place(index, hash, std::move(oldSlots[i]));
+                else
+                    spilled.push_back(std::move(oldSlots[i]));
+
+                oldSlots[i].~Slot();
+            }
+
+            Deallocate(oldControl, oldSlots, oldSlotCount);
+
+            // Elements placed so far keep fitting with a longer tail, so this never spills again
+            for (auto& value : spilled)
+            {
+                const UINT64 hash = Hash(KeyOf()(value));
+
+                size_t index;
+                while ((index = FindInsertIndex(hash)) == NOT_FOUND)
+                    Rehash(_capacity, (_slotCount - _capacity) * 2);
+
+                Place(index, hash, std::move(value));
+            }
+        }
+
+        /** Moves an element into an empty slot. */
+        void Place(size_t index, UINT64 hash, Slot&& value)
+        {
+            new (&_slots[index]) Slot(std::move(value));
+            _control[index] = Fragment(hash);
+            _distances[index] = Distance(index, Home(hash));
+        }
+
+        /** Allocates empty arrays. Doesn't free the previous ones. */
+        void Allocate(size_t capacity, size_t slotCount)
+        {
+            _capacity = capacity;
+            _slotCount = slotCount;
+
+            // A sentinel ends the slots, followed by empty bytes so groups can be loaded at any slot. The distances
+            // are stored after them, in the same allocation.
+            ControlAllocator controlAllocator(_allocator);
+            _control = controlAllocator.allocate(GetControlSize(_slotCount));
+            memset(_control, FlatHashGroup::EMPTY, _slotCount + GROUP_SIZE);
+            _control[_slotCount] = FlatHashGroup::SENTINEL;
+            _distances = (UINT8*)(_control + _slotCount + GROUP_SIZE);
+
+            SlotAllocator slotAllocator(_allocator);
+            _slots = slotAllocator.allocate(_slotCount);
+        }
+
+        void Deallocate(INT8* control, Slot* slots, size_t slotCount)
+        {
+            if (slotCount == 0)
+                return;
+
+            ControlAllocator controlAllocator(_allocator);
+            controlAllocator.deallocate(control, GetControlSize(slotCount));
+
+            SlotAllocator slotAllocator(_allocator);
+            slotAllocator.deallocate(slots, slotCount);
+        }
+
+        /** Returns the size of the allocation holding the control bytes and distances. */
+        static size_t GetControlSize(size_t slotCount) { return slotCount + GROUP_SIZE + slotCount; }
+
+        void DestroySlots()
+        {
+            if (!std::is_trivially_destructible<Slot>::value)
+            {
+                for (size_t i = 0; i < _slotCount; i++)
+                {
+                    if (_control[i] >= 0)
+                        _slots[i].~Slot();
+                }
+            }
+        }
+
+        void Release()
+        {
+            DestroySlots();
+            Deallocate(_control, _slots, _slotCount);
+
+            _control = EmptyControl();
+            _distances = nullptr;
+            _slots = nullptr;
+            _size = 0;
+            _capacity = 0;
+            _slotCount = 0;
+        }
+
+        void CopyFrom(const FlatHashTable& other)
+        {
+            if (other._size == 0)
+                return;
+
+            Allocate(other._capacity, other._slotCount);
+            memcpy(_control, other._control, GetControlSize(_slotCount));
+
+            for (size_t i = 0; i < _slotCount; i++)
+            {
+                if (_control[i] >= 0)
+                    new (&_slots[i]) Slot(other._slots[i]);
+            }
+
+            _size = other._size;
+        }
+
+        void Steal(FlatHashTable& other)
+        {
+            _control = other._control;
+            _distances = other._distances;
+            _slots = other._slots;
+            _size = other._size;
+            _capacity = other._capacity;
+            _slotCount = other._slotCount;
+
+            other._control = EmptyControl();
+            other._distances = nullptr;
+            other._slots = nullptr;
+            other._size = 0;
+            other._capacity = 0;
+            other._slotCount = 0;
+        }
+
+        /** Control bytes of tables without allocated memory, so iteration needs no special case for them. */
+        static INT8* EmptyControl()
+        {
+            static INT8 control[GROUP_SIZE] = { FlatHashGroup::SENTINEL, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY,
+                FlatHashGroup::EMPTY, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY,
+                FlatHashGroup::EMPTY, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY,
+                FlatHashGroup::EMPTY, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY, FlatHashGroup::EMPTY,
+                FlatHashGroup::EMPTY };
+
+            return control;
+        }
+
+        H _hasher;
+        C _equal;
+        A _allocator;
+
+        INT8* _control = EmptyControl();
+        UINT8* _distances = nullptr;
+        Slot* _slots = nullptr;
+        size_t _size = 0;
+        size_t _capacity = 0;
+        size_t _slotCount = 0;
+    };
+
+    /** Returns the key of a FlatHashMap element. */
+    struct FlatHashMapKeyOf
+    {
+        template <typename T>
+        const typename T::first_type& operator()(const T& value) const { return value.first; }
+    };
+
+    /** Returns the key of a FlatHashSet element, which is the element itself. */
+    struct FlatHashSetKeyOf
+    {
+        template <typename T>
+        const T& operator()(const T& value) const { return value; }
+    };
+
+    /**
+     * Hash map storing its elements in a single array, see FlatHashTable. Much faster than UnorderedMap for lookups
+     * and iteration, and doesn't allocate per element. Has the same interface as UnorderedMap so it can replace it.
+     *
+     * Unlike UnorderedMap, adding or removing elements moves other elements, so it invalidates all iterators, pointers
+     * and references to elements, except for iterators returned by erase(). Elements are stored as Pair<K, V> instead
+     * of Pair<const K, V>, but their keys must not be modified.
+     */
+    template <typename K, typename V, typename H = HashType<K>, typename C = std::equal_to<K>,
+        typename A = StdAllocator<Pair<K, V>>>
+    class FlatHashMap : public FlatHashTable<K, Pair<K, V>, FlatHashMapKeyOf, H, C, A>
+    {
+        using Base = FlatHashTable<K, Pair<K, V>, FlatHashMapKeyOf, H, C, A>;
+
+    public:
+        using mapped_type = V;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        FlatHashMap() = default;
+
+        FlatHashMap(std::initializer_list<Pair<K, V>> values)
+        {
+            this->reserve(values.size());
+            for (auto& value : values)
+                insert(value);
+        }
+
+        /** Adds a copy of the element, unless an element with the same key exists. */
+        Pair<iterator, bool> insert(const Pair<K, V>& value)
+        {
+            return this->EmplaceKey(value.first, value);
+        }
+
+        /** @copydoc insert(const Pair<K, V>&) */
+        Pair<iterator, bool> insert(Pair<K, V>&& value)
+        {
+            return this->EmplaceKey(value.first, std::move(value));
+        }
+
+        /** Adds an element with the value constructed from @p args, unless an element with the key exists. */
+        template <typename... Args>
+        Pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+        {
+            return this->EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        /** @copydoc try_emplace(const K&, Args&&...) */
+        template <typename... Args>
+        Pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+        {
+            return this->EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        /** Returns the value of the key, adding a default constructed one first if the key isn't in the map. */
+        V& operator[](const K& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        /** @copydoc operator[](const K&) */
+        V& operator[](K&& key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+    };
+
+    /**
+     * Hash set storing its elements in a single array, see FlatHashTable. Much faster than UnorderedSet for lookups
+     * and iteration, and doesn't allocate per element. Has the same interface as UnorderedSet so it can replace it.
+     *
+     * Unlike UnorderedSet, adding or removing elements moves other elements, so it invalidates all iterators, pointers
+     * and references to elements, except for iterators returned by erase().
+     */
+    template <typename T, typename H = HashType<T>, typename C = std::equal_to<T>, typename A = StdAllocator<T>>
+    class FlatHashSet : public FlatHashTable<T, T, FlatHashSetKeyOf, H, C, A>
+    {
+        using Base = FlatHashTable<T, T, FlatHashSetKeyOf, H, C, A>;
+
+    public:
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        FlatHashSet() = default;
+
+        FlatHashSet(std::initializer_list<T> values)
+        {
+            this->reserve(values.size());
+            for (auto& value : values)
+                insert(value);
+        }
+
+        /** Adds a copy of the element, unless it is in the set already. */
+        Pair<iterator, bool> insert(const T& value)
+        {
+            return this->EmplaceKey(value, value);
+        }
+
+        /** @copydoc insert(const T&) */
+        Pair<iterator, bool> insert(T&& value)
+        {
+            return this->EmplaceKey(value, std::move(value));
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,807 @@
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeHash.h"
+#include "FileSystem/TeDataStream.h"
+
+#if defined(__AVX2__)
+#   define TE_HASH_AVX2 1
+#   include <immintrin.h>
+#elif defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64)))
+#   define TE_HASH_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+#   include <intrin.h>
+#endif
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 PRIME32_1 = 0x9E3779B1U;
+        constexpr UINT32 PRIME32_2 = 0x85EBCA77U;
+        constexpr UINT32 PRIME32_3 = 0xC2B2AE3DU;
+
+        constexpr UINT64 PRIME64_1 = 0x9E3779B185EBCA87ULL;
+        constexpr UINT64 PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr UINT64 PRIME64_3 = 0x165667B19E3779F9ULL;
+        constexpr UINT64 PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr UINT64 PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+        constexpr UINT64 PRIME_MX1 = 0x165667919E3779F9ULL;
+        constexpr UINT64 PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+        /** Number of bytes processed by one accumulation of long inputs. */
+        constexpr size_t STRIPE_SIZE = 64;
+
+        /** Number of bytes the secret is offset by for each stripe. */
+        constexpr size_t SECRET_CONSUME_RATE = 8;
+
+        constexpr size_t SECRET_SIZE = 192;
+        constexpr size_t SECRET_SIZE_MIN = 136;
+        constexpr size_t SECRET_LASTACC_START = 7;
+        constexpr size_t SECRET_MERGEACCS_START = 11;
+
+        /** Number of stripes between scrambles of the accumulators. */
+        constexpr size_t STRIPES_PER_BLOCK = (SECRET_SIZE - STRIPE_SIZE) / SECRET_CONSUME_RATE;
+        constexpr size_t BLOCK_SIZE = STRIPE_SIZE * STRIPES_PER_BLOCK;
+
+        /** Largest input not processed in stripes. */
+        constexpr size_t MIDSIZE_MAX = 240;
+        constexpr size_t MIDSIZE_STARTOFFSET = 3;
+        constexpr size_t MIDSIZE_LASTOFFSET = 17;
+
+        /** Default secret of XXH3, which seeds alter. */
+        alignas(64) const UINT8 DEFAULT_SECRET[SECRET_SIZE] =
+        {
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
+
+        /** Size of the chunks streams are read in. */
+        constexpr size_t STREAM_CHUNK_SIZE = 16 * 1024;
+
+        // Note: All loads assume a little endian platform, like the rest of the engine's serialization
+        UINT32 Read32(const UINT8* data)
+        {
+            UINT32 value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        UINT64 Read64(const UINT8* data)
+        {
+            UINT64 value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        void Write64(UINT8* data, UINT64 value)
+        {
+            memcpy(data, &value, sizeof(value));
+        }
+
+        UINT32 Swap32(UINT32 value)
+        {
+            return ((value << 24) & 0xFF000000U) | ((value << 8) & 0x00FF0000U) |
+                ((value >> 8) & 0x0000FF00U) | ((value >> 24) & 0x000000FFU);
+        }
+
+        UINT64 Swap64(UINT64 value)
+        {
+            return ((UINT64)Swap32((UINT32)value) << 32) | Swap32((UINT32)(value >> 32));
+        }
+
+        UINT32 RotateLeft32(UINT32 value, UINT32 bits)
+        {
+            return (value << bits) | (value >> (32 - bits));
+        }
+
+        UINT64 RotateLeft64(UINT64 value, UINT32 bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        /** Full 64x64 to 128-bit multiplication. */
+        Hash128 Multiply128(UINT64 lhs, UINT64 rhs)
+        {
+            Hash128 output;
+
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = (unsigned __int128)lhs * rhs;
+            output.Low = (UINT64)product;
+            output.High = (UINT64)(product >> 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+            output.Low = _umul128(lhs, rhs, &output.High);
+#else
+            const UINT64 loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+            const UINT64 hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+            const UINT64 loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+            const UINT64 hiHi = (lhs >> 32) * (rhs >> 32);
+
+            const UINT64 cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+            output.High = (hiLo >> 32) + (cross >> 32) + hiHi;
+            output.Low = (cross << 32) | (loLo & 0xFFFFFFFF);
+#endif
+
+            return output;
+        }
+
+        /** Multiplies into 128 bits, and folds the result back to 64 bits. */
+        UINT64 MultiplyFold64(UINT64 lhs, UINT64 rhs)
+        {
+            const Hash128 product = Multiply128(lhs, rhs);
+            return product.Low ^ product.High;
+        }
+
+        UINT64 XorShift64(UINT64 value, UINT32 shift)
+        {
+            return value ^ (value >> shift);
+        }
+
+        /** Final mix of XXH64, used by the shortest inputs. */
+        UINT64 Avalanche64(UINT64 hash)
+        {
+            hash ^= hash >> 33;
+            hash *= PRIME64_2;
+            hash ^= hash >> 29;
+            hash *= PRIME64_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        UINT64 Avalanche(UINT64 hash)
+        {
+            hash = XorShift64(hash, 37);
+            hash *= PRIME_MX1;
+            hash = XorShift64(hash, 32);
+            return hash;
+        }
+
+        /** Stronger final mix for 4 to 8 byte inputs, which are keyed by a single multiplication only. */
+        UINT64 RotateRotateMultiply(UINT64 hash, UINT64 size)
+        {
+            hash ^= RotateLeft64(hash, 49) ^ RotateLeft64(hash, 24);
+            hash *= PRIME_MX2;
+            hash ^= (hash >> 35) + size;
+            hash *= PRIME_MX2;
+            return XorShift64(hash, 28);
+        }
+
+        UINT64 Mix16(const UINT8* input, const UINT8* secret, UINT64 seed)
+        {
+            return MultiplyFold64(
+                Read64(input) ^ (Read64(secret) + seed),
+                Read64(input + 8) ^ (Read64(secret + 8) - seed));
+        }
+
+        Hash128 Mix32(Hash128 acc, const UINT8* input1, const UINT8* input2, const UINT8* secret, UINT64 seed)
+        {
+            acc.Low += Mix16(input1, secret, seed);
+            acc.Low ^= Read64(input2) + Read64(input2 + 8);
+            acc.High += Mix16(input2, secret + 16, seed);
+            acc.High ^= Read64(input1) + Read64(input1 + 8);
+            return acc;
+        }
+
+        UINT64 Hash64Short(const UINT8* input, size_t size, const UINT8* secret, UINT64 seed)
+        {
+            if (size > 8)
+            {
+                const UINT64 bitflip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+                const UINT64 bitflip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+                const UINT64 low = Read64(input) ^ bitflip1;
+                const UINT64 high = Read64(input + size - 8) ^ bitflip2;
+                const UINT64 acc = size + Swap64(low) + high + MultiplyFold64(low, high);
+                return Avalanche(acc);
+            }
+
+            if (size >= 4)
+            {
+                seed ^= (UINT64)Swap32((UINT32)seed) << 32;
+                const UINT64 bitflip = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+                const UINT64 value = Read32(input + size - 4) + ((UINT64)Read32(input) << 32);
+                return RotateRotateMultiply(value ^ bitflip, size);
+            }
+
+            if (size > 0)
+            {
+                const UINT32 combined = ((UINT32)input[0] << 16) | ((UINT32)input[size >> 1] << 24) |
+                    (UINT32)input[size - 1] | ((UINT32)size << 8);
+                const UINT64 bitflip = (Read32(secret) ^ Read32(secret + 4)) + seed;
+                return Avalanche64(combined ^ bitflip);
+            }
+
+            return Avalanche64(seed ^ (Read64(secret + 56) ^ Read64(secret + 64)));
+        }
+
+        UINT64 Hash64Medium(const UINT8* input, size_t size, const UINT8* secret, UINT64 seed)
+        {
+            UINT64 acc = size * PRIME64_1;
+
+            if (size <= 128)
+            {
+                if (size > 32)
+                {
+                    if (size > 64)
+                    {
+                        if (size > 96)
+                        {
+                            acc += Mix16(input + 48, secret + 96, seed);
+                            acc += Mix16(input + size - 64, secret + 112, seed);
+                        }
+
+                        acc += Mix16(input + 32, secret + 64, seed);
+                        acc += Mix16(input + size - 48, secret + 80, seed);
+                    }
+
+                    acc += Mix16(input + 16, secret + 32, seed);
+                    acc += Mix16(input + size - 32, secret + 48, seed);
+                }
+
+                acc += Mix16(input, secret, seed);
+                acc += Mix16(input + size - 16, secret + 16, seed);
+
+                return Avalanche(acc);
+            }
+
+            const size_t rounds = size / 16;
+            for (size_t i = 0; i < 8; i++)
+                acc += Mix16(input + 16 * i, secret + 16 * i, seed);
+
+            UINT64 accEnd = Mix16(input + size - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET, seed);
+            acc = Avalanche(acc);
+
+            for (size_t i = 8; i < rounds; i++)
+                accEnd += Mix16(input + 16 * i, secret + 16 * (i - 8) + MIDSIZE_STARTOFFSET, seed);
+
+            return Avalanche(acc + accEnd);
+        }
+
+        Hash128 Hash128Short(const UINT8* input, size_t size, const UINT8* secret, UINT64 seed)
+        {
+            Hash128 output;
+
+            if (size > 8)
+            {
+                const UINT64 bitflipLow = (Read64(secret + 32) ^ Read64(secret + 40)) - seed;
+                const UINT64 bitflipHigh = (Read64(secret + 48) ^ Read64(secret + 56)) + seed;
+                const UINT64 low = Read64(input);
+                UINT64 high = Read64(input + size - 8);
+
+                Hash128 product = Multiply128(low ^ high ^ bitflipLow, PRIME64_1);
+                product.Low += (UINT64)(size - 1) << 54;
+                high ^= bitflipHigh;
+                product.High += high + (UINT64)(UINT32)high * (PRIME32_2 - 1);
+                product.Low ^= Swap64(product.High);
+
+                output = Multiply128(product.Low, PRIME64_2);
+                output.High += product.High * PRIME64_2;
+                output.Low = Avalanche(output.Low);
+                output.High = Avalanche(output.High);
+                return output;
+            }
+
+            if (size >= 4)
+            {
+                seed ^= (UINT64)Swap32((UINT32)seed) << 32;
+                const UINT64 value = Read32(input) + ((UINT64)Read32(input + size - 4) << 32);
+                const UINT64 bitflip = (Read64(secret + 16) ^ Read64(secret + 24)) + seed;
+
+                output = Multiply128(value ^ bitflip, PRIME64_1 + (size << 2));
+                output.High += output.Low << 1;
+                output.Low ^= output.High >> 3;
+                output.Low = XorShift64(output.Low, 35);
+                output.Low *= PRIME_MX2;
+                output.Low = XorShift64(output.Low, 28);
+                output.High = Avalanche(output.High);
+                return output;
+            }
+
+            if (size > 0)
+            {
+                const UINT32 combinedLow = ((UINT32)input[0] << 16) | ((UINT32)input[size >> 1] << 24) |
+                    (UINT32)input[size - 1] | ((UINT32)size << 8);
+                const UINT32 combinedHigh = RotateLeft32(Swap32(combinedLow), 13);
+                const UINT64 bitflipLow = (Read32(secret) ^ Read32(secret + 4)) + seed;
+                const UINT64 bitflipHigh = (Read32(secret + 8) ^ Read32(secret + 12)) - seed;
+
+                output.Low = Avalanche64(combinedLow ^ bitflipLow);
+                output.High = Avalanche64(combinedHigh ^ bitflipHigh);
+                return output;
+            }
+
+            output.Low = Avalanche64(seed ^ Read64(secret + 64) ^ Read64(secret + 72));
+            output.High = Avalanche64(seed ^ Read64(secret + 80) ^ Read64(secret + 88));
+            return output;
+        }
+
+        Hash128 Hash128Medium(const UINT8* input, size_t size, const UINT8* secret, UINT64 seed)
+        {
+            Hash128 acc;
+            acc.Low = size * PRIME64_1;
+            acc.High = 0;
+
+            if (size <= 128)
+            {
+                if (size > 32)
+                {
+                    if (size > 64)
+                    {
+                        if (size > 96)
+                            acc = Mix32(acc, input + 48, input + size - 64, secret + 96, seed);
+
+                        acc = Mix32(acc, input + 32, input + size - 48, secret + 64, seed);
+                    }
+
+                    acc = Mix32(acc, input + 16, input + size - 32, secret + 32, seed);
+                }
+
+                acc = Mix32(acc, input, input + size - 16, secret, seed);
+            }
+            else
+            {
+                for (size_t i = 32; i < 160; i += 32)
+                    acc = Mix32(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+
+                acc.Low = Avalanche(acc.Low);
+                acc.High = Avalanche(acc.High);
+
+                for (size_t i = 160; i <= size; i += 32)
+                {
+                    acc = Mix32(acc, input + i - 32, input + i - 16, secret + MIDSIZE_STARTOFFSET + i - 160, seed);
+                }
+
+                acc = Mix32(acc, input + size - 16, input + size - 32,
+                    secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET - 16, 0 - seed);
+            }
+
+            Hash128 output;
+            output.Low = Avalanche(acc.Low + acc.High);
+            output.High = 0 - Avalanche(acc.Low * PRIME64_1 + acc.High * PRIME64_4 + (size - seed) * PRIME64_2);
+            return output;
+        }
+
+        /**
+         * Accumulates consecutive 64 byte stripes of the input. Each stripe uses the secret offset by 8 more bytes than
+         * the previous one.
+         */
+        void Accumulate(UINT64* acc, const UINT8* input, const UINT8* secret, size_t stripes)
+        {
+#if TE_HASH_AVX2
+            __m256i acc0 = _mm256_loadu_si256((const __m256i*)acc);
+            __m256i acc1 = _mm256_loadu_si256((const __m256i*)(acc + 4));
+
+            for (size_t i = 0; i < stripes; i++)
+            {
+                const UINT8* stripe = input + i * STRIPE_SIZE;
+                const UINT8* key = secret + i * SECRET_CONSUME_RATE;
+
+                const __m256i data0 = _mm256_loadu_si256((const __m256i*)stripe);
+                const __m256i data1 = _mm256_loadu_si256((const __m256i*)(stripe + 32));
+                const __m256i keyed0 = _mm256_xor_si256(data0, _mm256_loadu_si256((const __m256i*)key));
+                const __m256i keyed1 = _mm256_xor_si256(data1, _mm256_loadu_si256((const __m256i*)(key + 32)));
+
+                // Multiplies the low and high 32 bits of each keyed lane, and adds the input of the neighbour lane
+                const __m256i shifted0 = _mm256_shuffle_epi32(keyed0, _MM_SHUFFLE(0, 3, 0, 1));
+                const __m256i product0 = _mm256_mul_epu32(keyed0, shifted0);
+                const __m256i shifted1 = _mm256_shuffle_epi32(keyed1, _MM_SHUFFLE(0, 3, 0, 1));
+                const __m256i product1 = _mm256_mul_epu32(keyed1, shifted1);
+                acc0 = _mm256_add_epi64(acc0, _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2)));
+                acc1 = _mm256_add_epi64(acc1, _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2)));
+                acc0 = _mm256_add_epi64(acc0, product0);
+                acc1 = _mm256_add_epi64(acc1, product1);
+            }
+
+            _mm256_storeu_si256((__m256i*)acc, acc0);
+            _mm256_storeu_si256((__m256i*)(acc + 4), acc1);
+#elif TE_HASH_SSE2
+            __m128i accs[4];
+            for (UINT32 lane = 0; lane < 4; lane++)
+                accs[lane] = _mm_loadu_si128((const __m128i*)(acc + lane * 2));
+
+            for (size_t i = 0; i < stripes; i++)
+            {
+                const UINT8* stripe = input + i * STRIPE_SIZE;
+                const UINT8* key = secret + i * SECRET_CONSUME_RATE;
+
+                for (UINT32 lane = 0; lane < 4; lane++)
+                {
+                    // Multiplies the low and high 32 bits of each keyed lane, and adds the input of the neighbour lane
+                    const __m128i data = _mm_loadu_si128((const __m128i*)(stripe + lane * 16));
+                    const __m128i keyed = _mm_xor_si128(data, _mm_loadu_si128((const __m128i*)(key + lane * 16)));
+                    const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                    const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                    accs[lane] = _mm_add_epi64(accs[lane], _mm_add_epi64(product, swapped));
+                }
+            }
+
+            for (UINT32 lane = 0; lane < 4; lane++)
+                _mm_storeu_si128((__m128i*)(acc + lane * 2), accs[lane]);
+#else
+            for (size_t i = 0; i < stripes; i++)
+            {
+                const UINT8* stripe = input + i * STRIPE_SIZE;
+                const UINT8* key = secret + i * SECRET_CONSUME_RATE;
+
+                for (UINT32 lane = 0; lane < 8; lane++)
+                {
+                    const UINT64 data = Read64(stripe + lane * 8);
+                    const UINT64 keyed = data ^ Read64(key + lane * 8);
+                    acc[lane ^ 1] += data;
+                    acc[lane] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+                }
+            }
+#endif
+        }
+
+        /** Mixes the accumulators after a full block of stripes, so their high bits feed back into the low ones. */
+        void Scramble(UINT64* acc, const UINT8* secret)
+        {
+#if TE_HASH_AVX2
+            const __m256i prime = _mm256_set1_epi32((int)PRIME32_1);
+
+            for (UINT32 lane = 0; lane < 2; lane++)
+            {
+                __m256i value = _mm256_loadu_si256((const __m256i*)(acc + lane * 4));
+                value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+                value = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)(secret + lane * 32)));
+
+                // 64-bit multiplication by a 32-bit constant, from two 32x32 bit multiplications
+                const __m256i productLow = _mm256_mul_epu32(value, prime);
+                const __m256i high = _mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+                const __m256i productHigh = _mm256_mul_epu32(high, prime);
+                value = _mm256_add_epi64(productLow, _mm256_slli_epi64(productHigh, 32));
+
+                _mm256_storeu_si256((__m256i*)(acc + lane * 4), value);
+            }
+#elif TE_HASH_SSE2
+            const __m128i prime = _mm_set1_epi32((int)PRIME32_1);
+
+            for (UINT32 lane = 0; lane < 4; lane++)
+            {
+                __m128i value = _mm_loadu_si128((const __m128i*)(acc + lane * 2));
+                value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+                value = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)(secret + lane * 16)));
+
+                // 64-bit multiplication by a 32-bit constant, from two 32x32 bit multiplications
+                const __m128i productLow = _mm_mul_epu32(value, prime);
+                const __m128i productHigh = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                value = _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32));
+
+                _mm_storeu_si128((__m128i*)(acc + lane * 2), value);
+            }
+#else
+            for (UINT32 lane = 0; lane < 8; lane++)
+            {
+                UINT64 value = XorShift64(acc[lane], 47);
+                value ^= Read64(secret + lane * 8);
+                acc[lane] = value * PRIME32_1;
+            }
+#endif
+        }
+
+        void InitializeAccumulators(UINT64* acc)
+        {
+            acc[0] = PRIME32_3;
+            acc[1] = PRIME64_1;
+            acc[2] = PRIME64_2;
+            acc[3] = PRIME64_3;
+            acc[4] = PRIME64_4;
+            acc[5] = PRIME32_2;
+            acc[6] = PRIME64_5;
+            acc[7] = PRIME32_1;
+        }
+
+        /** Derives the secret used for long inputs from the seed. */
+        void InitializeSecret(UINT8* secret, UINT64 seed)
+        {
+            for (size_t i = 0; i < SECRET_SIZE; i += 16)
+            {
+                Write64(secret + i, Read64(DEFAULT_SECRET + i) + seed);
+                Write64(secret + i + 8, Read64(DEFAULT_SECRET + i + 8) - seed);
+            }
+        }
+
+        UINT64 MergeAccumulators(const UINT64* acc, const UINT8* secret, UINT64 start)
+        {
+            UINT64 result = start;
+            for (UINT32 i = 0; i < 4; i++)
+            {
+                result += MultiplyFold64(
+                    acc[2 * i] ^ Read64(secret + 16 * i),
+                    acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+            }
+
+            return Avalanche(result);
+        }
+
+        /** Accumulates all of an input larger than MIDSIZE_MAX. */
+        void AccumulateLong(UINT64* acc, const UINT8* input, size_t size, const UINT8* secret)
+        {
+            InitializeAccumulators(acc);
+
+            const size_t blocks = (size - 1) / BLOCK_SIZE;
+            for (size_t i = 0; i < blocks; i++)
+            {
+                Accumulate(acc, input + i * BLOCK_SIZE, secret, STRIPES_PER_BLOCK);
+                Scramble(acc, secret + SECRET_SIZE - STRIPE_SIZE);
+            }
+
+            const size_t stripes = ((size - 1) - BLOCK_SIZE * blocks) / STRIPE_SIZE;
+            Accumulate(acc, input + blocks * BLOCK_SIZE, secret, stripes);
+
+            // Last stripe always ends at the end of the input, even if it overlaps the previous one
+            Accumulate(acc, input + size - STRIPE_SIZE, secret + SECRET_SIZE - STRIPE_SIZE - SECRET_LASTACC_START, 1);
+        }
+
+        UINT64 Hash64Long(const UINT8* input, size_t size, UINT64 seed)
+        {
+            alignas(64) UINT8 customSecret[SECRET_SIZE];
+            const UINT8* secret = DEFAULT_SECRET;
+            if (seed != 0)
+            {
+                InitializeSecret(customSecret, seed);
+                secret = customSecret;
+            }
+
+            alignas(64) UINT64 acc[8];
+            AccumulateLong(acc, input, size, secret);
+
+            return MergeAccumulators(acc, secret + SECRET_MERGEACCS_START, size * PRIME64_1);
+        }
+
+        Hash128 Hash128Long(const UINT8* input, size_t size, UINT64 seed)
+        {
+            alignas(64) UINT8 customSecret[SECRET_SIZE];
+            const UINT8* secret = DEFAULT_SECRET;
+            if (seed != 0)
+            {
+                InitializeSecret(customSecret, seed);
+                secret = customSecret;
+            }
+
+            alignas(64) UINT64 acc[8];
+            AccumulateLong(acc, input, size, secret);
+
+            Hash128 output;
+            output.Low = MergeAccumulators(acc, secret + SECRET_MERGEACCS_START, size * PRIME64_1);
+            output.High = MergeAccumulators(acc, secret + SECRET_SIZE - sizeof(acc) - SECRET_MERGEACCS_START,
+                ~(size * PRIME64_2));
+            return output;
+        }
+
+        const char HEX_DIGITS[] = "0123456789abcdef";
+    }
+
+    UINT64 HashBytes(const void* data, size_t size, UINT64 seed)
+    {
+        const UINT8* input = (const UINT8*)data;
+
+        if (size <= 16)
+            return Hash64Short(input, size, DEFAULT_SECRET, seed);
+
+        if (size <= MIDSIZE_MAX)
+            return Hash64Medium(input, size, DEFAULT_SECRET, seed);
+
+        return Hash64Long(input, size, seed);
+    }
+
+    Hash128 HashBytes128(const void* data, size_t size, UINT64 seed)
+    {
+        const UINT8* input = (const UINT8*)data;
+
+        if (size <= 16)
+            return Hash128Short(input, size, DEFAULT_SECRET, seed);
+
+        if (size <= MIDSIZE_MAX)
+            return Hash128Medium(input, size, DEFAULT_SECRET, seed);
+
+        return Hash128Long(input, size, seed);
+    }
+
+    UINT64 HashStream(DataStream& stream, UINT64 seed)
+    {
+        Hasher hasher(seed);
+        hasher.Update(stream);
+
+        return hasher.Digest();
+    }
+
+    Hash128 HashStream128(DataStream& stream, UINT64 seed)
+    {
+        Hasher hasher(seed);
+        hasher.Update(stream);
+
+        return hasher.Digest128();
+    }
+
+    String ToHexString(const void* data, size_t size)
+    {
+        const UINT8* bytes = (const UINT8*)data;
+
+        String output;
+        output.resize(size * 2);
+        for (size_t i = 0; i < size; i++)
+        {
+            output[i * 2] = HEX_DIGITS[bytes[i] >> 4];
+            output[i * 2 + 1] = HEX_DIGITS[bytes[i] & 0xF];
+        }
+
+        return output;
+    }
+
+    String ToString(const Hash128& hash)
+    {
+        String output;
+        output.resize(32);
+        for (UINT32 i = 0; i < 16; i++)
+        {
+            output[i] = HEX_DIGITS[(hash.High >> (60 - i * 4)) & 0xF];
+            output[i + 16] = HEX_DIGITS[(hash.Low >> (60 - i * 4)) & 0xF];
+        }
+
+        return output;
+    }
+
+    Hasher::Hasher(UINT64 seed)
+    {
+        Reset(seed);
+    }
+
+    void Hasher::Reset(UINT64 seed)
+    {
+        static_assert(BUFFER_SIZE % STRIPE_SIZE == 0, "Buffer must hold whole stripes.");
+
+        InitializeAccumulators(_acc);
+        InitializeSecret(_secret, seed);
+
+        _seed = seed;
+        _totalSize = 0;
+        _stripesSoFar = 0;
+        _bufferedSize = 0;
+    }
+
+    void Hasher::ConsumeStripes(UINT64* acc, size_t& stripesSoFar, const UINT8* input, size_t stripes) const
+    {
+        const UINT8* secret = _secret + stripesSoFar * SECRET_CONSUME_RATE;
+
+        if (stripes >= STRIPES_PER_BLOCK - stripesSoFar)
+        {
+            size_t blockStripes = STRIPES_PER_BLOCK - stripesSoFar;
+            do
+            {
+                Accumulate(acc, input, secret, blockStripes);
+                Scramble(acc, _secret + SECRET_SIZE - STRIPE_SIZE);
+
+                input += blockStripes * STRIPE_SIZE;
+                stripes -= blockStripes;
+                blockStripes = STRIPES_PER_BLOCK;
+                secret = _secret;
+                stripesSoFar = 0;
+            } while (stripes >= STRIPES_PER_BLOCK);
+        }
+
+        if (stripes > 0)
+        {
+            Accumulate(acc, input, secret, stripes);
+            stripesSoFar += stripes;
+        }
+    }
+
+    void Hasher::Update(const void* data, size_t size)
+    {
+        if (size == 0)
+            return;
+
+        const UINT8* input = (const UINT8*)data;
+        const UINT8* end = input + size;
+
+        _totalSize += size;
+
+        if (size <= BUFFER_SIZE - _bufferedSize)
+        {
+            memcpy(_buffer + _bufferedSize, input, size);
+            _bufferedSize += (UINT32)size;
+            return;
+        }
+
+        // The buffer is only consumed once more data follows it, so the last stripe is always processed by the digest
+        if (_bufferedSize > 0)
+        {
+            const size_t loadSize = BUFFER_SIZE - _bufferedSize;
+            memcpy(_buffer + _bufferedSize, input, loadSize);
+            input += loadSize;
+
+            ConsumeStripes(_acc, _stripesSoFar, _buffer, BUFFER_SIZE / STRIPE_SIZE);
+            _bufferedSize = 0;
+        }
+
+        if ((size_t)(end - input) > BUFFER_SIZE)
+        {
+            const size_t stripes = (size_t)(end - 1 - input) / STRIPE_SIZE;
+            ConsumeStripes(_acc, _stripesSoFar, input, stripes);
+            input += stripes * STRIPE_SIZE;
+
+            // Keeps the last consumed stripe, the digest might need it to complete a partial last stripe
+            memcpy(_buffer + BUFFER_SIZE - STRIPE_SIZE, input - STRIPE_SIZE, STRIPE_SIZE);
+        }
+
+        memcpy(_buffer, input, (size_t)(end - input));
+        _bufferedSize = (UINT32)(end - input);
+    }
+
+    void Hasher::Update(DataStream& stream)
+    {
+        UINT8 chunk[STREAM_CHUNK_SIZE];
+        while (!stream.Eof())
+        {
+            const size_t read = stream.Read(chunk, sizeof(chunk));
+            if (read == 0)
+                break;
+
+            Update(chunk, read);
+        }
+    }
+
+    void Hasher::DigestLong(UINT64* acc) const
+    {
+        memcpy(acc, _acc, sizeof(_acc));
+
+        UINT8 lastStripe[STRIPE_SIZE];
+        const UINT8* lastStripePtr;
+
+        if (_bufferedSize >= STRIPE_SIZE)
+        {
+            size_t stripesSoFar = _stripesSoFar;
+            ConsumeStripes(acc, stripesSoFar, _buffer, (_bufferedSize - 1) / STRIPE_SIZE);
+            lastStripePtr = _buffer + _bufferedSize - STRIPE_SIZE;
+        }
+        else
+        {
+            // Completes the last stripe with the end of the previously consumed data
+            const size_t catchupSize = STRIPE_SIZE - _bufferedSize;
+            memcpy(lastStripe, _buffer + BUFFER_SIZE - catchupSize, catchupSize);
+            memcpy(lastStripe + catchupSize, _buffer, _bufferedSize);
+            lastStripePtr = lastStripe;
+        }
+
+        Accumulate(acc, lastStripePtr, _secret + SECRET_SIZE - STRIPE_SIZE - SECRET_LASTACC_START, 1);
+    }
+
+    UINT64 Hasher::Digest() const
+    {
+        if (_totalSize <= MIDSIZE_MAX)
+            return HashBytes(_buffer, (size_t)_totalSize, _seed);
+
+        UINT64 acc[8];
+        DigestLong(acc);
+
+        return MergeAccumulators(acc, _secret + SECRET_MERGEACCS_START, _totalSize * PRIME64_1);
+    }
+
+    Hash128 Hasher::Digest128() const
+    {
+        if (_totalSize <= MIDSIZE_MAX)
+            return HashBytes128(_buffer, (size_t)_totalSize, _seed);
+
+        UINT64 acc[8];
+        DigestLong(acc);
+
+        Hash128 output;
+        output.Low = MergeAccumulators(acc, _secret + SECRET_MERGEACCS_START, _totalSize * PRIME64_1);
+        output.High = MergeAccumulators(acc, _secret + SECRET_SIZE - sizeof(acc) - SECRET_MERGEACCS_START,
+            ~(_totalSize * PRIME64_2));
+        return output;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "String/TeString.h"
+
+namespace te
+{
+    /** 128-bit hash value, see HashBytes128(). */
+    struct Hash128
+    {
+        UINT64 Low = 0;
+        UINT64 High = 0;
+
+        bool operator==(const Hash128& rhs) const { return Low == rhs.Low && High == rhs.High; }
+        bool operator!=(const Hash128& rhs) const { return !(*this == rhs); }
+        bool operator<(const Hash128& rhs) const { return High < rhs.High || (High == rhs.High && Low < rhs.Low); }
+    };
+
+    /**
+     * Hashes a block of memory into a 64-bit value. Uses the XXH3 algorithm, so results match the reference xxHash
+     * library (XXH3_64bits_withSeed) and are stable across platforms and versions, which makes them safe to store on
+     * disk. Inputs longer than 240 bytes are processed 64 bytes at a time with SSE2 or AVX2 where available.
+     *
+     * Not a cryptographic hash, it must not be used where an attacker could choose the input to cause collisions.
+     */
+    TE_UTILITY_EXPORT UINT64 HashBytes(const void* data, size_t size, UINT64 seed = 0);
+
+    /**
+     * Hashes a block of memory into a 128-bit value, for when 64 bits aren't enough to make collisions unlikely (for
+     * example when identifying content across a large number of resources). Matches XXH3_128bits_withSeed.
+     */
+    TE_UTILITY_EXPORT Hash128 HashBytes128(const void* data, size_t size, UINT64 seed = 0);
+
+    /** Hashes the remaining contents of a stream, see HashBytes(). Reads the stream until the end. */
+    TE_UTILITY_EXPORT UINT64 HashStream(DataStream& stream, UINT64 seed = 0);
+
+    /** Hashes the remaining contents of a stream, see HashBytes128(). Reads the stream until the end. */
+    TE_UTILITY_EXPORT Hash128 HashStream128(DataStream& stream, UINT64 seed = 0);
+
+    /** Hashes the characters of a string, see HashBytes(). */
+    template <typename T>
+    UINT64 HashString(BasicStringView<T> value, UINT64 seed = 0)
+    {
+        return HashBytes(value.data(), value.size() * sizeof(T), seed);
+    }
+
+    /**
+     * Hashes an array of floats, see HashBytes(). Negative zeros are hashed as positive zeros, so values that compare
+     * equal always hash the same.
+     */
+    template <UINT32 Count>
+    UINT64 HashFloats(const float* values, UINT64 seed = 0)
+    {
+        float normalized[Count];
+        for (UINT32 i = 0; i < Count; i++)
+            normalized[i] = values[i] + 0.0f;
+
+        return HashBytes(normalized, sizeof(normalized), seed);
+    }
+
+    /** Converts bytes to a lowercase hexadecimal string, two characters per byte. */
+    TE_UTILITY_EXPORT String ToHexString(const void* data, size_t size);
+
+    /** Converts a hash to a 32 character hexadecimal string, most significant digits first. */
+    TE_UTILITY_EXPORT String ToString(const Hash128& hash);
+
+    /**
+     * Computes the same hashes as HashBytes() and HashBytes128() over data provided in multiple parts, so inputs don't
+     * need to be in memory all at once. Any split of the input into parts produces the same hash as hashing it whole.
+     *
+     * @note	Holds about 0.5KB of state, so avoid creating it where only a one-shot hash is needed.
+     */
+    class TE_UTILITY_EXPORT Hasher
+    {
+    public:
+        Hasher(UINT64 seed = 0);
+
+        /** Restarts hashing, discarding all previously provided data. */
+        void Reset(UINT64 seed = 0);
+
+        /** Appends data to the hashed input. */
+        void Update(const void* data, size_t size);
+
+        /** Appends the remaining contents of the stream to the hashed input. Reads the stream until the end. */
+        void Update(DataStream& stream);
+
+        /** Returns the 64-bit hash of all the data provided so far. More data can still be appended afterwards. */
+        UINT64 Digest() const;
+
+        /** Returns the 128-bit hash of all the data provided so far. More data can still be appended afterwards. */
+        Hash128 Digest128() const;
+
+    private:
+        static constexpr UINT32 SECRET_SIZE = 192;
+        static constexpr UINT32 BUFFER_SIZE = 256;
+
+        /** Processes stripes of the input once the total size is known to be larger than the buffer. */
+        void ConsumeStripes(UINT64* acc, size_t& stripesSoFar, const UINT8* input, size_t stripes) const;
+
+        /** Processes the buffered remainder into a copy of the accumulators, before they are merged. */
+        void DigestLong(UINT64* acc) const;
+
+        UINT64 _acc[8];
+        UINT8 _secret[SECRET_SIZE];
+        UINT8 _buffer[BUFFER_SIZE];
+        UINT64 _seed = 0;
+        UINT64 _totalSize = 0;
+        size_t _stripesSoFar = 0;
+        UINT32 _bufferedSize = 0;
+    };
+}
+
+namespace std
+{
+    /** Hash value generator for Hash128. */
+    template<>
+    struct hash<te::Hash128>
+    {
+        size_t operator()(const te::Hash128& value) const
+        {
+            return (size_t)value.Low;
+        }
+    };
+
+    /** Hash value generator for String. */
+    template<>
+    struct hash<te::String>
+    {
+        size_t operator()(const te::String& value) const
+        {
+            return (size_t)te::HashString<char>(value);
+        }
+    };
+
+    /** Hash value generator for WString. */
+    template<>
+    struct hash<te::WString>
+    {
+        size_t operator()(const te::WString& value) const
+        {
+            return (size_t)te::HashString<wchar_t>(value);
+        }
+    };
+}
\ No newline at end of file
@@ -16,5 +16,11 @@ namespace te
 
         /** Creates a new universally unique identifier (UUID/GUID). */
         static UUID GenerateUUID();
+
+        /**
+         * Suspends the calling thread for at least the provided amount of microseconds, using the most precise timer
+         * available on the platform. The thread can still wake up later than requested, depending on the scheduler.
+         */
+        static void SleepMicroseconds(UINT64 microseconds);
     };
 }
\ No newline at end of file
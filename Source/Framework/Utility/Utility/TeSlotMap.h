@@ -0,0 +1,224 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    /**
+     * Handle to an object stored in a SlotMap<T>: index of a slot, and generation of the slot when the object was
+     * inserted. The generation changes when the object is erased, so handles to erased objects are detected even after
+     * their slot is reused. Handles are plain values: copying one never touches memory shared with other threads.
+     */
+    template <typename T>
+    struct SlotHandle
+    {
+        UINT32 Index = (UINT32)-1;
+        UINT32 Generation = 0;
+
+        bool operator== (const SlotHandle& rhs) const { return Index == rhs.Index && Generation == rhs.Generation; }
+        bool operator!= (const SlotHandle& rhs) const { return !(*this == rhs); }
+
+        /** Returns true if the handle was never assigned. Use SlotMap::Contains() to know if the object still exists. */
+        bool IsNull() const { return Index == (UINT32)-1; }
+    };
+
+    /**
+     * Container owning objects referenced through generational handles, as a cheaper alternative to SPtr for objects
+     * created and destroyed at a high rate. Insertion, removal and handle validation are O(1) and never allocate once
+     * the container reached its peak size.
+     *
+     * Objects are stored densely in a single array, in no particular order, so iteration is as fast as over a Vector.
+     * A separate array of slots maps handles to positions in the dense array. Removal moves the last object in place of
+     * the removed one, meaning pointers and references to objects are invalidated by insertions and removals, but
+     * handles are not.
+     *
+     * @note	Not thread safe.
+     */
+    template <typename T>
+    class SlotMap
+    {
+    public:
+        typedef SlotHandle<T> Handle;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+
+        SlotMap() = default;
+
+        /** Constructs a new object in the map and returns its handle. */
+        template <typename... Args>
+        Handle Emplace(Args&&... args)
+        {
+            _values.emplace_back(std::forward<Args>(args)...);
+
+            UINT32 index;
+            if (_freeHead != INVALID_INDEX)
+            {
+                index = _freeHead;
+                _freeHead = _slots[index].Position;
+                _slots[index].Generation++;
+            }
+            else
+            {
+                index = (UINT32)_slots.size();
+                _slots.push_back({ 1, 0 });
+            }
+
+            Slot& slot = _slots[index];
+            slot.Position = (UINT32)_values.size() - 1;
+            _valueSlots.push_back(index);
+
+            return { index, slot.Generation };
+        }
+
+        /** Copies an object into the map and returns its handle. */
+        Handle Insert(const T& value) { return Emplace(value); }
+
+        /** Moves an object into the map and returns its handle. */
+        Handle Insert(T&& value) { return Emplace(std::move(value)); }
+
+        /** Destroys the object referenced by a handle. Returns false if the handle was already invalid. */
+        bool Erase(Handle handle)
+        {
+            if (!Contains(handle))
+                return false;
+
+            Slot& slot = _slots[handle.Index];
+            const UINT32 position = slot.Position;
+            const UINT32 last = (UINT32)_values.size() - 1;
+
+            if (position != last)
+            {
+                _values[position] = std::move(_values[last]);
+                _valueSlots[position] = _valueSlots[last];
+                _slots[_valueSlots[position]].Position = position;
+            }
+
+            _values.pop_back();
+            _valueSlots.pop_back();
+
+            slot.Generation++;
+            slot.Position = _freeHead;
+            _freeHead = handle.Index;
+
+            return true;
+        }
+
+        /** Checks if a handle references an object of the map. */
+        bool Contains(Handle handle) const
+        {
+            return IsLive(handle.Generation) && handle.Index < (UINT32)_slots.size() &&
+                _slots[handle.Index].Generation == handle.Generation;
+        }
+
+        /** Returns the object referenced by a handle, or null if the handle is invalid. */
+        T* Get(Handle handle) { return Contains(handle) ? &_values[_slots[handle.Index].Position] : nullptr; }
+
+        /** @copydoc Get */
+        const T* Get(Handle handle) const
+        {
+            return Contains(handle) ? &_values[_slots[handle.Index].Position] : nullptr;
+        }
+
+        /** Returns the object referenced by a handle. The handle must be valid. */
+        T& operator[] (Handle handle)
+        {
+            TE_ASSERT_ERROR(Contains(handle), "Accessing a SlotMap with an invalid handle");
+            return _values[_slots[handle.Index].Position];
+        }
+
+        /** @copydoc operator[] */
+        const T& operator[] (Handle handle) const
+        {
+            TE_ASSERT_ERROR(Contains(handle), "Accessing a SlotMap with an invalid handle");
+            return _values[_slots[handle.Index].Position];
+        }
+
+        /** Returns the handle of the object at a position of the dense array, e.g. while iterating. */
+        Handle GetHandle(UINT32 position) const
+        {
+            const UINT32 index = _valueSlots[position];
+            return { index, _slots[index].Generation };
+        }
+
+        /** Returns the handle of an object of the map, from a pointer or reference to it. */
+        Handle GetHandle(const T& value) const { return GetHandle((UINT32)(&value - _values.data())); }
+
+        /** Destroys all objects. Handles to them become invalid. */
+        void Clear()
+        {
+            for (auto& index : _valueSlots)
+            {
+                Slot& slot = _slots[index];
+                slot.Generation++;
+                slot.Position = _freeHead;
+                _freeHead = index;
+            }
+
+            _values.clear();
+            _valueSlots.clear();
+        }
+
+        /** Reserves memory for @p count objects, so that inserting up to that many doesn't allocate. */
+        void Reserve(UINT32 count)
+        {
+            _values.reserve(count);
+            _valueSlots.reserve(count);
+            _slots.reserve(count);
+        }
+
+        /** Returns the number of objects in the map. */
+        UINT32 Size() const { return (UINT32)_values.size(); }
+
+        /** Checks if the map holds no object. */
+        bool Empty() const { return _values.empty(); }
+
+        /** Returns the dense array of objects. */
+        T* Data() { return _values.data(); }
+
+        /** @copydoc Data */
+        const T* Data() const { return _values.data(); }
+
+        iterator begin() { return _values.data(); }
+        iterator end() { return _values.data() + _values.size(); }
+        const_iterator begin() const { return _values.data(); }
+        const_iterator end() const { return _values.data() + _values.size(); }
+
+    private:
+        static constexpr UINT32 INVALID_INDEX = (UINT32)-1;
+
+        /** Checks if a generation is the one of an object, rather than of a free slot. */
+        static bool IsLive(UINT32 generation) { return (generation & 1) != 0; }
+
+        /** Indirection from a handle to an object. */
+        struct Slot
+        {
+            /**
+             * Incremented when an object is inserted in or erased from the slot, so it is odd while the slot holds an
+             * object and even while it is free. Free slots never match a handle, even a forged one or one from another
+             * map. Starts at one so that zeroed handles are never valid.
+             */
+            UINT32 Generation;
+
+            /** Position of the object in the dense array, or next free slot if the slot is free. */
+            UINT32 Position;
+        };
+
+        Vector<T> _values;
+        Vector<UINT32> _valueSlots; /**< Slot of each object of the dense array. */
+        Vector<Slot> _slots;
+        UINT32 _freeHead = INVALID_INDEX; /**< First free slot, the others are linked through Slot::Position. */
+    };
+}
+
+namespace std
+{
+    /** Hash value generator for SlotHandle. */
+    template<typename T>
+    struct hash<te::SlotHandle<T>>
+    {
+        size_t operator()(const te::SlotHandle<T>& handle) const
+        {
+            return std::hash<te::UINT64>()(((te::UINT64)handle.Generation << 32) | handle.Index);
+        }
+    };
+}
\ No newline at end of file
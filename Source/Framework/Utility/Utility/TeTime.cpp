@@ -3,6 +3,8 @@
 namespace te
 {
     const double Time::MICROSEC_TO_SEC = 1.0 / 1000000.0;
+    const UINT64 Time::DEFAULT_FIXED_STEP = 16666;
+    const UINT32 Time::DEFAULT_MAX_FIXED_STEPS = 4;
 
     Time::Time()
         : _run(true)
@@ -12,6 +14,9 @@ namespace te
         , _appStartTime(0)
         , _lastFrameTime(0)
         , _currentFrame(0UL)
+        , _fixedStep(DEFAULT_FIXED_STEP)
+        , _fixedAccumulator(0)
+        , _maxFixedSteps(DEFAULT_MAX_FIXED_STEPS)
     {
         _timer.reset(new Timer());
         _appStartTime = _timer->GetStartMs();
@@ -29,6 +34,7 @@ namespace te
             UINT64 currentFrameTime = _timer->GetMicroseconds();
 
             _frameDelta = (float)((currentFrameTime - _lastFrameTime) * MICROSEC_TO_SEC);
+            _fixedAccumulator += currentFrameTime - _lastFrameTime;
             _timeSinceStartMs = (UINT64)(currentFrameTime / 1000);
             _timeSinceStart = _timeSinceStartMs / 1000.0f;
 
@@ -38,6 +44,28 @@ namespace te
         }
     }
 
+    void Time::SetFixedFrameDelta(float step)
+    {
+        _fixedStep = std::max((UINT64)(step / MICROSEC_TO_SEC), (UINT64)1);
+    }
+
+    UINT32 Time::GetFixedUpdateStep(UINT64& step)
+    {
+        step = _fixedStep;
+
+        // Drop simulation time we can't catch up on
+        UINT64 maxAccumulated = _fixedStep * _maxFixedSteps;
+        if (_fixedAccumulator > maxAccumulated)
+            _fixedAccumulator = maxAccumulated;
+
+        return (UINT32)(_fixedAccumulator / _fixedStep);
+    }
+
+    void Time::AdvanceFixedUpdate(UINT64 step)
+    {
+        _fixedAccumulator -= std::min(step, _fixedAccumulator);
+    }
+
     UINT64 Time::GetTimePrecise() const
     {
         return _timer->GetMicroseconds();
@@ -22,9 +22,43 @@ namespace te
         void Stop();
         void Start();
 
+        /** Returns the time step (in seconds) between two fixed updates. */
+        float GetFixedFrameDelta() const { return (float)(_fixedStep * MICROSEC_TO_SEC); }
+
+        /** Changes the time step (in seconds) between two fixed updates. */
+        void SetFixedFrameDelta(float step);
+
+        /**
+         * Sets the maximum number of fixed updates that can run in a single frame. When a frame takes longer than this
+         * many steps, the remaining simulation time is dropped instead of being caught up on, so a slow frame can't cause
+         * an ever growing number of updates.
+         */
+        void SetMaxFixedUpdateSteps(UINT32 steps) { _maxFixedSteps = std::max(steps, 1U); }
+
+        /**
+         * Returns how far (in range [0, 1)) the current frame is between the last fixed update and the next one. Use it
+         * to interpolate simulation state when rendering at a different rate than the fixed update rate.
+         */
+        float GetFixedUpdateAlpha() const { return (float)((double)_fixedAccumulator / (double)_fixedStep); }
+
+        /**
+         * Returns the number of fixed updates that should run this frame, and the step (in microseconds) for each of
+         * them. Call AdvanceFixedUpdate() after each executed update.
+         */
+        UINT32 GetFixedUpdateStep(UINT64& step);
+
+        /** Advances the fixed update timers by @p step microseconds. */
+        void AdvanceFixedUpdate(UINT64 step);
+
     public:
         static const double MICROSEC_TO_SEC;
 
+        /** Default time step between fixed updates, 60 times a second in microseconds. */
+        static const UINT64 DEFAULT_FIXED_STEP;
+
+        /** Default maximum number of fixed updates per frame. */
+        static const UINT32 DEFAULT_MAX_FIXED_STEPS;
+
     protected:
         bool   _run;
         float  _frameDelta;
@@ -35,6 +69,10 @@ namespace te
         UINT64 _lastFrameTime;
         std::atomic<unsigned long> _currentFrame;
 
+        UINT64 _fixedStep; // Microseconds
+        UINT64 _fixedAccumulator; // Microseconds of simulation time not yet consumed by fixed updates
+        UINT32 _maxFixedSteps;
+
         SPtr<Timer> _timer;
     };
 
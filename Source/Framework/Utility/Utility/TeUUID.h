@@ -81,13 +81,7 @@ namespace std
     {
         size_t operator()(const te::UUID& value) const
         {
-            size_t hash = 0;
-            te::hash_combine(hash, value._data[0]);
-            te::hash_combine(hash, value._data[1]);
-            te::hash_combine(hash, value._data[2]);
-            te::hash_combine(hash, value._data[3]);
-
-            return hash;
+            return (size_t)te::HashBytes(value._data, sizeof(value._data));
         }
     };
 }
\ No newline at end of file
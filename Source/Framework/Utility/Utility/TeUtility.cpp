@@ -12,12 +12,7 @@ namespace te
         UINT8 digest[16];
         md5.decdigest(digest, sizeof(digest));
 
-        String buf;
-        buf.resize(32);
-        for (int i = 0; i < 16; i++)
-            snprintf(&(buf[0]) + i * 2, 3, "%02x", digest[i]);
-
-        return buf;
+        return ToHexString(digest, sizeof(digest));
     }
 
     String Md5(const String& source)
@@ -29,12 +24,7 @@ namespace te
         UINT8 digest[16];
         md5.decdigest(digest, sizeof(digest));
 
-        String buf;
-        buf.resize(32);
-        for (int i = 0; i < 16; i++)
-            snprintf(&(buf[0]) + i * 2, 3, "%02x", digest[i]);
-
-        return buf;
+        return ToHexString(digest, sizeof(digest));
     }
 
     void GetTime(char* buffer)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "String/TeString.h"
+#include "Utility/TeHash.h"
 
 namespace te
 {
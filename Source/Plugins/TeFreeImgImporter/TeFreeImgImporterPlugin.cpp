@@ -1,5 +1,6 @@
 #include "TeFreeImgImporterPrerequisites.h"
 #include "TeFreeImgImporter.h"
+#include "Importer/TeImporter.h"
 
 namespace te
 {
@@ -13,7 +14,7 @@ namespace te
 	/**	Entry point to the plugin. Called by the engine when the plugin is loaded. */
 	extern "C" TE_PLUGIN_EXPORT void* LoadPlugin()
 	{
-		te_new<FreeImgImporter>();
+		gImporter().RegisterAssetImporter(te_new<FreeImgImporter>());
 		return nullptr;
 	}
 }
\ No newline at end of file
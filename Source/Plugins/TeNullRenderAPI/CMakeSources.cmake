@@ -0,0 +1,20 @@
+set (TE_NULLRENDERAPI_INC_NOFILTER
+	"TeNullRenderAPIPrerequisites.h"
+	"TeNullRenderAPIFactory.h"
+	"TeNullRenderAPI.h"
+	"TeNullRenderWindow.h"
+)
+
+set (TE_NULLRENDERAPI_SRC_NOFILTER
+	"TeNullRenderAPIFactory.cpp"
+	"TeNullRenderAPIPlugin.cpp"
+	"TeNullRenderAPI.cpp"
+	"TeNullRenderWindow.cpp"
+)
+
+source_group ("" FILES ${TE_NULLRENDERAPI_SRC_NOFILTER} ${TE_NULLRENDERAPI_INC_NOFILTER})
+
+set (TE_NULLRENDERAPI_SRC
+	${TE_NULLRENDERAPI_INC_NOFILTER}
+	${TE_NULLRENDERAPI_SRC_NOFILTER}
+)
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "TeNullRenderAPI.h"
+#include "TeNullRenderWindow.h"
+
+namespace te
+{
+    NullRenderAPI::NullRenderAPI()
+    {
+    }
+
+    NullRenderAPI::~NullRenderAPI()
+    {
+    }
+
+    SPtr<RenderWindow> NullRenderAPI::CreateRenderWindow(const RENDER_WINDOW_DESC& windowDesc)
+    {
+        _numWindowsCreated++;
+        return te_shared_ptr_new<NullRenderWindow>(windowDesc, this);
+    }
+
+    void NullRenderAPI::Initialize()
+    {
+    }
+
+    void NullRenderAPI::Update()
+    {
+        _numFrames++;
+    }
+
+    RenderAPIStats NullRenderAPI::GetStats() const
+    {
+        RenderAPIStats stats;
+        stats.NumFrames = _numFrames.load();
+        stats.NumWindowsCreated = _numWindowsCreated.load();
+        stats.NumWindowUpdates = _numWindowUpdates.load();
+        stats.NumWindowResizes = _numWindowResizes.load();
+
+        return stats;
+    }
+}
\ No newline at end of file
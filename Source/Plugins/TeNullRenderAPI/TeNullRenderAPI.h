@@ -0,0 +1,36 @@
+#pragma once
+
+#include "TeNullRenderAPIPrerequisites.h"
+#include "RenderAPI/TeRenderAPI.h"
+
+#include <atomic>
+
+namespace te
+{
+    /**
+     * Render API that produces no output and requires neither a GPU nor a display. It only keeps count of the work
+     * submitted to it, which makes it suitable for dedicated servers and for benchmarking the rest of the frame.
+     */
+    class NullRenderAPI: public RenderAPI
+    {
+    public:
+        NullRenderAPI();
+        ~NullRenderAPI();
+
+        SPtr<RenderWindow> CreateRenderWindow(const RENDER_WINDOW_DESC& windowDesc) override;
+        void Initialize() override;
+        void Update() override;
+
+        /** @copydoc RenderAPI::GetStats */
+        RenderAPIStats GetStats() const override;
+
+    protected:
+        friend class NullRenderWindow;
+
+        // Windows may be updated on the core thread while stats are queried on the sim thread
+        std::atomic<UINT64> _numFrames { 0 };
+        std::atomic<UINT64> _numWindowsCreated { 0 };
+        std::atomic<UINT64> _numWindowUpdates { 0 };
+        std::atomic<UINT64> _numWindowResizes { 0 };
+    };
+}
\ No newline at end of file
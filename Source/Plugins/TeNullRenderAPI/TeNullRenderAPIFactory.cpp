@@ -0,0 +1,16 @@
+#include "TeNullRenderAPIFactory.h"
+#include "TeNullRenderAPI.h"
+
+namespace te
+{
+    void NullRenderAPIFactory::Create()
+    {
+        RenderAPI::StartUp<NullRenderAPI>();
+    }
+
+    const String& NullRenderAPIFactory::Name() const
+    {
+        static String StrSystemName = SystemName;
+        return StrSystemName;
+    }
+}
\ No newline at end of file
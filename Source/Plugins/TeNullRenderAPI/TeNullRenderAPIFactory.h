@@ -0,0 +1,17 @@
+#pragma once
+
+#include "TeNullRenderAPIPrerequisites.h"
+#include "RenderAPI/TeRenderAPIFactory.h"
+
+namespace te
+{
+    class NullRenderAPIFactory : public RenderAPIFactory
+    {
+    public:
+        static constexpr const char* SystemName = "TeNullRenderAPI";
+
+        void Create() override;
+
+        const String& Name() const override;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    class NullRenderAPI;
+    class NullRenderWindow;
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "TeNullRenderWindow.h"
+#include "TeNullRenderAPI.h"
+
+namespace te
+{
+    NullRenderWindow::NullRenderWindow(const RENDER_WINDOW_DESC& desc, NullRenderAPI* owner)
+        : RenderWindow(desc)
+        , _owner(owner)
+    {
+        // There is no monitor to center the window on
+        if (_properties.Left < 0)
+            _properties.Left = 0;
+
+        if (_properties.Top < 0)
+            _properties.Top = 0;
+    }
+
+    void NullRenderWindow::Update()
+    {
+        _owner->_numWindowUpdates++;
+    }
+
+    void NullRenderWindow::Initialize()
+    {
+    }
+
+    void NullRenderWindow::GetCustomAttribute(const String& name, void* pData) const
+    {
+        if (name == "WINDOW")
+        {
+            UINT64* handle = (UINT64*)pData;
+            *handle = 0;
+            return;
+        }
+
+        RenderWindow::GetCustomAttribute(name, pData);
+    }
+
+    void NullRenderWindow::Move(INT32 left, INT32 top)
+    {
+        Lock lock(_windowMutex);
+
+        _properties.Left = left;
+        _properties.Top = top;
+        NotifyMovedOrResized();
+    }
+
+    void NullRenderWindow::Resize(UINT32 width, UINT32 height)
+    {
+        SetSize(width, height);
+    }
+
+    void NullRenderWindow::SetHidden(bool hidden)
+    {
+        Lock lock(_windowMutex);
+        RenderWindow::SetHidden(hidden);
+    }
+
+    void NullRenderWindow::SetActive(bool state)
+    {
+        SetHidden(!state);
+    }
+
+    void NullRenderWindow::Minimize()
+    {
+        Lock lock(_windowMutex);
+        _properties.IsMaximized = false;
+    }
+
+    void NullRenderWindow::Maximize()
+    {
+        Lock lock(_windowMutex);
+        _properties.IsMaximized = true;
+    }
+
+    void NullRenderWindow::Restore()
+    {
+        Lock lock(_windowMutex);
+        _properties.IsMaximized = false;
+    }
+
+    void NullRenderWindow::SetFullscreen(UINT32 width, UINT32 height, float refreshRate, UINT32 monitorIdx)
+    {
+        {
+            Lock lock(_windowMutex);
+            _properties.IsFullScreen = true;
+        }
+
+        SetSize(width, height);
+    }
+
+    void NullRenderWindow::SetFullscreen(const VideoMode& videoMode)
+    {
+        SetFullscreen(videoMode.GetWidth(), videoMode.GetHeight(), videoMode.GetRefreshRate());
+    }
+
+    void NullRenderWindow::SetWindowed(UINT32 width, UINT32 height)
+    {
+        {
+            Lock lock(_windowMutex);
+            _properties.IsFullScreen = false;
+        }
+
+        SetSize(width, height);
+    }
+
+    Vector2I NullRenderWindow::ScreenToWindowPos(const Vector2I& screenPos) const
+    {
+        Lock lock(_windowMutex);
+        return screenPos - Vector2I(_properties.Left, _properties.Top);
+    }
+
+    Vector2I NullRenderWindow::WindowToScreenPos(const Vector2I& windowPos) const
+    {
+        Lock lock(_windowMutex);
+        return windowPos + Vector2I(_properties.Left, _properties.Top);
+    }
+
+    void NullRenderWindow::WindowMovedOrResized()
+    {
+    }
+
+    void NullRenderWindow::SetSize(UINT32 width, UINT32 height)
+    {
+        Lock lock(_windowMutex);
+
+        if (_properties.Width == width && _properties.Height == height)
+            return;
+
+        _properties.Width = width;
+        _properties.Height = height;
+        _owner->_numWindowResizes++;
+
+        NotifyMovedOrResized();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "TeNullRenderAPIPrerequisites.h"
+#include "RenderAPI/TeRenderWindow.h"
+#include "Math/TeVector2I.h"
+
+namespace te
+{
+    /**
+     * Render window that isn't backed by any native window. It keeps track of its properties and reports events the same
+     * way a native window would, so code depending on the window behaves as usual.
+     */
+    class NullRenderWindow : public RenderWindow
+	{
+	public:
+        NullRenderWindow(const RENDER_WINDOW_DESC& desc, NullRenderAPI* owner);
+		~NullRenderWindow() = default;
+
+        void Update() override;
+        void Initialize() override;
+        void GetCustomAttribute(const String& name, void* pData) const override;
+        void WindowMovedOrResized() override;
+
+        /** @copydoc RenderWindow::Move */
+        void Move(INT32 left, INT32 top) override;
+
+        /** @copydoc RenderWindow::Resize */
+        void Resize(UINT32 width, UINT32 height) override;
+
+        /** @copydoc RenderWindow::SetHidden */
+        void SetHidden(bool hidden) override;
+
+        /** @copydoc RenderWindow::SetActive */
+        void SetActive(bool state) override;
+
+        /** @copydoc RenderWindow::Minimize */
+        void Minimize() override;
+
+        /** @copydoc RenderWindow::Maximize */
+        void Maximize() override;
+
+        /** @copydoc RenderWindow::Restore */
+        void Restore() override;
+
+        /** @copydoc RenderWindow::SetFullscreen(UINT32, UINT32, float, UINT32) */
+        void SetFullscreen(UINT32 width, UINT32 height, float refreshRate = 60.0f, UINT32 monitorIdx = 0) override;
+
+        /** @copydoc RenderWindow::SetFullscreen(const VideoMode&) */
+        void SetFullscreen(const VideoMode& videoMode) override;
+
+        /** @copydoc RenderWindow::SetWindowed */
+        void SetWindowed(UINT32 width, UINT32 height) override;
+
+        /** @copydoc RenderWindow::ScreenToWindowPos */
+        Vector2I ScreenToWindowPos(const Vector2I& screenPos) const override;
+
+        /** @copydoc RenderWindow::WindowToScreenPos */
+        Vector2I WindowToScreenPos(const Vector2I& windowPos) const override;
+
+    protected:
+        /** Changes the size of the window and notifies listeners if it changed. */
+        void SetSize(UINT32 width, UINT32 height);
+
+    protected:
+        NullRenderAPI* _owner;
+    };
+}
\ No newline at end of file
@@ -1,7 +1,491 @@
 #include "TeObjectImporter.h"
+#include "Importer/TeMeshImportOptions.h"
+#include "Mesh/TeMeshData.h"
+#include "Mesh/TeMeshOptimizer.h"
+#include "Serialization/TeBinarySerializer.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Error/TeDebug.h"
+
+#include <cstdlib>
 
 namespace te
 {
+    namespace
+    {
+        /** Chunks are never made smaller than this, so tiny files don't pay for spawning tasks. */
+        constexpr size_t MIN_CHUNK_SIZE = 1024 * 1024;
+
+        /** Number of chunks created per hardware thread, so uneven chunks still keep all threads busy. */
+        constexpr UINT32 CHUNKS_PER_THREAD = 4;
+
+        /** Marks a missing UV or normal index of a face corner. */
+        constexpr INT32 MISSING_INDEX = -1;
+
+        /** Exactly representable powers of 10, for the fast path of float parsing. */
+        const double POWERS_OF_10[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        /** Position, UV and normal indices of a single face corner, zero based. */
+        struct Corner
+        {
+            INT32 Position;
+            INT32 UV;
+            INT32 Normal;
+
+            bool operator==(const Corner& other) const
+            {
+                return Position == other.Position && UV == other.UV && Normal == other.Normal;
+            }
+        };
+
+        /** Face index relative to the end of the attribute list (negative OBJ index), resolved once chunks are merged. */
+        struct RelativeIndex
+        {
+            UINT32 CornerIdx;
+            UINT32 Component; /**< 0 for position, 1 for UV, 2 for normal. */
+            INT64 LocalIndex; /**< Index relative to the first attribute of the chunk, may be negative. */
+        };
+
+        /** Start of a range of faces using a material. */
+        struct MaterialRange
+        {
+            UINT32 FirstCorner;
+            String Name;
+        };
+
+        /** Part of the file parsed by a single task. */
+        struct ObjChunk
+        {
+            const char* Start = nullptr;
+            const char* End = nullptr;
+
+            Vector<Vector3> Positions;
+            Vector<Vector2> UVs;
+            Vector<Vector3> Normals;
+            Vector<Corner> Corners; /**< Three per triangle. */
+            Vector<RelativeIndex> RelativeIndices;
+            Vector<MaterialRange> Materials;
+
+            UINT32 FirstPosition = 0;
+            UINT32 FirstUV = 0;
+            UINT32 FirstNormal = 0;
+            UINT32 FirstCorner = 0;
+
+            bool Failed = false;
+            String Error; /**< Statement that failed to parse. */
+        };
+
+        bool IsSpace(char value)
+        {
+            return value == ' ' || value == '\t' || value == '\r';
+        }
+
+        bool IsDigit(char value)
+        {
+            return value >= '0' && value <= '9';
+        }
+
+        const char* SkipSpaces(const char* ptr, const char* end)
+        {
+            while (ptr < end && IsSpace(*ptr))
+                ptr++;
+
+            return ptr;
+        }
+
+        const char* SkipLine(const char* ptr, const char* end)
+        {
+            const char* lineEnd = (const char*)memchr(ptr, '\n', end - ptr);
+            return lineEnd != nullptr ? lineEnd + 1 : end;
+        }
+
+        /**
+         * Parses a decimal floating point number. Numbers with up to 15 significant digits and small exponents are
+         * converted exactly with a single multiplication or division, anything else falls back to strtod(). Returns the
+         * position after the number, or null if there is no number at @p ptr.
+         */
+        const char* ParseFloat(const char* ptr, const char* end, float& value)
+        {
+            const char* start = ptr;
+
+            bool negative = false;
+            if (ptr < end && (*ptr == '-' || *ptr == '+'))
+            {
+                negative = *ptr == '-';
+                ptr++;
+            }
+
+            UINT64 mantissa = 0;
+            INT32 numDigits = 0;
+            INT32 exponent = 0;
+            bool hasDigits = false;
+
+            for (; ptr < end && IsDigit(*ptr); ptr++)
+            {
+                hasDigits = true;
+
+                if (numDigits < 19)
+                {
+                    mantissa = mantissa * 10 + (*ptr - '0');
+                    numDigits += mantissa != 0 ? 1 : 0;
+                }
+                else
+                    exponent++;
+            }
+
+            if (ptr < end && *ptr == '.')
+            {
+                for (ptr++; ptr < end && IsDigit(*ptr); ptr++)
+                {
+                    hasDigits = true;
+
+                    if (numDigits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*ptr - '0');
+                        numDigits += mantissa != 0 ? 1 : 0;
+                        exponent--;
+                    }
+                }
+            }
+
+            if (!hasDigits)
+            {
+                // Special values such as "nan" or "inf", parsed from the start so that the sign is kept
+                if (ptr < end && !IsSpace(*ptr) && *ptr != '\n')
+                {
+                    char buffer[16];
+                    size_t length = 0;
+
+                    ptr = start;
+                    while (ptr < end && !IsSpace(*ptr) && *ptr != '\n' && length < sizeof(buffer) - 1)
+                        buffer[length++] = *ptr++;
+
+                    buffer[length] = '\0';
+
+                    char* parseEnd;
+                    value = strtof(buffer, &parseEnd);
+                    return parseEnd != buffer ? ptr : nullptr;
+                }
+
+                return nullptr;
+            }
+
+            if (ptr < end && (*ptr == 'e' || *ptr == 'E'))
+            {
+                const char* exponentStart = ptr++;
+
+                bool negativeExponent = false;
+                if (ptr < end && (*ptr == '-' || *ptr == '+'))
+                {
+                    negativeExponent = *ptr == '-';
+                    ptr++;
+                }
+
+                if (ptr < end && IsDigit(*ptr))
+                {
+                    INT32 explicitExponent = 0;
+                    for (; ptr < end && IsDigit(*ptr); ptr++)
+                    {
+                        if (explicitExponent < 10000)
+                            explicitExponent = explicitExponent * 10 + (*ptr - '0');
+                    }
+
+                    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                }
+                else
+                    ptr = exponentStart;
+            }
+
+            if (numDigits <= 15 && exponent >= -22 && exponent <= 22)
+            {
+                double result = (double)mantissa;
+                result = exponent < 0 ? result / POWERS_OF_10[-exponent] : result * POWERS_OF_10[exponent];
+
+                value = (float)(negative ? -result : result);
+                return ptr;
+            }
+
+            String number(start, ptr);
+            value = (float)strtod(number.c_str(), nullptr);
+
+            return ptr;
+        }
+
+        /** Parses a signed decimal integer. Returns the position after the number, or null if there is none. */
+        const char* ParseInt(const char* ptr, const char* end, INT64& value)
+        {
+            bool negative = false;
+            if (ptr < end && (*ptr == '-' || *ptr == '+'))
+            {
+                negative = *ptr == '-';
+                ptr++;
+            }
+
+            if (ptr >= end || !IsDigit(*ptr))
+                return nullptr;
+
+            INT64 result = 0;
+            for (; ptr < end && IsDigit(*ptr); ptr++)
+            {
+                if (result < ((INT64)1 << 40))
+                    result = result * 10 + (*ptr - '0');
+            }
+
+            value = negative ? -result : result;
+            return ptr;
+        }
+
+        /**
+         * Parses a face index and converts it into a zero based one. Positive OBJ indices are absolute, negative ones
+         * are relative to the attributes read so far, which are only known once all chunks are parsed.
+         */
+        const char* ParseIndex(const char* ptr, const char* end, UINT32 component, UINT32 numLocal, INT32& index,
+            Vector<RelativeIndex>& relativeIndices)
+        {
+            INT64 value;
+            ptr = ParseInt(ptr, end, value);
+            if (ptr == nullptr || value == 0)
+                return nullptr;
+
+            if (value > 0)
+            {
+                if (value > std::numeric_limits<INT32>::max())
+                    return nullptr;
+
+                index = (INT32)(value - 1);
+            }
+            else
+            {
+                index = 0;
+                relativeIndices.push_back({ 0, component, (INT64)numLocal + value });
+            }
+
+            return ptr;
+        }
+
+        /** Parses a "f" line, triangulating the polygon as a fan. */
+        const char* ParseFace(const char* ptr, const char* end, ObjChunk& chunk, Vector<Corner>& polygon,
+            Vector<RelativeIndex>& relativeIndices)
+        {
+            polygon.clear();
+            relativeIndices.clear();
+
+            while (true)
+            {
+                ptr = SkipSpaces(ptr, end);
+                if (ptr >= end || *ptr == '\n' || *ptr == '#')
+                    break;
+
+                const UINT32 cornerIdx = (UINT32)polygon.size();
+                const size_t firstRelative = relativeIndices.size();
+
+                Corner corner = { 0, MISSING_INDEX, MISSING_INDEX };
+                ptr = ParseIndex(ptr, end, 0, (UINT32)chunk.Positions.size(), corner.Position, relativeIndices);
+                if (ptr == nullptr)
+                    return nullptr;
+
+                if (ptr < end && *ptr == '/')
+                {
+                    ptr++;
+                    if (ptr < end && *ptr != '/')
+                    {
+                        ptr = ParseIndex(ptr, end, 1, (UINT32)chunk.UVs.size(), corner.UV, relativeIndices);
+                        if (ptr == nullptr)
+                            return nullptr;
+                    }
+
+                    if (ptr < end && *ptr == '/')
+                    {
+                        ptr = ParseIndex(ptr + 1, end, 2, (UINT32)chunk.Normals.size(), corner.Normal, relativeIndices);
+
+                        if (ptr == nullptr)
+                            return nullptr;
+                    }
+                }
+
+                for (size_t i = firstRelative; i < relativeIndices.size(); i++)
+                    relativeIndices[i].CornerIdx = cornerIdx;
+
+                polygon.push_back(corner);
+            }
+
+            if (polygon.size() < 3)
+                return nullptr;
+
+            for (UINT32 i = 1; i + 1 < (UINT32)polygon.size(); i++)
+            {
+                const UINT32 triangleCorners[] = { 0, i, i + 1 };
+                for (UINT32 triangleCorner : triangleCorners)
+                {
+                    for (auto& relativeIndex : relativeIndices)
+                    {
+                        if (relativeIndex.CornerIdx == triangleCorner)
+                        {
+                            chunk.RelativeIndices.push_back({ (UINT32)chunk.Corners.size(), relativeIndex.Component,
+                                relativeIndex.LocalIndex });
+                        }
+                    }
+
+                    chunk.Corners.push_back(polygon[triangleCorner]);
+                }
+            }
+
+            return ptr;
+        }
+
+        /** Parses up to @p count floats, remaining values are left unchanged. Returns null on malformed input. */
+        const char* ParseFloats(const char* ptr, const char* end, float* values, UINT32 count, UINT32 minCount)
+        {
+            for (UINT32 i = 0; i < count; i++)
+            {
+                ptr = SkipSpaces(ptr, end);
+                if (ptr >= end || *ptr == '\n')
+                    return i >= minCount ? ptr : nullptr;
+
+                ptr = ParseFloat(ptr, end, values[i]);
+                if (ptr == nullptr)
+                    return nullptr;
+            }
+
+            return ptr;
+        }
+
+        /** Parses all the lines of a chunk. */
+        void ParseChunk(ObjChunk& chunk)
+        {
+            const char* ptr = chunk.Start;
+            const char* end = chunk.End;
+
+            Vector<Corner> polygon;
+            Vector<RelativeIndex> relativeIndices;
+
+            while (ptr < end)
+            {
+                ptr = SkipSpaces(ptr, end);
+                if (ptr >= end)
+                    break;
+
+                const char* lineStart = ptr;
+                const char next = ptr + 1 < end ? ptr[1] : '\n';
+
+                if (*ptr == 'v' && IsSpace(next))
+                {
+                    Vector3 position(0.0f, 0.0f, 0.0f);
+                    ptr = ParseFloats(ptr + 1, end, &position.x, 3, 3);
+                    chunk.Positions.push_back(position);
+                }
+                else if (*ptr == 'v' && next == 't' && ptr + 2 < end && IsSpace(ptr[2]))
+                {
+                    Vector2 uv(0.0f, 0.0f);
+                    ptr = ParseFloats(ptr + 2, end, &uv.x, 2, 1);
+                    chunk.UVs.push_back(uv);
+                }
+                else if (*ptr == 'v' && next == 'n' && ptr + 2 < end && IsSpace(ptr[2]))
+                {
+                    Vector3 normal(0.0f, 0.0f, 0.0f);
+                    ptr = ParseFloats(ptr + 2, end, &normal.x, 3, 3);
+                    chunk.Normals.push_back(normal);
+                }
+                else if (*ptr == 'f' && IsSpace(next))
+                    ptr = ParseFace(ptr + 1, end, chunk, polygon, relativeIndices);
+                else if (end - ptr > 7 && memcmp(ptr, "usemtl", 6) == 0 && IsSpace(ptr[6]))
+                {
+                    const char* nameStart = SkipSpaces(ptr + 6, end);
+                    const char* nameEnd = nameStart;
+                    while (nameEnd < end && *nameEnd != '\n' && *nameEnd != '\r')
+                        nameEnd++;
+
+                    while (nameEnd > nameStart && IsSpace(nameEnd[-1]))
+                        nameEnd--;
+
+                    chunk.Materials.push_back({ (UINT32)chunk.Corners.size(), String(nameStart, nameEnd) });
+                    ptr = nameEnd;
+                }
+
+                // Other statements (groups, smoothing groups, material libraries, lines, comments) don't affect the mesh
+                if (ptr == nullptr)
+                {
+                    chunk.Error = String(lineStart, SkipLine(lineStart, end));
+                    chunk.Failed = true;
+                    return;
+                }
+
+                ptr = SkipLine(ptr, end);
+            }
+        }
+
+        /** Runs @p function for every index in [0, count), in parallel if the task scheduler is running. */
+        void ParallelFor(UINT32 count, const std::function<void(UINT32)>& function)
+        {
+            if (count <= 1 || !TaskScheduler::IsStarted())
+            {
+                for (UINT32 i = 0; i < count; i++)
+                    function(i);
+
+                return;
+            }
+
+            Vector<SPtr<Task>> tasks;
+            tasks.reserve(count);
+
+            for (UINT32 i = 0; i < count; i++)
+            {
+                tasks.push_back(Task::Create("ObjectImport", [&function, i]() { function(i); }));
+                gTaskScheduler().AddTask(tasks.back());
+            }
+
+            for (auto& task : tasks)
+                task->Wait();
+        }
+
+        /**
+         * Finds the first corner with the same indices as each corner. Corners are bucketed by their position index,
+         * which acts as a perfect hash, and each bucket holds the few distinct UV and normal combinations used with the
+         * position. Faces tend to reference nearby positions, so the buckets stay in cache, unlike with a generic hash
+         * table. Position ranges are processed in parallel.
+         */
+        void FindFirstOccurrences(const Vector<Corner>& corners, UINT32 numPositions, Vector<UINT32>& firstOccurrence,
+            UINT32 numPartitions)
+        {
+            constexpr UINT32 END_OF_LIST = std::numeric_limits<UINT32>::max();
+
+            const UINT32 numCorners = (UINT32)corners.size();
+            firstOccurrence.resize(numCorners);
+
+            Vector<UINT32> buckets(numPositions, END_OF_LIST);
+            Vector<UINT32> nextInBucket(numCorners);
+
+            ParallelFor(numPartitions, [&](UINT32 partition)
+            {
+                const INT32 rangeStart = (INT32)((UINT64)numPositions * partition / numPartitions);
+                const INT32 rangeEnd = (INT32)((UINT64)numPositions * (partition + 1) / numPartitions);
+
+                for (UINT32 i = 0; i < numCorners; i++)
+                {
+                    const Corner& corner = corners[i];
+                    if (corner.Position < rangeStart || corner.Position >= rangeEnd)
+                        continue;
+
+                    UINT32 existing = buckets[corner.Position];
+                    while (existing != END_OF_LIST && !(corners[existing] == corner))
+                        existing = nextInBucket[existing];
+
+                    if (existing != END_OF_LIST)
+                        firstOccurrence[i] = existing;
+                    else
+                    {
+                        firstOccurrence[i] = i;
+                        nextInBucket[i] = buckets[corner.Position];
+                        buckets[corner.Position] = i;
+                    }
+                }
+            });
+        }
+    }
+
     ObjectImporter::ObjectImporter()
     {
     }
@@ -9,4 +493,217 @@ namespace te
     ObjectImporter::~ObjectImporter()
     {
     }
+
+    bool ObjectImporter::IsExtensionSupported(StringView extension) const
+    {
+        return extension == "obj";
+    }
+
+    SPtr<ImportOptions> ObjectImporter::CreateImportOptions() const
+    {
+        return te_shared_ptr_new<MeshImportOptions>();
+    }
+
+    bool ObjectImporter::Import(const String& filePath, const UINT8* data, size_t size, const ImportOptions& options,
+        Vector<UINT8>& output) const
+    {
+        const MeshImportOptions& meshOptions = static_cast<const MeshImportOptions&>(options);
+
+        // Split the file at line boundaries
+        const UINT32 maxChunks = std::max(TE_THREAD_HARDWARE_CONCURRENCY, 1U) * CHUNKS_PER_THREAD;
+        const UINT32 numChunks = (UINT32)std::max((size_t)1, std::min(size / MIN_CHUNK_SIZE, (size_t)maxChunks));
+
+        const char* text = (const char*)data;
+        const char* textEnd = text + size;
+
+        Vector<ObjChunk> chunks(numChunks);
+        const char* chunkStart = text;
+        for (UINT32 i = 0; i < numChunks; i++)
+        {
+            const char* chunkEnd = i + 1 == numChunks ? textEnd : text + size / numChunks * (i + 1);
+            if (chunkEnd < chunkStart)
+                chunkEnd = chunkStart;
+
+            if (chunkEnd < textEnd)
+                chunkEnd = SkipLine(chunkEnd, textEnd);
+
+            chunks[i].Start = chunkStart;
+            chunks[i].End = chunkEnd;
+            chunkStart = chunkEnd;
+        }
+
+        ParallelFor(numChunks, [&chunks](UINT32 idx) { ParseChunk(chunks[idx]); });
+
+        // Merge the chunks, resolving relative indices now that the attribute counts before each chunk are known
+        UINT64 numPositions = 0;
+        UINT64 numUVs = 0;
+        UINT64 numNormals = 0;
+        UINT64 numCorners = 0;
+
+        for (auto& chunk : chunks)
+        {
+            if (chunk.Failed)
+            {
+                TE_DEBUG("Malformed statement in OBJ file " + filePath + ": " + chunk.Error);
+                return false;
+            }
+
+            chunk.FirstPosition = (UINT32)numPositions;
+            chunk.FirstUV = (UINT32)numUVs;
+            chunk.FirstNormal = (UINT32)numNormals;
+            chunk.FirstCorner = (UINT32)numCorners;
+
+            numPositions += chunk.Positions.size();
+            numUVs += chunk.UVs.size();
+            numNormals += chunk.Normals.size();
+            numCorners += chunk.Corners.size();
+        }
+
+        if (numCorners == 0)
+        {
+            TE_DEBUG("OBJ file contains no faces: " + filePath);
+            return false;
+        }
+
+        if (std::max({ numPositions, numUVs, numNormals, numCorners }) >= (UINT64)std::numeric_limits<INT32>::max())
+        {
+            TE_DEBUG("OBJ file is too large to import: " + filePath);
+            return false;
+        }
+
+        const bool useUVs = meshOptions.ImportUVs && numUVs > 0;
+        const bool useNormals = meshOptions.ImportNormals && numNormals > 0;
+
+        Vector<Vector3> positions((size_t)numPositions);
+        Vector<Vector2> uvs(useUVs ? (size_t)numUVs : 0);
+        Vector<Vector3> normals(useNormals ? (size_t)numNormals : 0);
+        Vector<Corner> corners((size_t)numCorners);
+        std::atomic<bool> hasInvalidIndices(false);
+
+        ParallelFor(numChunks, [&](UINT32 idx)
+        {
+            ObjChunk& chunk = chunks[idx];
+
+            for (auto& relativeIndex : chunk.RelativeIndices)
+            {
+                Corner& corner = chunk.Corners[relativeIndex.CornerIdx];
+                INT32* indices[] = { &corner.Position, &corner.UV, &corner.Normal };
+                const UINT32 firstIndices[] = { chunk.FirstPosition, chunk.FirstUV, chunk.FirstNormal };
+
+                const INT64 index = firstIndices[relativeIndex.Component] + relativeIndex.LocalIndex;
+                *indices[relativeIndex.Component] = index >= 0 ? (INT32)index : std::numeric_limits<INT32>::max();
+            }
+
+            for (auto& corner : chunk.Corners)
+            {
+                if (!useUVs)
+                    corner.UV = MISSING_INDEX;
+
+                if (!useNormals)
+                    corner.Normal = MISSING_INDEX;
+
+                if (corner.Position < 0 || corner.Position >= (INT64)numPositions || corner.UV >= (INT64)numUVs ||
+                    corner.Normal >= (INT64)numNormals)
+                {
+                    hasInvalidIndices = true;
+                }
+            }
+
+            std::copy(chunk.Positions.begin(), chunk.Positions.end(), positions.begin() + chunk.FirstPosition);
+            std::copy(chunk.Corners.begin(), chunk.Corners.end(), corners.begin() + chunk.FirstCorner);
+
+            if (useUVs)
+                std::copy(chunk.UVs.begin(), chunk.UVs.end(), uvs.begin() + chunk.FirstUV);
+
+            if (useNormals)
+                std::copy(chunk.Normals.begin(), chunk.Normals.end(), normals.begin() + chunk.FirstNormal);
+
+            chunk.Positions = Vector<Vector3>();
+            chunk.UVs = Vector<Vector2>();
+            chunk.Normals = Vector<Vector3>();
+            chunk.Corners = Vector<Corner>();
+        });
+
+        if (hasInvalidIndices)
+        {
+            TE_DEBUG("OBJ file references vertex attributes that don't exist: " + filePath);
+            return false;
+        }
+
+        // Deduplicate vertices. First occurrences always precede the corners referencing them, so a single pass in
+        // corner order turns them into vertex indices, in the order vertices are first used.
+        const UINT32 numPartitions = numChunks > 1 ? std::max(TE_THREAD_HARDWARE_CONCURRENCY, 1U) : 1;
+
+        Vector<UINT32> vertexIndices;
+        FindFirstOccurrences(corners, (UINT32)numPositions, vertexIndices, numPartitions);
+
+        MeshData mesh;
+        mesh.Positions.reserve((size_t)numPositions);
+
+        for (UINT32 i = 0; i < (UINT32)numCorners; i++)
+        {
+            if (vertexIndices[i] != i)
+            {
+                vertexIndices[i] = vertexIndices[vertexIndices[i]];
+                continue;
+            }
+
+            const Corner& corner = corners[i];
+            vertexIndices[i] = (UINT32)mesh.Positions.size();
+
+            mesh.Positions.push_back(positions[corner.Position] * meshOptions.Scale);
+
+            if (useUVs)
+                mesh.UVs.push_back(corner.UV != MISSING_INDEX ? uvs[corner.UV] : Vector2(0.0f, 0.0f));
+
+            if (useNormals)
+                mesh.Normals.push_back(corner.Normal != MISSING_INDEX ? normals[corner.Normal] : Vector3(0.0f, 0.0f, 0.0f));
+        }
+
+        // Group faces by material, in the order materials are first used
+        Vector<MaterialRange> ranges = { { 0, String() } };
+        for (auto& chunk : chunks)
+        {
+            for (auto& material : chunk.Materials)
+                ranges.push_back({ chunk.FirstCorner + material.FirstCorner, material.Name });
+        }
+
+        Vector<String> materialNames;
+        Map<String, Vector<std::pair<UINT32, UINT32>>> materialRanges;
+
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            const UINT32 rangeEnd = i + 1 < ranges.size() ? ranges[i + 1].FirstCorner : (UINT32)numCorners;
+            if (rangeEnd == ranges[i].FirstCorner)
+                continue;
+
+            auto& entries = materialRanges[ranges[i].Name];
+            if (entries.empty())
+                materialNames.push_back(ranges[i].Name);
+
+            entries.push_back(std::make_pair(ranges[i].FirstCorner, rangeEnd));
+        }
+
+        mesh.Indices.reserve((size_t)numCorners);
+        for (auto& name : materialNames)
+        {
+            SubMesh subMesh;
+            subMesh.IndexOffset = (UINT32)mesh.Indices.size();
+            subMesh.MaterialName = name;
+
+            for (auto& range : materialRanges[name])
+                mesh.Indices.insert(mesh.Indices.end(), vertexIndices.begin() + range.first, vertexIndices.begin() + range.second);
+
+            subMesh.IndexCount = (UINT32)mesh.Indices.size() - subMesh.IndexOffset;
+            mesh.SubMeshes.push_back(subMesh);
+        }
+
+        MeshOptimizer::Optimize(mesh, meshOptions);
+
+        BinaryWriter writer;
+        writer.Write(mesh);
+        output = writer.TakeData();
+
+        return true;
+    }
 }
\ No newline at end of file
@@ -5,10 +5,29 @@
 
 namespace te
 {
+    /**
+     * Imports Wavefront OBJ files into MeshData. Large files are split into chunks at line boundaries, which are parsed
+     * in parallel as TaskScheduler tasks. Vertices are then deduplicated by their position, UV and normal indices, and
+     * faces are triangulated and grouped into one sub-mesh per material. MeshOptimizer then runs the optimizations
+     * enabled in MeshImportOptions.
+     */
     class ObjectImporter: public BaseImporter
     {
     public:
         ObjectImporter();
         ~ObjectImporter();
+
+        /** @copydoc BaseImporter::IsExtensionSupported */
+        bool IsExtensionSupported(StringView extension) const override;
+
+        /** @copydoc BaseImporter::GetVersion */
+        UINT32 GetVersion() const override { return 3; }
+
+        /** @copydoc BaseImporter::CreateImportOptions */
+        SPtr<ImportOptions> CreateImportOptions() const override;
+
+        /** @copydoc BaseImporter::Import */
+        bool Import(const String& filePath, const UINT8* data, size_t size, const ImportOptions& options,
+            Vector<UINT8>& output) const override;
     };
 }
\ No newline at end of file
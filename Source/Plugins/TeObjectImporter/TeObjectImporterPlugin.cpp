@@ -1,5 +1,6 @@
 #include "TeObjectImporterPrerequisites.h"
 #include "TeObjectImporter.h"
+#include "Importer/TeImporter.h"
 
 namespace te
 {
@@ -13,7 +14,7 @@ namespace te
 	/**	Entry point to the plugin. Called by the engine when the plugin is loaded. */
 	extern "C" TE_PLUGIN_EXPORT void* LoadPlugin()
 	{
-		te_new<ObjectImporter>();
+		gImporter().RegisterAssetImporter(te_new<ObjectImporter>());
 		return nullptr;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+set (TE_PACKBUILDER_INC_NOFILTER
+)
+
+set (TE_PACKBUILDER_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_PACKBUILDER_SRC_NOFILTER} ${TE_PACKBUILDER_INC_NOFILTER})
+
+set (TE_PACKBUILDER_SRC
+    ${TE_PACKBUILDER_INC_NOFILTER}
+    ${TE_PACKBUILDER_SRC_NOFILTER}
+)
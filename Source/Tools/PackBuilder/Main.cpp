@@ -0,0 +1,174 @@
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "FileSystem/TePackArchive.h"
+#include "FileSystem/TePackArchiveBuilder.h"
+
+#include <cstdio>
+#include <filesystem>
+
+/**
+ * Command line tool that packs files into a pack archive (see PackArchive).
+ *
+ * Assets are stored with their path relative to the root folder, and a UUID derived from that path, so rebuilding an
+ * archive from the same files results in the same UUIDs.
+ */
+
+namespace te
+{
+    void PrintUsage()
+    {
+        printf(
+            "Usage: PackBuilder [options] <archive> <file or folder>...\n"
+            "\n"
+            "Options:\n"
+            "  --append       Add the files to an existing archive instead of rewriting it.\n"
+            "  --compress     Compress files that compress well.\n"
+            "  --align <n>    Alignment of file data in bytes (default %u).\n"
+            "  --root <path>  Folder paths are stored relative to (default: working folder).\n"
+            "  --list         Print the contents of the archive and exit.\n",
+            PackArchiveBuilder::DEFAULT_ALIGNMENT);
+    }
+
+    /** Derives a UUID from the path of an asset. */
+    UUID MakeUUID(const String& path)
+    {
+        const UINT64 first = PackArchive::HashPath(path);
+        const UINT64 second = PackArchive::HashPath(path + ":" + ToString(first));
+
+        return UUID((UINT32)first, (UINT32)(first >> 32), (UINT32)second, (UINT32)(second >> 32));
+    }
+
+    int ListArchive(const String& path)
+    {
+        PackArchive archive(path);
+        if (!archive.IsValid())
+        {
+            printf("Unable to open archive: %s\n", path.c_str());
+            return 1;
+        }
+
+        for (UINT32 i = 0; i < archive.GetNumEntries(); i++)
+        {
+            const PackEntry& entry = archive.GetEntry(i);
+            printf("%s %12llu %12llu %s\n", entry.Id.ToString().c_str(), (unsigned long long)entry.UncompressedSize,
+                (unsigned long long)entry.Size, archive.GetEntryPath(entry).c_str());
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace te;
+    namespace fs = std::filesystem;
+
+    bool append = false;
+    bool compress = false;
+    bool list = false;
+    UINT32 alignment = PackArchiveBuilder::DEFAULT_ALIGNMENT;
+    fs::path root;
+    Vector<String> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const String arg = argv[i];
+
+        if (arg == "--append")
+            append = true;
+        else if (arg == "--compress")
+            compress = true;
+        else if (arg == "--list")
+            list = true;
+        else if (arg == "--align" && i + 1 < argc)
+            alignment = (UINT32)std::max(atoi(argv[++i]), 1);
+        else if (arg == "--root" && i + 1 < argc)
+            root = fs::path(argv[++i]);
+        else if (arg.compare(0, 2, "--") == 0)
+        {
+            PrintUsage();
+            return 1;
+        }
+        else
+            inputs.push_back(arg);
+    }
+
+    if (inputs.empty() || (!list && inputs.size() < 2))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const String archivePath = inputs[0];
+    if (list)
+        return ListArchive(archivePath);
+
+    // Built without exceptions, only the std::filesystem overloads reporting errors through an error code can be used
+    std::error_code error;
+    root = root.empty() ? fs::current_path(error) : fs::absolute(root, error);
+    if (error)
+    {
+        printf("Unable to resolve the root folder: %s\n", error.message().c_str());
+        return 1;
+    }
+
+    PackArchiveBuilder builder(alignment);
+
+    auto addFile = [&](const fs::path& file)
+    {
+        std::error_code fileError;
+        const fs::path absolute = fs::absolute(file, fileError);
+        if (fileError)
+        {
+            printf("Unable to resolve path: %s\n", file.string().c_str());
+            return false;
+        }
+
+        const String path = PackArchive::NormalizePath(absolute.lexically_relative(root).generic_string().c_str());
+        builder.AddFile(MakeUUID(path), path, file.string().c_str(), compress);
+
+        return true;
+    };
+
+    for (size_t i = 1; i < inputs.size(); i++)
+    {
+        const fs::path input(inputs[i].c_str());
+
+        if (fs::is_directory(input, error))
+        {
+            fs::recursive_directory_iterator iter(input, error);
+            for (; !error && iter != fs::recursive_directory_iterator(); iter.increment(error))
+            {
+                std::error_code entryError;
+                if (iter->is_regular_file(entryError) && !addFile(iter->path()))
+                    return 1;
+            }
+
+            if (error)
+            {
+                printf("Unable to read folder: %s (%s)\n", inputs[i].c_str(), error.message().c_str());
+                return 1;
+            }
+        }
+        else if (fs::is_regular_file(input, error))
+        {
+            if (!addFile(input))
+                return 1;
+        }
+        else
+        {
+            printf("Input not found: %s\n", inputs[i].c_str());
+            return 1;
+        }
+    }
+
+    const UINT32 numFiles = builder.GetNumPending();
+    const bool success = append ? builder.Append(archivePath) : builder.Write(archivePath);
+    if (!success)
+    {
+        printf("Unable to write archive: %s\n", archivePath.c_str());
+        return 1;
+    }
+
+    printf("%s %u files to %s\n", append ? "Appended" : "Packed", numFiles, archivePath.c_str());
+    return 0;
+}
\ No newline at end of file